@@ -0,0 +1,170 @@
+#include <benchmark/benchmark.h>
+
+#include "General/Allocator.h"
+#include "General/ArenaAllocator.h"
+#include "General/PoolAllocator.h"
+#include "General/HeapAllocator.h"
+#include "General/TrackingAllocator.h"
+#include "General/AlignedAllocator.h"
+#include "Containers/Vector.h"
+#include "Containers/String.h"
+
+#include <cstdlib>
+
+namespace AllocatorBench
+{
+  using ArenaString = SSTD::TString<char, '\0', size_t, SSTD::ArenaAllocator>;
+
+  static const char LongText[] = "a string that is too long for the small string buffer";
+
+  //build a vector of strings and throw it away again, like a per-request scratch list
+  static void VectorOfStrings(benchmark::State& state)
+  {
+    for (auto _ : state)
+    {
+      SSTD::Vector<SSTD::String> v{};
+      for (int64 i = 0; i < state.range(0); ++i)
+        v.EmplaceBack(LongText);
+      benchmark::DoNotOptimize(v.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void ArenaVectorOfStrings(benchmark::State& state)
+  {
+    SSTD::LinearArena arena{};
+    for (auto _ : state)
+    {
+      {
+        SSTD::ArenaScope scope(arena);
+        SSTD::Vector<ArenaString, size_t, SSTD::ArenaAllocator> v{};
+        for (int64 i = 0; i < state.range(0); ++i)
+          v.EmplaceBack(LongText);
+        benchmark::DoNotOptimize(v.Data());
+      }
+      arena.Reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void AllocateSmall(benchmark::State& state)
+  {
+    SSTD::Allocator<uint64> allocator{};
+    for (auto _ : state)
+    {
+      uint64* ptr = allocator.Allocate(4);
+      benchmark::DoNotOptimize(ptr);
+      allocator.Deallocate(ptr);
+    }
+  }
+
+  static void ArenaAllocateSmall(benchmark::State& state)
+  {
+    SSTD::LinearArena arena{};
+    SSTD::ArenaAllocator<uint64> allocator{ arena };
+    auto marker = arena.GetMarker();
+    for (auto _ : state)
+    {
+      uint64* ptr = allocator.Allocate(4);
+      benchmark::DoNotOptimize(ptr);
+      arena.Rollback(marker);
+    }
+  }
+
+  struct Node
+  {
+    Node* next;
+    Node* prev;
+    uint64 data;
+  };
+
+  //allocate a batch of list-node sized objects and free them again, from every thread
+  template<template<typename> typename A>
+  static void NodeChurn(benchmark::State& state)
+  {
+    static constexpr uint32 Count = 256;
+    A<Node> allocator{};
+    Node* nodes[Count];
+    for (auto _ : state)
+    {
+      for (uint32 i = 0; i < Count; ++i)
+        nodes[i] = allocator.Allocate(1);
+      benchmark::DoNotOptimize(nodes);
+      for (uint32 i = 0; i < Count; ++i)
+        allocator.Deallocate(nodes[i]);
+    }
+    state.SetItemsProcessed(state.iterations() * Count);
+  }
+
+  struct MallocHeap
+  {
+    static void* Allocate(size_t size) { return malloc(size); }
+    static void Free(void* ptr) { free(ptr); }
+  };
+
+  struct SSTDHeap
+  {
+    static void* Allocate(size_t size) { return SSTD::Heap::Allocate(size); }
+    static void Free(void* ptr) { SSTD::Heap::Free(ptr); }
+  };
+
+  //keep a window of live blocks with mixed sizes (8 byte - 4 KiB, mostly small) and replace one per step
+  template<typename H>
+  static void MixedChurn(benchmark::State& state)
+  {
+    static constexpr uint32 Live = 1024;
+    void* blocks[Live]{};
+    uint32 seed = 0x9E3779B9u + static_cast<uint32>(state.thread_index());
+    uint32 index = 0;
+    for (auto _ : state)
+    {
+      seed = seed * 1664525u + 1013904223u;
+      size_t size = (seed >> 28) < 12 ? 8 + ((seed >> 8) & 255) : 8 + ((seed >> 8) & 4095);
+
+      H::Free(blocks[index]);
+      blocks[index] = H::Allocate(size);
+      benchmark::DoNotOptimize(blocks[index]);
+      index = (index + 1) % Live;
+    }
+    for (uint32 i = 0; i < Live; ++i)
+      H::Free(blocks[i]);
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  //random reads over a buffer much bigger than the TLB reach of 4 KiB pages
+  template<template<typename> typename A>
+  static void RandomGather(benchmark::State& state)
+  {
+    const size_t count = static_cast<size_t>(state.range(0)) * SSTD::Byte::MB / sizeof(float);
+    SSTD::Vector<float, size_t, A> buffer(1.0f, count);
+
+    uint64 seed = 0x9E3779B97F4A7C15ull;
+    float sum = 0;
+    for (auto _ : state)
+    {
+      for (uint32 i = 0; i < 1024; ++i)
+      {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        sum += buffer[(seed >> 16) % count];
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * 1024);
+  }
+}
+
+BENCHMARK(AllocatorBench::VectorOfStrings)->Range(8, 8 << 10);
+BENCHMARK(AllocatorBench::ArenaVectorOfStrings)->Range(8, 8 << 10);
+
+BENCHMARK(AllocatorBench::AllocateSmall);
+BENCHMARK(AllocatorBench::ArenaAllocateSmall);
+
+BENCHMARK(AllocatorBench::NodeChurn<SSTD::Allocator>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(AllocatorBench::NodeChurn<SSTD::PoolAllocator>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(AllocatorBench::NodeChurn<SSTD::TrackingAllocator>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK(AllocatorBench::MixedChurn<AllocatorBench::MallocHeap>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(AllocatorBench::MixedChurn<AllocatorBench::SSTDHeap>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK(AllocatorBench::RandomGather<SSTD::Allocator>)->Arg(256);
+BENCHMARK(AllocatorBench::RandomGather<SSTD::AlignedAllocator>)->Arg(256);
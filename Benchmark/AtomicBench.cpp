@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#include "Platform/Threading/Atomic.h"
+#include "Platform/Threading/Mutex.h"
+#include "Platform/Threading/Lock.h"
+
+namespace AtomicBench
+{
+  struct Node
+  {
+    Node* next = nullptr;
+    uint64 value = 0;
+  };
+
+  //Treiber stack, the tag gets bumped on every pop so a stale head can never win the compare-exchange
+  struct TaggedStack
+  {
+    void Push(Node* node)
+    {
+      auto head = m_Head.Peek();
+      do
+      {
+        node->next = head.first;
+      } while (!m_Head.CompareExchange(head, node, head.second, SSTD::MemoryOrder::Release));
+    }
+
+    Node* Pop()
+    {
+      auto head = m_Head.Peek();
+      while (head.first)
+      {
+        if (m_Head.CompareExchange(head, head.first->next, head.second + 1, SSTD::MemoryOrder::Acquire))
+          return head.first;
+      }
+      return nullptr;
+    }
+
+    SSTD::AtomicTaggedPointer<Node> m_Head;
+  };
+
+  struct LockedStack
+  {
+    void Push(Node* node)
+    {
+      SSTD::Lock<SSTD::Mutex> lock(m_Mutex);
+      node->next = m_Head;
+      m_Head = node;
+    }
+
+    Node* Pop()
+    {
+      SSTD::Lock<SSTD::Mutex> lock(m_Mutex);
+      Node* node = m_Head;
+      if (node)
+        m_Head = node->next;
+      return node;
+    }
+
+    SSTD::Mutex m_Mutex;
+    Node* m_Head = nullptr;
+  };
+
+  static constexpr uint32 MaxThreads = 64;
+  static constexpr uint32 NodesPerThread = 64;
+
+  //nodes are never freed, so a node another thread just popped is always safe to read
+  static Node s_Nodes[MaxThreads * NodesPerThread];
+
+  static TaggedStack s_TaggedStack;
+  static LockedStack s_LockedStack;
+
+  template<typename Stack>
+  static void StackPushPop(benchmark::State& state, Stack& stack)
+  {
+    Node* nodes = s_Nodes + state.thread_index() * NodesPerThread;
+    for (uint32 i = 0; i < NodesPerThread; ++i)
+      stack.Push(nodes + i);
+
+    for (auto _ : state)
+    {
+      Node* node = stack.Pop();
+      if (node)
+      {
+        benchmark::DoNotOptimize(node->value++);
+        stack.Push(node);
+      }
+    }
+
+    //pop as many as we pushed, after the last thread finishes the stack is empty again
+    for (uint32 i = 0; i < NodesPerThread; ++i)
+      while (!stack.Pop())
+        ;
+  }
+
+  static void TaggedStackPushPop(benchmark::State& state)
+  {
+    StackPushPop(state, s_TaggedStack);
+  }
+
+  static void LockedStackPushPop(benchmark::State& state)
+  {
+    StackPushPop(state, s_LockedStack);
+  }
+
+  static void AtomicPointerCompareExchange(benchmark::State& state)
+  {
+    Node node;
+    SSTD::AtomicPointer<Node> ptr(&node);
+    for (auto _ : state)
+    {
+      Node* expected = &node;
+      benchmark::DoNotOptimize(ptr.CompareExchange(expected, &node));
+    }
+  }
+
+  static void AtomicPairCompareExchange(benchmark::State& state)
+  {
+    Node node;
+    SSTD::AtomicTaggedPointer<Node> ptr(&node, 0);
+    auto expected = ptr.Peek();
+    for (auto _ : state)
+      benchmark::DoNotOptimize(ptr.CompareExchange(expected, &node, expected.second + 1));
+  }
+}
+
+BENCHMARK(AtomicBench::AtomicPointerCompareExchange);
+BENCHMARK(AtomicBench::AtomicPairCompareExchange);
+
+BENCHMARK(AtomicBench::TaggedStackPushPop)->ThreadRange(1, AtomicBench::MaxThreads)->UseRealTime();
+BENCHMARK(AtomicBench::LockedStackPushPop)->ThreadRange(1, AtomicBench::MaxThreads)->UseRealTime();
@@ -0,0 +1,177 @@
+#include <benchmark/benchmark.h>
+
+#include "Containers/BTreeMap.h"
+#include "Containers/Vector.h"
+
+#include <map>
+#include <random>
+
+namespace BTreeBench
+{
+  //the length of one range scan
+  static constexpr uint32 ScanLength = 64;
+
+  static SSTD::Vector<uint64> MakeKeys(int64 count, uint64 seed)
+  {
+    std::mt19937_64 rng(seed);
+    SSTD::Vector<uint64> keys{};
+    for (int64 i = 0; i < count; ++i)
+      keys.PushBack(rng());
+    return keys;
+  }
+
+  //time ordered keys, like the timestamps of an event log
+  static SSTD::Vector<uint64> MakeSortedKeys(int64 count)
+  {
+    SSTD::Vector<uint64> keys{};
+    for (int64 i = 0; i < count; ++i)
+      keys.PushBack(static_cast<uint64>(i) * 16);
+    return keys;
+  }
+
+  static void BTreeInsert(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    for (auto _ : state)
+    {
+      SSTD::BTreeMap<uint64, uint64> map{};
+      for (uint64 key : keys)
+        map.Insert(key, key);
+      benchmark::DoNotOptimize(map.Size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDMapInsert(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    for (auto _ : state)
+    {
+      std::map<uint64, uint64> map{};
+      for (uint64 key : keys)
+        map.emplace(key, key);
+      benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void BTreeBulkLoad(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeSortedKeys(state.range(0));
+    for (auto _ : state)
+    {
+      SSTD::BTreeMap<uint64, uint64> map{};
+      map.BulkLoad(keys.Data(), keys.Data(), keys.Size());
+      benchmark::DoNotOptimize(map.Size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //the best std::map can do with sorted input, every insert is hinted at the end
+  static void STDMapSortedInsert(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeSortedKeys(state.range(0));
+    for (auto _ : state)
+    {
+      std::map<uint64, uint64> map{};
+      for (uint64 key : keys)
+        map.emplace_hint(map.end(), key, key);
+      benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void BTreeLookup(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::Vector<uint64> lookups = MakeKeys(state.range(0), 1);
+    SSTD::Sort(lookups.begin(), lookups.end(), [](uint64 a, uint64 b) { return (a ^ 0x5555) < (b ^ 0x5555); });
+
+    SSTD::BTreeMap<uint64, uint64> map{};
+    for (uint64 key : keys)
+      map.Insert(key, key);
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (uint64 key : lookups)
+        sum += *map.Find(key);
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDMapLookup(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::Vector<uint64> lookups = MakeKeys(state.range(0), 1);
+    SSTD::Sort(lookups.begin(), lookups.end(), [](uint64 a, uint64 b) { return (a ^ 0x5555) < (b ^ 0x5555); });
+
+    std::map<uint64, uint64> map{};
+    for (uint64 key : keys)
+      map.emplace(key, key);
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (uint64 key : lookups)
+        sum += map.find(key)->second;
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //a lower bound at a random time followed by a short scan
+  static void BTreeRangeScan(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeSortedKeys(state.range(0));
+    SSTD::Vector<uint64> starts = MakeKeys(1024, 2);
+    SSTD::BTreeMap<uint64, uint64> map{};
+    map.BulkLoad(keys.Data(), keys.Data(), keys.Size());
+
+    uint64 span = static_cast<uint64>(state.range(0)) * 16;
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (uint64 start : starts)
+      {
+        uint32 n = 0;
+        for (auto it = map.LowerBound(start % span); it != map.end() && n < ScanLength; ++it, ++n)
+          sum += it.Value();
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * starts.Size() * ScanLength);
+  }
+
+  static void STDMapRangeScan(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeSortedKeys(state.range(0));
+    SSTD::Vector<uint64> starts = MakeKeys(1024, 2);
+    std::map<uint64, uint64> map{};
+    for (uint64 key : keys)
+      map.emplace_hint(map.end(), key, key);
+
+    uint64 span = static_cast<uint64>(state.range(0)) * 16;
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (uint64 start : starts)
+      {
+        uint32 n = 0;
+        for (auto it = map.lower_bound(start % span); it != map.end() && n < ScanLength; ++it, ++n)
+          sum += it->second;
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * starts.Size() * ScanLength);
+  }
+}
+
+BENCHMARK(BTreeBench::BTreeInsert)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BTreeBench::STDMapInsert)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BTreeBench::BTreeBulkLoad)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BTreeBench::STDMapSortedInsert)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(BTreeBench::BTreeLookup)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BTreeBench::STDMapLookup)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BTreeBench::BTreeRangeScan)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(BTreeBench::STDMapRangeScan)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include "Containers/ConcurrentHashMap.h"
+#include "Containers/HashMap.h"
+#include "Platform/Threading/Mutex.h"
+#include "Platform/Threading/Lock.h"
+
+namespace ConcurrentHashMapBench
+{
+  static constexpr uint32 MaxThreads = 64;
+  static constexpr uint64 KeyCount = 1 << 16;
+
+  //the baseline, one HashMap behind one Mutex
+  struct LockedMap
+  {
+    bool Find(uint64 key, uint64& value)
+    {
+      SSTD::Lock<SSTD::Mutex> lock(m_Mutex);
+      const uint64* found = m_Map.Find(key);
+      if (found)
+        value = *found;
+      return found != nullptr;
+    }
+
+    void Upsert(uint64 key, uint64 value)
+    {
+      SSTD::Lock<SSTD::Mutex> lock(m_Mutex);
+      m_Map.InsertOrAssign(key, value);
+    }
+
+    void Remove(uint64 key)
+    {
+      SSTD::Lock<SSTD::Mutex> lock(m_Mutex);
+      m_Map.Remove(key);
+    }
+
+    SSTD::Mutex m_Mutex;
+    SSTD::HashMap<uint64, uint64> m_Map{};
+  };
+
+  struct ShardedMap
+  {
+    bool Find(uint64 key, uint64& value) { return m_Map.Find(key, value); }
+
+    void Upsert(uint64 key, uint64 value) { m_Map.Upsert(key, value); }
+
+    void Remove(uint64 key) { m_Map.Remove(key); }
+
+    SSTD::ConcurrentHashMap<uint64, uint64> m_Map{};
+  };
+
+  //filled once with every other key, the writes keep it around that size
+  template<typename Map>
+  static Map& GetMap()
+  {
+    static Map* map = []()
+      {
+        Map* m = new Map();
+        for (uint64 key = 0; key < KeyCount; key += 2)
+          m->Upsert(key, key);
+        return m;
+      }();
+    return *map;
+  }
+
+  //ReadPercent of the operations are lookups, the rest are split between upserts and removes
+  template<typename Map, uint64 ReadPercent>
+  static void Mix(benchmark::State& state)
+  {
+    Map& map = GetMap<Map>();
+    uint64 rng = 0x9E3779B97F4A7C15ull * (state.thread_index() + 1);
+    uint64 hits = 0;
+
+    for (auto _ : state)
+    {
+      rng ^= rng << 13;
+      rng ^= rng >> 7;
+      rng ^= rng << 17;
+
+      uint64 key = rng % KeyCount;
+      uint64 op = (rng >> 32) % 100;
+      if (op < ReadPercent)
+      {
+        uint64 value;
+        hits += map.Find(key, value);
+      }
+      else if (op & 1)
+        map.Upsert(key, key);
+      else
+        map.Remove(key);
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations());
+  }
+}
+
+BENCHMARK(ConcurrentHashMapBench::Mix<ConcurrentHashMapBench::ShardedMap, 95>)->ThreadRange(1, ConcurrentHashMapBench::MaxThreads)->UseRealTime();
+BENCHMARK(ConcurrentHashMapBench::Mix<ConcurrentHashMapBench::LockedMap, 95>)->ThreadRange(1, ConcurrentHashMapBench::MaxThreads)->UseRealTime();
+BENCHMARK(ConcurrentHashMapBench::Mix<ConcurrentHashMapBench::ShardedMap, 50>)->ThreadRange(1, ConcurrentHashMapBench::MaxThreads)->UseRealTime();
+BENCHMARK(ConcurrentHashMapBench::Mix<ConcurrentHashMapBench::LockedMap, 50>)->ThreadRange(1, ConcurrentHashMapBench::MaxThreads)->UseRealTime();
@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+
+#include "Containers/FlatMap.h"
+#include "Containers/HashMap.h"
+#include "Containers/Vector.h"
+
+#include <map>
+#include <random>
+
+namespace FlatMapBench
+{
+  static SSTD::Vector<uint64> MakeKeys(int64 count, uint64 seed)
+  {
+    std::mt19937_64 rng(seed);
+    SSTD::Vector<uint64> keys{};
+    for (int64 i = 0; i < count; ++i)
+      keys.PushBack(rng());
+    return keys;
+  }
+
+  //built once from unsorted input
+
+  static void FlatMapBuild(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    for (auto _ : state)
+    {
+      SSTD::FlatMap<uint64, uint64> map{};
+      map.Insert(keys.Data(), keys.Data(), keys.Size());
+      benchmark::DoNotOptimize(map.Size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDMapBuild(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    for (auto _ : state)
+    {
+      std::map<uint64, uint64> map{};
+      for (uint64 key : keys)
+        map.emplace(key, key);
+      benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //read many times, looked up in a different order than inserted
+
+  static void FlatMapLookup(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::Vector<uint64> lookups = MakeKeys(state.range(0), 1);
+    SSTD::Sort(lookups.begin(), lookups.end(), [](uint64 a, uint64 b) { return (a ^ 0x5555) < (b ^ 0x5555); });
+
+    SSTD::FlatMap<uint64, uint64> map{};
+    map.Insert(keys.Data(), keys.Data(), keys.Size());
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (uint64 key : lookups)
+        sum += *map.Find(key);
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDMapLookup(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::Vector<uint64> lookups = MakeKeys(state.range(0), 1);
+    SSTD::Sort(lookups.begin(), lookups.end(), [](uint64 a, uint64 b) { return (a ^ 0x5555) < (b ^ 0x5555); });
+
+    std::map<uint64, uint64> map{};
+    for (uint64 key : keys)
+      map.emplace(key, key);
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (uint64 key : lookups)
+        sum += map.find(key)->second;
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void HashMapLookup(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::Vector<uint64> lookups = MakeKeys(state.range(0), 1);
+    SSTD::Sort(lookups.begin(), lookups.end(), [](uint64 a, uint64 b) { return (a ^ 0x5555) < (b ^ 0x5555); });
+
+    SSTD::HashMap<uint64, uint64> map{};
+    for (uint64 key : keys)
+      map.Insert(key, key);
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (uint64 key : lookups)
+        sum += *map.Find(key);
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //in key order
+
+  static void FlatMapIterate(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::FlatMap<uint64, uint64> map{};
+    map.Insert(keys.Data(), keys.Data(), keys.Size());
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      map.Apply([&sum](const uint64& key, uint64& value) { sum += key ^ value; });
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDMapIterate(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    std::map<uint64, uint64> map{};
+    for (uint64 key : keys)
+      map.emplace(key, key);
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (auto& entry : map)
+        sum += entry.first ^ entry.second;
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+}
+
+BENCHMARK(FlatMapBench::FlatMapBuild)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(FlatMapBench::STDMapBuild)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(FlatMapBench::FlatMapLookup)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(FlatMapBench::STDMapLookup)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(FlatMapBench::HashMapLookup)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(FlatMapBench::FlatMapIterate)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(FlatMapBench::STDMapIterate)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,190 @@
+#include <benchmark/benchmark.h>
+
+#include "Containers/HandleMap.h"
+#include "Containers/HashMap.h"
+#include "Containers/Vector.h"
+
+#include <unordered_map>
+#include <random>
+
+namespace HandleMapBench
+{
+  struct Particle
+  {
+    float x, y, z;
+    float vx, vy, vz;
+  };
+
+  //half of the elements are removed and replaced, so the free list and the dense swap removal are both exercised
+  //the HashMap and the std::unordered_map get the same churn with ids as keys
+  struct Scene
+  {
+    SSTD::HandleMap<Particle> handles{};
+    SSTD::HashMap<uint64, Particle> hashed{};
+    std::unordered_map<uint64, Particle> stdHashed{};
+    SSTD::Vector<uint64> liveHandles{};
+    SSTD::Vector<uint64> liveIds{};
+  };
+
+  static void BuildScene(Scene& scene, int64 count)
+  {
+    std::mt19937_64 rng(1);
+    SSTD::Vector<uint64> handles{};
+    SSTD::Vector<uint64> ids{};
+    uint64 nextId = 0;
+
+    for (int64 i = 0; i < count; ++i)
+    {
+      Particle p{ float(i), 0, 0, 1, 1, 1 };
+      handles.PushBack(scene.handles.Insert(p));
+      scene.hashed.Insert(nextId, p);
+      scene.stdHashed.emplace(nextId, p);
+      ids.PushBack(nextId++);
+    }
+
+    for (int64 i = 0; i < count; ++i)
+    {
+      if (rng() & 1)
+        continue;
+
+      scene.handles.Remove(handles[i]);
+      scene.hashed.Remove(ids[i]);
+      scene.stdHashed.erase(ids[i]);
+
+      Particle p{ float(i), 0, 0, 1, 1, 1 };
+      handles[i] = scene.handles.Insert(p);
+      scene.hashed.Insert(nextId, p);
+      scene.stdHashed.emplace(nextId, p);
+      ids[i] = nextId++;
+    }
+
+    //lookups in random order
+    for (int64 i = count - 1; i > 0; --i)
+    {
+      int64 j = rng() % (i + 1);
+      SSTD::Swap(handles[i], handles[j]);
+      SSTD::Swap(ids[i], ids[j]);
+    }
+    scene.liveHandles = SSTD::Move(handles);
+    scene.liveIds = SSTD::Move(ids);
+  }
+
+  static void Integrate(Particle& p)
+  {
+    p.x += p.vx * 0.016f;
+    p.y += p.vy * 0.016f;
+    p.z += p.vz * 0.016f;
+  }
+
+  //iteration
+
+  static void HandleMapIterate(benchmark::State& state)
+  {
+    Scene scene{};
+    BuildScene(scene, state.range(0));
+    for (auto _ : state)
+    {
+      for (Particle& p : scene.handles)
+        Integrate(p);
+      benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void HashMapIterate(benchmark::State& state)
+  {
+    Scene scene{};
+    BuildScene(scene, state.range(0));
+    for (auto _ : state)
+    {
+      scene.hashed.Apply([](SSTD::Pair<uint64, Particle>& slot) { Integrate(slot.second); });
+      benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDHashMapIterate(benchmark::State& state)
+  {
+    Scene scene{};
+    BuildScene(scene, state.range(0));
+    for (auto _ : state)
+    {
+      for (auto& slot : scene.stdHashed)
+        Integrate(slot.second);
+      benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //lookup
+
+  static void HandleMapLookup(benchmark::State& state)
+  {
+    Scene scene{};
+    BuildScene(scene, state.range(0));
+    for (auto _ : state)
+    {
+      float sum = 0;
+      for (uint64 handle : scene.liveHandles)
+        sum += scene.handles.Get(handle)->x;
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void HashMapLookup(benchmark::State& state)
+  {
+    Scene scene{};
+    BuildScene(scene, state.range(0));
+    for (auto _ : state)
+    {
+      float sum = 0;
+      for (uint64 id : scene.liveIds)
+        sum += scene.hashed.Find(id)->x;
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDHashMapLookup(benchmark::State& state)
+  {
+    Scene scene{};
+    BuildScene(scene, state.range(0));
+    for (auto _ : state)
+    {
+      float sum = 0;
+      for (uint64 id : scene.liveIds)
+        sum += scene.stdHashed.find(id)->second.x;
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //stale handles are rejected without touching the values
+  static void HandleMapStaleLookup(benchmark::State& state)
+  {
+    Scene scene{};
+    BuildScene(scene, state.range(0));
+    SSTD::Vector<uint64> stale{};
+    for (uint64 handle : scene.liveHandles)
+      stale.PushBack(handle + (1ull << 32));
+
+    for (auto _ : state)
+    {
+      int64 found = 0;
+      for (uint64 handle : stale)
+        found += scene.handles.Get(handle) != nullptr;
+      benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+}
+
+BENCHMARK(HandleMapBench::HandleMapIterate)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HandleMapBench::HashMapIterate)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HandleMapBench::STDHashMapIterate)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(HandleMapBench::HandleMapLookup)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HandleMapBench::HashMapLookup)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HandleMapBench::STDHashMapLookup)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HandleMapBench::HandleMapStaleLookup)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
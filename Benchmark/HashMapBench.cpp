@@ -0,0 +1,353 @@
+#include <benchmark/benchmark.h>
+
+#include "Containers/HashMap.h"
+#include "Containers/String.h"
+#include "Containers/Vector.h"
+
+#include <unordered_map>
+#include <string>
+#include <random>
+#include <vector>
+
+namespace HashMapBench
+{
+  //random keys so neither table gets the sequential layout for free, the misses never collide with the hits
+  static SSTD::Vector<uint64> MakeIntKeys(int64 count, uint64 seed)
+  {
+    std::mt19937_64 rng(seed);
+    SSTD::Vector<uint64> keys{};
+    for (int64 i = 0; i < count; ++i)
+      keys.PushBack(rng() | 1);
+    return keys;
+  }
+
+  static SSTD::Vector<uint64> MakeMissKeys(int64 count)
+  {
+    std::mt19937_64 rng(7);
+    SSTD::Vector<uint64> keys{};
+    for (int64 i = 0; i < count; ++i)
+      keys.PushBack(rng() & ~1ull);
+    return keys;
+  }
+
+  static std::string MakeStdString(uint64 key)
+  {
+    return "entity/" + std::to_string(key);
+  }
+
+  static SSTD::String MakeString(uint64 key)
+  {
+    std::string s = MakeStdString(key);
+    return SSTD::String(s.c_str(), s.size());
+  }
+
+  //int keys
+
+  static void IntInsert(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeIntKeys(state.range(0), 1);
+    for (auto _ : state)
+    {
+      SSTD::HashMap<uint64, uint64> map{};
+      for (uint64 key : keys)
+        map.Insert(key, key);
+      benchmark::DoNotOptimize(map.Size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDIntInsert(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeIntKeys(state.range(0), 1);
+    for (auto _ : state)
+    {
+      std::unordered_map<uint64, uint64> map{};
+      for (uint64 key : keys)
+        map.emplace(key, key);
+      benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void IntHit(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeIntKeys(state.range(0), 1);
+    SSTD::HashMap<uint64, uint64> map{};
+    for (uint64 key : keys)
+      map.Insert(key, key);
+
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (uint64 key : keys)
+        sum += *map.Find(key);
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDIntHit(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeIntKeys(state.range(0), 1);
+    std::unordered_map<uint64, uint64> map{};
+    for (uint64 key : keys)
+      map.emplace(key, key);
+
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (uint64 key : keys)
+        sum += map.find(key)->second;
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void IntMiss(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeIntKeys(state.range(0), 1);
+    SSTD::Vector<uint64> misses = MakeMissKeys(state.range(0));
+    SSTD::HashMap<uint64, uint64> map{};
+    for (uint64 key : keys)
+      map.Insert(key, key);
+
+    for (auto _ : state)
+    {
+      uint64 found = 0;
+      for (uint64 key : misses)
+        found += map.Contains(key);
+      benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDIntMiss(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeIntKeys(state.range(0), 1);
+    SSTD::Vector<uint64> misses = MakeMissKeys(state.range(0));
+    std::unordered_map<uint64, uint64> map{};
+    for (uint64 key : keys)
+      map.emplace(key, key);
+
+    for (auto _ : state)
+    {
+      uint64 found = 0;
+      for (uint64 key : misses)
+        found += map.count(key);
+      benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //fill and empty again, the insert is part of the timing for both
+  static void IntErase(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeIntKeys(state.range(0), 1);
+    SSTD::HashMap<uint64, uint64> map{};
+    map.Reserve(keys.Size());
+    for (auto _ : state)
+    {
+      for (uint64 key : keys)
+        map.Insert(key, key);
+      for (uint64 key : keys)
+        map.Remove(key);
+      benchmark::DoNotOptimize(map.Size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDIntErase(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeIntKeys(state.range(0), 1);
+    std::unordered_map<uint64, uint64> map{};
+    map.reserve(keys.Size());
+    for (auto _ : state)
+    {
+      for (uint64 key : keys)
+        map.emplace(key, key);
+      for (uint64 key : keys)
+        map.erase(key);
+      benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //string keys
+
+  static void StringInsert(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> ids = MakeIntKeys(state.range(0), 1);
+    SSTD::Vector<SSTD::String> keys{};
+    for (uint64 id : ids)
+      keys.PushBack(MakeString(id));
+
+    for (auto _ : state)
+    {
+      SSTD::HashMap<SSTD::String, uint64> map{};
+      for (const SSTD::String& key : keys)
+        map.Insert(key, 1);
+      benchmark::DoNotOptimize(map.Size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDStringInsert(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> ids = MakeIntKeys(state.range(0), 1);
+    std::vector<std::string> keys{};
+    for (uint64 id : ids)
+      keys.push_back(MakeStdString(id));
+
+    for (auto _ : state)
+    {
+      std::unordered_map<std::string, uint64> map{};
+      for (const std::string& key : keys)
+        map.emplace(key, 1);
+      benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //looked up with a const char*, no String is built for the lookup
+  static void StringHit(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> ids = MakeIntKeys(state.range(0), 1);
+    std::vector<std::string> lookups{};
+    SSTD::HashMap<SSTD::String, uint64> map{};
+    for (uint64 id : ids)
+    {
+      lookups.push_back(MakeStdString(id));
+      map.Insert(MakeString(id), id);
+    }
+
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (const std::string& key : lookups)
+        sum += *map.Find(key.c_str());
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDStringHit(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> ids = MakeIntKeys(state.range(0), 1);
+    std::vector<std::string> lookups{};
+    std::unordered_map<std::string, uint64> map{};
+    for (uint64 id : ids)
+    {
+      lookups.push_back(MakeStdString(id));
+      map.emplace(MakeStdString(id), id);
+    }
+
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (const std::string& key : lookups)
+        sum += map.find(key)->second;
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void StringMiss(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> ids = MakeIntKeys(state.range(0), 1);
+    SSTD::Vector<uint64> missing = MakeMissKeys(state.range(0));
+    std::vector<std::string> lookups{};
+    SSTD::HashMap<SSTD::String, uint64> map{};
+    for (uint64 id : ids)
+      map.Insert(MakeString(id), id);
+    for (uint64 id : missing)
+      lookups.push_back(MakeStdString(id));
+
+    for (auto _ : state)
+    {
+      uint64 found = 0;
+      for (const std::string& key : lookups)
+        found += map.Contains(key.c_str());
+      benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDStringMiss(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> ids = MakeIntKeys(state.range(0), 1);
+    SSTD::Vector<uint64> missing = MakeMissKeys(state.range(0));
+    std::vector<std::string> lookups{};
+    std::unordered_map<std::string, uint64> map{};
+    for (uint64 id : ids)
+      map.emplace(MakeStdString(id), id);
+    for (uint64 id : missing)
+      lookups.push_back(MakeStdString(id));
+
+    for (auto _ : state)
+    {
+      uint64 found = 0;
+      for (const std::string& key : lookups)
+        found += map.count(key);
+      benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void StringErase(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> ids = MakeIntKeys(state.range(0), 1);
+    SSTD::Vector<SSTD::String> keys{};
+    for (uint64 id : ids)
+      keys.PushBack(MakeString(id));
+
+    SSTD::HashMap<SSTD::String, uint64> map{};
+    map.Reserve(keys.Size());
+    for (auto _ : state)
+    {
+      for (const SSTD::String& key : keys)
+        map.Insert(key, 1);
+      for (const SSTD::String& key : keys)
+        map.Remove(key);
+      benchmark::DoNotOptimize(map.Size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDStringErase(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> ids = MakeIntKeys(state.range(0), 1);
+    std::vector<std::string> keys{};
+    for (uint64 id : ids)
+      keys.push_back(MakeStdString(id));
+
+    std::unordered_map<std::string, uint64> map{};
+    map.reserve(keys.size());
+    for (auto _ : state)
+    {
+      for (const std::string& key : keys)
+        map.emplace(key, 1);
+      for (const std::string& key : keys)
+        map.erase(key);
+      benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+}
+
+BENCHMARK(HashMapBench::IntInsert)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::STDIntInsert)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::IntHit)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::STDIntHit)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::IntMiss)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::STDIntMiss)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::IntErase)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::STDIntErase)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(HashMapBench::StringInsert)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::STDStringInsert)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::StringHit)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::STDStringHit)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::StringMiss)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::STDStringMiss)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::StringErase)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(HashMapBench::STDStringErase)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
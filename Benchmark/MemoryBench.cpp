@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <cstdlib>
+#include "General/Memory.h"
+
+namespace MemoryBench
+{
+  //both buffers are touched once up front, so page faults don't end up in the timing
+  struct Buffers
+  {
+    explicit Buffers(size_t size)
+      : src(static_cast<uint8*>(malloc(size + 64))), dst(static_cast<uint8*>(malloc(size + 64)))
+    {
+      memset(src, 0x5A, size + 64);
+      memset(dst, 0, size + 64);
+    }
+
+    ~Buffers()
+    {
+      free(src);
+      free(dst);
+    }
+
+    uint8* src;
+    uint8* dst;
+  };
+
+  struct SSTDMemory
+  {
+    static void* Copy(void* dst, const void* src, size_t size) { return SSTD::MemCopy(dst, src, size); }
+    static void* Move(void* dst, const void* src, size_t size) { return SSTD::MemMove(dst, src, size); }
+    static void* Set(void* dst, uint8 value, size_t size) { return SSTD::MemSet(dst, value, size); }
+    static int Compare(const void* lhs, const void* rhs, size_t size) { return SSTD::MemCompare(lhs, rhs, size); }
+    static const void* Find(const void* ptr, uint8 value, size_t size) { return SSTD::MemFind(ptr, value, size); }
+  };
+
+  struct STDMemory
+  {
+    static void* Copy(void* dst, const void* src, size_t size) { return memcpy(dst, src, size); }
+    static void* Move(void* dst, const void* src, size_t size) { return memmove(dst, src, size); }
+    static void* Set(void* dst, uint8 value, size_t size) { return memset(dst, value, size); }
+    static int Compare(const void* lhs, const void* rhs, size_t size) { return memcmp(lhs, rhs, size); }
+    static const void* Find(const void* ptr, uint8 value, size_t size) { return memchr(ptr, value, size); }
+  };
+
+  template<typename M>
+  static void Copy(benchmark::State& state)
+  {
+    size_t size = static_cast<size_t>(state.range(0));
+    Buffers buffers(size);
+    for (auto _ : state)
+    {
+      M::Copy(buffers.dst, buffers.src, size);
+      benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+  }
+
+  //overlapping by a few bytes, the usual case for Vector insert/erase
+  template<typename M>
+  static void Move(benchmark::State& state)
+  {
+    size_t size = static_cast<size_t>(state.range(0));
+    Buffers buffers(size);
+    for (auto _ : state)
+    {
+      M::Move(buffers.src + 7, buffers.src, size);
+      benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+  }
+
+  template<typename M>
+  static void Set(benchmark::State& state)
+  {
+    size_t size = static_cast<size_t>(state.range(0));
+    Buffers buffers(size);
+    for (auto _ : state)
+    {
+      M::Set(buffers.dst, 0xCD, size);
+      benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+  }
+
+  //equal buffers, so the whole range has to be compared
+  template<typename M>
+  static void Compare(benchmark::State& state)
+  {
+    size_t size = static_cast<size_t>(state.range(0));
+    Buffers buffers(size);
+    memset(buffers.dst, 0x5A, size + 64);
+    for (auto _ : state)
+      benchmark::DoNotOptimize(M::Compare(buffers.dst, buffers.src, size));
+    state.SetBytesProcessed(state.iterations() * size);
+  }
+
+  //the byte is at the very end
+  template<typename M>
+  static void Find(benchmark::State& state)
+  {
+    size_t size = static_cast<size_t>(state.range(0));
+    Buffers buffers(size);
+    buffers.src[size - 1] = 0x11;
+    for (auto _ : state)
+      benchmark::DoNotOptimize(M::Find(buffers.src, 0x11, size));
+    state.SetBytesProcessed(state.iterations() * size);
+  }
+}
+
+#define MEMORY_BENCHMARK(Name) \
+  BENCHMARK(MemoryBench::Name<MemoryBench::SSTDMemory>)->RangeMultiplier(8)->Range(1, 1 << 30); \
+  BENCHMARK(MemoryBench::Name<MemoryBench::STDMemory>)->RangeMultiplier(8)->Range(1, 1 << 30)
+
+MEMORY_BENCHMARK(Copy);
+MEMORY_BENCHMARK(Move);
+MEMORY_BENCHMARK(Set);
+MEMORY_BENCHMARK(Compare);
+MEMORY_BENCHMARK(Find);
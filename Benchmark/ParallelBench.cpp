@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include "General/ParallelAlgorithm.h"
+#include "Containers/Vector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace ParallelBench
+{
+  //range(0) is the size, range(1) the threads including the calling one, 1 runs everything inline
+
+  static SSTD::Vector<uint64> MakeInput(int64 count)
+  {
+    std::mt19937_64 rng(1);
+    SSTD::Vector<uint64> values{};
+    values.Reserve(count);
+    for (int64 i = 0; i < count; ++i)
+      values.PushBack(rng());
+    return values;
+  }
+
+  static void ParallelSort(benchmark::State& state)
+  {
+    SSTD::ThreadPool pool(static_cast<uint32>(state.range(1) - 1));
+    SSTD::Vector<uint64> input = MakeInput(state.range(0));
+    for (auto _ : state)
+    {
+      state.PauseTiming();
+      SSTD::Vector<uint64> values = input;
+      state.ResumeTiming();
+      SSTD::Sort(pool, values.begin(), values.end());
+      benchmark::DoNotOptimize(values.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDSort(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> input = MakeInput(state.range(0));
+    for (auto _ : state)
+    {
+      state.PauseTiming();
+      SSTD::Vector<uint64> values = input;
+      state.ResumeTiming();
+      std::sort(values.Data(), values.Data() + values.Size());
+      benchmark::DoNotOptimize(values.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //memory bound, more threads only help as long as the bandwidth lasts
+  static void ParallelReduce(benchmark::State& state)
+  {
+    SSTD::ThreadPool pool(static_cast<uint32>(state.range(1) - 1));
+    SSTD::Vector<uint64> input = MakeInput(state.range(0));
+    for (auto _ : state)
+    {
+      uint64 sum = SSTD::ParallelReduce(pool, input.begin(), input.end(), 0ull, [](uint64 a, uint64 b) { return a + b; });
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(uint64));
+  }
+
+  static void ParallelScan(benchmark::State& state)
+  {
+    SSTD::ThreadPool pool(static_cast<uint32>(state.range(1) - 1));
+    SSTD::Vector<uint64> input = MakeInput(state.range(0));
+    SSTD::Vector<uint64> output = input;
+    for (auto _ : state)
+    {
+      SSTD::ParallelScan(pool, input.begin(), input.end(), output.begin(), [](uint64 a, uint64 b) { return a + b; });
+      benchmark::DoNotOptimize(output.Data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(uint64));
+  }
+
+  //compute bound, should scale with the cores
+  static void ParallelTransform(benchmark::State& state)
+  {
+    SSTD::ThreadPool pool(static_cast<uint32>(state.range(1) - 1));
+    SSTD::Vector<uint64> input = MakeInput(state.range(0));
+    SSTD::Vector<double> output(state.range(0));
+    for (auto _ : state)
+    {
+      SSTD::ParallelTransform(pool, input.begin(), input.end(), output.begin(), [](uint64 x)
+        {
+          double value = static_cast<double>(x >> 11);
+          return std::sqrt(value) * std::log(value + 1.0);
+        });
+      benchmark::DoNotOptimize(output.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //what one fork-join costs, every thread gets a task that does nothing
+  static void ParallelForOverhead(benchmark::State& state)
+  {
+    SSTD::ThreadPool pool(static_cast<uint32>(state.range(1) - 1));
+    uint32 tasks = pool.GetConcurrency();
+    for (auto _ : state)
+    {
+      SSTD::ParallelFor(pool, 0u, tasks, [](uint32 i) { benchmark::DoNotOptimize(i); }, 1);
+    }
+  }
+}
+
+BENCHMARK(ParallelBench::ParallelSort)->ArgsProduct({ { 1 << 20, 1 << 24 }, { 1, 2, 4, 8, 16 } })->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(ParallelBench::STDSort)->Args({ 1 << 20, 1 })->Args({ 1 << 24, 1 })->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK(ParallelBench::ParallelReduce)->ArgsProduct({ { 1 << 24 }, { 1, 2, 4, 8, 16 } })->UseRealTime();
+BENCHMARK(ParallelBench::ParallelScan)->ArgsProduct({ { 1 << 24 }, { 1, 2, 4, 8, 16 } })->UseRealTime();
+BENCHMARK(ParallelBench::ParallelTransform)->ArgsProduct({ { 1 << 22 }, { 1, 2, 4, 8, 16 } })->UseRealTime();
+BENCHMARK(ParallelBench::ParallelForOverhead)->ArgsProduct({ { 0 }, { 2, 4, 8, 16 } })->UseRealTime();
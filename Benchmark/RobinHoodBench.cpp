@@ -0,0 +1,301 @@
+#include <benchmark/benchmark.h>
+
+#include "Containers/RobinHoodMap.h"
+#include "Containers/HashMap.h"
+#include "Containers/Vector.h"
+
+#include <unordered_map>
+#include <random>
+
+namespace RobinHoodBench
+{
+  //counts what std::unordered_map allocates, its nodes and bucket array are otherwise invisible
+  static size_t s_STDBytes = 0;
+
+  template<typename T>
+  struct CountingAllocator
+  {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(size_t n)
+    {
+      s_STDBytes += n * sizeof(T);
+      return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+      s_STDBytes -= n * sizeof(T);
+      std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U>
+    bool operator==(const CountingAllocator<U>&) const { return true; }
+  };
+
+  using STDMap = std::unordered_map<uint64, uint64, std::hash<uint64>, std::equal_to<uint64>, CountingAllocator<std::pair<const uint64, uint64>>>;
+
+  //random keys, the misses never collide with the hits
+  static SSTD::Vector<uint64> MakeKeys(int64 count, uint64 seed)
+  {
+    std::mt19937_64 rng(seed);
+    SSTD::Vector<uint64> keys{};
+    for (int64 i = 0; i < count; ++i)
+      keys.PushBack(rng() | 1);
+    return keys;
+  }
+
+  //the same keys in another order, std::unordered_map allocates its nodes in insertion order and looking them up in
+  //that order would walk its memory front to back
+  static SSTD::Vector<uint64> MakeLookups(const SSTD::Vector<uint64>& keys)
+  {
+    SSTD::Vector<uint64> lookups = keys;
+    std::mt19937_64 rng(3);
+    for (size_t i = lookups.Size(); i > 1; --i)
+      SSTD::Swap(lookups[i - 1], lookups[rng() % i]);
+    return lookups;
+  }
+
+  static SSTD::Vector<uint64> MakeMissKeys(int64 count)
+  {
+    std::mt19937_64 rng(7);
+    SSTD::Vector<uint64> keys{};
+    for (int64 i = 0; i < count; ++i)
+      keys.PushBack(rng() & ~1ull);
+    return keys;
+  }
+
+  //a lookup table that is built once with its final size known up front
+  static SSTD::RobinHoodMap<uint64, uint64> MakeRobinHood(const SSTD::Vector<uint64>& keys)
+  {
+    SSTD::RobinHoodMap<uint64, uint64> map{};
+    map.Reserve(keys.Size());
+    for (uint64 key : keys)
+      map.Insert(key, key);
+    return map;
+  }
+
+  static SSTD::HashMap<uint64, uint64> MakeHashMap(const SSTD::Vector<uint64>& keys)
+  {
+    SSTD::HashMap<uint64, uint64> map{};
+    map.Reserve(keys.Size());
+    for (uint64 key : keys)
+      map.Insert(key, key);
+    return map;
+  }
+
+  static STDMap MakeSTD(const SSTD::Vector<uint64>& keys)
+  {
+    STDMap map{};
+    map.reserve(keys.Size());
+    for (uint64 key : keys)
+      map.emplace(key, key);
+    return map;
+  }
+
+  //memory per entry, once reserved up front and once grown one insert at a time
+
+  static void RobinHoodMemory(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    size_t reserved = 0;
+    size_t grown = 0;
+    for (auto _ : state)
+    {
+      SSTD::RobinHoodMap<uint64, uint64> map = MakeRobinHood(keys);
+      reserved = map.MemoryUsage();
+
+      SSTD::RobinHoodMap<uint64, uint64> growing{};
+      for (uint64 key : keys)
+        growing.Insert(key, key);
+      grown = growing.MemoryUsage();
+    }
+    state.counters["reserved_bytes_per_entry"] = static_cast<double>(reserved) / state.range(0);
+    state.counters["grown_bytes_per_entry"] = static_cast<double>(grown) / state.range(0);
+  }
+
+  static void HashMapMemory(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    size_t reserved = 0;
+    size_t grown = 0;
+    for (auto _ : state)
+    {
+      SSTD::HashMap<uint64, uint64> map = MakeHashMap(keys);
+      reserved = map.Capacity() * (sizeof(SSTD::Pair<uint64, uint64>) + 1);
+
+      SSTD::HashMap<uint64, uint64> growing{};
+      for (uint64 key : keys)
+        growing.Insert(key, key);
+      grown = growing.Capacity() * (sizeof(SSTD::Pair<uint64, uint64>) + 1);
+    }
+    state.counters["reserved_bytes_per_entry"] = static_cast<double>(reserved) / state.range(0);
+    state.counters["grown_bytes_per_entry"] = static_cast<double>(grown) / state.range(0);
+  }
+
+  //without the malloc header of every node, so the real footprint is higher still
+  static void STDMemory(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    size_t reserved = 0;
+    size_t grown = 0;
+    for (auto _ : state)
+    {
+      size_t before = s_STDBytes;
+      {
+        STDMap map = MakeSTD(keys);
+        reserved = s_STDBytes - before;
+      }
+      {
+        STDMap growing{};
+        for (uint64 key : keys)
+          growing.emplace(key, key);
+        grown = s_STDBytes - before;
+      }
+    }
+    state.counters["reserved_bytes_per_entry"] = static_cast<double>(reserved) / state.range(0);
+    state.counters["grown_bytes_per_entry"] = static_cast<double>(grown) / state.range(0);
+  }
+
+  //lookups on a reserved table, the robin hood one sits at 9/10 load
+
+  static void RobinHoodHit(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::Vector<uint64> lookups = MakeLookups(keys);
+    SSTD::RobinHoodMap<uint64, uint64> map = MakeRobinHood(keys);
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (uint64 key : lookups)
+        sum += *map.Find(key);
+      benchmark::DoNotOptimize(sum);
+    }
+    state.counters["load"] = map.LoadFactor();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void RobinHoodMiss(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::Vector<uint64> misses = MakeMissKeys(state.range(0));
+    SSTD::RobinHoodMap<uint64, uint64> map = MakeRobinHood(keys);
+    for (auto _ : state)
+    {
+      uint64 found = 0;
+      for (uint64 key : misses)
+        found += map.Contains(key);
+      benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void HashMapHit(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::Vector<uint64> lookups = MakeLookups(keys);
+    SSTD::HashMap<uint64, uint64> map = MakeHashMap(keys);
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (uint64 key : lookups)
+        sum += *map.Find(key);
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void HashMapMiss(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::Vector<uint64> misses = MakeMissKeys(state.range(0));
+    SSTD::HashMap<uint64, uint64> map = MakeHashMap(keys);
+    for (auto _ : state)
+    {
+      uint64 found = 0;
+      for (uint64 key : misses)
+        found += map.Contains(key);
+      benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDHit(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::Vector<uint64> lookups = MakeLookups(keys);
+    STDMap map = MakeSTD(keys);
+    for (auto _ : state)
+    {
+      uint64 sum = 0;
+      for (uint64 key : lookups)
+        sum += map.find(key)->second;
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDMiss(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::Vector<uint64> misses = MakeMissKeys(state.range(0));
+    STDMap map = MakeSTD(keys);
+    for (auto _ : state)
+    {
+      uint64 found = 0;
+      for (uint64 key : misses)
+        found += map.count(key);
+      benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //remove and reinsert at full load, the table never fills up with tombstones
+  static void RobinHoodChurn(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    SSTD::RobinHoodMap<uint64, uint64> map = MakeRobinHood(keys);
+    for (auto _ : state)
+    {
+      for (uint64 key : keys)
+      {
+        map.Remove(key);
+        map.Insert(key, key);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDChurn(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> keys = MakeKeys(state.range(0), 1);
+    STDMap map = MakeSTD(keys);
+    for (auto _ : state)
+    {
+      for (uint64 key : keys)
+      {
+        map.erase(key);
+        map.emplace(key, key);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+}
+
+BENCHMARK(RobinHoodBench::RobinHoodMemory)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(RobinHoodBench::HashMapMemory)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(RobinHoodBench::STDMemory)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(RobinHoodBench::RobinHoodHit)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(RobinHoodBench::HashMapHit)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(RobinHoodBench::STDHit)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(RobinHoodBench::RobinHoodMiss)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(RobinHoodBench::HashMapMiss)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(RobinHoodBench::STDMiss)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(RobinHoodBench::RobinHoodChurn)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(RobinHoodBench::STDChurn)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
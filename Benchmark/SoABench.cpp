@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include "Containers/Vector.h"
+#include "Containers/SoAVector.h"
+#include "Containers/Color.h"
+#include "Math/Vec.h"
+
+namespace SoABench
+{
+  using Vec3f = SSTD::Vec3<float>;
+
+  struct Particle
+  {
+    Vec3f position;
+    Vec3f velocity;
+    SSTD::Color color;
+    uint32 id;
+  };
+
+  static constexpr float DeltaTime = 1.0f / 60.0f;
+
+  //position += velocity * dt, the kernel never looks at color or id
+  static void UpdateAoS(benchmark::State& state)
+  {
+    SSTD::Vector<Particle> particles{};
+    for (int64 i = 0; i < state.range(0); ++i)
+      particles.PushBack(Particle{ Vec3f(0.0f, 0.0f, 0.0f), Vec3f(1.0f, 2.0f, 3.0f), SSTD::Color(), static_cast<uint32>(i) });
+
+    for (auto _ : state)
+    {
+      for (Particle& p : particles)
+        p.position += p.velocity * DeltaTime;
+      benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(Particle));
+  }
+
+  static void UpdateSoA(benchmark::State& state)
+  {
+    SSTD::SoAVector<Vec3f, Vec3f, SSTD::Color, uint32> particles{};
+    for (int64 i = 0; i < state.range(0); ++i)
+      particles.EmplaceBack(Vec3f(0.0f, 0.0f, 0.0f), Vec3f(1.0f, 2.0f, 3.0f), SSTD::Color(), static_cast<uint32>(i));
+
+    for (auto _ : state)
+    {
+      particles.ApplyColumns<0, 1>([](Vec3f* position, const Vec3f* velocity, size_t size)
+        {
+          for (size_t i = 0; i < size; ++i)
+            position[i] += Vec3f(velocity[i]) * DeltaTime;
+        });
+      benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(Vec3f) * 2);
+  }
+
+  //one float column per component, the loop is plain streams the compiler vectorizes
+  static void UpdateSoAComponents(benchmark::State& state)
+  {
+    SSTD::SoAVector<float, float, float, float, float, float, SSTD::Color, uint32> particles{};
+    for (int64 i = 0; i < state.range(0); ++i)
+      particles.EmplaceBack(0.0f, 0.0f, 0.0f, 1.0f, 2.0f, 3.0f, SSTD::Color(), static_cast<uint32>(i));
+
+    for (auto _ : state)
+    {
+      particles.ApplyColumns<0, 1, 2, 3, 4, 5>([](float* x, float* y, float* z, const float* vx, const float* vy, const float* vz, size_t size)
+        {
+          for (size_t i = 0; i < size; ++i)
+          {
+            x[i] += vx[i] * DeltaTime;
+            y[i] += vy[i] * DeltaTime;
+            z[i] += vz[i] * DeltaTime;
+          }
+        });
+      benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(float) * 6);
+  }
+}
+
+BENCHMARK(SoABench::UpdateAoS)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(SoABench::UpdateSoA)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(SoABench::UpdateSoAComponents)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
@@ -0,0 +1,322 @@
+#include <benchmark/benchmark.h>
+
+#include "General/Algorithm.h"
+#include "Containers/String.h"
+#include "Containers/Vector.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+namespace SortBench
+{
+  enum class Input
+  {
+    Random,
+    Sorted,
+    Reversed,
+    FewUnique,
+  };
+
+  static SSTD::Vector<uint64> MakeInput(Input input, int64 count)
+  {
+    std::mt19937_64 rng(1);
+    SSTD::Vector<uint64> values{};
+    for (int64 i = 0; i < count; ++i)
+    {
+      switch (input)
+      {
+      case Input::Random: values.PushBack(rng()); break;
+      case Input::Sorted: values.PushBack(static_cast<uint64>(i)); break;
+      case Input::Reversed: values.PushBack(static_cast<uint64>(count - i)); break;
+      case Input::FewUnique: values.PushBack(rng() % 16); break;
+      }
+    }
+    return values;
+  }
+
+  //every iteration sorts a fresh copy, the copy is part of the time for all of them
+
+  template<class SortType, Input I>
+  static void SSTDSort(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> input = MakeInput(I, state.range(0));
+    for (auto _ : state)
+    {
+      SSTD::Vector<uint64> values = input;
+      SSTD::Sort<SortType>(values.begin(), values.end(), [](uint64 a, uint64 b) { return a < b; });
+      benchmark::DoNotOptimize(values.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  template<Input I>
+  static void STDSort(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> input = MakeInput(I, state.range(0));
+    for (auto _ : state)
+    {
+      SSTD::Vector<uint64> values = input;
+      std::sort(values.Data(), values.Data() + values.Size());
+      benchmark::DoNotOptimize(values.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  template<Input I>
+  static void STDStableSort(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> input = MakeInput(I, state.range(0));
+    for (auto _ : state)
+    {
+      SSTD::Vector<uint64> values = input;
+      std::stable_sort(values.Data(), values.Data() + values.Size());
+      benchmark::DoNotOptimize(values.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  template<Input I>
+  static void SSTDRadixSort(benchmark::State& state)
+  {
+    SSTD::Vector<uint64> input = MakeInput(I, state.range(0));
+    for (auto _ : state)
+    {
+      SSTD::Vector<uint64> values = input;
+      SSTD::Sort<SSTD::SortTypeRadix>(values.begin(), values.end());
+      benchmark::DoNotOptimize(values.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //32 bit ids, floats and records sorted by a 64 bit timestamp, radix against the comparison sorts
+
+  enum class Key
+  {
+    Id,
+    Float,
+    Record,
+  };
+
+  struct Record
+  {
+    uint64 timestamp;
+    uint32 id;
+    uint32 flags;
+  };
+
+  template<Key K>
+  static auto MakeKeys(int64 count)
+  {
+    std::mt19937_64 rng(1);
+    if constexpr (K == Key::Id)
+    {
+      SSTD::Vector<uint32> values{};
+      for (int64 i = 0; i < count; ++i)
+        values.PushBack(static_cast<uint32>(rng()));
+      return values;
+    }
+    else if constexpr (K == Key::Float)
+    {
+      std::normal_distribution<float> distribution(0.0f, 1000.0f);
+      SSTD::Vector<float> values{};
+      for (int64 i = 0; i < count; ++i)
+        values.PushBack(distribution(rng));
+      return values;
+    }
+    else
+    {
+      //timestamps of the last day in nanoseconds
+      uint64 now = 1700000000ull * 1000000000ull;
+      SSTD::Vector<Record> values{};
+      for (int64 i = 0; i < count; ++i)
+        values.PushBack(Record{ now - rng() % (86400ull * 1000000000ull), static_cast<uint32>(i), 0 });
+      return values;
+    }
+  }
+
+  template<class SortType, Key K>
+  static void SortKeys(benchmark::State& state)
+  {
+    auto input = MakeKeys<K>(state.range(0));
+    for (auto _ : state)
+    {
+      auto values = input;
+      if constexpr (K != Key::Record)
+        SSTD::Sort<SortType>(values.begin(), values.end());
+      else if constexpr (SSTD::IsSame<SortType, SSTD::SortTypeRadix>::valid)
+        SSTD::Sort<SortType>(values.begin(), values.end(), [](const Record& r) { return r.timestamp; });
+      else
+        SSTD::Sort<SortType>(values.begin(), values.end(), [](const Record& a, const Record& b) { return a.timestamp < b.timestamp; });
+      benchmark::DoNotOptimize(values.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  template<Key K>
+  static void STDSortKeys(benchmark::State& state)
+  {
+    auto input = MakeKeys<K>(state.range(0));
+    for (auto _ : state)
+    {
+      auto values = input;
+      if constexpr (K != Key::Record)
+        std::sort(values.Data(), values.Data() + values.Size());
+      else
+        std::sort(values.Data(), values.Data() + values.Size(), [](const Record& a, const Record& b) { return a.timestamp < b.timestamp; });
+      benchmark::DoNotOptimize(values.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //an event stream that is kept sorted by time, every tick appends a batch that arrived slightly out of order and
+  //re-sorts everything, the ties keep their arrival order only with a stable sort
+  struct Event
+  {
+    uint64 timestamp;
+    uint64 id;
+  };
+
+  static constexpr int64 EventsPerTick = 1024;
+
+  static SSTD::Vector<Event> MakeEvents(int64 count)
+  {
+    std::mt19937_64 rng(1);
+    SSTD::Vector<Event> events{};
+    for (int64 i = 0; i < count; ++i)
+      events.PushBack(Event{ static_cast<uint64>(i) * 4, static_cast<uint64>(i) });
+    return events;
+  }
+
+  static void AppendTick(SSTD::Vector<Event>& events, std::mt19937_64& rng)
+  {
+    uint64 now = events[events.Size() - 1].timestamp;
+    for (int64 i = 0; i < EventsPerTick; ++i)
+      events[events.Size() - EventsPerTick + i] = Event{ now - rng() % 256 + static_cast<uint64>(i) * 4, rng() };
+  }
+
+  static bool EventLess(const Event& a, const Event& b) { return a.timestamp < b.timestamp; }
+
+  template<class SortType>
+  static void SortEvents(benchmark::State& state)
+  {
+    SSTD::Vector<Event> input = MakeEvents(state.range(0));
+    std::mt19937_64 rng(2);
+    SortType sorter{};
+    for (auto _ : state)
+    {
+      state.PauseTiming();
+      SSTD::Vector<Event> events = input;
+      AppendTick(events, rng);
+      state.ResumeTiming();
+      sorter.Sort(events.begin(), events.end(), EventLess);
+      benchmark::DoNotOptimize(events.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDStableSortEvents(benchmark::State& state)
+  {
+    SSTD::Vector<Event> input = MakeEvents(state.range(0));
+    std::mt19937_64 rng(2);
+    for (auto _ : state)
+    {
+      state.PauseTiming();
+      SSTD::Vector<Event> events = input;
+      AppendTick(events, rng);
+      state.ResumeTiming();
+      std::stable_sort(events.Data(), events.Data() + events.Size(), EventLess);
+      benchmark::DoNotOptimize(events.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //expensive to compare and to move, sorted with the branchy partition
+
+  static SSTD::Vector<SSTD::String> MakeStrings(int64 count)
+  {
+    std::mt19937_64 rng(1);
+    SSTD::Vector<SSTD::String> values{};
+    for (int64 i = 0; i < count; ++i)
+    {
+      std::string s = "entity/" + std::to_string(rng() % 100000);
+      values.PushBack(SSTD::String(s.c_str(), s.size()));
+    }
+    return values;
+  }
+
+  template<class SortType>
+  static void SSTDSortStrings(benchmark::State& state)
+  {
+    SSTD::Vector<SSTD::String> input = MakeStrings(state.range(0));
+    for (auto _ : state)
+    {
+      SSTD::Vector<SSTD::String> values = input;
+      SSTD::Sort<SortType>(values.begin(), values.end(), [](const SSTD::String& a, const SSTD::String& b) { return a < b; });
+      benchmark::DoNotOptimize(values.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDSortStrings(benchmark::State& state)
+  {
+    SSTD::Vector<SSTD::String> input = MakeStrings(state.range(0));
+    for (auto _ : state)
+    {
+      SSTD::Vector<SSTD::String> values = input;
+      std::sort(values.Data(), values.Data() + values.Size(), [](const SSTD::String& a, const SSTD::String& b) { return a < b; });
+      benchmark::DoNotOptimize(values.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+}
+
+using SortBench::Input;
+using SortBench::Key;
+
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypePDQ, Input::Random>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypeMerge, Input::Random>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypeHeap, Input::Random>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypeInsertion, Input::Random>)->Arg(1 << 10);
+BENCHMARK(SortBench::SSTDRadixSort<Input::Random>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::STDSort<Input::Random>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::STDStableSort<Input::Random>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypePDQ, Input::Sorted>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypeMerge, Input::Sorted>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypeHeap, Input::Sorted>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDRadixSort<Input::Sorted>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::STDSort<Input::Sorted>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::STDStableSort<Input::Sorted>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypePDQ, Input::Reversed>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypeMerge, Input::Reversed>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypeHeap, Input::Reversed>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::STDSort<Input::Reversed>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::STDStableSort<Input::Reversed>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypePDQ, Input::FewUnique>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypeMerge, Input::FewUnique>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDSort<SSTD::SortTypeHeap, Input::FewUnique>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDRadixSort<Input::FewUnique>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::STDSort<Input::FewUnique>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::STDStableSort<Input::FewUnique>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(SortBench::SortKeys<SSTD::SortTypeRadix, Key::Id>)->RangeMultiplier(32)->Range(1 << 10, 1 << 25);
+BENCHMARK(SortBench::SortKeys<SSTD::SortTypePDQ, Key::Id>)->RangeMultiplier(32)->Range(1 << 10, 1 << 25);
+BENCHMARK(SortBench::STDSortKeys<Key::Id>)->RangeMultiplier(32)->Range(1 << 10, 1 << 25);
+BENCHMARK(SortBench::SortKeys<SSTD::SortTypeRadix, Key::Float>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SortKeys<SSTD::SortTypePDQ, Key::Float>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::STDSortKeys<Key::Float>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SortKeys<SSTD::SortTypeRadix, Key::Record>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SortKeys<SSTD::SortTypePDQ, Key::Record>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::STDSortKeys<Key::Record>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(SortBench::SortEvents<SSTD::SortTypeMerge>)->RangeMultiplier(32)->Range(1 << 15, 1 << 20);
+BENCHMARK(SortBench::SortEvents<SSTD::SortTypePDQ>)->RangeMultiplier(32)->Range(1 << 15, 1 << 20);
+BENCHMARK(SortBench::STDStableSortEvents)->RangeMultiplier(32)->Range(1 << 15, 1 << 20);
+
+BENCHMARK(SortBench::SSTDSortStrings<SSTD::SortTypePDQ>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDSortStrings<SSTD::SortTypeMerge>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::SSTDSortStrings<SSTD::SortTypeHeap>)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(SortBench::STDSortStrings)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
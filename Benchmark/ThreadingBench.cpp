@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include "Platform/Threading/Thread.h"
+#include "Platform/Threading/Mutex.h"
+#include "Platform/Threading/Lock.h"
+#include "Platform/Threading/ConditionVariable.h"
+
+namespace ThreadingBench
+{
+  static SSTD::Mutex s_Mutex;
+  static std::mutex s_STDMutex;
+  static uint64 s_Counter = 0;
+
+  static void MutexUncontended(benchmark::State& state)
+  {
+    SSTD::Mutex mutex;
+    for (auto _ : state)
+    {
+      mutex.Lock();
+      benchmark::ClobberMemory();
+      mutex.Unlock();
+    }
+  }
+
+  static void STDMutexUncontended(benchmark::State& state)
+  {
+    std::mutex mutex;
+    for (auto _ : state)
+    {
+      mutex.lock();
+      benchmark::ClobberMemory();
+      mutex.unlock();
+    }
+  }
+
+  static void MutexContention(benchmark::State& state)
+  {
+    for (auto _ : state)
+    {
+      SSTD::Lock<SSTD::Mutex> lock(s_Mutex);
+      benchmark::DoNotOptimize(++s_Counter);
+    }
+  }
+
+  static void STDMutexContention(benchmark::State& state)
+  {
+    for (auto _ : state)
+    {
+      std::lock_guard<std::mutex> lock(s_STDMutex);
+      benchmark::DoNotOptimize(++s_Counter);
+    }
+  }
+
+  //one round trip = main thread pings, worker pongs
+  static void ConditionVariablePingPong(benchmark::State& state)
+  {
+    SSTD::Mutex mutex;
+    SSTD::ConditionVariable cv;
+    bool ping = false;
+    bool done = false;
+
+    SSTD::Thread worker(SSTD::Function<void()>::Create([&]()
+      {
+        SSTD::Lock<SSTD::Mutex> lock(mutex);
+        while (true)
+        {
+          cv.WaitFor(lock, [&]() { return ping || done; });
+          if (done)
+            break;
+          ping = false;
+          cv.NotifyAll();
+        }
+      }), true);
+
+    for (auto _ : state)
+    {
+      SSTD::Lock<SSTD::Mutex> lock(mutex);
+      ping = true;
+      cv.NotifyAll();
+      cv.WaitFor(lock, [&]() { return !ping; });
+    }
+
+    {
+      SSTD::Lock<SSTD::Mutex> lock(mutex);
+      done = true;
+      cv.NotifyAll();
+    }
+    worker.Join();
+  }
+
+  static void STDConditionVariablePingPong(benchmark::State& state)
+  {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool ping = false;
+    bool done = false;
+
+    std::thread worker([&]()
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+          cv.wait(lock, [&]() { return ping || done; });
+          if (done)
+            break;
+          ping = false;
+          cv.notify_all();
+        }
+      });
+
+    for (auto _ : state)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      ping = true;
+      cv.notify_all();
+      cv.wait(lock, [&]() { return !ping; });
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      done = true;
+      cv.notify_all();
+    }
+    worker.join();
+  }
+}
+
+BENCHMARK(ThreadingBench::MutexUncontended);
+BENCHMARK(ThreadingBench::STDMutexUncontended);
+
+BENCHMARK(ThreadingBench::MutexContention)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(ThreadingBench::STDMutexContention)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK(ThreadingBench::ConditionVariablePingPong)->UseRealTime();
+BENCHMARK(ThreadingBench::STDConditionVariablePingPong)->UseRealTime();
@@ -1,7 +1,14 @@
 #include <benchmark/benchmark.h>
 
 #include <vector>
+#include <string>
+#include <memory>
 #include "Containers/Vector.h"
+#include "Containers/SmallVector.h"
+#include "Containers/StaticVector.h"
+#include "Containers/SegmentedVector.h"
+#include "Containers/String.h"
+#include "Containers/Pointer.h"
 
 namespace VectorBench
 {
@@ -61,6 +68,159 @@ namespace VectorBench
       benchmark::DoNotOptimize(v);
     }
   }
+
+  static const char LongText[] = "a string that is too long for the small string buffer";
+
+  //every Reserve moves all elements into a new buffer, that is what growth costs
+  static void GrowStrings(benchmark::State& state)
+  {
+    SSTD::Vector<SSTD::String> v{};
+    for (int64 i = 0; i < state.range(0); ++i)
+      v.EmplaceBack(LongText);
+
+    for (auto _ : state)
+    {
+      v.Reserve(v.Capacity() + 1);
+      benchmark::DoNotOptimize(v.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDGrowStrings(benchmark::State& state)
+  {
+    std::vector<std::string> v{};
+    for (int64 i = 0; i < state.range(0); ++i)
+      v.emplace_back(LongText);
+
+    for (auto _ : state)
+    {
+      v.reserve(v.capacity() + 1);
+      benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void GrowSharedPointers(benchmark::State& state)
+  {
+    SSTD::Vector<SSTD::SharedPointer<int>> v{};
+    for (int64 i = 0; i < state.range(0); ++i)
+      v.EmplaceBack(new int(static_cast<int>(i)));
+
+    for (auto _ : state)
+    {
+      v.Reserve(v.Capacity() + 1);
+      benchmark::DoNotOptimize(v.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void STDGrowSharedPointers(benchmark::State& state)
+  {
+    std::vector<std::shared_ptr<int>> v{};
+    for (int64 i = 0; i < state.range(0); ++i)
+      v.emplace_back(new int(static_cast<int>(i)));
+
+    for (auto _ : state)
+    {
+      v.reserve(v.capacity() + 1);
+      benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  //short lived list that usually holds a handful of items
+  static void TemporaryList(benchmark::State& state)
+  {
+    for (auto _ : state)
+    {
+      SSTD::Vector<int> v{};
+      for (int64 i = 0; i < state.range(0); ++i)
+        v.PushBack(static_cast<int>(i));
+      benchmark::DoNotOptimize(v.Data());
+    }
+  }
+
+  static void SmallTemporaryList(benchmark::State& state)
+  {
+    for (auto _ : state)
+    {
+      SSTD::SmallVector<int, 8> v{};
+      for (int64 i = 0; i < state.range(0); ++i)
+        v.PushBack(static_cast<int>(i));
+      benchmark::DoNotOptimize(v.Data());
+    }
+  }
+
+  //fill a per frame buffer and hand out a copy, like Window::BeginEvents does
+  static void FrameBuffer(benchmark::State& state)
+  {
+    SSTD::Vector<int64> events{};
+    for (auto _ : state)
+    {
+      events.Erase();
+      for (int64 i = 0; i < state.range(0); ++i)
+        events.PushBack(i);
+      SSTD::Vector<int64> copy{ events };
+      benchmark::DoNotOptimize(copy.Data());
+    }
+  }
+
+  static void StaticFrameBuffer(benchmark::State& state)
+  {
+    SSTD::StaticVector<int64, 256> events{};
+    for (auto _ : state)
+    {
+      events.Erase();
+      for (int64 i = 0; i < state.range(0); ++i)
+        events.PushBack(i);
+      SSTD::StaticVector<int64, 256> copy{ events };
+      benchmark::DoNotOptimize(copy.Data());
+    }
+  }
+
+  //growing to a large size, Vector copies everything on each doubling, SegmentedVector only adds chunks
+  static void PushBackLarge(benchmark::State& state)
+  {
+    for (auto _ : state)
+    {
+      SSTD::Vector<int64> v{};
+      for (int64 i = 0; i < state.range(0); ++i)
+        v.PushBack(i);
+      benchmark::DoNotOptimize(v.Data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void SegmentedPushBackLarge(benchmark::State& state)
+  {
+    for (auto _ : state)
+    {
+      SSTD::SegmentedVector<int64, 4096> v{};
+      for (int64 i = 0; i < state.range(0); ++i)
+        v.PushBack(i);
+      benchmark::DoNotOptimize(&v.Back());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void SegmentedSum(benchmark::State& state)
+  {
+    SSTD::SegmentedVector<int64, 4096> v{};
+    for (int64 i = 0; i < state.range(0); ++i)
+      v.PushBack(i);
+
+    for (auto _ : state)
+    {
+      int64 sum = 0;
+      v.ApplyChunks([&sum](const int64* data, size_t size)
+        {
+          for (size_t i = 0; i < size; ++i)
+            sum += data[i];
+        });
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
 }
 
 BENCHMARK(VectorBench::ConstructorEmpty);
@@ -70,4 +230,20 @@ BENCHMARK(VectorBench::ConstructorReserve);
 BENCHMARK(VectorBench::STDConstructorReserve);
 
 BENCHMARK(VectorBench::ConstructorPushBack);
-BENCHMARK(VectorBench::STDConstructorPushBack);
\ No newline at end of file
+BENCHMARK(VectorBench::STDConstructorPushBack);
+
+BENCHMARK(VectorBench::GrowStrings)->Range(8, 8 << 10);
+BENCHMARK(VectorBench::STDGrowStrings)->Range(8, 8 << 10);
+
+BENCHMARK(VectorBench::GrowSharedPointers)->Range(8, 8 << 10);
+BENCHMARK(VectorBench::STDGrowSharedPointers)->Range(8, 8 << 10);
+
+BENCHMARK(VectorBench::TemporaryList)->DenseRange(2, 16, 7);
+BENCHMARK(VectorBench::SmallTemporaryList)->DenseRange(2, 16, 7);
+
+BENCHMARK(VectorBench::FrameBuffer)->Range(8, 256);
+BENCHMARK(VectorBench::StaticFrameBuffer)->Range(8, 256);
+
+BENCHMARK(VectorBench::PushBackLarge)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(VectorBench::SegmentedPushBackLarge)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(VectorBench::SegmentedSum)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
\ No newline at end of file
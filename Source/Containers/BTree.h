@@ -0,0 +1,878 @@
+#pragma once
+
+#include "General/Memory.h"
+#include "General/Numeric.h"
+#include "General/Meta.h"
+#include "General/Utility.h"
+#include "General/Algorithm.h"
+#include "General/Allocator.h"
+
+#include "Containers/Pair.h"
+#include "Containers/Vector.h"
+
+#include "Platform/DefinePlatform.h"
+
+#ifdef ARCH_X64
+#include <immintrin.h>
+#endif
+
+namespace SSTD
+{
+  //B+tree: every element sits in a leaf, the inner nodes only hold separator keys, the leaves are chained for range scans
+  //a node is a few cache lines of keys, searching one is a linear SIMD compare for integral keys and a binary search otherwise
+  namespace BTreeSearch
+  {
+    //64 bit compares need AVX2 (or SSE4.2 for two lanes), without vector compares a binary search beats a scalar scan
+#ifdef ARCH_X64
+    static constexpr bool HasVectorCompare32 = true;
+#else
+    static constexpr bool HasVectorCompare32 = false;
+#endif
+#if defined(ARCH_X64) && (defined(__AVX2__) || defined(__SSE4_2__))
+    static constexpr bool HasVectorCompare64 = true;
+#else
+    static constexpr bool HasVectorCompare64 = false;
+#endif
+
+    template<typename K>
+    static constexpr bool IsVectorKey = IsNumeric<K>::valid && !IsSame<K, float>::valid && !IsSame<K, double>::valid &&
+      ((sizeof(K) == 4 && HasVectorCompare32) || (sizeof(K) == 8 && HasVectorCompare64));
+
+    //the compares are signed only, flipping the top bit maps the unsigned order onto the signed one
+    template<typename K>
+    static constexpr uint64 SignFlip = static_cast<K>(-1) < static_cast<K>(0) ? 0 : 1ull << (sizeof(K) * 8 - 1);
+
+    //number of keys below key, with OrEqual the ones at or below key, keys has to be sorted
+    template<bool OrEqual, typename K>
+    static inline uint32 CountIntegral(const K* keys, uint32 count, K key)
+    {
+      uint32 i = 0;
+      uint32 result = 0;
+#ifdef ARCH_X64
+      if constexpr (sizeof(K) == 4)
+      {
+        int32 flip = static_cast<int32>(SignFlip<K>);
+        int32 value = static_cast<int32>(key) ^ flip;
+#ifdef __AVX2__
+        __m256i key8 = _mm256_set1_epi32(value);
+        __m256i flip8 = _mm256_set1_epi32(flip);
+        for (; i + 8 <= count; i += 8)
+        {
+          __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)), flip8);
+          __m256i cmp = OrEqual ? _mm256_cmpgt_epi32(v, key8) : _mm256_cmpgt_epi32(key8, v);
+          uint32 bits = Bit::PopCount(static_cast<uint32>(_mm256_movemask_ps(_mm256_castsi256_ps(cmp))));
+          result += OrEqual ? 8 - bits : bits;
+        }
+#endif
+        __m128i key4 = _mm_set1_epi32(value);
+        __m128i flip4 = _mm_set1_epi32(flip);
+        for (; i + 4 <= count; i += 4)
+        {
+          __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), flip4);
+          __m128i cmp = OrEqual ? _mm_cmpgt_epi32(v, key4) : _mm_cmpgt_epi32(key4, v);
+          uint32 bits = Bit::PopCount(static_cast<uint32>(_mm_movemask_ps(_mm_castsi128_ps(cmp))));
+          result += OrEqual ? 4 - bits : bits;
+        }
+      }
+      else
+      {
+#if defined(__AVX2__)
+        int64 flip = static_cast<int64>(SignFlip<K>);
+        __m256i key4 = _mm256_set1_epi64x(static_cast<int64>(key) ^ flip);
+        __m256i flip4 = _mm256_set1_epi64x(flip);
+        for (; i + 4 <= count; i += 4)
+        {
+          __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)), flip4);
+          __m256i cmp = OrEqual ? _mm256_cmpgt_epi64(v, key4) : _mm256_cmpgt_epi64(key4, v);
+          uint32 bits = Bit::PopCount(static_cast<uint32>(_mm256_movemask_pd(_mm256_castsi256_pd(cmp))));
+          result += OrEqual ? 4 - bits : bits;
+        }
+#elif defined(__SSE4_2__)
+        int64 flip = static_cast<int64>(SignFlip<K>);
+        __m128i key2 = _mm_set1_epi64x(static_cast<int64>(key) ^ flip);
+        __m128i flip2 = _mm_set1_epi64x(flip);
+        for (; i + 2 <= count; i += 2)
+        {
+          __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), flip2);
+          __m128i cmp = OrEqual ? _mm_cmpgt_epi64(v, key2) : _mm_cmpgt_epi64(key2, v);
+          uint32 bits = Bit::PopCount(static_cast<uint32>(_mm_movemask_pd(_mm_castsi128_pd(cmp))));
+          result += OrEqual ? 2 - bits : bits;
+        }
+#endif
+      }
+#endif
+      //no branch on the result, the compiler turns this into flag arithmetic
+      for (; i < count; ++i)
+        result += OrEqual ? static_cast<uint32>(!(key < keys[i])) : static_cast<uint32>(keys[i] < key);
+      return result;
+    }
+
+    template<bool OrEqual, typename K, typename Q, typename C>
+    static inline uint32 Count(const K* keys, uint32 count, const Q& key, const C& compare)
+    {
+      if constexpr (IsVectorKey<K> && IsSame<Q, K>::valid && IsSame<C, Less<K>>::valid)
+        return CountIntegral<OrEqual>(keys, count, key);
+      else if constexpr (OrEqual)
+        return static_cast<uint32>(LowerBound(keys, count, key, [&compare](const K& lhs, const Q& rhs) { return !compare(rhs, lhs); }));
+      else
+        return static_cast<uint32>(LowerBound(keys, count, key, compare));
+    }
+  }
+
+  //the value type of a BTreeSet, it takes no room in the leaves
+  struct BTreeNoValue {};
+
+  template<typename V, uint32 N>
+  struct BTreeValues
+  {
+    V* Get() { return reinterpret_cast<V*>(data); }
+    const V* Get() const { return reinterpret_cast<const V*>(data); }
+
+    alignas(V) uint8 data[N * sizeof(V)];
+  };
+
+  template<uint32 N>
+  struct BTreeValues<BTreeNoValue, N>
+  {
+    BTreeNoValue* Get() { return nullptr; }
+    const BTreeNoValue* Get() const { return nullptr; }
+  };
+
+  //the part BTreeMap and BTreeSet share, see BTreeMap.h
+  template<typename K, typename V, typename C, template<typename> typename A>
+  class BTree
+  {
+  protected:
+    static constexpr bool HasValues = !IsSame<V, BTreeNoValue>::valid;
+
+    //a node is about NodeBytes, rounded up to whole cache lines by the alignment
+    static constexpr size_t NodeBytes = 512;
+    static constexpr size_t ValueBytes = HasValues ? sizeof(V) : 0;
+
+    static constexpr uint32 FitCapacity(size_t capacity) { return capacity < 4 ? 4 : static_cast<uint32>(capacity); }
+
+    //an inner node splits into two halves and a key that moves up, that only stays balanced for an odd capacity
+    static constexpr uint32 OddCapacity(uint32 capacity) { return (capacity & 1) ? capacity : capacity - 1; }
+
+  public:
+    static constexpr uint32 LeafCapacity = FitCapacity((NodeBytes - 2 * sizeof(void*)) / (sizeof(K) + ValueBytes));
+    static constexpr uint32 InnerCapacity = OddCapacity(FitCapacity((NodeBytes - 2 * sizeof(void*)) / (sizeof(K) + sizeof(void*))));
+
+  protected:
+    static constexpr uint32 MinLeaf = LeafCapacity / 2;
+    static constexpr uint32 MinInner = InnerCapacity / 2;
+    static constexpr uint32 MaxDepth = 48;
+
+    struct Node
+    {
+      uint32 count = 0;
+    };
+
+    struct alignas(64) Leaf : Node
+    {
+      K* Keys() { return reinterpret_cast<K*>(keys); }
+      const K* Keys() const { return reinterpret_cast<const K*>(keys); }
+      V* Values() { return values.Get(); }
+      const V* Values() const { return values.Get(); }
+
+      alignas(K) uint8 keys[LeafCapacity * sizeof(K)];
+      BTreeValues<V, LeafCapacity> values;
+      Leaf* next = nullptr;
+    };
+
+    //children[i] holds the keys below keys[i], children[i + 1] the ones at or above it
+    struct alignas(64) Inner : Node
+    {
+      K* Keys() { return reinterpret_cast<K*>(keys); }
+      const K* Keys() const { return reinterpret_cast<const K*>(keys); }
+
+      alignas(K) uint8 keys[InnerCapacity * sizeof(K)];
+      Node* children[InnerCapacity + 1];
+    };
+
+    struct Position
+    {
+      Leaf* leaf;
+      uint32 index;
+    };
+
+  public:
+    //walks the leaf chain, end() is a null leaf
+    template<bool IsConst>
+    class BTreeIterator
+    {
+      using LeafType = typename Conditional<IsConst, const Leaf, Leaf>::Type;
+      using ValueType = typename Conditional<IsConst, const V, V>::Type;
+
+    public:
+      struct Entry
+      {
+        const K& key;
+        ValueType& value;
+      };
+
+      BTreeIterator() : m_Leaf(nullptr), m_Index(0) {}
+      BTreeIterator(LeafType* leaf, uint32 index) : m_Leaf(leaf), m_Index(index) {}
+
+      bool operator!=(const BTreeIterator& other) const { return m_Leaf != other.m_Leaf || m_Index != other.m_Index; }
+      bool operator==(const BTreeIterator& other) const { return !(*this != other); }
+
+      BTreeIterator& operator++()
+      {
+        if (++m_Index == m_Leaf->count)
+        {
+          m_Leaf = m_Leaf->next;
+          m_Index = 0;
+        }
+        return *this;
+      }
+
+      BTreeIterator operator++(int) { BTreeIterator i(*this); ++*this; return i; }
+
+      const K& Key() const { return m_Leaf->Keys()[m_Index]; }
+
+      ValueType& Value() const requires HasValues { return m_Leaf->Values()[m_Index]; }
+
+      //a map gives an Entry with key and value, a set the key
+      decltype(auto) operator*() const
+      {
+        if constexpr (HasValues)
+          return Entry{ Key(), Value() };
+        else
+          return Key();
+      }
+
+    private:
+      LeafType* m_Leaf;
+      uint32 m_Index;
+    };
+
+    using TreeIterator = BTreeIterator<false>;
+    using ConstTreeIterator = BTreeIterator<true>;
+
+    explicit BTree() {}
+
+    BTree(const BTree& other)
+    {
+      CopyFrom(other);
+    }
+
+    BTree(BTree&& other) noexcept
+    {
+      Steal(other);
+    }
+
+    ~BTree()
+    {
+      Clear();
+    }
+
+    BTree& operator=(const BTree& other)
+    {
+      if (this != &other)
+      {
+        Clear();
+        CopyFrom(other);
+      }
+      return *this;
+    }
+
+    BTree& operator=(BTree&& other) noexcept
+    {
+      if (this != &other)
+      {
+        Clear();
+        Steal(other);
+      }
+      return *this;
+    }
+
+    template<typename Q>
+    bool Contains(const Q& key) const
+    {
+      return FindPosition(key).leaf != nullptr;
+    }
+
+    //the emptied leaf borrows from or merges with a neighbour, so every node but the root stays at least half full
+    template<typename Q>
+    bool Remove(const Q& key)
+    {
+      if (!m_Root)
+        return false;
+
+      Inner* path[MaxDepth];
+      uint32 slots[MaxDepth];
+      Leaf* leaf = Descend(key, path, slots);
+
+      uint32 index = BTreeSearch::Count<false>(leaf->Keys(), leaf->count, key, m_Compare);
+      if (index == leaf->count || m_Compare(key, leaf->Keys()[index]))
+        return false;
+
+      EraseAt(leaf->Keys(), leaf->count, index);
+      if constexpr (HasValues)
+        EraseAt(leaf->Values(), leaf->count, index);
+      --leaf->count;
+      --m_Size;
+
+      if (m_Depth == 1)
+      {
+        if (leaf->count == 0)
+        {
+          FreeLeaf(leaf);
+          m_Root = nullptr;
+          m_First = nullptr;
+          m_Depth = 0;
+        }
+        return true;
+      }
+
+      if (leaf->count < MinLeaf)
+        RebalanceLeaf(leaf, path, slots);
+      return true;
+    }
+
+    void Clear()
+    {
+      if (m_Root)
+        FreeNode(m_Root, 1);
+      m_Root = nullptr;
+      m_First = nullptr;
+      m_Size = 0;
+      m_Depth = 0;
+    }
+
+    size_t Size() const { return m_Size; }
+
+    bool IsEmpty() const { return m_Size == 0; }
+
+    //levels including the leaves
+    uint32 Depth() const { return m_Depth; }
+
+    TreeIterator begin() { return TreeIterator(m_First, 0); }
+
+    TreeIterator end() { return TreeIterator(); }
+
+    ConstTreeIterator begin() const { return ConstTreeIterator(m_First, 0); }
+
+    ConstTreeIterator end() const { return ConstTreeIterator(); }
+
+    //first element not below key
+    template<typename Q>
+    TreeIterator LowerBound(const Q& key)
+    {
+      Position position = LowerBoundPosition<false>(key);
+      return TreeIterator(position.leaf, position.index);
+    }
+
+    template<typename Q>
+    ConstTreeIterator LowerBound(const Q& key) const
+    {
+      Position position = LowerBoundPosition<false>(key);
+      return ConstTreeIterator(position.leaf, position.index);
+    }
+
+    //first element above key
+    template<typename Q>
+    TreeIterator UpperBound(const Q& key)
+    {
+      Position position = LowerBoundPosition<true>(key);
+      return TreeIterator(position.leaf, position.index);
+    }
+
+    template<typename Q>
+    ConstTreeIterator UpperBound(const Q& key) const
+    {
+      Position position = LowerBoundPosition<true>(key);
+      return ConstTreeIterator(position.leaf, position.index);
+    }
+
+  protected:
+    template<typename T>
+    static void InsertAt(T* data, uint32 count, uint32 index, T&& value)
+    {
+      Relocate(data + index + 1, data + index, count - index);
+      new (data + index) T(Move(value));
+    }
+
+    template<typename T>
+    static void EraseAt(T* data, uint32 count, uint32 index)
+    {
+      data[index].~T();
+      Relocate(data + index, data + index + 1, count - index - 1);
+    }
+
+    Leaf* NewLeaf()
+    {
+      Leaf* leaf = m_LeafAllocator.Allocate(1);
+      new (leaf) Leaf();
+      return leaf;
+    }
+
+    Inner* NewInner()
+    {
+      Inner* inner = m_InnerAllocator.Allocate(1);
+      new (inner) Inner();
+      return inner;
+    }
+
+    //only the node itself, the elements have to be gone or relocated already
+    void FreeLeaf(Leaf* leaf)
+    {
+      leaf->~Leaf();
+      m_LeafAllocator.Deallocate(leaf);
+    }
+
+    void FreeInner(Inner* inner)
+    {
+      inner->~Inner();
+      m_InnerAllocator.Deallocate(inner);
+    }
+
+    void FreeNode(Node* node, uint32 level)
+    {
+      if (level == m_Depth)
+      {
+        Leaf* leaf = static_cast<Leaf*>(node);
+        for (uint32 i = 0; i < leaf->count; ++i)
+        {
+          leaf->Keys()[i].~K();
+          if constexpr (HasValues)
+            leaf->Values()[i].~V();
+        }
+        FreeLeaf(leaf);
+        return;
+      }
+
+      Inner* inner = static_cast<Inner*>(node);
+      for (uint32 i = 0; i <= inner->count; ++i)
+        FreeNode(inner->children[i], level + 1);
+      for (uint32 i = 0; i < inner->count; ++i)
+        inner->Keys()[i].~K();
+      FreeInner(inner);
+    }
+
+    //leaf that holds key or would hold it, the inner nodes on the way and the child taken in each are stored in path and slots
+    template<typename Q>
+    Leaf* Descend(const Q& key, Inner** path, uint32* slots) const
+    {
+      Node* node = m_Root;
+      for (uint32 level = 0; level + 1 < m_Depth; ++level)
+      {
+        Inner* inner = static_cast<Inner*>(node);
+        uint32 child = BTreeSearch::Count<true>(inner->Keys(), inner->count, key, m_Compare);
+        path[level] = inner;
+        slots[level] = child;
+        node = inner->children[child];
+      }
+      return static_cast<Leaf*>(node);
+    }
+
+    template<typename Q>
+    Leaf* FindLeaf(const Q& key) const
+    {
+      Node* node = m_Root;
+      for (uint32 level = 1; level < m_Depth; ++level)
+      {
+        Inner* inner = static_cast<Inner*>(node);
+        node = inner->children[BTreeSearch::Count<true>(inner->Keys(), inner->count, key, m_Compare)];
+      }
+      return static_cast<Leaf*>(node);
+    }
+
+    //leaf is null if key isn't there
+    template<typename Q>
+    Position FindPosition(const Q& key) const
+    {
+      if (!m_Root)
+        return Position{ nullptr, 0 };
+
+      Leaf* leaf = FindLeaf(key);
+      uint32 index = BTreeSearch::Count<false>(leaf->Keys(), leaf->count, key, m_Compare);
+      if (index < leaf->count && !m_Compare(key, leaf->Keys()[index]))
+        return Position{ leaf, index };
+      return Position{ nullptr, 0 };
+    }
+
+    template<bool Upper, typename Q>
+    Position LowerBoundPosition(const Q& key) const
+    {
+      if (!m_Root)
+        return Position{ nullptr, 0 };
+
+      Leaf* leaf = FindLeaf(key);
+      uint32 index = BTreeSearch::Count<Upper>(leaf->Keys(), leaf->count, key, m_Compare);
+      if (index == leaf->count)
+        return Position{ leaf->next, 0 };
+      return Position{ leaf, index };
+    }
+
+    //the value is only constructed from args if the key is new
+    template<typename KK, typename... Args>
+    Pair<Position, bool> Emplace(KK&& key, Args&&... args)
+    {
+      if (!m_Root)
+      {
+        m_First = NewLeaf();
+        m_Root = m_First;
+        m_Depth = 1;
+      }
+
+      Inner* path[MaxDepth];
+      uint32 slots[MaxDepth];
+      Leaf* leaf = Descend(key, path, slots);
+
+      uint32 index = BTreeSearch::Count<false>(leaf->Keys(), leaf->count, key, m_Compare);
+      if (index < leaf->count && !m_Compare(key, leaf->Keys()[index]))
+        return Pair<Position, bool>(Position{ leaf, index }, false);
+
+      //built before anything moves, like Vector::EmplaceAt
+      K newKey{ Forward<KK>(key) };
+      V newValue{ Forward<Args>(args)... };
+
+      Leaf* right = nullptr;
+      if (leaf->count == LeafCapacity)
+      {
+        //the upper half moves to a new leaf, the new element goes to whichever half it belongs to
+        right = NewLeaf();
+        uint32 half = LeafCapacity / 2;
+        right->count = LeafCapacity - half;
+        Relocate(right->Keys(), leaf->Keys() + half, right->count);
+        if constexpr (HasValues)
+          Relocate(right->Values(), leaf->Values() + half, right->count);
+        leaf->count = half;
+        right->next = leaf->next;
+        leaf->next = right;
+
+        if (index > half)
+        {
+          leaf = right;
+          index -= half;
+        }
+      }
+
+      InsertAt(leaf->Keys(), leaf->count, index, Move(newKey));
+      if constexpr (HasValues)
+        InsertAt(leaf->Values(), leaf->count, index, Move(newValue));
+      ++leaf->count;
+      ++m_Size;
+
+      if (right)
+        InsertIntoParent(path, slots, m_Depth - 1, K(right->Keys()[0]), right);
+      return Pair<Position, bool>(Position{ leaf, index }, true);
+    }
+
+    //links right in behind the node at level (0 is the root), splits the parents that are full
+    void InsertIntoParent(Inner** path, uint32* slots, uint32 level, K&& separator, Node* right)
+    {
+      for (;;)
+      {
+        if (level == 0)
+        {
+          Inner* root = NewInner();
+          new (root->Keys()) K(Move(separator));
+          root->children[0] = m_Root;
+          root->children[1] = right;
+          root->count = 1;
+          m_Root = root;
+          ++m_Depth;
+          return;
+        }
+
+        Inner* parent = path[level - 1];
+        uint32 slot = slots[level - 1];
+        if (parent->count < InnerCapacity)
+        {
+          InsertAt(parent->Keys(), parent->count, slot, Move(separator));
+          InsertAt(parent->children, parent->count + 1, slot + 1, Move(right));
+          ++parent->count;
+          return;
+        }
+
+        //keys below mid stay, the one at mid moves up, the ones above go to the new node
+        uint32 mid = InnerCapacity / 2;
+        Inner* sibling = NewInner();
+        sibling->count = InnerCapacity - mid - 1;
+        Relocate(sibling->Keys(), parent->Keys() + mid + 1, sibling->count);
+        Relocate(sibling->children, parent->children + mid + 1, sibling->count + 1);
+        K up{ Move(parent->Keys()[mid]) };
+        parent->Keys()[mid].~K();
+        parent->count = mid;
+
+        if (slot <= mid)
+        {
+          InsertAt(parent->Keys(), parent->count, slot, Move(separator));
+          InsertAt(parent->children, parent->count + 1, slot + 1, Move(right));
+          ++parent->count;
+        }
+        else
+        {
+          InsertAt(sibling->Keys(), sibling->count, slot - mid - 1, Move(separator));
+          InsertAt(sibling->children, sibling->count + 1, slot - mid, Move(right));
+          ++sibling->count;
+        }
+
+        separator = Move(up);
+        right = sibling;
+        --level;
+      }
+    }
+
+    void RebalanceLeaf(Leaf* leaf, Inner** path, uint32* slots)
+    {
+      uint32 level = m_Depth - 2;
+      Inner* parent = path[level];
+      uint32 slot = slots[level];
+
+      Leaf* left = slot > 0 ? static_cast<Leaf*>(parent->children[slot - 1]) : nullptr;
+      Leaf* right = slot < parent->count ? static_cast<Leaf*>(parent->children[slot + 1]) : nullptr;
+
+      if (left && left->count > MinLeaf)
+      {
+        Relocate(leaf->Keys() + 1, leaf->Keys(), leaf->count);
+        Relocate(leaf->Keys(), left->Keys() + left->count - 1, 1);
+        if constexpr (HasValues)
+        {
+          Relocate(leaf->Values() + 1, leaf->Values(), leaf->count);
+          Relocate(leaf->Values(), left->Values() + left->count - 1, 1);
+        }
+        --left->count;
+        ++leaf->count;
+        parent->Keys()[slot - 1] = leaf->Keys()[0];
+        return;
+      }
+
+      if (right && right->count > MinLeaf)
+      {
+        Relocate(leaf->Keys() + leaf->count, right->Keys(), 1);
+        Relocate(right->Keys(), right->Keys() + 1, right->count - 1);
+        if constexpr (HasValues)
+        {
+          Relocate(leaf->Values() + leaf->count, right->Values(), 1);
+          Relocate(right->Values(), right->Values() + 1, right->count - 1);
+        }
+        --right->count;
+        ++leaf->count;
+        parent->Keys()[slot] = right->Keys()[0];
+        return;
+      }
+
+      //the right one of the two always goes away, so m_First stays valid
+      if (left)
+      {
+        MergeLeaves(left, leaf);
+        RemoveFromInner(parent, slot - 1);
+      }
+      else
+      {
+        MergeLeaves(leaf, right);
+        RemoveFromInner(parent, slot);
+      }
+      RebalanceInner(level, path, slots);
+    }
+
+    void MergeLeaves(Leaf* left, Leaf* right)
+    {
+      Relocate(left->Keys() + left->count, right->Keys(), right->count);
+      if constexpr (HasValues)
+        Relocate(left->Values() + left->count, right->Values(), right->count);
+      left->count += right->count;
+      left->next = right->next;
+      right->count = 0;
+      FreeLeaf(right);
+    }
+
+    //removes keys[index] and the child behind it
+    void RemoveFromInner(Inner* inner, uint32 index)
+    {
+      EraseAt(inner->Keys(), inner->count, index);
+      EraseAt(inner->children, inner->count + 1, index + 1);
+      --inner->count;
+    }
+
+    void RebalanceInner(uint32 level, Inner** path, uint32* slots)
+    {
+      for (;;)
+      {
+        Inner* node = path[level];
+        if (level == 0)
+        {
+          //the root is allowed to be small, but not to have a single child
+          if (node->count == 0)
+          {
+            m_Root = node->children[0];
+            FreeInner(node);
+            --m_Depth;
+          }
+          return;
+        }
+
+        if (node->count >= MinInner)
+          return;
+
+        Inner* parent = path[level - 1];
+        uint32 slot = slots[level - 1];
+        Inner* left = slot > 0 ? static_cast<Inner*>(parent->children[slot - 1]) : nullptr;
+        Inner* right = slot < parent->count ? static_cast<Inner*>(parent->children[slot + 1]) : nullptr;
+
+        //the separator in the parent moves down and the neighbour's outer key moves up in its place
+        if (left && left->count > MinInner)
+        {
+          InsertAt(node->Keys(), node->count, 0, Move(parent->Keys()[slot - 1]));
+          InsertAt(node->children, node->count + 1, 0, Move(left->children[left->count]));
+          ++node->count;
+          parent->Keys()[slot - 1] = Move(left->Keys()[left->count - 1]);
+          left->Keys()[left->count - 1].~K();
+          --left->count;
+          return;
+        }
+
+        if (right && right->count > MinInner)
+        {
+          new (node->Keys() + node->count) K(Move(parent->Keys()[slot]));
+          node->children[node->count + 1] = right->children[0];
+          ++node->count;
+          parent->Keys()[slot] = Move(right->Keys()[0]);
+          EraseAt(right->Keys(), right->count, 0);
+          EraseAt(right->children, right->count + 1, 0);
+          --right->count;
+          return;
+        }
+
+        if (left)
+        {
+          MergeInner(left, node, parent->Keys()[slot - 1]);
+          RemoveFromInner(parent, slot - 1);
+        }
+        else
+        {
+          MergeInner(node, right, parent->Keys()[slot]);
+          RemoveFromInner(parent, slot);
+        }
+        --level;
+      }
+    }
+
+    void MergeInner(Inner* left, Inner* right, K& separator)
+    {
+      new (left->Keys() + left->count) K(Move(separator));
+      Relocate(left->Keys() + left->count + 1, right->Keys(), right->count);
+      Relocate(left->children + left->count + 1, right->children, right->count + 1);
+      left->count += right->count + 1;
+      right->count = 0;
+      FreeInner(right);
+    }
+
+    //builds the tree bottom up from count ascending keys, of equal keys only the first is kept
+    //the elements are spread evenly, so every node ends up (almost) full
+    template<typename KeyAt, typename ValueAt>
+    void BuildSorted(size_t count, const KeyAt& keyAt, const ValueAt& valueAt)
+    {
+      Clear();
+      if (count == 0)
+        return;
+
+      size_t distinct = 1;
+      for (size_t i = 1; i < count; ++i)
+        distinct += m_Compare(keyAt(i - 1), keyAt(i));
+
+      Vector<Node*> nodes{};
+      Vector<const K*> lowest{};
+      size_t leafCount = (distinct + LeafCapacity - 1) / LeafCapacity;
+      nodes.Reserve(leafCount);
+      lowest.Reserve(leafCount);
+
+      size_t input = 0;
+      Leaf* previous = nullptr;
+      for (size_t l = 0; l < leafCount; ++l)
+      {
+        Leaf* leaf = NewLeaf();
+        uint32 size = static_cast<uint32>(distinct / leafCount + (l < distinct % leafCount));
+        for (uint32 i = 0; i < size; ++i)
+        {
+          new (leaf->Keys() + i) K(keyAt(input));
+          if constexpr (HasValues)
+            new (leaf->Values() + i) V(valueAt(input));
+
+          //skip the rest of a run of equal keys
+          do
+            ++input;
+          while (input < count && !m_Compare(keyAt(input - 1), keyAt(input)));
+        }
+        leaf->count = size;
+
+        if (previous)
+          previous->next = leaf;
+        else
+          m_First = leaf;
+        previous = leaf;
+        nodes.PushBack(leaf);
+        lowest.PushBack(leaf->Keys());
+      }
+
+      m_Size = distinct;
+      m_Depth = 1;
+
+      while (nodes.Size() > 1)
+      {
+        Vector<Node*> parents{};
+        Vector<const K*> parentLowest{};
+        size_t parentCount = (nodes.Size() + InnerCapacity) / (InnerCapacity + 1);
+
+        size_t child = 0;
+        for (size_t p = 0; p < parentCount; ++p)
+        {
+          Inner* inner = NewInner();
+          uint32 children = static_cast<uint32>(nodes.Size() / parentCount + (p < nodes.Size() % parentCount));
+          for (uint32 i = 0; i < children; ++i, ++child)
+          {
+            inner->children[i] = nodes[child];
+            if (i > 0)
+              new (inner->Keys() + i - 1) K(*lowest[child]);
+          }
+          inner->count = children - 1;
+          parents.PushBack(inner);
+          parentLowest.PushBack(lowest[child - children]);
+        }
+
+        nodes = Move(parents);
+        lowest = Move(parentLowest);
+        ++m_Depth;
+      }
+      m_Root = nodes[0];
+    }
+
+    void CopyFrom(const BTree& other)
+    {
+      Vector<Position> entries{};
+      entries.Reserve(other.m_Size);
+      for (Leaf* leaf = other.m_First; leaf; leaf = leaf->next)
+        for (uint32 i = 0; i < leaf->count; ++i)
+          entries.PushBack(Position{ leaf, i });
+
+      BuildSorted(entries.Size(),
+        [&entries](size_t i) -> const K& { return entries[i].leaf->Keys()[entries[i].index]; },
+        [&entries](size_t i) -> const V& { return entries[i].leaf->Values()[entries[i].index]; });
+    }
+
+    void Steal(BTree& other)
+    {
+      m_Root = other.m_Root;
+      m_First = other.m_First;
+      m_Size = other.m_Size;
+      m_Depth = other.m_Depth;
+      other.m_Root = nullptr;
+      other.m_First = nullptr;
+      other.m_Size = 0;
+      other.m_Depth = 0;
+    }
+
+  protected:
+    Node* m_Root{ nullptr };
+    Leaf* m_First{ nullptr };
+    size_t m_Size{ 0 };
+    uint32 m_Depth{ 0 };
+    C m_Compare{};
+    A<Leaf> m_LeafAllocator{};
+    A<Inner> m_InnerAllocator{};
+  };
+}
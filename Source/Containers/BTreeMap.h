@@ -0,0 +1,130 @@
+#pragma once
+
+#include "General/Utility.h"
+#include "General/Algorithm.h"
+#include "General/Allocator.h"
+
+#include "General/Exception.h"
+
+#include "Containers/Pair.h"
+#include "Containers/BTree.h"
+
+namespace SSTD
+{
+  //Ordered map on a B+tree, see BTree.h
+  //keys and values are kept in separate arrays inside a leaf, so a search only touches key cache lines
+  //lookups take any key type C can compare with K, e.g. a const char* for String keys
+  //elements move when a leaf splits or merges, pointers returned by Find are valid until the next insert or remove
+  template<typename K, typename V, typename C = Less<K>, template<typename> typename A = Allocator>
+  class BTreeMap : public BTree<K, V, C, A>
+  {
+    using Tree = BTree<K, V, C, A>;
+    using Position = typename Tree::Position;
+
+  public:
+    using Tree::Tree;
+
+    //false if the key was already there, the value is left alone then
+    bool Insert(const K& key, const V& value)
+    {
+      return TryEmplace(key, value).second;
+    }
+
+    bool Insert(K&& key, V&& value)
+    {
+      return TryEmplace(Move(key), Move(value)).second;
+    }
+
+    V& InsertOrAssign(const K& key, const V& value)
+    {
+      Pair<V*, bool> result = TryEmplace(key, value);
+      if (!result.second)
+        *result.first = value;
+      return *result.first;
+    }
+
+    V& InsertOrAssign(K&& key, V&& value)
+    {
+      Pair<V*, bool> result = TryEmplace(Move(key), Move(value));
+      if (!result.second)
+        *result.first = Move(value);
+      return *result.first;
+    }
+
+    //the value is only constructed from args if the key is new
+    template<typename KK, typename... Args>
+    Pair<V*, bool> TryEmplace(KK&& key, Args&&... args)
+    {
+      Pair<Position, bool> result = Tree::Emplace(Forward<KK>(key), Forward<Args>(args)...);
+      return Pair<V*, bool>(result.first.leaf->Values() + result.first.index, result.second);
+    }
+
+    //default constructs the value if the key is new
+    V& operator[](const K& key)
+    {
+      return *TryEmplace(key).first;
+    }
+
+    V& operator[](K&& key)
+    {
+      return *TryEmplace(Move(key)).first;
+    }
+
+    //replaces the content with count elements, keys has to be in ascending order, of equal keys the first is kept
+    //much faster than inserting one by one, every node ends up (almost) full
+    void BulkLoad(const K* keys, const V* values, size_t count)
+    {
+      Tree::BuildSorted(count, [keys](size_t i) -> const K& { return keys[i]; }, [values](size_t i) -> const V& { return values[i]; });
+    }
+
+    template<typename Q>
+    V* Find(const Q& key)
+    {
+      Position position = Tree::FindPosition(key);
+      return position.leaf ? position.leaf->Values() + position.index : nullptr;
+    }
+
+    template<typename Q>
+    const V* Find(const Q& key) const
+    {
+      Position position = Tree::FindPosition(key);
+      return position.leaf ? position.leaf->Values() + position.index : nullptr;
+    }
+
+    template<typename Q>
+    V& At(const Q& key)
+    {
+      V* value = Find(key);
+      if (!value)
+        throw Exception();
+
+      return *value;
+    }
+
+    template<typename Q>
+    const V& At(const Q& key) const
+    {
+      const V* value = Find(key);
+      if (!value)
+        throw Exception();
+
+      return *value;
+    }
+
+    //in key order
+    template<typename F>
+    void Apply(const F& function)
+    {
+      for (auto it = Tree::begin(); it != Tree::end(); ++it)
+        function(it.Key(), it.Value());
+    }
+
+    //every element with from <= key < to, in key order
+    template<typename Q, typename F>
+    void ApplyRange(const Q& from, const Q& to, const F& function)
+    {
+      for (auto it = Tree::LowerBound(from); it != Tree::end() && Tree::m_Compare(it.Key(), to); ++it)
+        function(it.Key(), it.Value());
+    }
+  };
+}
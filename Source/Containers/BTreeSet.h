@@ -0,0 +1,63 @@
+#pragma once
+
+#include "General/Utility.h"
+#include "General/Algorithm.h"
+#include "General/Allocator.h"
+
+#include "Containers/Pair.h"
+#include "Containers/BTree.h"
+
+namespace SSTD
+{
+  //Ordered set on a B+tree, see BTree.h
+  //lookups take any key type C can compare with K, e.g. a const char* for String keys
+  template<typename K, typename C = Less<K>, template<typename> typename A = Allocator>
+  class BTreeSet : public BTree<K, BTreeNoValue, C, A>
+  {
+    using Tree = BTree<K, BTreeNoValue, C, A>;
+    using Position = typename Tree::Position;
+
+  public:
+    using Tree::Tree;
+
+    //false if the key was already there
+    bool Insert(const K& key)
+    {
+      return Tree::Emplace(key).second;
+    }
+
+    bool Insert(K&& key)
+    {
+      return Tree::Emplace(Move(key)).second;
+    }
+
+    //replaces the content with count keys, keys has to be in ascending order, duplicates are dropped
+    void BulkLoad(const K* keys, size_t count)
+    {
+      Tree::BuildSorted(count, [keys](size_t i) -> const K& { return keys[i]; }, [](size_t) -> const BTreeNoValue& { static const BTreeNoValue none{}; return none; });
+    }
+
+    template<typename Q>
+    const K* Find(const Q& key) const
+    {
+      Position position = Tree::FindPosition(key);
+      return position.leaf ? position.leaf->Keys() + position.index : nullptr;
+    }
+
+    //in key order
+    template<typename F>
+    void Apply(const F& function) const
+    {
+      for (const K& key : *this)
+        function(key);
+    }
+
+    //every key with from <= key < to, in key order
+    template<typename Q, typename F>
+    void ApplyRange(const Q& from, const Q& to, const F& function) const
+    {
+      for (auto it = Tree::LowerBound(from); it != Tree::end() && Tree::m_Compare(it.Key(), to); ++it)
+        function(it.Key());
+    }
+  };
+}
@@ -0,0 +1,360 @@
+#pragma once
+
+#include "General/Utility.h"
+#include "General/Hash.h"
+#include "General/Pattern.h"
+#include "General/Exception.h"
+
+#include "Containers/Vector.h"
+
+#include "Platform/Threading/Atomic.h"
+#include "Platform/Threading/Mutex.h"
+#include "Platform/Threading/Lock.h"
+#include "Platform/Threading/Epoch.h"
+
+namespace SSTD
+{
+  //Hash map for many threads, split into shards by the hash, every shard is a chained table with its own Mutex
+  //readers never lock: the chains are walked with atomic loads inside an EpochGuard, nodes are never changed once
+  //they are linked in, an update links in a copy, and unlinked nodes and old bucket arrays are only freed once no
+  //reader can see them anymore (see Epoch.h)
+  //so lookups hand out copies of the value or call a function on it, never a pointer
+  template<typename K, typename V, typename H = Hasher<K>, typename E = Equals<K>>
+  class ConcurrentHashMap : public NonCopyable
+  {
+  public:
+    //the shards take the top bits of the hash and the buckets the low ones, so they only meet once a shard has 2^48 buckets
+    static constexpr size_t MaxShards = size_t(1) << 16;
+
+    //shardCount is rounded up to a power of two, more shards means less contention between writers
+    explicit ConcurrentHashMap(size_t shardCount = 64)
+    {
+      if (shardCount > MaxShards)
+        throw Exception();
+
+      m_ShardCount = 1;
+      m_ShardShift = 64;
+      while (m_ShardCount < shardCount)
+      {
+        m_ShardCount <<= 1;
+        --m_ShardShift;
+      }
+
+      m_Shards = new Shard[m_ShardCount];
+      for (size_t i = 0; i < m_ShardCount; ++i)
+        m_Shards[i].table.Store(new Table(InitialBuckets), MemoryOrder::Release);
+    }
+
+    //no reader may be inside the map anymore
+    ~ConcurrentHashMap()
+    {
+      for (size_t i = 0; i < m_ShardCount; ++i)
+      {
+        Shard& shard = m_Shards[i];
+        FreeTable(shard.table.Load(MemoryOrder::Relaxed));
+        for (size_t r = 0; r < shard.retired.Size(); ++r)
+          shard.retired[r].free(shard.retired[r].ptr);
+      }
+      delete[] m_Shards;
+    }
+
+    //calls function with the value while it is protected, false if the key isn't there
+    template<typename Q, typename F>
+    bool Visit(const Q& key, const F& function) const
+    {
+      uint64 hash = m_Hasher(key);
+      const Shard& shard = ShardOf(hash);
+
+      EpochGuard guard;
+      const Node* node = FindNode(shard, hash, key);
+      if (!node)
+        return false;
+
+      function(node->value);
+      return true;
+    }
+
+    template<typename Q>
+    bool Find(const Q& key, V& value) const
+    {
+      return Visit(key, [&value](const V& found) { value = found; });
+    }
+
+    template<typename Q>
+    bool Contains(const Q& key) const
+    {
+      return Visit(key, [](const V&) {});
+    }
+
+    //false if the key was already there, the value is left alone then
+    bool Insert(const K& key, const V& value)
+    {
+      uint64 hash = m_Hasher(key);
+      Shard& shard = ShardOf(hash);
+      Lock<Mutex> lock(shard.mutex);
+
+      if (FindLink(shard, hash, key))
+        return false;
+
+      Link(shard, new Node(hash, key, value));
+      return true;
+    }
+
+    //inserts or replaces the value, true if the key was new
+    bool Upsert(const K& key, const V& value)
+    {
+      uint64 hash = m_Hasher(key);
+      Shard& shard = ShardOf(hash);
+      Lock<Mutex> lock(shard.mutex);
+
+      AtomicPointer<Node>* link = FindLink(shard, hash, key);
+      if (!link)
+      {
+        Link(shard, new Node(hash, key, value));
+        return true;
+      }
+
+      //readers still on the old node keep walking the chain through its next
+      Node* old = link->Load(MemoryOrder::Relaxed);
+      Node* node = new Node(hash, key, value);
+      node->next.Store(old->next.Load(MemoryOrder::Relaxed), MemoryOrder::Relaxed);
+      link->Store(node);
+      Retire(shard, old, &FreeNode);
+      return false;
+    }
+
+    //returns the value for key, compute() is called to make it if the key is new, at most once per key
+    //the value is constructed in the node from what compute() returns
+    //compute() runs under the shard mutex, which is what keeps it to one call: it must not use this map, a key in the
+    //same shard deadlocks
+    template<typename F>
+    V ComputeIfAbsent(const K& key, const F& compute)
+    {
+      uint64 hash = m_Hasher(key);
+      Shard& shard = ShardOf(hash);
+
+      {
+        EpochGuard guard;
+        if (const Node* node = FindNode(shard, hash, key))
+          return node->value;
+      }
+
+      Lock<Mutex> lock(shard.mutex);
+
+      //someone else might have added it since the lookup
+      if (AtomicPointer<Node>* link = FindLink(shard, hash, key))
+        return link->Load(MemoryOrder::Relaxed)->value;
+
+      //still holding the lock, compute() must not come back into the map
+      Node* node = new Node(hash, key, compute());
+      Link(shard, node);
+      return node->value;
+    }
+
+    template<typename Q>
+    bool Remove(const Q& key)
+    {
+      uint64 hash = m_Hasher(key);
+      Shard& shard = ShardOf(hash);
+      Lock<Mutex> lock(shard.mutex);
+
+      AtomicPointer<Node>* link = FindLink(shard, hash, key);
+      if (!link)
+        return false;
+
+      Node* node = link->Load(MemoryOrder::Relaxed);
+      link->Store(node->next.Load(MemoryOrder::Relaxed));
+      shard.count.Store(shard.count.Load(MemoryOrder::Relaxed) - 1, MemoryOrder::Relaxed);
+      Retire(shard, node, &FreeNode);
+      return true;
+    }
+
+    void Erase()
+    {
+      for (size_t i = 0; i < m_ShardCount; ++i)
+      {
+        Shard& shard = m_Shards[i];
+        Lock<Mutex> lock(shard.mutex);
+
+        Table* old = shard.table.Load(MemoryOrder::Relaxed);
+        shard.table.Store(new Table(InitialBuckets));
+        shard.count.Store(0, MemoryOrder::Relaxed);
+        Retire(shard, old, &FreeTable);
+      }
+    }
+
+    //only a snapshot while other threads write
+    size_t Size() const
+    {
+      size_t size = 0;
+      for (size_t i = 0; i < m_ShardCount; ++i)
+        size += m_Shards[i].count.Load(MemoryOrder::Relaxed);
+      return size;
+    }
+
+    bool IsEmpty() const { return Size() == 0; }
+
+    size_t ShardCount() const { return m_ShardCount; }
+
+  private:
+    static constexpr size_t InitialBuckets = 16;
+
+    //retired memory is only looked at again after this many more retires
+    static constexpr size_t CollectThreshold = 64;
+
+    struct Node
+    {
+      template<typename VV>
+      Node(uint64 pHash, const K& pKey, VV&& pValue) : hash(pHash), key(pKey), value(Forward<VV>(pValue)) {}
+
+      AtomicPointer<Node> next{};
+      uint64 hash;
+      K key;
+      V value;
+    };
+
+    struct Table
+    {
+      explicit Table(size_t count) : mask(count - 1), heads(new AtomicPointer<Node>[count]) {}
+      ~Table() { delete[] heads; }
+
+      size_t mask;
+      AtomicPointer<Node>* heads;
+    };
+
+    struct Retired
+    {
+      void* ptr;
+      void (*free)(void*);
+      uint64 stamp;
+    };
+
+    struct alignas(64) Shard
+    {
+      Mutex mutex;
+      AtomicPointer<Table> table{};
+      a_uint64 count{ 0 };
+      Vector<Retired> retired{};
+    };
+
+    static void FreeNode(void* ptr)
+    {
+      delete static_cast<Node*>(ptr);
+    }
+
+    //the nodes still linked in go with the table
+    static void FreeTable(void* ptr)
+    {
+      Table* table = static_cast<Table*>(ptr);
+      for (size_t i = 0; i <= table->mask; ++i)
+      {
+        Node* node = table->heads[i].Load(MemoryOrder::Relaxed);
+        while (node)
+        {
+          Node* next = node->next.Load(MemoryOrder::Relaxed);
+          delete node;
+          node = next;
+        }
+      }
+      delete table;
+    }
+
+    Shard& ShardOf(uint64 hash) const
+    {
+      //split in two so a single shard shifts by 64 without it being undefined
+      return m_Shards[(hash >> 1) >> (m_ShardShift - 1)];
+    }
+
+    //the node with key, nullptr if there is none, the caller has to hold an EpochGuard
+    template<typename Q>
+    const Node* FindNode(const Shard& shard, uint64 hash, const Q& key) const
+    {
+      const Table* table = shard.table.Load(MemoryOrder::Acquire);
+      for (const Node* node = table->heads[hash & table->mask].Load(MemoryOrder::Acquire); node; node = node->next.Load(MemoryOrder::Acquire))
+      {
+        if (node->hash == hash && m_Equals(node->key, key))
+          return node;
+      }
+      return nullptr;
+    }
+
+    //the pointer that links in the node with key, nullptr if there is none, the shard has to be locked
+    template<typename Q>
+    AtomicPointer<Node>* FindLink(Shard& shard, uint64 hash, const Q& key)
+    {
+      Table* table = shard.table.Load(MemoryOrder::Relaxed);
+      AtomicPointer<Node>* link = &table->heads[hash & table->mask];
+      for (Node* node = link->Load(MemoryOrder::Relaxed); node; node = link->Load(MemoryOrder::Relaxed))
+      {
+        if (node->hash == hash && m_Equals(node->key, key))
+          return link;
+        link = &node->next;
+      }
+      return nullptr;
+    }
+
+    //links the node in at the head of its bucket, the shard has to be locked
+    void Link(Shard& shard, Node* node)
+    {
+      uint64 count = shard.count.Load(MemoryOrder::Relaxed) + 1;
+      shard.count.Store(count, MemoryOrder::Relaxed);
+
+      Table* table = shard.table.Load(MemoryOrder::Relaxed);
+      if (count > table->mask + 1)
+        table = Grow(shard, table);
+
+      AtomicPointer<Node>& head = table->heads[node->hash & table->mask];
+      node->next.Store(head.Load(MemoryOrder::Relaxed), MemoryOrder::Relaxed);
+      head.Store(node);
+    }
+
+    //readers may still walk the old chains, so they are copied instead of relinked and the old ones retired as a whole
+    Table* Grow(Shard& shard, Table* old)
+    {
+      Table* table = new Table((old->mask + 1) * 2);
+      for (size_t i = 0; i <= old->mask; ++i)
+      {
+        for (Node* node = old->heads[i].Load(MemoryOrder::Relaxed); node; node = node->next.Load(MemoryOrder::Relaxed))
+        {
+          Node* copy = new Node(node->hash, node->key, node->value);
+          AtomicPointer<Node>& head = table->heads[node->hash & table->mask];
+          copy->next.Store(head.Load(MemoryOrder::Relaxed), MemoryOrder::Relaxed);
+          head.Store(copy, MemoryOrder::Relaxed);
+        }
+      }
+
+      shard.table.Store(table);
+      Retire(shard, old, &FreeTable);
+      return table;
+    }
+
+    //the stamp is taken after the unlink, the shard has to be locked
+    void Retire(Shard& shard, void* ptr, void (*free)(void*))
+    {
+      shard.retired.PushBack(Retired{ ptr, free, Epoch::Current() });
+      if (shard.retired.Size() % CollectThreshold == 0)
+        Collect(shard);
+    }
+
+    //the stamps only grow, so whatever can be freed is at the front
+    void Collect(Shard& shard)
+    {
+      Epoch::TryAdvance();
+
+      size_t count = 0;
+      while (count < shard.retired.Size() && Epoch::CanFree(shard.retired[count].stamp))
+      {
+        shard.retired[count].free(shard.retired[count].ptr);
+        ++count;
+      }
+      shard.retired.RemoveRange(0, count);
+    }
+
+  private:
+    Shard* m_Shards{ nullptr };
+    size_t m_ShardCount{ 0 };
+    uint32 m_ShardShift{ 64 };
+    H m_Hasher{};
+    E m_Equals{};
+  };
+}
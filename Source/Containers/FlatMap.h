@@ -0,0 +1,296 @@
+#pragma once
+
+#include "General/Utility.h"
+#include "General/Algorithm.h"
+#include "General/Allocator.h"
+
+#include "General/Exception.h"
+
+#include "Containers/Pair.h"
+#include "Containers/Vector.h"
+
+namespace SSTD
+{
+  //Sorted map on two parallel Vectors, one for the keys and one for the values
+  //lookups are a branchless binary search over the keys only, so the values never get pulled into the cache
+  //single inserts and removes shift everything behind them, build it with the bulk Insert/InsertSorted instead
+  //lookups take any key type C can compare with K, e.g. a const char* for String keys
+  template<typename K, typename V, typename C = Less<K>, template<typename> typename A = Allocator>
+  class FlatMap
+  {
+  public:
+    explicit FlatMap() {}
+    FlatMap(const FlatMap& other) = default;
+    FlatMap(FlatMap&& other) noexcept = default;
+    ~FlatMap() {}
+
+    FlatMap& operator=(const FlatMap& other) = default;
+    FlatMap& operator=(FlatMap&& other) noexcept = default;
+
+    //false if the key was already there, the value is left alone then
+    bool Insert(const K& key, const V& value)
+    {
+      return TryEmplace(key, value).second;
+    }
+
+    bool Insert(K&& key, V&& value)
+    {
+      return TryEmplace(Move(key), Move(value)).second;
+    }
+
+    //unsorted input, sorted once and then merged with what is already there in one pass
+    //of equal keys the one already in the map wins, then the first one in the input
+    void Insert(const K* keys, const V* values, size_t count)
+    {
+      //only the indices are sorted, the keys aren't copied until the merge
+      Vector<size_t, size_t, A> order{};
+      order.Reserve(count);
+      for (size_t i = 0; i < count; ++i)
+        order.EmplaceBack(i);
+
+      //the index breaks ties, so the first of equal keys ends up in front
+      Sort(order.begin(), order.end(), [this, keys](size_t lhs, size_t rhs)
+        {
+          if (m_Compare(keys[lhs], keys[rhs]))
+            return true;
+          return !m_Compare(keys[rhs], keys[lhs]) && lhs < rhs;
+        });
+
+      Merge(count, [&order, keys](size_t i) -> const K& { return keys[order[i]]; }, [&order, values](size_t i) -> const V& { return values[order[i]]; });
+    }
+
+    //keys has to be in ascending order already, only the merge is done
+    void InsertSorted(const K* keys, const V* values, size_t count)
+    {
+      Merge(count, [keys](size_t i) -> const K& { return keys[i]; }, [values](size_t i) -> const V& { return values[i]; });
+    }
+
+    V& InsertOrAssign(const K& key, const V& value)
+    {
+      Pair<V*, bool> result = TryEmplace(key, value);
+      if (!result.second)
+        *result.first = value;
+      return *result.first;
+    }
+
+    V& InsertOrAssign(K&& key, V&& value)
+    {
+      Pair<V*, bool> result = TryEmplace(Move(key), Move(value));
+      if (!result.second)
+        *result.first = Move(value);
+      return *result.first;
+    }
+
+    //the value is only constructed from args if the key is new
+    template<typename KK, typename... Args>
+    Pair<V*, bool> TryEmplace(KK&& key, Args&&... args)
+    {
+      size_t index = LowerBound(key);
+      if (index < m_Keys.Size() && !m_Compare(key, m_Keys[index]))
+        return Pair<V*, bool>(&m_Values[index], false);
+
+      //both arrays have to stay in step even if a constructor throws, the value is built first and taken out again
+      //if the key fails
+      m_Values.EmplaceAt(index, Forward<Args>(args)...);
+      try
+      {
+        m_Keys.EmplaceAt(index, Forward<KK>(key));
+      }
+      catch (...)
+      {
+        m_Values.RemoveRange(index, 1);
+        throw;
+      }
+      return Pair<V*, bool>(&m_Values[index], true);
+    }
+
+    //default constructs the value if the key is new
+    V& operator[](const K& key)
+    {
+      return *TryEmplace(key).first;
+    }
+
+    V& operator[](K&& key)
+    {
+      return *TryEmplace(Move(key)).first;
+    }
+
+    template<typename Q>
+    bool Remove(const Q& key)
+    {
+      size_t index = FindIndex(key);
+      if (index == NotFound)
+        return false;
+
+      m_Keys.RemoveRange(index, 1);
+      m_Values.RemoveRange(index, 1);
+      return true;
+    }
+
+    template<typename Q>
+    V* Find(const Q& key)
+    {
+      size_t index = FindIndex(key);
+      return index == NotFound ? nullptr : &m_Values[index];
+    }
+
+    template<typename Q>
+    const V* Find(const Q& key) const
+    {
+      size_t index = FindIndex(key);
+      return index == NotFound ? nullptr : &m_Values[index];
+    }
+
+    template<typename Q>
+    bool Contains(const Q& key) const
+    {
+      return FindIndex(key) != NotFound;
+    }
+
+    template<typename Q>
+    V& At(const Q& key)
+    {
+      V* value = Find(key);
+      if (!value)
+        throw Exception();
+
+      return *value;
+    }
+
+    template<typename Q>
+    const V& At(const Q& key) const
+    {
+      const V* value = Find(key);
+      if (!value)
+        throw Exception();
+
+      return *value;
+    }
+
+    void Reserve(const size_t size)
+    {
+      m_Keys.Reserve(size);
+      m_Values.Reserve(size);
+    }
+
+    void Minimize()
+    {
+      m_Keys.Minimize();
+      m_Values.Minimize();
+    }
+
+    void Erase()
+    {
+      m_Keys.Erase();
+      m_Values.Erase();
+    }
+
+    void Clear()
+    {
+      m_Keys.Clear();
+      m_Values.Clear();
+    }
+
+    //in key order
+    template<typename F>
+    void Apply(const F& function)
+    {
+      for (size_t i = 0; i < m_Keys.Size(); ++i)
+        function(static_cast<const K&>(m_Keys[i]), m_Values[i]);
+    }
+
+    const K& KeyAt(const size_t index) const { return m_Keys[index]; }
+
+    V& ValueAt(const size_t index) { return m_Values[index]; }
+
+    const V& ValueAt(const size_t index) const { return m_Values[index]; }
+
+    const Vector<K, size_t, A>& Keys() const { return m_Keys; }
+
+    const Vector<V, size_t, A>& Values() const { return m_Values; }
+
+    size_t Size() const { return m_Keys.Size(); }
+
+    bool IsEmpty() const { return m_Keys.IsEmpty(); }
+
+  private:
+    static constexpr size_t NotFound = ~static_cast<size_t>(0);
+
+    template<typename Q>
+    size_t LowerBound(const Q& key) const
+    {
+      return SSTD::LowerBound(m_Keys.Data(), m_Keys.Size(), key, m_Compare);
+    }
+
+    template<typename Q>
+    size_t FindIndex(const Q& key) const
+    {
+      size_t index = LowerBound(key);
+      return index < m_Keys.Size() && !m_Compare(key, m_Keys[index]) ? index : NotFound;
+    }
+
+    //merges count sorted entries into new vectors, duplicates in the input are dropped
+    template<typename KeyAt, typename ValueAt>
+    void Merge(size_t count, const KeyAt& keyAt, const ValueAt& valueAt)
+    {
+      if (count == 0)
+        return;
+
+      Vector<K, size_t, A> keys{};
+      Vector<V, size_t, A> values{};
+      keys.Reserve(m_Keys.Size() + count);
+      values.Reserve(m_Keys.Size() + count);
+
+      size_t i = 0;
+      size_t j = 0;
+      while (i < m_Keys.Size() && j < count)
+      {
+        if (m_Compare(m_Keys[i], keyAt(j)))
+        {
+          keys.EmplaceBack(Move(m_Keys[i]));
+          values.EmplaceBack(Move(m_Values[i]));
+          ++i;
+          continue;
+        }
+
+        if (m_Compare(keyAt(j), m_Keys[i]))
+        {
+          keys.EmplaceBack(keyAt(j));
+          values.EmplaceBack(valueAt(j));
+        }
+        j = NextDistinct(j, count, keyAt);
+      }
+
+      for (; i < m_Keys.Size(); ++i)
+      {
+        keys.EmplaceBack(Move(m_Keys[i]));
+        values.EmplaceBack(Move(m_Values[i]));
+      }
+
+      while (j < count)
+      {
+        keys.EmplaceBack(keyAt(j));
+        values.EmplaceBack(valueAt(j));
+        j = NextDistinct(j, count, keyAt);
+      }
+
+      m_Keys = Move(keys);
+      m_Values = Move(values);
+    }
+
+    template<typename KeyAt>
+    size_t NextDistinct(size_t j, size_t count, const KeyAt& keyAt) const
+    {
+      const K& key = keyAt(j);
+      do
+        ++j;
+      while (j < count && !m_Compare(key, keyAt(j)));
+      return j;
+    }
+
+  private:
+    Vector<K, size_t, A> m_Keys{};
+    Vector<V, size_t, A> m_Values{};
+    C m_Compare{};
+  };
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "General/Utility.h"
+#include "General/Algorithm.h"
+#include "General/Allocator.h"
+
+#include "Containers/Vector.h"
+
+namespace SSTD
+{
+  //Sorted set on one Vector, see FlatMap.h
+  //lookups take any key type C can compare with K, e.g. a const char* for String keys
+  template<typename K, typename C = Less<K>, template<typename> typename A = Allocator>
+  class FlatSet
+  {
+  public:
+    using SetIterator = ConstIterator<K>;
+
+    explicit FlatSet() {}
+    FlatSet(const FlatSet& other) = default;
+    FlatSet(FlatSet&& other) noexcept = default;
+    ~FlatSet() {}
+
+    FlatSet& operator=(const FlatSet& other) = default;
+    FlatSet& operator=(FlatSet&& other) noexcept = default;
+
+    //false if the key was already there
+    bool Insert(const K& key)
+    {
+      return Emplace(key);
+    }
+
+    bool Insert(K&& key)
+    {
+      return Emplace(Move(key));
+    }
+
+    //unsorted input, sorted once and then merged with what is already there in one pass
+    void Insert(const K* keys, size_t count)
+    {
+      Vector<K, size_t, A> sorted(keys, count);
+      Sort(sorted.begin(), sorted.end(), m_Compare);
+      Merge(sorted.Data(), count);
+    }
+
+    //keys has to be in ascending order already, only the merge is done
+    void InsertSorted(const K* keys, size_t count)
+    {
+      Merge(keys, count);
+    }
+
+    template<typename Q>
+    bool Remove(const Q& key)
+    {
+      size_t index = FindIndex(key);
+      if (index == NotFound)
+        return false;
+
+      m_Keys.RemoveRange(index, 1);
+      return true;
+    }
+
+    template<typename Q>
+    const K* Find(const Q& key) const
+    {
+      size_t index = FindIndex(key);
+      return index == NotFound ? nullptr : &m_Keys[index];
+    }
+
+    template<typename Q>
+    bool Contains(const Q& key) const
+    {
+      return FindIndex(key) != NotFound;
+    }
+
+    void Reserve(const size_t size) { m_Keys.Reserve(size); }
+
+    void Minimize() { m_Keys.Minimize(); }
+
+    void Erase() { m_Keys.Erase(); }
+
+    void Clear() { m_Keys.Clear(); }
+
+    const K& operator[](const size_t index) const { return m_Keys[index]; }
+
+    const K* Data() const { return m_Keys.Data(); }
+
+    size_t Size() const { return m_Keys.Size(); }
+
+    bool IsEmpty() const { return m_Keys.IsEmpty(); }
+
+    SetIterator begin() const { return m_Keys.begin(); }
+
+    SetIterator end() const { return m_Keys.end(); }
+
+  private:
+    static constexpr size_t NotFound = ~static_cast<size_t>(0);
+
+    template<typename KK>
+    bool Emplace(KK&& key)
+    {
+      size_t index = SSTD::LowerBound(m_Keys.Data(), m_Keys.Size(), key, m_Compare);
+      if (index < m_Keys.Size() && !m_Compare(key, m_Keys[index]))
+        return false;
+
+      m_Keys.EmplaceAt(index, Forward<KK>(key));
+      return true;
+    }
+
+    template<typename Q>
+    size_t FindIndex(const Q& key) const
+    {
+      size_t index = SSTD::LowerBound(m_Keys.Data(), m_Keys.Size(), key, m_Compare);
+      return index < m_Keys.Size() && !m_Compare(key, m_Keys[index]) ? index : NotFound;
+    }
+
+    //merges count sorted keys into a new vector, duplicates in the input are dropped
+    void Merge(const K* keys, size_t count)
+    {
+      if (count == 0)
+        return;
+
+      Vector<K, size_t, A> merged{};
+      merged.Reserve(m_Keys.Size() + count);
+
+      size_t i = 0;
+      size_t j = 0;
+      while (i < m_Keys.Size() && j < count)
+      {
+        if (m_Compare(m_Keys[i], keys[j]))
+        {
+          merged.EmplaceBack(Move(m_Keys[i++]));
+          continue;
+        }
+
+        if (m_Compare(keys[j], m_Keys[i]))
+          merged.EmplaceBack(keys[j]);
+        j = NextDistinct(keys, j, count);
+      }
+
+      for (; i < m_Keys.Size(); ++i)
+        merged.EmplaceBack(Move(m_Keys[i]));
+
+      while (j < count)
+      {
+        merged.EmplaceBack(keys[j]);
+        j = NextDistinct(keys, j, count);
+      }
+
+      m_Keys = Move(merged);
+    }
+
+    size_t NextDistinct(const K* keys, size_t j, size_t count) const
+    {
+      const K& key = keys[j];
+      do
+        ++j;
+      while (j < count && !m_Compare(key, keys[j]));
+      return j;
+    }
+
+  private:
+    Vector<K, size_t, A> m_Keys{};
+    C m_Compare{};
+  };
+}
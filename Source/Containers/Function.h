@@ -4,6 +4,8 @@
 
 #include "General/Exception.h"
 
+#include <new>
+
 namespace SSTD
 {
   template<typename T>
@@ -14,6 +16,7 @@ namespace SSTD
   {
     struct ICallable
     {
+      virtual ~ICallable() = default;
       virtual void Delete() = 0;
       virtual ICallable* Copy(void* dst) = 0;
       virtual ICallable* Move(void* dst) = 0;
@@ -25,9 +28,10 @@ namespace SSTD
     template<typename T>
     struct CallableObject : public ICallable
     {
-      static const bool HasAlloc = sizeof(T) > ReservedStackSize;
+      static const bool HasAlloc = sizeof(ICallable) + sizeof(T) > ReservedStackSize;
 
-      explicit CallableObject(T&& val) : obj(Forward<T>(val)) {}
+      template<typename U>
+      explicit CallableObject(U&& val) : obj(Forward<U>(val)) {}
 
       void Delete() override final
       {
@@ -209,7 +213,7 @@ namespace SSTD
         m_Callable = new (&m_Buffer) T(Forward<Args2>(args)...);
     }
 
-    uint8 m_Buffer[ReservedStackSize]{};
+    alignas(void*) uint8 m_Buffer[ReservedStackSize]{};
     ICallable* m_Callable = nullptr;
   };
 }
\ No newline at end of file
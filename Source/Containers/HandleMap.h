@@ -1,24 +1,207 @@
 #pragma once
 
-#include "General/Concepts.h"
 #include "General/Numeric.h"
+#include "General/Utility.h"
+#include "General/Allocator.h"
+
+#include "General/Exception.h"
+
+#include "Containers/Vector.h"
 
 namespace SSTD
 {
-
-  template<typename T>
+  //Generational slot map: Insert hands out a handle that stays valid until the element is removed, a handle to a
+  //removed element is detected instead of reaching whatever reused its slot
+  //the values are kept packed in one dense array, so iterating is a plain array walk
+  //a handle is the slot index in the low 32 bits and the generation of the slot in the high 32 bits, 0 is never valid
+  template<typename T, template<typename> typename A = Allocator>
   class HandleMap
   {
   public:
-    using HandleType = uint32;
+    using HandleType = uint64;
+    using MapIterator = Iterator<T>;
+    using ConstMapIterator = ConstIterator<T>;
+
+    static constexpr HandleType InvalidHandle = 0;
+
     explicit HandleMap() {}
-    HandleMap(const HandleMap& other) {}
-    HandleMap(HandleMap&& other) {}
+    HandleMap(const HandleMap& other) = default;
+    HandleMap(HandleMap&& other) noexcept = default;
     ~HandleMap() {}
 
-    bool Validate(HandleType handle) {}
-    
+    HandleMap& operator=(const HandleMap& other) = default;
+    HandleMap& operator=(HandleMap&& other) noexcept = default;
+
+    HandleType Insert(const T& value)
+    {
+      return Emplace(value);
+    }
+
+    HandleType Insert(T&& value)
+    {
+      return Emplace(Move(value));
+    }
+
+    template<typename... Args>
+    HandleType Emplace(Args&&... args)
+    {
+      uint32 index;
+      if (m_FreeHead != NoSlot)
+      {
+        index = m_FreeHead;
+        m_FreeHead = m_Slots[index].target;
+      }
+      else
+      {
+        index = static_cast<uint32>(m_Slots.Size());
+        m_Slots.PushBack(Slot{ 0, 1 });
+      }
+
+      Slot& slot = m_Slots[index];
+      slot.target = static_cast<uint32>(m_Values.Size());
+      m_Values.EmplaceBack(Forward<Args>(args)...);
+      m_DenseToSlot.PushBack(index);
+      return MakeHandle(index, slot.generation);
+    }
+
+    //the last value is moved into the hole, so the dense array stays packed
+    bool Remove(HandleType handle)
+    {
+      if (!Validate(handle))
+        return false;
+
+      uint32 index = IndexOf(handle);
+      Slot& slot = m_Slots[index];
+      uint32 dense = slot.target;
+      uint32 last = static_cast<uint32>(m_Values.Size()) - 1;
+
+      if (dense != last)
+      {
+        m_Values[dense] = Move(m_Values[last]);
+        m_DenseToSlot[dense] = m_DenseToSlot[last];
+        m_Slots[m_DenseToSlot[dense]].target = dense;
+      }
+      m_Values.PopBack();
+      m_DenseToSlot.PopBack();
+
+      //0 is kept free for InvalidHandle
+      if (++slot.generation == 0)
+        slot.generation = 1;
+      slot.target = m_FreeHead;
+      m_FreeHead = index;
+      return true;
+    }
+
+    bool Validate(HandleType handle) const
+    {
+      uint32 index = IndexOf(handle);
+      return index < m_Slots.Size() && m_Slots[index].generation == GenerationOf(handle) && GenerationOf(handle) != 0;
+    }
+
+    //nullptr for a stale or invalid handle
+    T* Get(HandleType handle)
+    {
+      return Validate(handle) ? &m_Values[m_Slots[IndexOf(handle)].target] : nullptr;
+    }
+
+    const T* Get(HandleType handle) const
+    {
+      return Validate(handle) ? &m_Values[m_Slots[IndexOf(handle)].target] : nullptr;
+    }
+
+    T& At(HandleType handle)
+    {
+      T* value = Get(handle);
+      if (!value)
+        throw Exception();
+
+      return *value;
+    }
+
+    const T& At(HandleType handle) const
+    {
+      const T* value = Get(handle);
+      if (!value)
+        throw Exception();
+
+      return *value;
+    }
+
+    //unchecked, the handle has to be valid
+    T& operator[](HandleType handle) { return m_Values[m_Slots[IndexOf(handle)].target]; }
+    const T& operator[](HandleType handle) const { return m_Values[m_Slots[IndexOf(handle)].target]; }
+
+    //handle of the value at position index of the dense array
+    HandleType HandleAt(const size_t index) const
+    {
+      uint32 slot = m_DenseToSlot[index];
+      return MakeHandle(slot, m_Slots[slot].generation);
+    }
+
+    void Reserve(const size_t size)
+    {
+      m_Values.Reserve(size);
+      m_DenseToSlot.Reserve(size);
+      m_Slots.Reserve(size);
+    }
+
+    //removes every value, all handles handed out so far become stale
+    void Erase()
+    {
+      for (size_t i = 0; i < m_DenseToSlot.Size(); ++i)
+      {
+        Slot& slot = m_Slots[m_DenseToSlot[i]];
+        if (++slot.generation == 0)
+          slot.generation = 1;
+        slot.target = m_FreeHead;
+        m_FreeHead = m_DenseToSlot[i];
+      }
+      m_Values.Erase();
+      m_DenseToSlot.Erase();
+    }
+
+    template<typename F>
+    void Apply(const F& function)
+    {
+      m_Values.Apply(function);
+    }
+
+    T* Data() { return m_Values.Data(); }
+
+    const T* Data() const { return m_Values.Data(); }
+
+    size_t Size() const { return m_Values.Size(); }
+
+    bool IsEmpty() const { return m_Values.IsEmpty(); }
+
+    MapIterator begin() { return m_Values.begin(); }
+
+    MapIterator end() { return m_Values.end(); }
+
+    ConstMapIterator begin() const { return m_Values.begin(); }
+
+    ConstMapIterator end() const { return m_Values.end(); }
+
   private:
+    static constexpr uint32 NoSlot = ~static_cast<uint32>(0);
+
+    //target is the dense index while the slot is used and the next free slot while it is not
+    struct Slot
+    {
+      uint32 target;
+      uint32 generation;
+    };
 
+    static constexpr HandleType MakeHandle(uint32 index, uint32 generation) { return static_cast<HandleType>(generation) << 32 | index; }
+
+    static constexpr uint32 IndexOf(HandleType handle) { return static_cast<uint32>(handle); }
+
+    static constexpr uint32 GenerationOf(HandleType handle) { return static_cast<uint32>(handle >> 32); }
+
+  private:
+    Vector<T, size_t, A> m_Values{};
+    Vector<uint32, size_t, A> m_DenseToSlot{};
+    Vector<Slot, size_t, A> m_Slots{};
+    uint32 m_FreeHead{ NoSlot };
   };
-}
\ No newline at end of file
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "General/Utility.h"
+#include "General/Hash.h"
+#include "General/Allocator.h"
+
+#include "General/Exception.h"
+
+#include "Containers/Pair.h"
+#include "Containers/HashTable.h"
+
+namespace SSTD
+{
+  template<typename K, typename V>
+  struct HashMapKeyOf
+  {
+    static const K& Get(const Pair<K, V>& slot) { return slot.first; }
+  };
+
+  //Unordered map on a swiss table, see HashTable.h
+  //lookups take any key type H and E accept, e.g. a const char* for String keys
+  //the elements move when the table grows, pointers returned by Find are valid until the next insert
+  template<typename K, typename V, typename H = Hasher<K>, typename E = Equals<K>, template<typename> typename A = Allocator>
+  class HashMap : public HashTable<Pair<K, V>, HashMapKeyOf<K, V>, H, E, A>
+  {
+    using Table = HashTable<Pair<K, V>, HashMapKeyOf<K, V>, H, E, A>;
+
+  public:
+    using Table::Table;
+
+    //false if the key was already there, the value is left alone then
+    bool Insert(const K& key, const V& value)
+    {
+      return TryEmplace(key, value).second;
+    }
+
+    bool Insert(K&& key, V&& value)
+    {
+      return TryEmplace(Move(key), Move(value)).second;
+    }
+
+    V& InsertOrAssign(const K& key, const V& value)
+    {
+      Pair<V*, bool> result = TryEmplace(key, value);
+      if (!result.second)
+        *result.first = value;
+      return *result.first;
+    }
+
+    V& InsertOrAssign(K&& key, V&& value)
+    {
+      Pair<V*, bool> result = TryEmplace(Move(key), Move(value));
+      if (!result.second)
+        *result.first = Move(value);
+      return *result.first;
+    }
+
+    //the value is only constructed from args if the key is new
+    template<typename KK, typename... Args>
+    Pair<V*, bool> TryEmplace(KK&& key, Args&&... args)
+    {
+      Pair<size_t, bool> result = Table::FindOrPrepareInsert(key);
+      Pair<K, V>* slot = Table::Slots() + result.first;
+      if (result.second)
+        Table::ConstructSlot(result.first, [&](Pair<K, V>* target) { new (target) Pair<K, V>(Forward<KK>(key), V{ Forward<Args>(args)... }); });
+      return Pair<V*, bool>(&slot->second, result.second);
+    }
+
+    //default constructs the value if the key is new
+    V& operator[](const K& key)
+    {
+      return *TryEmplace(key).first;
+    }
+
+    V& operator[](K&& key)
+    {
+      return *TryEmplace(Move(key)).first;
+    }
+
+    template<typename Q>
+    V* Find(const Q& key)
+    {
+      size_t index = Table::FindIndex(key);
+      return index == Table::NotFound ? nullptr : &Table::Slots()[index].second;
+    }
+
+    template<typename Q>
+    const V* Find(const Q& key) const
+    {
+      size_t index = Table::FindIndex(key);
+      return index == Table::NotFound ? nullptr : &Table::Slots()[index].second;
+    }
+
+    template<typename Q>
+    V& At(const Q& key)
+    {
+      V* value = Find(key);
+      if (!value)
+        throw Exception();
+
+      return *value;
+    }
+
+    template<typename Q>
+    const V& At(const Q& key) const
+    {
+      const V* value = Find(key);
+      if (!value)
+        throw Exception();
+
+      return *value;
+    }
+  };
+}
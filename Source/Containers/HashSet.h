@@ -0,0 +1,51 @@
+#pragma once
+
+#include "General/Utility.h"
+#include "General/Hash.h"
+#include "General/Allocator.h"
+
+#include "Containers/HashTable.h"
+
+namespace SSTD
+{
+  template<typename K>
+  struct HashSetKeyOf
+  {
+    static const K& Get(const K& slot) { return slot; }
+  };
+
+  //Unordered set on a swiss table, see HashTable.h
+  //lookups take any key type H and E accept, e.g. a const char* for String keys
+  template<typename K, typename H = Hasher<K>, typename E = Equals<K>, template<typename> typename A = Allocator>
+  class HashSet : public HashTable<K, HashSetKeyOf<K>, H, E, A>
+  {
+    using Table = HashTable<K, HashSetKeyOf<K>, H, E, A>;
+
+  public:
+    using Table::Table;
+
+    //false if the key was already there
+    bool Insert(const K& key)
+    {
+      Pair<size_t, bool> result = Table::FindOrPrepareInsert(key);
+      if (result.second)
+        Table::ConstructSlot(result.first, [&](K* target) { new (target) K(key); });
+      return result.second;
+    }
+
+    bool Insert(K&& key)
+    {
+      Pair<size_t, bool> result = Table::FindOrPrepareInsert(key);
+      if (result.second)
+        Table::ConstructSlot(result.first, [&](K* target) { new (target) K(Move(key)); });
+      return result.second;
+    }
+
+    template<typename Q>
+    const K* Find(const Q& key) const
+    {
+      size_t index = Table::FindIndex(key);
+      return index == Table::NotFound ? nullptr : Table::Slots() + index;
+    }
+  };
+}
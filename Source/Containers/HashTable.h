@@ -0,0 +1,599 @@
+#pragma once
+
+#include "General/Memory.h"
+#include "General/Numeric.h"
+#include "General/Utility.h"
+#include "General/Allocator.h"
+#include "General/Hash.h"
+
+#include "Containers/Pair.h"
+
+#include "Platform/DefinePlatform.h"
+#include "Platform/Threading/AtomicUtils.h"
+
+#include <string.h>
+
+#ifdef ARCH_X64
+#include <immintrin.h>
+#endif
+
+namespace SSTD
+{
+  //Open addressing in the style of a swiss table: every slot has one control byte, the control bytes sit in their own
+  //array and are probed a whole group at a time, only slots whose byte matches 7 bits of the hash get compared
+  namespace SwissTable
+  {
+    //a full slot stores the low 7 hash bits (0..127), everything else is negative
+    static constexpr int8 Empty = -128;
+    static constexpr int8 Deleted = -2;
+    static constexpr int8 Sentinel = -1;
+
+    static constexpr bool IsFull(int8 ctrl) { return ctrl >= 0; }
+
+    //seed for H1, every table takes the next one when it first allocates and keeps it while it holds elements
+    inline uint64 NextSeed()
+    {
+      static volatile uint64 s_Tables = 0;
+      return (AtomicUtils::PostIncrement(s_Tables, MemoryOrder::Relaxed) + 1) * 0x9E3779B97F4A7C15ull;
+    }
+
+    //Shift is log2 of the bits one slot takes in the mask
+    template<uint32 Width, uint32 Shift>
+    class BitMask
+    {
+    public:
+      explicit BitMask(uint64 mask) : m_Mask(mask) {}
+
+      explicit operator bool() const { return m_Mask != 0; }
+
+      uint32 Lowest() const { return Bit::CountTrailingZeros(m_Mask) >> Shift; }
+
+      void RemoveLowest() { m_Mask &= m_Mask - 1; }
+
+      //slots before the first set one, counted from the bottom
+      uint32 TrailingZeros() const { return m_Mask ? Bit::CountTrailingZeros(m_Mask) >> Shift : Width; }
+
+      //slots after the last set one, counted from the top
+      uint32 LeadingZeros() const { return m_Mask ? (Bit::CountLeadingZeros(m_Mask) - (64 - (Width << Shift))) >> Shift : Width; }
+
+    private:
+      uint64 m_Mask;
+    };
+
+#ifdef ARCH_X64
+    struct GroupSSE2
+    {
+      static constexpr uint32 Width = 16;
+      using Mask = BitMask<Width, 0>;
+
+      explicit GroupSSE2(const int8* ctrl) : m_Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+      Mask Match(int8 hash) const { return Mask(static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash), m_Ctrl)))); }
+
+      Mask MatchEmpty() const { return Match(Empty); }
+
+      //Empty and Deleted are the only bytes below Sentinel
+      Mask MatchEmptyOrDeleted() const { return Mask(static_cast<uint32>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(Sentinel), m_Ctrl)))); }
+
+      __m128i m_Ctrl;
+    };
+
+#ifdef __AVX2__
+    struct GroupAVX2
+    {
+      static constexpr uint32 Width = 32;
+      using Mask = BitMask<Width, 0>;
+
+      explicit GroupAVX2(const int8* ctrl) : m_Ctrl(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctrl))) {}
+
+      Mask Match(int8 hash) const { return Mask(static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(hash), m_Ctrl)))); }
+
+      Mask MatchEmpty() const { return Match(Empty); }
+
+      Mask MatchEmptyOrDeleted() const { return Mask(static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(Sentinel), m_Ctrl)))); }
+
+      __m256i m_Ctrl;
+    };
+#endif
+#endif
+
+    //8 control bytes in a register, one result bit in the top of every byte
+    struct GroupPortable
+    {
+      static constexpr uint32 Width = 8;
+      using Mask = BitMask<Width, 3>;
+
+      static constexpr uint64 Lsbs = 0x0101010101010101ull;
+      static constexpr uint64 Msbs = 0x8080808080808080ull;
+
+      explicit GroupPortable(const int8* ctrl) { memcpy(&m_Ctrl, ctrl, sizeof(m_Ctrl)); }
+
+      //can report a byte that does not match when the one below it does, the key compare sorts that out
+      Mask Match(int8 hash) const
+      {
+        uint64 x = m_Ctrl ^ (Lsbs * static_cast<uint8>(hash));
+        return Mask((x - Lsbs) & ~x & Msbs);
+      }
+
+      Mask MatchEmpty() const { return Mask(m_Ctrl & ~(m_Ctrl << 6) & Msbs); }
+
+      Mask MatchEmptyOrDeleted() const { return Mask(m_Ctrl & ~(m_Ctrl << 7) & Msbs); }
+
+      uint64 m_Ctrl;
+    };
+
+    //picked by the target the code is compiled for, every translation unit using a table has to agree
+#if defined(ARCH_X64) && defined(__AVX2__)
+    using Group = GroupAVX2;
+#elif defined(ARCH_X64)
+    using Group = GroupSSE2;
+#else
+    using Group = GroupPortable;
+#endif
+
+    //what an empty table points at, lookups stop at the first group without touching any slot
+    alignas(32) inline constexpr int8 EmptyGroup[32] = {
+      Sentinel, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty,
+      Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty, Empty };
+
+    //triangular probing over whole groups, visits every group once when the capacity is 2^n - 1
+    class ProbeSequence
+    {
+    public:
+      ProbeSequence(uint64 hash, size_t mask) : m_Mask(mask), m_Offset(hash & mask) {}
+
+      size_t Offset() const { return m_Offset; }
+      size_t Offset(size_t i) const { return (m_Offset + i) & m_Mask; }
+
+      void Next()
+      {
+        m_Index += Group::Width;
+        m_Offset = (m_Offset + m_Index) & m_Mask;
+      }
+
+    private:
+      size_t m_Mask;
+      size_t m_Offset;
+      size_t m_Index{ 0 };
+    };
+  }
+
+  //Shared by HashMap and HashSet, Slot is what gets stored and KeyOf::Get(slot) returns its key
+  //capacity is 0 or 2^n - 1 and the table is grown once 7/8 of it is used
+  template<typename Slot, typename KeyOf, typename H, typename E, template<typename> typename A>
+  class HashTable
+  {
+    using Group = SwissTable::Group;
+
+  protected:
+    static constexpr size_t NotFound = ~static_cast<size_t>(0);
+
+  public:
+    template<typename U>
+    class TableIterator
+    {
+    public:
+      TableIterator(const int8* ctrl, U* slot) : m_Ctrl(ctrl), m_Slot(slot) { SkipFree(); }
+
+      bool operator!=(const TableIterator& other) { return m_Ctrl != other.m_Ctrl; }
+      bool operator==(const TableIterator& other) { return m_Ctrl == other.m_Ctrl; }
+
+      TableIterator& operator++() { ++m_Ctrl; ++m_Slot; SkipFree(); return *this; }
+      TableIterator operator++(int) { TableIterator i(*this); ++(*this); return i; }
+
+      U& operator*() { return *m_Slot; }
+      U* operator->() { return m_Slot; }
+
+    private:
+      //stops on a full slot or on the sentinel behind the last one
+      void SkipFree()
+      {
+        while (*m_Ctrl < SwissTable::Sentinel)
+        {
+          ++m_Ctrl;
+          ++m_Slot;
+        }
+      }
+
+      const int8* m_Ctrl;
+      U* m_Slot;
+    };
+
+    using TableIteratorType = TableIterator<Slot>;
+    using ConstTableIteratorType = TableIterator<const Slot>;
+
+    HashTable() noexcept {}
+
+    HashTable(const HashTable& other)
+      :m_Hasher(other.m_Hasher), m_Equals(other.m_Equals)
+    {
+      CopyFrom(other);
+    }
+
+    HashTable(HashTable&& other) noexcept
+      :m_Hasher(Move(other.m_Hasher)), m_Equals(Move(other.m_Equals))
+    {
+      Steal(other);
+    }
+
+    ~HashTable()
+    {
+      Clear();
+    }
+
+    HashTable& operator=(const HashTable& other)
+    {
+      if (this == &other)
+        return *this;
+
+      Erase();
+      m_Hasher = other.m_Hasher;
+      m_Equals = other.m_Equals;
+      CopyFrom(other);
+      return *this;
+    }
+
+    HashTable& operator=(HashTable&& other) noexcept
+    {
+      if (this == &other)
+        return *this;
+
+      Clear();
+      m_Hasher = Move(other.m_Hasher);
+      m_Equals = Move(other.m_Equals);
+      Steal(other);
+      return *this;
+    }
+
+    template<typename Q>
+    bool Contains(const Q& key) const
+    {
+      return FindIndex(key) != NotFound;
+    }
+
+    //true if there was something to remove
+    template<typename Q>
+    bool Remove(const Q& key)
+    {
+      size_t index = FindIndex(key);
+      if (index == NotFound)
+        return false;
+
+      RemoveIndex(index);
+      return true;
+    }
+
+    //makes room for size elements without growing again
+    void Reserve(const size_t size)
+    {
+      if (size > m_Size + m_GrowthLeft)
+        Resize(NormalizeCapacity(GrowthToCapacity(size)));
+    }
+
+    //rebuilds the table with room for at least capacity slots, Rehash(0) shrinks it to what the elements need
+    void Rehash(const size_t capacity)
+    {
+      if (capacity == 0 && m_Size == 0)
+      {
+        Clear();
+        return;
+      }
+
+      size_t needed = GrowthToCapacity(m_Size);
+      Resize(NormalizeCapacity(capacity > needed ? capacity : needed));
+    }
+
+    //destroys the elements, the memory is kept
+    void Erase()
+    {
+      if (m_Capacity == 0)
+        return;
+
+      DestroySlots();
+      ResetCtrl();
+      m_Size = 0;
+      m_GrowthLeft = CapacityToGrowth(m_Capacity);
+    }
+
+    //destroys the elements and frees the table
+    void Clear()
+    {
+      if (m_Capacity == 0)
+        return;
+
+      DestroySlots();
+      m_CtrlAllocator.Deallocate(m_Ctrl);
+      m_SlotAllocator.Deallocate(m_Slots);
+      m_Ctrl = const_cast<int8*>(SwissTable::EmptyGroup);
+      m_Slots = nullptr;
+      m_Capacity = m_Size = m_GrowthLeft = 0;
+    }
+
+    template<typename F>
+    void Apply(const F& function)
+    {
+      for (Slot& slot : *this)
+        function(slot);
+    }
+
+    size_t Size() const { return m_Size; }
+
+    size_t Capacity() const { return m_Capacity; }
+
+    bool IsEmpty() const { return m_Size == 0; }
+
+    TableIteratorType begin() { return TableIteratorType(m_Ctrl, m_Slots); }
+
+    TableIteratorType end() { return TableIteratorType(m_Ctrl + m_Capacity, m_Slots + m_Capacity); }
+
+    ConstTableIteratorType begin() const { return ConstTableIteratorType(m_Ctrl, m_Slots); }
+
+    ConstTableIteratorType end() const { return ConstTableIteratorType(m_Ctrl + m_Capacity, m_Slots + m_Capacity); }
+
+  protected:
+    template<typename Q>
+    size_t FindIndex(const Q& key) const
+    {
+      uint64 hash = m_Hasher(key);
+      SwissTable::ProbeSequence sequence(H1(hash), m_Capacity);
+      while (true)
+      {
+        Group group(m_Ctrl + sequence.Offset());
+        for (auto mask = group.Match(H2(hash)); mask; mask.RemoveLowest())
+        {
+          size_t index = sequence.Offset(mask.Lowest());
+          if (m_Equals(KeyOf::Get(m_Slots[index]), key)) [[likely]]
+            return index;
+        }
+
+        if (group.MatchEmpty())
+          return NotFound;
+
+        sequence.Next();
+      }
+    }
+
+    //returns the slot of key and true if it still has to be constructed there
+    template<typename Q>
+    Pair<size_t, bool> FindOrPrepareInsert(const Q& key)
+    {
+      uint64 hash = m_Hasher(key);
+      SwissTable::ProbeSequence sequence(H1(hash), m_Capacity);
+      while (true)
+      {
+        Group group(m_Ctrl + sequence.Offset());
+        for (auto mask = group.Match(H2(hash)); mask; mask.RemoveLowest())
+        {
+          size_t index = sequence.Offset(mask.Lowest());
+          if (m_Equals(KeyOf::Get(m_Slots[index]), key)) [[likely]]
+            return Pair<size_t, bool>(index, false);
+        }
+
+        if (group.MatchEmpty())
+          break;
+
+        sequence.Next();
+      }
+      return Pair<size_t, bool>(PrepareInsert(hash), true);
+    }
+
+    //the slot has to be constructed right away with ConstructSlot, the element count already includes it
+    size_t PrepareInsert(uint64 hash)
+    {
+      size_t index = FindFirstFree(hash);
+      if (m_GrowthLeft == 0 && m_Ctrl[index] != SwissTable::Deleted) [[unlikely]]
+      {
+        Grow();
+        index = FindFirstFree(hash);
+      }
+
+      ++m_Size;
+      m_GrowthLeft -= m_Ctrl[index] == SwissTable::Empty;
+      SetCtrl(index, H2(hash));
+      return index;
+    }
+
+    //construct(slot) builds the element in a slot from PrepareInsert, if it throws the slot is released again so no
+    //full slot is left holding garbage
+    template<typename Construct>
+    void ConstructSlot(size_t index, Construct&& construct)
+    {
+      try
+      {
+        construct(m_Slots + index);
+      }
+      catch (...)
+      {
+        ReleaseIndex(index);
+        throw;
+      }
+    }
+
+    void RemoveIndex(size_t index)
+    {
+      m_Slots[index].~Slot();
+      ReleaseIndex(index);
+    }
+
+    //frees the slot without destroying what is in it
+    void ReleaseIndex(size_t index)
+    {
+      --m_Size;
+
+      if (WasNeverFull(index))
+      {
+        SetCtrl(index, SwissTable::Empty);
+        ++m_GrowthLeft;
+      }
+      else
+        SetCtrl(index, SwissTable::Deleted);
+    }
+
+    Slot* Slots() { return m_Slots; }
+
+    const Slot* Slots() const { return m_Slots; }
+
+  private:
+    static size_t CapacityToGrowth(size_t capacity)
+    {
+      //a full group of 8 would leave nothing to stop a probe
+      if (Group::Width == 8 && capacity == 7)
+        return 6;
+      return capacity - capacity / 8;
+    }
+
+    static size_t GrowthToCapacity(size_t growth)
+    {
+      if (Group::Width == 8 && growth == 7)
+        return 8;
+      return growth + (growth > 0 ? (growth - 1) / 7 : 0);
+    }
+
+    //smallest 2^n - 1 that is at least capacity
+    static size_t NormalizeCapacity(size_t capacity)
+    {
+      return capacity ? ~static_cast<size_t>(0) >> Bit::CountLeadingZeros(capacity) : 1;
+    }
+
+    //the seed differs between tables, so copying one table into another in iteration order doesn't cluster
+    uint64 H1(uint64 hash) const { return (hash >> 7) ^ m_Seed; }
+
+    static int8 H2(uint64 hash) { return static_cast<int8>(hash & 0x7F); }
+
+    //the first Width - 1 bytes are cloned behind the sentinel, so a group loaded near the end sees the start of the table
+    void SetCtrl(size_t index, int8 value)
+    {
+      m_Ctrl[index] = value;
+      m_Ctrl[((index - (Group::Width - 1)) & m_Capacity) + ((Group::Width - 1) & m_Capacity)] = value;
+    }
+
+    size_t FindFirstFree(uint64 hash) const
+    {
+      SwissTable::ProbeSequence sequence(H1(hash), m_Capacity);
+      while (true)
+      {
+        auto mask = Group(m_Ctrl + sequence.Offset()).MatchEmptyOrDeleted();
+        if (mask)
+          return sequence.Offset(mask.Lowest());
+        sequence.Next();
+      }
+    }
+
+    //if no group containing the slot was ever full, no probe went past it and it can become Empty instead of Deleted
+    bool WasNeverFull(size_t index) const
+    {
+      if (m_Capacity <= Group::Width)
+        return true;
+
+      auto empty_before = Group(m_Ctrl + ((index - Group::Width) & m_Capacity)).MatchEmpty();
+      auto empty_after = Group(m_Ctrl + index).MatchEmpty();
+      return empty_before && empty_after && empty_after.TrailingZeros() + empty_before.LeadingZeros() < Group::Width;
+    }
+
+    //a table that mostly holds tombstones is rebuilt at the same size instead of doubling
+    void Grow()
+    {
+      if (m_Capacity > Group::Width && m_Size * 32 <= m_Capacity * 25)
+        Resize(m_Capacity);
+      else
+        Resize(m_Capacity * 2 + 1);
+    }
+
+    void Resize(size_t capacity)
+    {
+      int8* old_ctrl = m_Ctrl;
+      Slot* old_slots = m_Slots;
+      size_t old_capacity = m_Capacity;
+
+      if (old_capacity == 0)
+        m_Seed = SwissTable::NextSeed();
+
+      m_Capacity = capacity;
+      m_Ctrl = m_CtrlAllocator.Allocate(capacity + Group::Width);
+      m_Slots = m_SlotAllocator.Allocate(capacity);
+      ResetCtrl();
+      m_GrowthLeft = CapacityToGrowth(capacity) - m_Size;
+
+      for (size_t i = 0; i < old_capacity; ++i)
+      {
+        if (!SwissTable::IsFull(old_ctrl[i]))
+          continue;
+
+        uint64 hash = m_Hasher(KeyOf::Get(old_slots[i]));
+        size_t index = FindFirstFree(hash);
+        SetCtrl(index, H2(hash));
+        RelocateSlot(m_Slots + index, old_slots + i);
+      }
+
+      if (old_capacity)
+      {
+        m_CtrlAllocator.Deallocate(old_ctrl);
+        m_SlotAllocator.Deallocate(old_slots);
+      }
+    }
+
+    static void RelocateSlot(Slot* dst, Slot* src)
+    {
+      if constexpr (IsTriviallyRelocatable<Slot>::valid)
+        memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(Slot));
+      else
+      {
+        new (dst) Slot(Move(*src));
+        src->~Slot();
+      }
+    }
+
+    void ResetCtrl()
+    {
+      MemSet(m_Ctrl, static_cast<uint8>(SwissTable::Empty), m_Capacity + Group::Width);
+      m_Ctrl[m_Capacity] = SwissTable::Sentinel;
+    }
+
+    void DestroySlots()
+    {
+      if constexpr (!IsTriviallyDestructible<Slot>::valid)
+      {
+        for (size_t i = 0; i < m_Capacity; ++i)
+          if (SwissTable::IsFull(m_Ctrl[i]))
+            m_Slots[i].~Slot();
+      }
+    }
+
+    void CopyFrom(const HashTable& other)
+    {
+      Reserve(other.m_Size);
+      for (const Slot& slot : other)
+      {
+        size_t index = PrepareInsert(m_Hasher(KeyOf::Get(slot)));
+        ConstructSlot(index, [&](Slot* target) { new (target) Slot(slot); });
+      }
+    }
+
+    void Steal(HashTable& other)
+    {
+      m_Ctrl = other.m_Ctrl;
+      m_Slots = other.m_Slots;
+      m_Capacity = other.m_Capacity;
+      m_Size = other.m_Size;
+      m_GrowthLeft = other.m_GrowthLeft;
+      m_Seed = other.m_Seed;
+
+      other.m_Ctrl = const_cast<int8*>(SwissTable::EmptyGroup);
+      other.m_Slots = nullptr;
+      other.m_Capacity = other.m_Size = other.m_GrowthLeft = 0;
+    }
+
+  private:
+    int8* m_Ctrl{ const_cast<int8*>(SwissTable::EmptyGroup) };
+    Slot* m_Slots{ nullptr };
+    size_t m_Capacity{ 0 };
+    size_t m_Size{ 0 };
+    size_t m_GrowthLeft{ 0 };
+    uint64 m_Seed{ 0 };
+
+    [[no_unique_address]] H m_Hasher{};
+    [[no_unique_address]] E m_Equals{};
+    A<int8> m_CtrlAllocator{};
+    A<Slot> m_SlotAllocator{};
+  };
+}
@@ -11,6 +11,9 @@ namespace SSTD
     Pair(const Pair& other) : first(other.first), second(other.second) {}
     Pair(Pair&& other) noexcept : first(Move(other.first)), second(Move(other.second)) {}
 
+    template<class U1, class U2>
+    Pair(U1&& pFirst, U2&& pSecond) : first(Forward<U1>(pFirst)), second(Forward<U2>(pSecond)) {}
+
     template<class U1, class U2>
     Pair(Pair<U1, U2>&& other) : first(Move(other.first)), second(Move(other.second)) {}
 
@@ -26,4 +29,10 @@ namespace SSTD
     T1 first{};
     T2 second{};
   };
+
+  template<typename T1, typename T2>
+  struct IsTriviallyRelocatable<Pair<T1, T2>>
+  {
+    static constexpr bool valid = IsTriviallyRelocatable<T1>::valid && IsTriviallyRelocatable<T2>::valid;
+  };
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "General/Pattern.h"
 #include "General/Utility.h"
+#include "General/PoolAllocator.h"
 
 namespace SSTD
 {
@@ -10,7 +11,7 @@ namespace SSTD
   {
   public:
     SharedPointer() :m_Ptr(nullptr), m_RefCount(nullptr) {}
-    SharedPointer(T* ptr) : m_Ptr(ptr), m_RefCount(new SizeType(1)) {}
+    SharedPointer(T* ptr) : m_Ptr(ptr), m_RefCount(CreateRefCount()) {}
     SharedPointer(const SharedPointer& other)
       : m_Ptr(other.m_Ptr), m_RefCount(other.m_RefCount)
     {
@@ -26,7 +27,7 @@ namespace SSTD
 
     template<typename ... Args>
     SharedPointer(Args... args)
-      : m_RefCount(new SizeType(1))
+      : m_RefCount(CreateRefCount())
     {
       m_Ptr = new T(args...);
     }
@@ -66,10 +67,10 @@ namespace SSTD
       if (m_Ptr)
       {
         (*m_RefCount)--;
-        if (m_RefCount == 0)
+        if (*m_RefCount == 0)
         {
           delete m_Ptr;
-          delete m_RefCount;
+          RefCountAllocator().Deallocate(m_RefCount);
         }
         m_Ptr = nullptr;
         m_RefCount = nullptr;
@@ -81,11 +82,26 @@ namespace SSTD
     SizeType GetRefCount() const { return m_RefCount ? (*m_RefCount) : 0; }
 
   private:
+    //the counters are tiny and short lived, so they come from a pool instead of the heap
+    using RefCountAllocator = PoolAllocator<SizeType>;
+
+    static SizeType* CreateRefCount()
+    {
+      SizeType* count = RefCountAllocator().Allocate(1);
+      *count = 1;
+      return count;
+    }
 
     T* m_Ptr;
     SizeType* m_RefCount;
   };
 
+  template<typename T, IntegralType SizeType>
+  struct IsTriviallyRelocatable<SharedPointer<T, SizeType>>
+  {
+    static constexpr bool valid = true;
+  };
+
   template<typename T>
   class UniquePointer : NonCopyable
   {
@@ -134,4 +150,10 @@ namespace SSTD
   private:
     T* m_Ptr;
   };
-}
\ No newline at end of file
+
+  template<typename T>
+  struct IsTriviallyRelocatable<UniquePointer<T>>
+  {
+    static constexpr bool valid = true;
+  };
+}
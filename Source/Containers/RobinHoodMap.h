@@ -0,0 +1,663 @@
+#pragma once
+
+#include "General/Utility.h"
+#include "General/Hash.h"
+#include "General/Memory.h"
+#include "General/Allocator.h"
+
+#include "General/Exception.h"
+
+#include "Platform/DefinePlatform.h"
+
+#include "Containers/Pair.h"
+
+#include <string.h>
+
+#ifdef ARCH_X64
+#include <immintrin.h>
+#endif
+
+#ifdef PLATFORM_WIN64
+#include <intrin.h>
+#endif
+
+namespace SSTD
+{
+  namespace RobinHood
+  {
+    //one per slot, the low 16 bits are the probe distance + 1 (0 marks a free slot), the high 16 bits cache part of the hash
+    //so most mismatches are rejected without touching the slot
+    using Info = uint32;
+
+    static constexpr uint32 DistanceBits = 16;
+    static constexpr Info DistanceMask = (1u << DistanceBits) - 1;
+
+    static constexpr Info Fragment(uint64 hash) { return static_cast<Info>(hash) << DistanceBits; }
+
+    static constexpr Info Distance(Info info) { return info & DistanceMask; }
+
+    //maps the hash onto [0, capacity) by its high bits, so the capacity doesn't have to be a power of two
+    static inline size_t Home(uint64 hash, size_t capacity)
+    {
+#ifdef PLATFORM_WIN64
+      return static_cast<size_t>(__umulh(hash, capacity));
+#else
+      return static_cast<size_t>((static_cast<unsigned __int128>(hash) * capacity) >> 64);
+#endif
+    }
+
+    //a probe looks at this many infos at once, the first Width - 1 are cloned behind the last one so it doesn't have
+    //to care about wrapping around
+    static constexpr uint32 Width = 8;
+
+    //bit i of match is set if lane i holds the key's hash at the distance the key would have there, bit i of stop if
+    //the element in lane i is closer to its home than that, the key can't be in lane i or any lane after it then
+    struct Scan
+    {
+      uint32 match;
+      uint32 stop;
+    };
+
+    //the distances stay below this, so the last lane of a probe can't carry into the hash bits
+    static constexpr Info MaxDistance = DistanceMask - Width;
+
+    static inline Scan ScanGroup(const Info* info, Info wanted)
+    {
+#if defined(ARCH_X64) && defined(__AVX2__)
+      __m256i expected = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int32>(wanted)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+      __m256i actual = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(info));
+      __m256i mask = _mm256_set1_epi32(static_cast<int32>(DistanceMask));
+      __m256i closer = _mm256_cmpgt_epi32(_mm256_and_si256(expected, mask), _mm256_and_si256(actual, mask));
+      return Scan{ static_cast<uint32>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(expected, actual)))),
+                   static_cast<uint32>(_mm256_movemask_ps(_mm256_castsi256_ps(closer))) };
+#elif defined(ARCH_X64)
+      __m128i low = _mm_add_epi32(_mm_set1_epi32(static_cast<int32>(wanted)), _mm_setr_epi32(0, 1, 2, 3));
+      __m128i high = _mm_add_epi32(low, _mm_set1_epi32(4));
+      __m128i actual_low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(info));
+      __m128i actual_high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(info + 4));
+      __m128i mask = _mm_set1_epi32(static_cast<int32>(DistanceMask));
+
+      uint32 match = static_cast<uint32>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(low, actual_low)))) |
+                     static_cast<uint32>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(high, actual_high)))) << 4;
+      uint32 stop = static_cast<uint32>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(_mm_and_si128(low, mask), _mm_and_si128(actual_low, mask))))) |
+                    static_cast<uint32>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(_mm_and_si128(high, mask), _mm_and_si128(actual_high, mask))))) << 4;
+      return Scan{ match, stop };
+#else
+      Scan scan{ 0, 0 };
+      for (uint32 i = 0; i < Width; ++i)
+      {
+        scan.match |= static_cast<uint32>(info[i] == wanted + i) << i;
+        scan.stop |= static_cast<uint32>(Distance(info[i]) < Distance(wanted) + i) << i;
+      }
+      return scan;
+#endif
+    }
+
+    //what an empty map points at
+    inline constexpr Info EmptyInfo[Width] = {};
+  }
+
+  //Unordered map with robin hood linear probing, meant for tables that are kept 60-90% full
+  //a new element takes the slot of the first one that is closer to its home than the new one would be, which keeps
+  //probes short enough to only grow at 9/10 of the capacity, and a probe for a missing key stops at that slot
+  //removing shifts the following elements back by one instead of leaving a tombstone, so a table that sees a lot of
+  //churn doesn't slow down or have to be rebuilt, inserts and removes do move a whole run of elements at high load
+  //the capacity can be any number, Reserve makes exactly the room that is asked for and growing multiplies it by 1.5
+  //the elements are stored in one flat array, iterating walks it from front to back
+  //lookups take any key type H and E accept, e.g. a const char* for String keys
+  //the elements move on insert and remove, pointers returned by Find are valid until the next one
+  template<typename K, typename V, typename H = Hasher<K>, typename E = Equals<K>, template<typename> typename A = Allocator>
+  class RobinHoodMap
+  {
+    using Slot = Pair<K, V>;
+    using Info = RobinHood::Info;
+
+    static constexpr size_t NotFound = ~static_cast<size_t>(0);
+    static constexpr size_t MinCapacity = 16;
+
+  public:
+    template<typename U>
+    class MapIterator
+    {
+    public:
+      MapIterator(const Info* info, const Info* end, U* slot) : m_Info(info), m_End(end), m_Slot(slot) { SkipFree(); }
+
+      bool operator!=(const MapIterator& other) { return m_Info != other.m_Info; }
+      bool operator==(const MapIterator& other) { return m_Info == other.m_Info; }
+
+      MapIterator& operator++() { ++m_Info; ++m_Slot; SkipFree(); return *this; }
+      MapIterator operator++(int) { MapIterator i(*this); ++(*this); return i; }
+
+      U& operator*() { return *m_Slot; }
+      U* operator->() { return m_Slot; }
+
+    private:
+      //stops on a full slot or behind the last one
+      void SkipFree()
+      {
+        while (m_Info != m_End && *m_Info == 0)
+        {
+          ++m_Info;
+          ++m_Slot;
+        }
+      }
+
+      const Info* m_Info;
+      const Info* m_End;
+      U* m_Slot;
+    };
+
+    using MapIteratorType = MapIterator<Slot>;
+    using ConstMapIteratorType = MapIterator<const Slot>;
+
+    RobinHoodMap() noexcept {}
+
+    RobinHoodMap(const RobinHoodMap& other)
+      :m_Hasher(other.m_Hasher), m_Equals(other.m_Equals)
+    {
+      CopyFrom(other);
+    }
+
+    RobinHoodMap(RobinHoodMap&& other) noexcept
+      :m_Hasher(Move(other.m_Hasher)), m_Equals(Move(other.m_Equals))
+    {
+      Steal(other);
+    }
+
+    ~RobinHoodMap()
+    {
+      Clear();
+    }
+
+    RobinHoodMap& operator=(const RobinHoodMap& other)
+    {
+      if (this == &other)
+        return *this;
+
+      Erase();
+      m_Hasher = other.m_Hasher;
+      m_Equals = other.m_Equals;
+      CopyFrom(other);
+      return *this;
+    }
+
+    RobinHoodMap& operator=(RobinHoodMap&& other) noexcept
+    {
+      if (this == &other)
+        return *this;
+
+      Clear();
+      m_Hasher = Move(other.m_Hasher);
+      m_Equals = Move(other.m_Equals);
+      Steal(other);
+      return *this;
+    }
+
+    //false if the key was already there, the value is left alone then
+    bool Insert(const K& key, const V& value)
+    {
+      return TryEmplace(key, value).second;
+    }
+
+    bool Insert(K&& key, V&& value)
+    {
+      return TryEmplace(Move(key), Move(value)).second;
+    }
+
+    V& InsertOrAssign(const K& key, const V& value)
+    {
+      Pair<V*, bool> result = TryEmplace(key, value);
+      if (!result.second)
+        *result.first = value;
+      return *result.first;
+    }
+
+    V& InsertOrAssign(K&& key, V&& value)
+    {
+      Pair<V*, bool> result = TryEmplace(Move(key), Move(value));
+      if (!result.second)
+        *result.first = Move(value);
+      return *result.first;
+    }
+
+    //the value is only constructed from args if the key is new
+    template<typename KK, typename... Args>
+    Pair<V*, bool> TryEmplace(KK&& key, Args&&... args)
+    {
+      uint64 hash = m_Hasher(key);
+      Probe probe = Locate(hash, key);
+      if (probe.found)
+        return Pair<V*, bool>(&m_Slots[probe.index].second, false);
+
+      size_t index = PrepareInsert(hash, probe);
+      ConstructSlot(index, [&](Slot* target) { new (target) Slot(Forward<KK>(key), V{ Forward<Args>(args)... }); });
+      return Pair<V*, bool>(&m_Slots[index].second, true);
+    }
+
+    //default constructs the value if the key is new
+    V& operator[](const K& key)
+    {
+      return *TryEmplace(key).first;
+    }
+
+    V& operator[](K&& key)
+    {
+      return *TryEmplace(Move(key)).first;
+    }
+
+    template<typename Q>
+    V* Find(const Q& key)
+    {
+      size_t index = FindIndex(key);
+      return index == NotFound ? nullptr : &m_Slots[index].second;
+    }
+
+    template<typename Q>
+    const V* Find(const Q& key) const
+    {
+      size_t index = FindIndex(key);
+      return index == NotFound ? nullptr : &m_Slots[index].second;
+    }
+
+    template<typename Q>
+    V& At(const Q& key)
+    {
+      V* value = Find(key);
+      if (!value)
+        throw Exception();
+
+      return *value;
+    }
+
+    template<typename Q>
+    const V& At(const Q& key) const
+    {
+      const V* value = Find(key);
+      if (!value)
+        throw Exception();
+
+      return *value;
+    }
+
+    template<typename Q>
+    bool Contains(const Q& key) const
+    {
+      return FindIndex(key) != NotFound;
+    }
+
+    //true if there was something to remove
+    template<typename Q>
+    bool Remove(const Q& key)
+    {
+      size_t index = FindIndex(key);
+      if (index == NotFound)
+        return false;
+
+      RemoveIndex(index);
+      return true;
+    }
+
+    //makes room for size elements without growing again, and not more than that
+    void Reserve(const size_t size)
+    {
+      if (size > m_GrowthLimit)
+        Resize(GrowthToCapacity(size));
+    }
+
+    //destroys the elements, the memory is kept
+    void Erase()
+    {
+      if (m_Capacity == 0)
+        return;
+
+      DestroySlots();
+      MemSet(m_Info, 0, (m_Capacity + RobinHood::Width) * sizeof(Info));
+      m_Size = 0;
+    }
+
+    //destroys the elements and frees the table
+    void Clear()
+    {
+      if (m_Capacity == 0)
+        return;
+
+      DestroySlots();
+      m_InfoAllocator.Deallocate(m_Info);
+      m_SlotAllocator.Deallocate(m_Slots);
+      m_Info = const_cast<Info*>(RobinHood::EmptyInfo);
+      m_Slots = nullptr;
+      m_Capacity = m_Size = m_GrowthLimit = 0;
+    }
+
+    template<typename F>
+    void Apply(const F& function)
+    {
+      for (Slot& slot : *this)
+        function(static_cast<const K&>(slot.first), slot.second);
+    }
+
+    size_t Size() const { return m_Size; }
+
+    size_t Capacity() const { return m_Capacity; }
+
+    bool IsEmpty() const { return m_Size == 0; }
+
+    float LoadFactor() const { return m_Capacity ? static_cast<float>(m_Size) / m_Capacity : 0.0f; }
+
+    //bytes held by the table, not counting what the elements allocate themselves
+    size_t MemoryUsage() const { return m_Capacity ? m_Capacity * sizeof(Slot) + (m_Capacity + RobinHood::Width) * sizeof(Info) : 0; }
+
+    MapIteratorType begin() { return MapIteratorType(m_Info, m_Info + m_Capacity, m_Slots); }
+
+    MapIteratorType end() { return MapIteratorType(m_Info + m_Capacity, m_Info + m_Capacity, m_Slots + m_Capacity); }
+
+    ConstMapIteratorType begin() const { return ConstMapIteratorType(m_Info, m_Info + m_Capacity, m_Slots); }
+
+    ConstMapIteratorType end() const { return ConstMapIteratorType(m_Info + m_Capacity, m_Info + m_Capacity, m_Slots + m_Capacity); }
+
+  private:
+    //where a probe for a key ended, the slot holding it or the slot it belongs in
+    struct Probe
+    {
+      size_t index;
+      Info distance;
+      bool found;
+    };
+
+    static size_t CapacityToGrowth(size_t capacity) { return capacity - capacity / 10; }
+
+    static size_t GrowthToCapacity(size_t growth)
+    {
+      size_t capacity = growth + (growth + 8) / 9;
+      return capacity > MinCapacity ? capacity : MinCapacity;
+    }
+
+    size_t Next(size_t index) const { return index + 1 == m_Capacity ? 0 : index + 1; }
+
+    size_t Previous(size_t index) const { return index == 0 ? m_Capacity - 1 : index - 1; }
+
+    //the first Width - 1 infos are cloned behind the last one, so a group read near the end sees the start of the table
+    void SetInfo(size_t index, Info info)
+    {
+      m_Info[index] = info;
+      if (index < RobinHood::Width - 1)
+        m_Info[m_Capacity + index] = info;
+    }
+
+    //after the infos in [from, to) were written directly
+    void UpdateClones(size_t from, size_t to)
+    {
+      for (size_t index = from; index < to && index < RobinHood::Width - 1; ++index)
+        m_Info[m_Capacity + index] = m_Info[index];
+    }
+
+    template<typename Q>
+    size_t FindIndex(const Q& key) const
+    {
+      if (m_Size == 0)
+        return NotFound;
+
+      uint64 hash = m_Hasher(key);
+      size_t index = RobinHood::Home(hash, m_Capacity);
+      Info wanted = RobinHood::Fragment(hash) | 1;
+      while (true)
+      {
+        RobinHood::Scan scan = RobinHood::ScanGroup(m_Info + index, wanted);
+        for (uint32 match = scan.match; match; match &= match - 1)
+        {
+          size_t slot = index + Bit::CountTrailingZeros(match);
+          slot = slot < m_Capacity ? slot : slot - m_Capacity;
+          if (m_Equals(m_Slots[slot].first, key)) [[likely]]
+            return slot;
+        }
+
+        if (scan.stop)
+          return NotFound;
+
+        index += RobinHood::Width;
+        index = index < m_Capacity ? index : index - m_Capacity;
+        wanted += RobinHood::Width;
+      }
+    }
+
+    //stops at the key or at the first slot the key would take from its owner
+    template<typename Q>
+    Probe Locate(uint64 hash, const Q& key) const
+    {
+      if (m_Capacity == 0)
+        return Probe{ 0, 1, false };
+
+      size_t index = RobinHood::Home(hash, m_Capacity);
+      Info wanted = RobinHood::Fragment(hash) | 1;
+      while (true)
+      {
+        Info info = m_Info[index];
+        if (info == wanted && m_Equals(m_Slots[index].first, key))
+          return Probe{ index, RobinHood::Distance(wanted), true };
+
+        if (RobinHood::Distance(info) < RobinHood::Distance(wanted))
+          return Probe{ index, RobinHood::Distance(wanted), false };
+
+        index = Next(index);
+        ++wanted;
+      }
+    }
+
+    //same as Locate for a key that is known to be missing
+    Probe Locate(uint64 hash) const
+    {
+      size_t index = RobinHood::Home(hash, m_Capacity);
+      Info distance = 1;
+      while (RobinHood::Distance(m_Info[index]) >= distance)
+      {
+        index = Next(index);
+        ++distance;
+      }
+      return Probe{ index, distance, false };
+    }
+
+    //opens probe.index for the new element by shifting the run up to the next free slot forward by one
+    //the slot has to be constructed right away with ConstructSlot, the element count already includes it
+    size_t PrepareInsert(uint64 hash, Probe probe)
+    {
+      while (true)
+      {
+        if (m_Size < m_GrowthLimit && probe.distance < RobinHood::MaxDistance) [[likely]]
+        {
+          size_t free = probe.index;
+          bool overflow = false;
+          while (m_Info[free] != 0 && !overflow)
+          {
+            overflow = RobinHood::Distance(m_Info[free]) == RobinHood::MaxDistance;
+            free = Next(free);
+          }
+
+          if (!overflow) [[likely]]
+          {
+            ShiftForward(probe.index, free);
+            SetInfo(probe.index, RobinHood::Fragment(hash) | probe.distance);
+            ++m_Size;
+            return probe.index;
+          }
+        }
+
+        Grow();
+        probe = Locate(hash);
+      }
+    }
+
+    //moves the elements in [from, free) one slot further away from their home, free has to be a free slot
+    void ShiftForward(size_t from, size_t free)
+    {
+      if (free < from)
+      {
+        //the run wraps around, the part at the start moves first to make room for the last slot
+        ShiftForward(0, free);
+        RelocateSlot(m_Slots, m_Slots + m_Capacity - 1);
+        SetInfo(0, m_Info[m_Capacity - 1] + 1);
+        free = m_Capacity - 1;
+      }
+
+      Relocate(m_Slots + from + 1, m_Slots + from, free - from);
+      for (size_t index = free; index > from; --index)
+        m_Info[index] = m_Info[index - 1] + 1;
+      UpdateClones(from + 1, free + 1);
+    }
+
+    //construct(slot) builds the element in the slot PrepareInsert opened, if it throws the run is shifted back so no
+    //full slot is left holding garbage
+    template<typename Construct>
+    void ConstructSlot(size_t index, Construct&& construct)
+    {
+      try
+      {
+        construct(m_Slots + index);
+      }
+      catch (...)
+      {
+        ReleaseIndex(index);
+        throw;
+      }
+    }
+
+    void RemoveIndex(size_t index)
+    {
+      m_Slots[index].~Slot();
+      ReleaseIndex(index);
+    }
+
+    //backward shift deletion, the elements behind index move one slot closer to their home, up to the first free slot
+    //or element that is in its home slot already, what is in the slot itself is not destroyed
+    void ReleaseIndex(size_t index)
+    {
+      --m_Size;
+
+      size_t end = Next(index);
+      while (RobinHood::Distance(m_Info[end]) > 1)
+        end = Next(end);
+
+      if (end <= index)
+      {
+        //the run wraps around, the part up to the last slot moves first and the first slot follows it
+        size_t last = m_Capacity - 1;
+        Relocate(m_Slots + index, m_Slots + index + 1, last - index);
+        for (size_t i = index; i < last; ++i)
+          m_Info[i] = m_Info[i + 1] - 1;
+        UpdateClones(index, last);
+
+        if (end == 0)
+        {
+          SetInfo(last, 0);
+          return;
+        }
+
+        RelocateSlot(m_Slots + last, m_Slots);
+        SetInfo(last, m_Info[0] - 1);
+        index = 0;
+      }
+
+      Relocate(m_Slots + index, m_Slots + index + 1, end - index - 1);
+      for (size_t i = index; i + 1 < end; ++i)
+        m_Info[i] = m_Info[i + 1] - 1;
+      m_Info[end - 1] = 0;
+      UpdateClones(index, end);
+    }
+
+    void Grow()
+    {
+      size_t capacity = m_Capacity + m_Capacity / 2;
+      Resize(capacity > MinCapacity ? capacity : MinCapacity);
+    }
+
+    void Resize(size_t capacity)
+    {
+      Info* old_info = m_Info;
+      Slot* old_slots = m_Slots;
+      size_t old_capacity = m_Capacity;
+
+      m_Capacity = capacity;
+      m_Info = m_InfoAllocator.Allocate(capacity + RobinHood::Width);
+      m_Slots = m_SlotAllocator.Allocate(capacity);
+      MemSet(m_Info, 0, (capacity + RobinHood::Width) * sizeof(Info));
+      m_GrowthLimit = CapacityToGrowth(capacity);
+
+      for (size_t i = 0; i < old_capacity; ++i)
+      {
+        if (old_info[i] == 0)
+          continue;
+
+        uint64 hash = m_Hasher(old_slots[i].first);
+        Probe probe = Locate(hash);
+        size_t free = probe.index;
+        while (m_Info[free] != 0)
+          free = Next(free);
+
+        ShiftForward(probe.index, free);
+        SetInfo(probe.index, RobinHood::Fragment(hash) | probe.distance);
+        RelocateSlot(m_Slots + probe.index, old_slots + i);
+      }
+
+      if (old_capacity)
+      {
+        m_InfoAllocator.Deallocate(old_info);
+        m_SlotAllocator.Deallocate(old_slots);
+      }
+    }
+
+    static void RelocateSlot(Slot* dst, Slot* src)
+    {
+      if constexpr (IsTriviallyRelocatable<Slot>::valid)
+        memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(Slot));
+      else
+      {
+        new (dst) Slot(Move(*src));
+        src->~Slot();
+      }
+    }
+
+    void DestroySlots()
+    {
+      if constexpr (!IsTriviallyDestructible<Slot>::valid)
+      {
+        for (size_t i = 0; i < m_Capacity; ++i)
+          if (m_Info[i] != 0)
+            m_Slots[i].~Slot();
+      }
+    }
+
+    void CopyFrom(const RobinHoodMap& other)
+    {
+      Reserve(other.m_Size);
+      for (const Slot& slot : other)
+      {
+        uint64 hash = m_Hasher(slot.first);
+        size_t index = PrepareInsert(hash, Locate(hash));
+        ConstructSlot(index, [&](Slot* target) { new (target) Slot(slot); });
+      }
+    }
+
+    void Steal(RobinHoodMap& other)
+    {
+      m_Info = other.m_Info;
+      m_Slots = other.m_Slots;
+      m_Capacity = other.m_Capacity;
+      m_Size = other.m_Size;
+      m_GrowthLimit = other.m_GrowthLimit;
+
+      other.m_Info = const_cast<Info*>(RobinHood::EmptyInfo);
+      other.m_Slots = nullptr;
+      other.m_Capacity = other.m_Size = other.m_GrowthLimit = 0;
+    }
+
+    Info* m_Info{ const_cast<Info*>(RobinHood::EmptyInfo) };
+    Slot* m_Slots{ nullptr };
+    size_t m_Capacity{ 0 };
+    size_t m_Size{ 0 };
+    size_t m_GrowthLimit{ 0 };
+
+    [[no_unique_address]] H m_Hasher{};
+    [[no_unique_address]] E m_Equals{};
+    A<Info> m_InfoAllocator{};
+    A<Slot> m_SlotAllocator{};
+  };
+}
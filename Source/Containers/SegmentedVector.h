@@ -0,0 +1,282 @@
+#pragma once
+
+#include "General/Memory.h"
+#include "General/Numeric.h"
+#include "General/Meta.h"
+#include "General/Allocator.h"
+
+#include "General/Exception.h"
+
+#include "Containers/Vector.h"
+
+namespace SSTD
+{
+  //Grows by whole chunks of ChunkSize elements and never moves what is already stored, pointers and references
+  //stay valid until the element is popped or the vector is cleared
+  //indexing goes through the chunk table: chunk = index / ChunkSize, slot = index % ChunkSize
+  template<typename T, size_t ChunkSize = 256, IntegralType SizeType = size_t, template<typename> typename A = Allocator>
+    requires IsNumeric<SizeType>::valid && (ChunkSize > 0) && ((ChunkSize & (ChunkSize - 1)) == 0)
+  class SegmentedVector
+  {
+    static constexpr SizeType ChunkMask = static_cast<SizeType>(ChunkSize - 1);
+    static constexpr SizeType ChunkShift = []()
+      {
+        SizeType shift = 0;
+        while ((static_cast<size_t>(1) << shift) != ChunkSize)
+          ++shift;
+        return shift;
+      }();
+
+  public:
+    using AllocType = A<T>;
+
+    template<typename V, typename U>
+    class SegmentedIterator
+    {
+    public:
+      SegmentedIterator(V* vector, SizeType index) : m_Vector(vector), m_Index(index) {}
+
+      bool operator!=(const SegmentedIterator& other) { return m_Index != other.m_Index; }
+      bool operator==(const SegmentedIterator& other) { return m_Index == other.m_Index; }
+
+      SegmentedIterator& operator++() { ++m_Index; return *this; }
+      SegmentedIterator& operator--() { --m_Index; return *this; }
+      SegmentedIterator operator++(int) { SegmentedIterator i(*this); ++m_Index; return i; }
+      SegmentedIterator operator--(int) { SegmentedIterator i(*this); --m_Index; return i; }
+
+      U& operator*() { return (*m_Vector)[m_Index]; }
+      U* operator->() { return &(*m_Vector)[m_Index]; }
+
+      size_t operator-(const SegmentedIterator& other) { return m_Index - other.m_Index; }
+
+    private:
+      V* m_Vector;
+      SizeType m_Index;
+    };
+
+    using VectorIterator = SegmentedIterator<SegmentedVector, T>;
+    using ConstVectorIterator = SegmentedIterator<const SegmentedVector, const T>;
+
+    SegmentedVector() noexcept {}
+
+    SegmentedVector(const SegmentedVector& other)
+      :m_Allocator(other.m_Allocator)
+    {
+      Append(other);
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+      :m_Allocator(other.m_Allocator), m_Chunks(Move(other.m_Chunks)), m_Size(other.m_Size)
+    {
+      other.m_Size = 0;
+    }
+
+    ~SegmentedVector()
+    {
+      Clear();
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& other)
+    {
+      if (this == &other)
+        return *this;
+
+      Erase();
+      Append(other);
+      return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& other) noexcept
+    {
+      if (this == &other)
+        return *this;
+
+      Clear();
+      m_Chunks = Move(other.m_Chunks);
+      m_Size = other.m_Size;
+      other.m_Size = 0;
+      return *this;
+    }
+
+    T& operator[](const SizeType index) { return m_Chunks[index >> ChunkShift][index & ChunkMask]; }
+    const T& operator[](const SizeType index) const { return m_Chunks[index >> ChunkShift][index & ChunkMask]; }
+
+    T& At(const SizeType index)
+    {
+      if (index >= m_Size)
+        throw Exception();
+
+      return (*this)[index];
+    }
+
+    const T& At(const SizeType index) const
+    {
+      if (index >= m_Size)
+        throw Exception();
+
+      return (*this)[index];
+    }
+
+    //only adds chunks, nothing that is stored moves
+    void Reserve(const SizeType size)
+    {
+      while (Capacity() < size)
+        m_Chunks.PushBack(m_Allocator.Allocate(ChunkSize));
+    }
+
+    //new elements are value initialized
+    void Resize(const SizeType size)
+    {
+      Reserve(size);
+      for (SizeType i = m_Size; i < size; ++i)
+        new (&(*this)[i]) T{};
+      for (SizeType i = size; i < m_Size; ++i)
+        (*this)[i].~T();
+      m_Size = size;
+    }
+
+    //destroys the elements and frees every chunk
+    void Clear()
+    {
+      Erase();
+      for (T* chunk : m_Chunks)
+        m_Allocator.Deallocate(chunk);
+      m_Chunks.Clear();
+    }
+
+    //destroys the elements, the chunks are kept for reuse
+    void Erase()
+    {
+      ApplyChunks([](T* data, SizeType size)
+        {
+          for (SizeType i = 0; i < size; ++i)
+            data[i].~T();
+        });
+      m_Size = 0;
+    }
+
+    //frees the chunks behind the last element
+    void Minimize()
+    {
+      SizeType used = (m_Size + ChunkMask) >> ChunkShift;
+      while (m_Chunks.Size() > used)
+      {
+        m_Allocator.Deallocate(m_Chunks.Back());
+        m_Chunks.PopBack();
+      }
+    }
+
+    void PushBack(const T& value)
+    {
+      EmplaceBack(value);
+    }
+
+    void PushBack(T&& value)
+    {
+      EmplaceBack(Forward<T>(value));
+    }
+
+    template<typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+      if (m_Size == Capacity())
+        m_Chunks.PushBack(m_Allocator.Allocate(ChunkSize));
+
+      T* slot = &(*this)[m_Size];
+      m_Allocator.Construct(slot, T{ Forward<Args>(args)... });
+      ++m_Size;
+      return *slot;
+    }
+
+    void PopBack()
+    {
+      (*this)[--m_Size].~T();
+    }
+
+    //copies chunk by chunk
+    void Append(const T* data, SizeType size)
+    {
+      Reserve(m_Size + size);
+      while (size > 0)
+      {
+        SizeType slot = m_Size & ChunkMask;
+        SizeType count = ChunkSize - slot < size ? ChunkSize - slot : size;
+        TMemCpy<T>(m_Chunks[m_Size >> ChunkShift] + slot, data, count);
+        m_Size += count;
+        data += count;
+        size -= count;
+      }
+    }
+
+    void Append(const SegmentedVector& other)
+    {
+      other.ApplyChunks([this](const T* data, SizeType size) { Append(data, size); });
+    }
+
+    //calls function(data, count) once per chunk that holds elements, count is ChunkSize for all but the last one
+    template<typename F>
+    void ApplyChunks(const F& function)
+    {
+      SizeType remaining = m_Size;
+      for (SizeType i = 0; remaining > 0; ++i)
+      {
+        SizeType count = remaining < ChunkSize ? remaining : ChunkSize;
+        function(m_Chunks[i], count);
+        remaining -= count;
+      }
+    }
+
+    template<typename F>
+    void ApplyChunks(const F& function) const
+    {
+      SizeType remaining = m_Size;
+      for (SizeType i = 0; remaining > 0; ++i)
+      {
+        SizeType count = remaining < ChunkSize ? remaining : ChunkSize;
+        function(static_cast<const T*>(m_Chunks[i]), count);
+        remaining -= count;
+      }
+    }
+
+    template<typename F>
+    void Apply(const F& function)
+    {
+      ApplyChunks([&function](T* data, SizeType size)
+        {
+          for (SizeType i = 0; i < size; ++i)
+            function(data[i]);
+        });
+    }
+
+    bool CheckIndex(const SizeType index) { return index < m_Size; }
+
+    SizeType Size() const { return m_Size; }
+
+    SizeType Capacity() const { return static_cast<SizeType>(m_Chunks.Size()) << ChunkShift; }
+
+    SizeType ChunkCount() const { return static_cast<SizeType>(m_Chunks.Size()); }
+
+    bool IsEmpty() const { return m_Size == 0; }
+
+    T& Front() { return (*this)[0]; }
+
+    const T& Front() const { return (*this)[0]; }
+
+    T& Back() { return (*this)[m_Size - 1]; }
+
+    const T& Back() const { return (*this)[m_Size - 1]; }
+
+    VectorIterator begin() { return VectorIterator(this, 0); }
+
+    VectorIterator end() { return VectorIterator(this, m_Size); }
+
+    ConstVectorIterator begin() const { return ConstVectorIterator(this, 0); }
+
+    ConstVectorIterator end() const { return ConstVectorIterator(this, m_Size); }
+
+  private:
+    AllocType m_Allocator{};
+    Vector<T*, SizeType> m_Chunks{};
+    SizeType m_Size{ 0 };
+  };
+}
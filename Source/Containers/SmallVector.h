@@ -0,0 +1,345 @@
+#pragma once
+
+#include "General/Memory.h"
+#include "General/Numeric.h"
+#include "General/Iterator.h"
+#include "General/Meta.h"
+#include "General/Allocator.h"
+
+#include "General/Exception.h"
+
+namespace SSTD
+{
+  //Vector with room for N elements inside the object, only spills to the heap (through A) when that is full
+  //moving a SmallVector that is still inline moves the elements, the buffer can not be stolen
+  template<typename T, size_t N, IntegralType SizeType = size_t, template<typename> typename A = Allocator>
+    requires IsNumeric<SizeType>::valid && (N > 0)
+  class SmallVector
+  {
+  public:
+    using VectorIterator = Iterator<T>;
+    using ConstVectorIterator = ConstIterator<T>;
+    using AllocType = A<T>;
+
+    static constexpr SizeType InlineCapacity = static_cast<SizeType>(N);
+
+    //what IndexOf returns when the value isn't there, the same as Vector::NotFound
+    static constexpr SizeType NotFound = ~static_cast<SizeType>(0);
+
+    SmallVector() noexcept {}
+
+    explicit SmallVector(SizeType size)
+    {
+      Reserve(size);
+    }
+
+    SmallVector(const T& value, SizeType size)
+    {
+      Reserve(size);
+      for (SizeType i = 0; i < size; ++i)
+        m_Allocator.Construct(m_Buffer + i, T{ value });
+      m_Size = size;
+    }
+
+    SmallVector(const T* value, SizeType size)
+    {
+      Append(value, size);
+    }
+
+    SmallVector(const SmallVector& other)
+      :m_Allocator(other.m_Allocator)
+    {
+      Append(other.m_Buffer, other.m_Size);
+    }
+
+    SmallVector(SmallVector&& other) noexcept
+      :m_Allocator(other.m_Allocator)
+    {
+      Steal(other);
+    }
+
+    ~SmallVector()
+    {
+      Clear();
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+      if (this == &other)
+        return *this;
+
+      Erase();
+      Append(other.m_Buffer, other.m_Size);
+      return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept
+    {
+      if (this == &other)
+        return *this;
+
+      Clear();
+      Steal(other);
+      return *this;
+    }
+
+    T& operator[](const SizeType index) { return m_Buffer[index]; }
+    const T& operator[](const SizeType index) const { return m_Buffer[index]; }
+
+    //new elements are value initialized
+    void Resize(const SizeType size)
+    {
+      Reserve(size);
+      for (SizeType i = m_Size; i < size; ++i)
+        new (m_Buffer + i) T{};
+      for (SizeType i = size; i < m_Size; ++i)
+        m_Buffer[i].~T();
+      m_Size = size;
+    }
+
+    void Reserve(const SizeType size)
+    {
+      if (size <= m_Capacity)
+        return;
+
+      T* tmp = m_Allocator.Allocate(size);
+      Relocate(tmp, m_Buffer, m_Size);
+      ReleaseHeap();
+      m_Buffer = tmp;
+      m_Capacity = size;
+    }
+
+    //destroys the elements and gives the heap buffer back, the vector is inline again afterwards
+    void Clear()
+    {
+      Erase();
+      ReleaseHeap();
+      m_Buffer = InlineBuffer();
+      m_Capacity = InlineCapacity;
+    }
+
+    void Erase()
+    {
+      for (SizeType i = 0; i < m_Size; ++i)
+        m_Buffer[i].~T();
+      m_Size = 0;
+    }
+
+    //moves the elements back inline if they fit, otherwise shrinks the heap buffer to the size
+    void Minimize()
+    {
+      if (IsInline() || m_Size == m_Capacity)
+        return;
+
+      T* tmp = m_Size <= InlineCapacity ? InlineBuffer() : m_Allocator.Allocate(m_Size);
+      Relocate(tmp, m_Buffer, m_Size);
+      ReleaseHeap();
+      m_Buffer = tmp;
+      m_Capacity = m_Size <= InlineCapacity ? InlineCapacity : m_Size;
+    }
+
+    void PushBack(const T& value)
+    {
+      EmplaceBack(value);
+    }
+
+    void PushBack(T&& value)
+    {
+      EmplaceBack(Forward<T>(value));
+    }
+
+    void PushBackUnique(const T& value)
+    {
+      if (!Contains(value))
+        PushBack(value);
+    }
+
+    void PushBackUnique(T&& value)
+    {
+      if (!Contains(value))
+        PushBack(Move(value));
+    }
+
+    template<typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+      if (m_Size == m_Capacity)
+      {
+        //built before growing, args may point into this vector
+        T value{ Forward<Args>(args)... };
+        Reserve(m_Capacity * 2);
+        new (m_Buffer + m_Size) T(Move(value));
+      }
+      else
+        m_Allocator.Construct(m_Buffer + m_Size, T{ Forward<Args>(args)... });
+
+      return m_Buffer[m_Size++];
+    }
+
+    void PopBack()
+    {
+      m_Buffer[--m_Size].~T();
+    }
+
+    void Insert(const SizeType index, const T& value)
+    {
+      EmplaceAt(index, value);
+    }
+
+    void Insert(const SizeType index, T&& value)
+    {
+      EmplaceAt(index, Move(value));
+    }
+
+    //the elements from index on are shifted up by one
+    template<typename... Args>
+    T& EmplaceAt(const SizeType index, Args&&... args)
+    {
+      T value{ Forward<Args>(args)... };
+
+      if (m_Size == m_Capacity)
+        Reserve(m_Capacity * 2);
+      Relocate(m_Buffer + index + 1, m_Buffer + index, m_Size - index);
+      new (m_Buffer + index) T(Move(value));
+      ++m_Size;
+      return m_Buffer[index];
+    }
+
+    void Append(const T* data, SizeType size)
+    {
+      if (m_Size + size > m_Capacity)
+        Reserve(m_Size + size > m_Capacity * 2 ? m_Size + size : m_Capacity * 2);
+      TMemCpy<T>(m_Buffer + m_Size, data, size);
+      m_Size += size;
+    }
+
+    void Append(const SmallVector& other)
+    {
+      Append(other.m_Buffer, other.m_Size);
+    }
+
+    T RemoveAt(const SizeType index)
+    {
+      T tmp = Move(m_Buffer[index]);
+      m_Buffer[index].~T();
+      Relocate(m_Buffer + index, m_Buffer + index + 1, m_Size - index - 1); //shift the elements
+      --m_Size;
+      return tmp;
+    }
+
+    //removes count elements starting at index, the ones behind are shifted down
+    void RemoveRange(const SizeType index, const SizeType count)
+    {
+      for (SizeType i = index; i < index + count; ++i)
+        m_Buffer[i].~T();
+      Relocate(m_Buffer + index, m_Buffer + index + count, m_Size - index - count);
+      m_Size -= count;
+    }
+
+    SizeType IndexOf(const T& value) const
+    {
+      for (SizeType i = 0; i < m_Size; i++)
+        if (value == m_Buffer[i])
+          return i;
+      return NotFound;
+    }
+
+    T& At(const SizeType index)
+    {
+      if (index >= m_Size)
+        throw Exception();
+
+      return m_Buffer[index];
+    }
+
+    const T& At(const SizeType index) const
+    {
+      if (index >= m_Size)
+        throw Exception();
+
+      return m_Buffer[index];
+    }
+
+    bool Contains(const T& value)
+    {
+      for (SizeType i = 0; i < m_Size; i++)
+        if (m_Buffer[i] == value)
+          return true;
+      return false;
+    }
+
+    bool CheckIndex(const SizeType index) { return index < m_Size; }
+
+    T* Data() { return m_Buffer; }
+
+    const T* Data() const { return m_Buffer; }
+
+    SizeType Size() const { return m_Size; }
+
+    SizeType Capacity() const { return m_Capacity; }
+
+    bool IsEmpty() const { return m_Size == 0; }
+
+    //true as long as nothing spilled to the heap
+    bool IsInline() const { return m_Buffer == InlineBuffer(); }
+
+    template<typename F>
+    void Apply(const F& function)
+    {
+      for (SizeType i = 0; i < m_Size; i++)
+        function(m_Buffer[i]);
+    }
+
+    T& Front() { return m_Buffer[0]; }
+
+    const T& Front() const { return m_Buffer[0]; }
+
+    T& Back() { return m_Buffer[m_Size - 1]; }
+
+    const T& Back() const { return m_Buffer[m_Size - 1]; }
+
+    VectorIterator begin() { return VectorIterator(m_Buffer); }
+
+    VectorIterator end() { return VectorIterator(m_Buffer + m_Size); }
+
+    ConstVectorIterator begin() const { return ConstVectorIterator(m_Buffer); }
+
+    ConstVectorIterator end() const { return ConstVectorIterator(m_Buffer + m_Size); }
+  private:
+    T* InlineBuffer() { return reinterpret_cast<T*>(m_Inline); }
+
+    const T* InlineBuffer() const { return reinterpret_cast<const T*>(m_Inline); }
+
+    void ReleaseHeap()
+    {
+      if (!IsInline())
+        m_Allocator.Deallocate(m_Buffer);
+    }
+
+    //expects this to be empty and inline
+    void Steal(SmallVector& other)
+    {
+      if (other.IsInline())
+      {
+        Relocate(InlineBuffer(), other.m_Buffer, other.m_Size);
+        m_Size = other.m_Size;
+        other.m_Size = 0;
+        return;
+      }
+
+      m_Buffer = other.m_Buffer;
+      m_Size = other.m_Size;
+      m_Capacity = other.m_Capacity;
+      other.m_Buffer = other.InlineBuffer();
+      other.m_Size = 0;
+      other.m_Capacity = InlineCapacity;
+    }
+
+  private:
+    AllocType m_Allocator{};
+    SizeType m_Size{ 0 };
+    SizeType m_Capacity{ InlineCapacity };
+    alignas(T) uint8 m_Inline[N * sizeof(T)];
+    T* m_Buffer{ InlineBuffer() };
+  };
+}
@@ -0,0 +1,330 @@
+#pragma once
+
+#include "General/Memory.h"
+#include "General/Numeric.h"
+#include "General/Meta.h"
+#include "General/Utility.h"
+#include "General/AlignedAllocator.h"
+
+#include "Containers/Span.h"
+
+namespace SSTD
+{
+  //Structure of arrays, every field gets its own contiguous column
+  //all columns live in one block and each one starts at a multiple of ColumnAlignment, so kernels that only touch
+  //a few fields stream just those and can use aligned SIMD loads
+  //rows are reached through Row (a proxy holding the index), columns through Column<I>() or ApplyColumns
+  template<typename... Fields>
+    requires (sizeof...(Fields) > 0)
+  class SoAVector
+  {
+  public:
+    static constexpr size_t FieldCount = sizeof...(Fields);
+    static constexpr size_t ColumnAlignment = 64;
+
+    template<size_t Index>
+    using FieldType = TypeAt<Index, Fields...>;
+
+    template<typename V>
+    class RowProxy
+    {
+    public:
+      RowProxy(V* vector, size_t index) : m_Vector(vector), m_Index(index) {}
+
+      template<size_t Index>
+      auto& Get() const { return m_Vector->template Data<Index>()[m_Index]; }
+
+      size_t Index() const { return m_Index; }
+
+    private:
+      V* m_Vector;
+      size_t m_Index;
+    };
+
+    using Row = RowProxy<SoAVector>;
+    using ConstRow = RowProxy<const SoAVector>;
+
+    SoAVector() noexcept {}
+
+    explicit SoAVector(size_t capacity)
+    {
+      Reserve(capacity);
+    }
+
+    SoAVector(const SoAVector& other)
+    {
+      Append(other);
+    }
+
+    SoAVector(SoAVector&& other) noexcept
+      :m_Size(other.m_Size), m_Capacity(other.m_Capacity), m_Block(other.m_Block)
+    {
+      for (size_t i = 0; i < FieldCount; ++i)
+        m_Columns[i] = other.m_Columns[i];
+
+      other.m_Size = other.m_Capacity = 0;
+      other.m_Block = nullptr;
+    }
+
+    ~SoAVector()
+    {
+      Clear();
+    }
+
+    SoAVector& operator=(const SoAVector& other)
+    {
+      if (this == &other)
+        return *this;
+
+      Erase();
+      Append(other);
+      return *this;
+    }
+
+    SoAVector& operator=(SoAVector&& other) noexcept
+    {
+      if (this == &other)
+        return *this;
+
+      Clear();
+      Swap(m_Size, other.m_Size);
+      Swap(m_Capacity, other.m_Capacity);
+      Swap(m_Block, other.m_Block);
+      for (size_t i = 0; i < FieldCount; ++i)
+        Swap(m_Columns[i], other.m_Columns[i]);
+      return *this;
+    }
+
+    Row operator[](const size_t index) { return Row(this, index); }
+    ConstRow operator[](const size_t index) const { return ConstRow(this, index); }
+
+    //one value per field, in field order
+    template<typename... Args>
+      requires (sizeof...(Args) == FieldCount)
+    Row EmplaceBack(Args&&... args)
+    {
+      auto construct = [&](void* const* columns)
+        {
+          ForEachField([&]<size_t... Index>(IndexSequence<Index...>)
+          {
+            (new (static_cast<FieldType<Index>*>(columns[Index]) + m_Size) FieldType<Index>(Forward<Args>(args)), ...);
+          });
+        };
+
+      //args may point into this vector, the new row is built in the new block before the old one is freed
+      if (m_Size == m_Capacity)
+        Reallocate(m_Capacity * 2 > m_Size ? m_Capacity * 2 : m_Size + 1, construct);
+      else
+        construct(m_Columns);
+      return Row(this, m_Size++);
+    }
+
+    void PopBack()
+    {
+      --m_Size;
+      ForEachField([&]<size_t... Index>(IndexSequence<Index...>)
+      {
+        (Data<Index>()[m_Size].~FieldType<Index>(), ...);
+      });
+    }
+
+    //copies size rows given as one array per field
+    void Append(const Fields*... columns, size_t size)
+    {
+      TryReserve(m_Size + size);
+      AppendColumns(MakeIndexSequence<FieldCount>{}, size, columns...);
+      m_Size += size;
+    }
+
+    void Append(const SoAVector& other)
+    {
+      TryReserve(m_Size + other.m_Size);
+      ForEachField([&]<size_t... Index>(IndexSequence<Index...>)
+      {
+        (TMemCpy<FieldType<Index>>(Data<Index>() + m_Size, other.template Data<Index>(), other.m_Size), ...);
+      });
+      m_Size += other.m_Size;
+    }
+
+    //the rows behind index are shifted down, order is kept
+    void RemoveAt(const size_t index)
+    {
+      ForEachField([&]<size_t... Index>(IndexSequence<Index...>)
+      {
+        ((Data<Index>()[index].~FieldType<Index>(),
+          Relocate(Data<Index>() + index, Data<Index>() + index + 1, m_Size - index - 1)), ...);
+      });
+      --m_Size;
+    }
+
+    //new rows are value initialized
+    void Resize(const size_t size)
+    {
+      Reserve(size);
+      ForEachField([&]<size_t... Index>(IndexSequence<Index...>)
+      {
+        (ResizeColumn<Index>(size), ...);
+      });
+      m_Size = size;
+    }
+
+    void Reserve(const size_t capacity)
+    {
+      if (capacity <= m_Capacity)
+        return;
+
+      Reallocate(capacity, [](void* const*) {});
+    }
+
+    void Erase()
+    {
+      ForEachField([&]<size_t... Index>(IndexSequence<Index...>)
+      {
+        (DestroyColumn<Index>(), ...);
+      });
+      m_Size = 0;
+    }
+
+    void Clear()
+    {
+      Erase();
+      if (m_Block)
+        m_Allocator.Deallocate(m_Block);
+      m_Block = nullptr;
+      m_Capacity = 0;
+      for (size_t i = 0; i < FieldCount; ++i)
+        m_Columns[i] = nullptr;
+    }
+
+    template<size_t Index>
+    FieldType<Index>* Data() { return static_cast<FieldType<Index>*>(m_Columns[Index]); }
+
+    template<size_t Index>
+    const FieldType<Index>* Data() const { return static_cast<const FieldType<Index>*>(m_Columns[Index]); }
+
+    template<size_t Index>
+    Span<FieldType<Index>> Column() { return Span<FieldType<Index>>(Data<Index>(), m_Size); }
+
+    template<size_t Index>
+    Span<const FieldType<Index>> Column() const { return Span<const FieldType<Index>>(Data<Index>(), m_Size); }
+
+    //calls function(Data<Columns>()..., Size()), the pointers are ColumnAlignment aligned
+    template<size_t... Columns, typename F>
+    void ApplyColumns(const F& function)
+    {
+      function(Data<Columns>()..., m_Size);
+    }
+
+    template<size_t... Columns, typename F>
+    void ApplyColumns(const F& function) const
+    {
+      function(Data<Columns>()..., m_Size);
+    }
+
+    Row Front() { return Row(this, 0); }
+
+    ConstRow Front() const { return ConstRow(this, 0); }
+
+    Row Back() { return Row(this, m_Size - 1); }
+
+    ConstRow Back() const { return ConstRow(this, m_Size - 1); }
+
+    size_t Size() const { return m_Size; }
+
+    size_t Capacity() const { return m_Capacity; }
+
+    bool IsEmpty() const { return m_Size == 0; }
+
+  private:
+    template<typename F>
+    static void ForEachField(const F& function)
+    {
+      function(MakeIndexSequence<FieldCount>{});
+    }
+
+    template<size_t... Index>
+    void AppendColumns(IndexSequence<Index...>, size_t size, const Fields*... columns)
+    {
+      (TMemCpy<FieldType<Index>>(Data<Index>() + m_Size, columns, size), ...);
+    }
+
+    template<size_t Index>
+    void ResizeColumn(const size_t size)
+    {
+      for (size_t i = m_Size; i < size; ++i)
+        new (Data<Index>() + i) FieldType<Index>{};
+      for (size_t i = size; i < m_Size; ++i)
+        Data<Index>()[i].~FieldType<Index>();
+    }
+
+    template<size_t Index>
+    void DestroyColumn()
+    {
+      for (size_t i = 0; i < m_Size; ++i)
+        Data<Index>()[i].~FieldType<Index>();
+    }
+
+    //capacities are mostly powers of two, without the extra line every column would start at the same cache set
+    //and a kernel streaming several columns keeps evicting its own lines
+    static constexpr size_t AlignColumn(size_t bytes)
+    {
+      return ((bytes + ColumnAlignment - 1) & ~(ColumnAlignment - 1)) + ColumnAlignment;
+    }
+
+    static size_t BlockSize(size_t capacity)
+    {
+      return (AlignColumn(capacity * sizeof(Fields)) + ...);
+    }
+
+    static void Layout(uint8* block, size_t capacity, void** columns)
+    {
+      size_t i = 0;
+      ((columns[i++] = block, block += AlignColumn(capacity * sizeof(Fields))), ...);
+    }
+
+    void TryReserve(const size_t size)
+    {
+      if (size > m_Capacity)
+        Reserve(size > m_Capacity * 2 ? size : m_Capacity * 2);
+    }
+
+  private:
+    //construct(columns) fills the new block before the old rows are relocated and the old block is freed
+    template<typename Construct>
+    void Reallocate(const size_t capacity, Construct&& construct)
+    {
+      uint8* block = m_Allocator.Allocate(BlockSize(capacity));
+      void* columns[FieldCount];
+      Layout(block, capacity, columns);
+
+      try
+      {
+        construct(columns);
+      }
+      catch (...)
+      {
+        m_Allocator.Deallocate(block);
+        throw;
+      }
+
+      ForEachField([&]<size_t... Index>(IndexSequence<Index...>)
+      {
+        (Relocate(static_cast<FieldType<Index>*>(columns[Index]), Data<Index>(), m_Size), ...);
+      });
+
+      if (m_Block)
+        m_Allocator.Deallocate(m_Block);
+
+      m_Block = block;
+      for (size_t i = 0; i < FieldCount; ++i)
+        m_Columns[i] = columns[i];
+      m_Capacity = capacity;
+    }
+
+    AlignedAllocator<uint8, ColumnAlignment> m_Allocator{};
+    size_t m_Size{ 0 };
+    size_t m_Capacity{ 0 };
+    uint8* m_Block{ nullptr };
+    void* m_Columns[FieldCount]{};
+  };
+}
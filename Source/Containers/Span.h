@@ -0,0 +1,36 @@
+#pragma once
+
+#include "General/Numeric.h"
+#include "General/Iterator.h"
+
+namespace SSTD
+{
+  //Non owning view of size contiguous elements
+  template<typename T>
+  class Span
+  {
+  public:
+    using SpanIterator = Iterator<T>;
+
+    constexpr Span() noexcept {}
+    constexpr Span(T* data, size_t size) noexcept : m_Data(data), m_Size(size) {}
+
+    constexpr T& operator[](const size_t index) const { return m_Data[index]; }
+
+    constexpr T* Data() const { return m_Data; }
+
+    constexpr size_t Size() const { return m_Size; }
+
+    constexpr bool IsEmpty() const { return m_Size == 0; }
+
+    constexpr Span SubSpan(const size_t offset, const size_t size) const { return Span(m_Data + offset, size); }
+
+    SpanIterator begin() const { return SpanIterator(m_Data); }
+
+    SpanIterator end() const { return SpanIterator(m_Data + m_Size); }
+
+  private:
+    T* m_Data{ nullptr };
+    size_t m_Size{ 0 };
+  };
+}
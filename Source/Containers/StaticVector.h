@@ -0,0 +1,342 @@
+#pragma once
+
+#include "General/Memory.h"
+#include "General/Numeric.h"
+#include "General/Iterator.h"
+#include "General/Meta.h"
+#include "General/Utility.h"
+
+#include "General/Exception.h"
+
+namespace SSTD
+{
+  //Vector with a fixed capacity that lives entirely inside the object and never allocates
+  //going over the capacity throws, TryEmplaceBack returns nullptr instead
+  //usable in constant expressions for trivially copyable T
+  template<typename T, size_t StaticCapacity, IntegralType SizeType = size_t>
+    requires IsNumeric<SizeType>::valid && (StaticCapacity > 0)
+  class StaticVector
+  {
+  public:
+    using VectorIterator = Iterator<T>;
+    using ConstVectorIterator = ConstIterator<T>;
+
+    //what IndexOf returns when the value isn't there, the same as Vector::NotFound
+    static constexpr SizeType NotFound = ~static_cast<SizeType>(0);
+
+    constexpr StaticVector() noexcept {}
+
+    constexpr StaticVector(const T& value, SizeType size)
+    {
+      CheckCapacity(size);
+      for (SizeType i = 0; i < size; ++i)
+        ConstructAt(i, value);
+      m_Size = size;
+    }
+
+    constexpr StaticVector(const T* value, SizeType size)
+    {
+      Append(value, size);
+    }
+
+    constexpr StaticVector(const StaticVector& other)
+    {
+      Append(other.Data(), other.m_Size);
+    }
+
+    constexpr StaticVector(StaticVector&& other) noexcept
+    {
+      for (SizeType i = 0; i < other.m_Size; ++i)
+        ConstructAt(i, Move(other.m_Storage.data[i]));
+      m_Size = other.m_Size;
+      other.Erase();
+    }
+
+    constexpr ~StaticVector()
+    {
+      Erase();
+    }
+
+    constexpr StaticVector& operator=(const StaticVector& other)
+    {
+      if (this == &other)
+        return *this;
+
+      Erase();
+      Append(other.Data(), other.m_Size);
+      return *this;
+    }
+
+    constexpr StaticVector& operator=(StaticVector&& other) noexcept
+    {
+      if (this == &other)
+        return *this;
+
+      Erase();
+      for (SizeType i = 0; i < other.m_Size; ++i)
+        ConstructAt(i, Move(other.m_Storage.data[i]));
+      m_Size = other.m_Size;
+      other.Erase();
+      return *this;
+    }
+
+    constexpr T& operator[](const SizeType index) { return m_Storage.data[index]; }
+    constexpr const T& operator[](const SizeType index) const { return m_Storage.data[index]; }
+
+    //new elements are value initialized
+    constexpr void Resize(const SizeType size)
+    {
+      CheckCapacity(size);
+      for (SizeType i = m_Size; i < size; ++i)
+        ConstructAt(i);
+      for (SizeType i = size; i < m_Size; ++i)
+        DestroyAt(i);
+      m_Size = size;
+    }
+
+    //only checks, the storage is always there
+    constexpr void Reserve(const SizeType size)
+    {
+      CheckCapacity(size);
+    }
+
+    constexpr void Clear()
+    {
+      Erase();
+    }
+
+    constexpr void Erase()
+    {
+      for (SizeType i = 0; i < m_Size; ++i)
+        DestroyAt(i);
+      m_Size = 0;
+    }
+
+    constexpr void PushBack(const T& value)
+    {
+      EmplaceBack(value);
+    }
+
+    constexpr void PushBack(T&& value)
+    {
+      EmplaceBack(Forward<T>(value));
+    }
+
+    constexpr void PushBackUnique(const T& value)
+    {
+      if (!Contains(value))
+        PushBack(value);
+    }
+
+    constexpr void PushBackUnique(T&& value)
+    {
+      if (!Contains(value))
+        PushBack(Move(value));
+    }
+
+    template<typename... Args>
+    constexpr T& EmplaceBack(Args&&... args)
+    {
+      CheckCapacity(m_Size + 1);
+      ConstructAt(m_Size, Forward<Args>(args)...);
+      return m_Storage.data[m_Size++];
+    }
+
+    //for callers that would rather drop an element than throw when full
+    template<typename... Args>
+    constexpr T* TryEmplaceBack(Args&&... args)
+    {
+      if (IsFull())
+        return nullptr;
+      ConstructAt(m_Size, Forward<Args>(args)...);
+      return &m_Storage.data[m_Size++];
+    }
+
+    constexpr void PopBack()
+    {
+      DestroyAt(--m_Size);
+    }
+
+    constexpr void Insert(const SizeType index, const T& value)
+    {
+      EmplaceAt(index, value);
+    }
+
+    constexpr void Insert(const SizeType index, T&& value)
+    {
+      EmplaceAt(index, Move(value));
+    }
+
+    //the elements from index on are shifted up by one
+    template<typename... Args>
+    constexpr T& EmplaceAt(const SizeType index, Args&&... args)
+    {
+      CheckCapacity(m_Size + 1);
+      T value{ Forward<Args>(args)... };
+
+      Shift(index + 1, index, m_Size - index);
+      ConstructAt(index, Move(value));
+      ++m_Size;
+      return m_Storage.data[index];
+    }
+
+    constexpr void Append(const T* data, SizeType size)
+    {
+      CheckCapacity(m_Size + size);
+      for (SizeType i = 0; i < size; ++i)
+        ConstructAt(m_Size + i, data[i]);
+      m_Size += size;
+    }
+
+    constexpr void Append(const StaticVector& other)
+    {
+      Append(other.Data(), other.m_Size);
+    }
+
+    constexpr T RemoveAt(const SizeType index)
+    {
+      T tmp = Move(m_Storage.data[index]);
+      DestroyAt(index);
+      Shift(index, index + 1, m_Size - index - 1); //shift the elements
+      --m_Size;
+      return tmp;
+    }
+
+    //removes count elements starting at index, the ones behind are shifted down
+    constexpr void RemoveRange(const SizeType index, const SizeType count)
+    {
+      for (SizeType i = index; i < index + count; ++i)
+        DestroyAt(i);
+      Shift(index, index + count, m_Size - index - count);
+      m_Size -= count;
+    }
+
+    constexpr SizeType IndexOf(const T& value) const
+    {
+      for (SizeType i = 0; i < m_Size; i++)
+        if (value == m_Storage.data[i])
+          return i;
+      return NotFound;
+    }
+
+    constexpr T& At(const SizeType index)
+    {
+      if (index >= m_Size)
+        throw Exception();
+
+      return m_Storage.data[index];
+    }
+
+    constexpr const T& At(const SizeType index) const
+    {
+      if (index >= m_Size)
+        throw Exception();
+
+      return m_Storage.data[index];
+    }
+
+    constexpr bool Contains(const T& value) const
+    {
+      for (SizeType i = 0; i < m_Size; i++)
+        if (m_Storage.data[i] == value)
+          return true;
+      return false;
+    }
+
+    constexpr bool CheckIndex(const SizeType index) const { return index < m_Size; }
+
+    constexpr T* Data() { return m_Storage.data; }
+
+    constexpr const T* Data() const { return m_Storage.data; }
+
+    constexpr SizeType Size() const { return m_Size; }
+
+    static constexpr SizeType Capacity() { return static_cast<SizeType>(StaticCapacity); }
+
+    constexpr bool IsEmpty() const { return m_Size == 0; }
+
+    constexpr bool IsFull() const { return m_Size == Capacity(); }
+
+    template<typename F>
+    constexpr void Apply(const F& function)
+    {
+      for (SizeType i = 0; i < m_Size; i++)
+        function(m_Storage.data[i]);
+    }
+
+    constexpr T& Front() { return m_Storage.data[0]; }
+
+    constexpr const T& Front() const { return m_Storage.data[0]; }
+
+    constexpr T& Back() { return m_Storage.data[m_Size - 1]; }
+
+    constexpr const T& Back() const { return m_Storage.data[m_Size - 1]; }
+
+    VectorIterator begin() { return VectorIterator(m_Storage.data); }
+
+    VectorIterator end() { return VectorIterator(m_Storage.data + m_Size); }
+
+    ConstVectorIterator begin() const { return ConstVectorIterator(const_cast<T*>(m_Storage.data)); }
+
+    ConstVectorIterator end() const { return ConstVectorIterator(const_cast<T*>(m_Storage.data) + m_Size); }
+  private:
+    constexpr void CheckCapacity(const SizeType size) const
+    {
+      if (size > Capacity())
+        throw Exception();
+    }
+
+    //placement new is not allowed in constant expressions, assigning to the union member starts the lifetime there
+    template<typename... Args>
+    constexpr void ConstructAt(const SizeType index, Args&&... args)
+    {
+      if (IsConstantEvaluated())
+        m_Storage.data[index] = T{ Forward<Args>(args)... };
+      else
+        new (m_Storage.data + index) T{ Forward<Args>(args)... };
+    }
+
+    constexpr void DestroyAt(const SizeType index)
+    {
+      if constexpr (!IsTriviallyDestructible<T>::valid)
+        m_Storage.data[index].~T();
+    }
+
+    //moves size elements from src to the free slots at dst
+    constexpr void Shift(const SizeType dst, const SizeType src, const SizeType size)
+    {
+      if (!IsConstantEvaluated())
+      {
+        Relocate(m_Storage.data + dst, m_Storage.data + src, size);
+        return;
+      }
+
+      if (dst < src)
+        for (SizeType i = 0; i < size; ++i)
+          m_Storage.data[dst + i] = m_Storage.data[src + i];
+      else
+        for (SizeType i = size; i > 0; --i)
+          m_Storage.data[dst + i - 1] = m_Storage.data[src + i - 1];
+    }
+
+    //the union keeps the elements from being constructed with the vector
+    union Storage
+    {
+      constexpr Storage() : empty() {}
+      constexpr ~Storage() {}
+
+      uint8 empty;
+      T data[StaticCapacity];
+    };
+
+  private:
+    SizeType m_Size{ 0 };
+    Storage m_Storage{};
+  };
+
+  template<typename T, size_t StaticCapacity, IntegralType SizeType>
+  struct IsTriviallyRelocatable<StaticVector<T, StaticCapacity, SizeType>>
+  {
+    static constexpr bool valid = IsTriviallyRelocatable<T>::valid;
+  };
+}
@@ -3,6 +3,7 @@
 #include "General/Allocator.h"
 #include "General/Meta.h"
 #include "General/Memory.h"
+#include "General/Hash.h"
 
 #include "General/Exception.h"
 
@@ -18,7 +19,7 @@ namespace SSTD
 
     TString(SizeType capacity) : m_Allocator()
     {
-      if (capacity > SSOSize)
+      if (capacity >= SSOSize)
       {
         m_Data.long_string.capacity = capacity;
         m_Data.long_string.msb_capacity = Bit::MSB(capacity);
@@ -35,13 +36,14 @@ namespace SSTD
     {
       if (str)
       {
-        if (size > SSOSize)
+        if (size >= SSOSize)
         {
-          size = Grow(size);
-          m_Data.long_string.size = m_Data.long_string.capacity = size;
+          SizeType capacity = Grow(size);
+          m_Data.long_string.size = size;
+          m_Data.long_string.capacity = capacity;
           m_Data.long_string.msb_capacity = Bit::MSB(m_Data.long_string.capacity);
           m_Data.long_string.msb_size = ~m_Data.long_string.msb_capacity;
-          m_Data.long_string.buffer = m_Allocator.Allocate(size);
+          m_Data.long_string.buffer = m_Allocator.Allocate(capacity);
           TMemCpy<CharType>(m_Data.long_string.buffer, str, size);
         }
         else
@@ -89,13 +91,49 @@ namespace SSTD
       Clear();
     }
 
-    bool operator==(const TString& other)
+    bool operator==(const TString& other) const
+    {
+      SizeType size = Size();
+      return size == other.Size() && MemCompare(CStr(), other.CStr(), size * sizeof(CharType)) == 0;
+    }
+    bool operator!=(const TString& other) const
+    {
+      return !(*this == other);
+    }
+
+    bool operator==(const CharType* other) const
     {
-      return false;
+      SizeType size = Size();
+      return size == HashFunctions::StringLength(other) && MemCompare(CStr(), other, size * sizeof(CharType)) == 0;
     }
-    bool operator!=(const TString& other)
+    bool operator!=(const CharType* other) const
     {
-      return false;
+      return !(*this == other);
+    }
+
+    //<0, 0 or >0, ordered by the code unit bytes and then by length, enough for sorted containers
+    int32 Compare(const CharType* other, SizeType otherSize) const
+    {
+      SizeType size = Size();
+      int32 result = MemCompare(CStr(), other, (size < otherSize ? size : otherSize) * sizeof(CharType));
+      if (result != 0)
+        return result;
+      return size < otherSize ? -1 : (size > otherSize ? 1 : 0);
+    }
+
+    bool operator<(const TString& other) const
+    {
+      return Compare(other.CStr(), other.Size()) < 0;
+    }
+
+    bool operator<(const CharType* other) const
+    {
+      return Compare(other, HashFunctions::StringLength(other)) < 0;
+    }
+
+    friend bool operator<(const CharType* lhs, const TString& rhs)
+    {
+      return rhs.Compare(lhs, HashFunctions::StringLength(lhs)) > 0;
     }
 
     CharType& operator[](SizeType index)
@@ -188,7 +226,7 @@ namespace SSTD
       if (IsShort())
       {
         start_size = GetShortSize();
-        if (size > SSOSize)
+        if (size >= SSOSize)
         {
           auto temp = m_Allocator.Allocate(size);
           TMemCpy<CharType>(temp, m_Data.short_string.buffer, GetShortSize());
@@ -371,6 +409,42 @@ namespace SSTD
     [[msvc::no_unique_address]] AllocType m_Allocator;	//TODO: this is MSVC specific, we may need to work with different compilers at some point
   };
 
+  //no pointer into itself, the short string lives in the object and the long one on the heap
+  template <typename CharType, CharType NullTerminator, typename SizeType, template<typename> typename A>
+  struct IsTriviallyRelocatable<TString<CharType, NullTerminator, SizeType, A>>
+  {
+    static constexpr bool valid = true;
+  };
+
+  //hashes the characters, a const char* with the same text hashes the same, so tables can be searched without building a String
+  template <typename CharType, CharType NullTerminator, typename SizeType, template<typename> typename A>
+  struct Hasher<TString<CharType, NullTerminator, SizeType, A>>
+  {
+    uint64 operator()(const TString<CharType, NullTerminator, SizeType, A>& str) const
+    {
+      return HashFunctions::Bytes(str.CStr(), str.Size() * sizeof(CharType));
+    }
+
+    uint64 operator()(const CharType* str) const
+    {
+      return HashFunctions::Bytes(str, HashFunctions::StringLength(str) * sizeof(CharType));
+    }
+  };
+
+  template <typename CharType, CharType NullTerminator, typename SizeType, template<typename> typename A>
+  struct Equals<TString<CharType, NullTerminator, SizeType, A>>
+  {
+    bool operator()(const TString<CharType, NullTerminator, SizeType, A>& lhs, const TString<CharType, NullTerminator, SizeType, A>& rhs) const
+    {
+      return lhs == rhs;
+    }
+
+    bool operator()(const TString<CharType, NullTerminator, SizeType, A>& lhs, const CharType* rhs) const
+    {
+      return lhs == rhs;
+    }
+  };
+
   using String   = TString<char, '\0'>;
   using WString = TString<wchar_t, L'\0'>;
 }
\ No newline at end of file
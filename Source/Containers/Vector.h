@@ -19,6 +19,9 @@ namespace SSTD
     using ConstVectorIterator = ConstIterator<T>;
     using AllocType = A<T>;
 
+    //what IndexOf returns when the value isn't there
+    static constexpr SizeType NotFound = ~static_cast<SizeType>(0);
+
     Vector() noexcept {}
 
     explicit Vector(SizeType size)
@@ -40,10 +43,9 @@ namespace SSTD
     }
 
     Vector(const Vector& other)
-      :m_Size(other.m_Size), m_Capacity(other.m_Capacity), m_Allocator(other.m_Allocator), m_Buffer(m_Allocator.Allocate(other.m_Size))
+      :m_Size(other.m_Size), m_Capacity(other.m_Size), m_Allocator(other.m_Allocator), m_Buffer(m_Allocator.Allocate(other.m_Size))
     {
-      for (SizeType i = 0; i < other.m_Size; ++i)
-        m_Allocator.Construct(m_Buffer + i, T{ other.m_Buffer[i] });
+      TMemCpy<T>(m_Buffer, other.m_Buffer, other.m_Size);
     }
 
     Vector(Vector&& other) noexcept
@@ -61,19 +63,19 @@ namespace SSTD
 
     Vector& operator=(const Vector& other)
     {
-      if (m_Buffer)
-        if (m_Capacity != other.m_Capacity)
-          Clear();
-        else
-          Erase();
+      if (this == &other)
+        return *this;
 
-      if (other.m_Capacity > 0 && m_Buffer == nullptr)
+      Erase();
+      if (m_Capacity < other.m_Size)
+      {
+        m_Allocator.Deallocate(m_Buffer);
         m_Buffer = m_Allocator.Allocate(other.m_Size);
-
-      m_Capacity = other.m_Capacity;
-      m_Size = other.m_Size;
+        m_Capacity = other.m_Size;
+      }
 
       TMemCpy<T>(m_Buffer, other.m_Buffer, other.m_Size);
+      m_Size = other.m_Size;
       return *this;
     }
 
@@ -91,9 +93,14 @@ namespace SSTD
     T& operator[](const SizeType index) { return m_Buffer[index]; }
     const T& operator[](const SizeType index) const { return m_Buffer[index]; }
 
+    //new elements are value initialized
     void Resize(const SizeType size)
     {
-      Reserve(size);//TODO: this is very not so gud
+      Reserve(size);
+      for (SizeType i = m_Size; i < size; ++i)
+        new (m_Buffer + i) T{};
+      for (SizeType i = size; i < m_Size; ++i)
+        m_Buffer[i].~T();
       m_Size = size;
     }
 
@@ -105,7 +112,7 @@ namespace SSTD
       T* tmp = m_Allocator.Allocate(size);
 
       if (m_Buffer)
-        TMemCpy<T>(tmp, m_Buffer, m_Size);
+        Relocate(tmp, m_Buffer, m_Size);
 
       m_Allocator.Deallocate(m_Buffer);
       m_Buffer = tmp;
@@ -159,20 +166,52 @@ namespace SSTD
     template<typename... Args>
     T& EmplaceBack(Args&&... args)
     {
-      TryReserve();
-      m_Allocator.Construct(m_Buffer + (m_Size++), T{ Forward<Args>(args)... });
-      return m_Buffer[m_Size];
+      if (m_Size == m_Capacity)
+      {
+        //built before growing, args may point into this vector
+        T value{ Forward<Args>(args)... };
+        TryReserve();
+        new (m_Buffer + m_Size) T(Move(value));
+      }
+      else
+        m_Allocator.Construct(m_Buffer + m_Size, T{ Forward<Args>(args)... });
+
+      return m_Buffer[m_Size++];
     }
 
     void PopBack()
     {
-      m_Buffer[m_Size--].~T();
+      m_Buffer[--m_Size].~T();
+    }
+
+    void Insert(const SizeType index, const T& value)
+    {
+      EmplaceAt(index, value);
+    }
+
+    void Insert(const SizeType index, T&& value)
+    {
+      EmplaceAt(index, Move(value));
+    }
+
+    //the elements from index on are shifted up by one
+    template<typename... Args>
+    T& EmplaceAt(const SizeType index, Args&&... args)
+    {
+      //built before anything moves, args may point into this vector
+      T value{ Forward<Args>(args)... };
+
+      TryReserve();
+      Relocate(m_Buffer + index + 1, m_Buffer + index, m_Size - index);
+      new (m_Buffer + index) T(Move(value));
+      ++m_Size;
+      return m_Buffer[index];
     }
 
     void Append(const T* data, SizeType size)
     {
       Reserve(m_Size + size);
-      TMemCpy<T>(m_Buffer[m_Size], data, size);
+      TMemCpy<T>(m_Buffer + m_Size, data, size);
       m_Size += size;
     }
 
@@ -185,16 +224,26 @@ namespace SSTD
     {
       T tmp = Move(m_Buffer[index]);
       m_Buffer[index].~T();
-      memmove(m_Buffer[index], m_Buffer[index + 1], (m_Size--) - index); //shift the elements
+      Relocate(m_Buffer + index, m_Buffer + index + 1, m_Size - index - 1); //shift the elements
+      --m_Size;
       return tmp;
     }
 
-    SizeType IndexOf(const T& value)
+    //removes count elements starting at index, the ones behind are shifted down
+    void RemoveRange(const SizeType index, const SizeType count)
+    {
+      for (SizeType i = index; i < index + count; ++i)
+        m_Buffer[i].~T();
+      Relocate(m_Buffer + index, m_Buffer + index + count, m_Size - index - count);
+      m_Size -= count;
+    }
+
+    SizeType IndexOf(const T& value) const
     {
       for (SizeType i = 0; i < m_Size; i++)
         if (value == m_Buffer[i])
           return i;
-      return -1;
+      return NotFound;
     }
 
     T& At(const SizeType index)
@@ -269,4 +318,10 @@ namespace SSTD
     SizeType m_Capacity{ 0 };
     T* m_Buffer{ nullptr };
   };
-}
\ No newline at end of file
+
+  template<typename T, IntegralType SizeType, template<typename> typename A>
+  struct IsTriviallyRelocatable<Vector<T, SizeType, A>>
+  {
+    static constexpr bool valid = true;
+  };
+}
@@ -1,9 +1,23 @@
 #pragma once
 #include "Numeric.h"
 #include "Utility.h"
+#include "Meta.h"
+#include "Memory.h"
+#include "Allocator.h"
+#include "ArenaAllocator.h"
+#include "Pattern.h"
+
+#include <string.h>
 
 namespace SSTD
 {
+  template<typename T>
+  struct Less
+  {
+    template<typename L, typename R>
+    constexpr bool operator()(const L& lhs, const R& rhs) const { return lhs < rhs; }
+  };
+
   struct SortTypeInsertion 
   {
   public:
@@ -40,25 +54,1319 @@ namespace SSTD
     }
 
     template<typename SizeType = uint32>
-    SizeType getComplexity(SizeType n) const { return n ^ 2; }
+    SizeType getComplexity(SizeType n) const { return n * n; }
+
+    const bool isStable = true;
+  protected:
+  };
+
+  //O(n log n) without extra memory and without a bad case, not stable
+  struct SortTypeHeap
+  {
+  public:
+    template<class ContainerIterator, typename CompareFunction>
+    void Sort(ContainerIterator first, ContainerIterator last, CompareFunction func)
+    {
+      size_t size = last - first;
+      if (size < 2)
+        return;
+
+      for (size_t i = size / 2; i > 0; --i)
+        SiftDown(first, i - 1, size, func);
+
+      //the largest is at the root, move it behind the heap and shrink it
+      for (size_t end = size - 1; end > 0; --end)
+      {
+        Swap(first[end], first[0]);
+        SiftDown(first, 0, end, func);
+      }
+    }
+
+    template<typename SizeType = uint32>
+    SizeType getComplexity(SizeType n) const
+    {
+      SizeType log = 0;
+      for (SizeType i = n; i > 1; i >>= 1)
+        ++log;
+      return n * log;
+    }
 
     const bool isStable = false;
   protected:
+    template<class ContainerIterator, typename CompareFunction>
+    static void SiftDown(ContainerIterator& first, size_t root, size_t size, CompareFunction& func)
+    {
+      auto value = Move(first[root]);
+      size_t child;
+      while ((child = 2 * root + 1) < size)
+      {
+        if (child + 1 < size && func(first[child], first[child + 1]))
+          ++child;
+        if (!func(value, first[child]))
+          break;
+
+        first[root] = Move(first[child]);
+        root = child;
+      }
+      first[root] = Move(value);
+    }
+  };
+
+  //Pattern-defeating quicksort (Orson Peters), O(n log n) without a bad case, not stable
+  //a quicksort with a median of 3 pivot, or a ninther above NintherThreshold elements, small ranges use insertion sort
+  //input that is sorted or reversed takes O(n): a partition that needed no swaps is finished with an insertion sort
+  //that gives up after a few moves, and a fully descending range is simply reversed
+  //when the pivot equals an element left of the range, everything equal to it is split off in one pass, so many
+  //duplicates don't degrade it
+  //a very unbalanced partition swaps a few elements around to break up the pattern that caused it, after log2(n) of
+  //those the range is heap sorted instead
+  //small trivially copyable types are partitioned without branches: the offsets of misplaced elements are collected a
+  //block at a time and swapped afterwards, so the comparisons don't cost branch mispredictions
+  //the iterators have to index contiguous memory, like the ones of Vector or plain pointers
+  struct SortTypePDQ
+  {
+  public:
+    template<class ContainerIterator, typename CompareFunction>
+    void Sort(ContainerIterator first, ContainerIterator last, CompareFunction func)
+    {
+      size_t size = last - first;
+      if (size < 2)
+        return;
+
+      auto* begin = &first[0];
+      auto* end = begin + size;
+      using T = typename RemoveReference<decltype(*begin)>::Type;
+
+      if (IsDescending(begin, end, func))
+      {
+        for (--end; begin < end; ++begin, --end)
+          Swap(*begin, *end);
+        return;
+      }
+
+      int32 log = 0;
+      for (size_t i = size; i > 1; i >>= 1)
+        ++log;
+
+      SortLoop<IsTriviallyCopyable<T>::valid && sizeof(T) <= 16>(begin, end, func, log, true);
+    }
+
+    template<typename SizeType = uint32>
+    SizeType getComplexity(SizeType n) const
+    {
+      SizeType log = 0;
+      for (SizeType i = n; i > 1; i >>= 1)
+        ++log;
+      return n * log;
+    }
+
+    const bool isStable = false;
+  protected:
+    static constexpr size_t InsertionThreshold = 24;
+    static constexpr size_t NintherThreshold = 128;
+    static constexpr size_t PartialInsertionLimit = 8;
+    static constexpr size_t BlockSize = 64;
+
+    template<typename T, typename CompareFunction>
+    static bool IsDescending(T* begin, T* end, CompareFunction& func)
+    {
+      for (T* it = begin + 1; it < end; ++it)
+        if (func(it[-1], *it))
+          return false;
+      return true;
+    }
+
+    template<bool Branchless, typename T, typename CompareFunction>
+    static void SortLoop(T* begin, T* end, CompareFunction& func, int32 badAllowed, bool leftmost)
+    {
+      while (true)
+      {
+        size_t size = end - begin;
+        if (size < InsertionThreshold)
+        {
+          if (leftmost)
+            InsertionSort(begin, end, func);
+          else
+            UnguardedInsertionSort(begin, end, func);
+          return;
+        }
+
+        //the pivot ends up in *begin
+        size_t half = size / 2;
+        if (size > NintherThreshold)
+        {
+          Sort3(begin, begin + half, end - 1, func);
+          Sort3(begin + 1, begin + (half - 1), end - 2, func);
+          Sort3(begin + 2, begin + (half + 1), end - 3, func);
+          Sort3(begin + (half - 1), begin + half, begin + (half + 1), func);
+          Swap(*begin, begin[half]);
+        }
+        else
+          Sort3(begin + half, begin, end - 1, func);
+
+        //the element left of the range is not less than the pivot, so it is equal to it and so is everything that
+        //partitions to the left, only the right part is left to sort
+        if (!leftmost && !func(begin[-1], *begin))
+        {
+          begin = PartitionLeft(begin, end, func) + 1;
+          continue;
+        }
+
+        Partition<T> partition = Branchless ? PartitionRightBranchless(begin, end, func) : PartitionRight(begin, end, func);
+        T* pivot = partition.pivot;
+        size_t leftSize = pivot - begin;
+        size_t rightSize = end - (pivot + 1);
+
+        if (leftSize < size / 8 || rightSize < size / 8)
+        {
+          if (--badAllowed == 0)
+          {
+            SortTypeHeap().Sort(begin, end, func);
+            return;
+          }
+
+          if (leftSize >= InsertionThreshold)
+          {
+            Swap(begin[0], begin[leftSize / 4]);
+            Swap(pivot[-1], *(pivot - leftSize / 4));
+            if (leftSize > NintherThreshold)
+            {
+              Swap(begin[1], begin[leftSize / 4 + 1]);
+              Swap(begin[2], begin[leftSize / 4 + 2]);
+              Swap(pivot[-2], *(pivot - (leftSize / 4 + 1)));
+              Swap(pivot[-3], *(pivot - (leftSize / 4 + 2)));
+            }
+          }
+
+          if (rightSize >= InsertionThreshold)
+          {
+            Swap(pivot[1], pivot[1 + rightSize / 4]);
+            Swap(end[-1], *(end - rightSize / 4));
+            if (rightSize > NintherThreshold)
+            {
+              Swap(pivot[2], pivot[2 + rightSize / 4]);
+              Swap(pivot[3], pivot[3 + rightSize / 4]);
+              Swap(end[-2], *(end - (1 + rightSize / 4)));
+              Swap(end[-3], *(end - (2 + rightSize / 4)));
+            }
+          }
+        }
+        else if (partition.alreadyPartitioned && PartialInsertionSort(begin, pivot, func) && PartialInsertionSort(pivot + 1, end, func))
+          return;
+
+        //the left part is recursed into, the balance check bounds the depth
+        SortLoop<Branchless>(begin, pivot, func, badAllowed, leftmost);
+        begin = pivot + 1;
+        leftmost = false;
+      }
+    }
+
+    template<typename T>
+    struct Partition
+    {
+      T* pivot;
+      bool alreadyPartitioned;
+    };
+
+    template<typename T, typename CompareFunction>
+    static void Sort2(T* a, T* b, CompareFunction& func)
+    {
+      if (func(*b, *a))
+        Swap(*a, *b);
+    }
+
+    template<typename T, typename CompareFunction>
+    static void Sort3(T* a, T* b, T* c, CompareFunction& func)
+    {
+      Sort2(a, b, func);
+      Sort2(b, c, func);
+      Sort2(a, b, func);
+    }
+
+    template<typename T, typename CompareFunction>
+    static void InsertionSort(T* begin, T* end, CompareFunction& func)
+    {
+      for (T* it = begin + 1; it < end; ++it)
+      {
+        if (!func(*it, it[-1]))
+          continue;
+
+        T value = Move(*it);
+        T* hole = it;
+        do
+        {
+          *hole = Move(hole[-1]);
+          --hole;
+        } while (hole != begin && func(value, hole[-1]));
+        *hole = Move(value);
+      }
+    }
+
+    //begin[-1] is not greater than anything in the range, so it stops every shift
+    template<typename T, typename CompareFunction>
+    static void UnguardedInsertionSort(T* begin, T* end, CompareFunction& func)
+    {
+      for (T* it = begin + 1; it < end; ++it)
+      {
+        if (!func(*it, it[-1]))
+          continue;
+
+        T value = Move(*it);
+        T* hole = it;
+        do
+        {
+          *hole = Move(hole[-1]);
+          --hole;
+        } while (func(value, hole[-1]));
+        *hole = Move(value);
+      }
+    }
+
+    //false as soon as more than PartialInsertionLimit elements had to move, the range is left half sorted then
+    template<typename T, typename CompareFunction>
+    static bool PartialInsertionSort(T* begin, T* end, CompareFunction& func)
+    {
+      size_t moved = 0;
+      for (T* it = begin + 1; it < end; ++it)
+      {
+        if (!func(*it, it[-1]))
+          continue;
+
+        T value = Move(*it);
+        T* hole = it;
+        do
+        {
+          *hole = Move(hole[-1]);
+          --hole;
+        } while (hole != begin && func(value, hole[-1]));
+        *hole = Move(value);
+
+        moved += it - hole;
+        if (moved > PartialInsertionLimit)
+          return false;
+      }
+      return true;
+    }
+
+    //elements equal to the pivot go right, the pivot's final position is returned
+    //the median of 3 left an element not less than the pivot at end - 1, which stops the first scan
+    template<typename T, typename CompareFunction>
+    static Partition<T> PartitionRight(T* begin, T* end, CompareFunction& func)
+    {
+      T pivot = Move(*begin);
+      T* first = begin;
+      T* last = end;
+
+      while (func(*++first, pivot));
+
+      //nothing is guaranteed to stop the scan from the right if nothing was less than the pivot
+      if (first - 1 == begin)
+        while (first < last && !func(*--last, pivot));
+      else
+        while (!func(*--last, pivot));
+
+      bool alreadyPartitioned = first >= last;
+      while (first < last)
+      {
+        Swap(*first, *last);
+        while (func(*++first, pivot));
+        while (!func(*--last, pivot));
+      }
+
+      T* position = first - 1;
+      *begin = Move(*position);
+      *position = Move(pivot);
+      return Partition<T>{ position, alreadyPartitioned };
+    }
+
+    //like PartitionRight, the misplaced elements are found a block at a time and their offsets written down
+    //unconditionally, only the count moves on with the comparison
+    template<typename T, typename CompareFunction>
+    static Partition<T> PartitionRightBranchless(T* begin, T* end, CompareFunction& func)
+    {
+      T pivot = Move(*begin);
+      T* first = begin;
+      T* last = end;
+
+      while (func(*++first, pivot));
+
+      if (first - 1 == begin)
+        while (first < last && !func(*--last, pivot));
+      else
+        while (!func(*--last, pivot));
+
+      bool alreadyPartitioned = first >= last;
+      if (!alreadyPartitioned)
+      {
+        Swap(*first, *last);
+        ++first;
+
+        alignas(64) uint8 leftOffsets[BlockSize];
+        alignas(64) uint8 rightOffsets[BlockSize];
+        T* leftBase = first;
+        T* rightBase = last;
+        size_t leftCount = 0;
+        size_t rightCount = 0;
+        size_t leftStart = 0;
+        size_t rightStart = 0;
+
+        while (first < last)
+        {
+          //only a side whose block ran empty scans again, the unknown part is split between them
+          size_t unknown = last - first;
+          size_t leftSplit = leftCount == 0 ? (rightCount == 0 ? unknown / 2 : unknown) : 0;
+          size_t rightSplit = rightCount == 0 ? unknown - leftSplit : 0;
+
+          size_t leftScan = leftSplit < BlockSize ? leftSplit : BlockSize;
+          for (size_t i = 0; i < leftScan; ++i)
+          {
+            leftOffsets[leftCount] = static_cast<uint8>(i);
+            leftCount += !func(*first, pivot);
+            ++first;
+          }
+
+          size_t rightScan = rightSplit < BlockSize ? rightSplit : BlockSize;
+          for (size_t i = 0; i < rightScan; ++i)
+          {
+            --last;
+            rightOffsets[rightCount] = static_cast<uint8>(i + 1);
+            rightCount += func(*last, pivot);
+          }
+
+          size_t count = leftCount < rightCount ? leftCount : rightCount;
+          SwapOffsets(leftBase, rightBase, leftOffsets + leftStart, rightOffsets + rightStart, count, leftCount == rightCount);
+          leftCount -= count;
+          rightCount -= count;
+          leftStart += count;
+          rightStart += count;
+
+          if (leftCount == 0)
+          {
+            leftStart = 0;
+            leftBase = first;
+          }
+
+          if (rightCount == 0)
+          {
+            rightStart = 0;
+            rightBase = last;
+          }
+        }
+
+        //one side still has misplaced elements, they are swapped to the border of the scanned part
+        if (leftCount)
+        {
+          const uint8* offsets = leftOffsets + leftStart;
+          while (leftCount--)
+            Swap(leftBase[offsets[leftCount]], *--last);
+          first = last;
+        }
+
+        if (rightCount)
+        {
+          const uint8* offsets = rightOffsets + rightStart;
+          while (rightCount--)
+          {
+            Swap(*(rightBase - offsets[rightCount]), *first);
+            ++first;
+          }
+        }
+      }
+
+      T* position = first - 1;
+      *begin = Move(*position);
+      *position = Move(pivot);
+      return Partition<T>{ position, alreadyPartitioned };
+    }
+
+    //a cyclic permutation needs one move per element instead of three, but with equal counts plain swaps keep a
+    //descending input O(n)
+    template<typename T>
+    static void SwapOffsets(T* leftBase, T* rightBase, const uint8* leftOffsets, const uint8* rightOffsets, size_t count, bool useSwaps)
+    {
+      if (useSwaps)
+      {
+        for (size_t i = 0; i < count; ++i)
+          Swap(leftBase[leftOffsets[i]], *(rightBase - rightOffsets[i]));
+      }
+      else if (count > 0)
+      {
+        T* left = leftBase + leftOffsets[0];
+        T* right = rightBase - rightOffsets[0];
+        T value = Move(*left);
+        *left = Move(*right);
+        for (size_t i = 1; i < count; ++i)
+        {
+          left = leftBase + leftOffsets[i];
+          *right = Move(*left);
+          right = rightBase - rightOffsets[i];
+          *left = Move(*right);
+        }
+        *right = Move(value);
+      }
+    }
+
+    //elements equal to the pivot go left, the pivot's final position is returned
+    template<typename T, typename CompareFunction>
+    static T* PartitionLeft(T* begin, T* end, CompareFunction& func)
+    {
+      T pivot = Move(*begin);
+      T* first = begin;
+      T* last = end;
+
+      while (func(pivot, *--last));
+
+      if (last + 1 == end)
+        while (first < last && !func(pivot, *++first));
+      else
+        while (!func(pivot, *++first));
+
+      while (first < last)
+      {
+        Swap(*first, *last);
+        while (func(pivot, *--last));
+        while (!func(pivot, *++first));
+      }
+
+      T* position = last;
+      *begin = Move(*position);
+      *position = Move(pivot);
+      return position;
+    }
   };
 
-  template<class SortType = SortTypeInsertion, class ContainerIterator, class CompareFunction>
+  namespace Radix
+  {
+    template<size_t Size>
+    struct UnsignedOf;
+
+    template<>
+    struct UnsignedOf<1> { using Type = uint8; };
+    template<>
+    struct UnsignedOf<2> { using Type = uint16; };
+    template<>
+    struct UnsignedOf<4> { using Type = uint32; };
+    template<>
+    struct UnsignedOf<8> { using Type = uint64; };
+
+    //an unsigned integer that sorts like key: signed integers get their sign bit flipped, negative floats all of
+    //their bits and positive floats only the sign bit, -0.0 ends up in front of 0.0
+    template<typename K>
+      requires IsNumeric<K>::valid
+    static inline typename UnsignedOf<sizeof(K)>::Type ToUnsigned(K key)
+    {
+      using U = typename UnsignedOf<sizeof(K)>::Type;
+      constexpr U sign = static_cast<U>(static_cast<U>(1) << (sizeof(K) * 8 - 1));
+      if constexpr (IsSame<K, float>::valid || IsSame<K, double>::valid)
+      {
+        U bits;
+        memcpy(&bits, &key, sizeof(K));
+        return (bits & sign) ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+      }
+      else if constexpr (static_cast<K>(-1) < static_cast<K>(0))
+        return static_cast<U>(static_cast<U>(key) ^ sign);
+      else
+        return static_cast<U>(key);
+    }
+
+    struct Identity
+    {
+      template<typename T>
+      constexpr const T& operator()(const T& value) const { return value; }
+    };
+  }
+
+  //LSD radix sort on the bytes of a numeric key, O(n * sizeof(key)) and stable, the scratch buffer is as large as the input
+  //Sort<SortTypeRadix>(first, last) sorts numbers, Sort<SortTypeRadix>(first, last, key) sorts anything by key(element),
+  //which has to return an integer, float or double
+  //one pass over the input counts all bytes at once, a byte that is the same in every key gets no pass of its own
+  //an input that doesn't fit in the cache is first split on its highest differing byte, every bucket then gets its
+  //remaining passes while it is small enough that the scatter stays in the cache
+  //the iterators have to index contiguous memory, like the ones of Vector or plain pointers
+  struct SortTypeRadix
+  {
+  public:
+    template<class ContainerIterator, typename T>
+    void Sort(ContainerIterator first, ContainerIterator last, const Less<T>&)
+    {
+      Sort(first, last, Radix::Identity());
+    }
+
+    template<class ContainerIterator, typename KeyFunction>
+      requires requires(KeyFunction key, ContainerIterator it) { Radix::ToUnsigned(key(*it)); }
+    void Sort(ContainerIterator first, ContainerIterator last, KeyFunction key)
+    {
+      size_t size = last - first;
+      if (size < 2)
+        return;
+
+      auto* data = &first[0];
+      using T = typename RemoveReference<decltype(*data)>::Type;
+      using U = decltype(Radix::ToUnsigned(key(*data)));
+
+      if (size < InsertionThreshold)
+      {
+        InsertionSort(data, size, key);
+        return;
+      }
+
+      Allocator<T> allocator{};
+      T* scratch = allocator.Allocate(size);
+      SortBytes(data, scratch, size, key, sizeof(U) - 1);
+      allocator.Deallocate(scratch);
+    }
+
+    template<typename SizeType = uint32>
+    SizeType getComplexity(SizeType n) const { return n; }
+
+    const bool isStable = true;
+  protected:
+    static constexpr size_t InsertionThreshold = 64;
+    static constexpr size_t CacheBytes = 512 * 1024;
+
+    //sorts data on the key bytes 0 to top, scratch is uninitialized memory for size elements
+    template<typename T, typename KeyFunction>
+    static void SortBytes(T* data, T* scratch, size_t size, KeyFunction& key, uint32 top)
+    {
+      using U = decltype(Radix::ToUnsigned(key(*data)));
+      constexpr uint32 Bytes = sizeof(U);
+
+      size_t counts[Bytes][256] = {};
+      for (size_t i = 0; i < size; ++i)
+      {
+        U bits = Radix::ToUnsigned(key(data[i]));
+        for (uint32 byte = 0; byte <= top; ++byte)
+          ++counts[byte][(bits >> (byte * 8)) & 0xFF];
+      }
+
+      //a byte needs a pass unless every key has the same value there
+      U first = Radix::ToUnsigned(key(data[0]));
+      bool needed[Bytes] = {};
+      int32 highest = -1;
+      for (uint32 byte = 0; byte <= top; ++byte)
+      {
+        needed[byte] = counts[byte][(first >> (byte * 8)) & 0xFF] != size;
+        if (needed[byte])
+          highest = static_cast<int32>(byte);
+      }
+
+      if (highest < 0)
+        return;
+
+      if (highest > 0 && size * sizeof(T) > CacheBytes)
+      {
+        //MSD split on the highest differing byte, the buckets are sorted on the bytes below it one by one
+        size_t offsets[256];
+        PrefixSums(counts[highest], offsets);
+        Scatter(data, scratch, size, key, static_cast<uint32>(highest), offsets);
+
+        size_t start = 0;
+        for (uint32 bucket = 0; bucket < 256; ++bucket)
+        {
+          size_t count = counts[highest][bucket];
+          if (count == 0)
+            continue;
+
+          RelocateRange(data + start, scratch + start, count);
+          if (count < InsertionThreshold)
+            InsertionSort(data + start, count, key);
+          else
+            SortBytes(data + start, scratch + start, count, key, static_cast<uint32>(highest - 1));
+          start += count;
+        }
+        return;
+      }
+
+      T* from = data;
+      T* to = scratch;
+      for (uint32 byte = 0; byte <= static_cast<uint32>(highest); ++byte)
+      {
+        if (!needed[byte])
+          continue;
+
+        size_t offsets[256];
+        PrefixSums(counts[byte], offsets);
+        Scatter(from, to, size, key, byte, offsets);
+        Swap(from, to);
+      }
+
+      if (from != data)
+        RelocateRange(data, from, size);
+    }
+
+    static void PrefixSums(const size_t* counts, size_t* offsets)
+    {
+      size_t sum = 0;
+      for (uint32 bucket = 0; bucket < 256; ++bucket)
+      {
+        offsets[bucket] = sum;
+        sum += counts[bucket];
+      }
+    }
+
+    //moves every element of from to its bucket in the uninitialized to, in order, which keeps the sort stable
+    template<typename T, typename KeyFunction>
+    static void Scatter(T* from, T* to, size_t size, KeyFunction& key, uint32 byte, size_t* offsets)
+    {
+      using U = decltype(Radix::ToUnsigned(key(*from)));
+      for (size_t i = 0; i < size; ++i)
+      {
+        U bits = Radix::ToUnsigned(key(from[i]));
+        size_t& offset = offsets[(bits >> (byte * 8)) & 0xFF];
+        RelocateRange(to + offset, from + i, 1);
+        ++offset;
+      }
+    }
+
+    template<typename T>
+    static void RelocateRange(T* dst, T* src, size_t size)
+    {
+      if constexpr (IsTriviallyCopyable<T>::valid)
+      {
+        if (size == 1)
+          *dst = *src;
+        else
+          memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T) * size);
+      }
+      else
+        Relocate(dst, src, size);
+    }
+
+    //stable, the keys are compared as their unsigned form
+    template<typename T, typename KeyFunction>
+    static void InsertionSort(T* data, size_t size, KeyFunction& key)
+    {
+      for (size_t i = 1; i < size; ++i)
+      {
+        auto bits = Radix::ToUnsigned(key(data[i]));
+        if (!(bits < Radix::ToUnsigned(key(data[i - 1]))))
+          continue;
+
+        T value = Move(data[i]);
+        size_t hole = i;
+        do
+        {
+          data[hole] = Move(data[hole - 1]);
+          --hole;
+        } while (hole > 0 && bits < Radix::ToUnsigned(key(data[hole - 1])));
+        data[hole] = Move(value);
+      }
+    }
+  };
+
+  //Stable merge sort after Tim Peters' listsort (timsort), O(n log n) and O(n) on input that is already (mostly) sorted
+  //natural runs are found and extended to a minimum length with a binary insertion sort, adjacent runs are merged
+  //with galloping once one side keeps winning, so runs that barely interleave are merged with few compares
+  //a merge needs scratch space for the shorter of both runs, at most GetScratchBytes<T>(size), it is only taken once
+  //the first merge happens:
+  //- default constructed, the scratch is allocated and kept for the next Sort on the same object
+  //- with a buffer, the buffer is used as long as it is large enough and aligned for T, it is never freed
+  //- with a LinearArena, the scratch comes from the arena and is rolled back at the end of every Sort
+  //the iterators have to index contiguous memory, like the ones of Vector or plain pointers
+  struct SortTypeMerge : public NonCopyable
+  {
+  public:
+    SortTypeMerge() = default;
+    SortTypeMerge(void* scratch, size_t bytes) : m_Scratch(scratch), m_ScratchBytes(bytes) {}
+    explicit SortTypeMerge(LinearArena& arena) : m_Arena(&arena) {}
+    ~SortTypeMerge()
+    {
+      if (m_Owned)
+        Allocator<ScratchBlock>().Deallocate(static_cast<ScratchBlock*>(m_Scratch));
+    }
+
+    template<class ContainerIterator, typename CompareFunction>
+    void Sort(ContainerIterator first, ContainerIterator last, CompareFunction func)
+    {
+      size_t size = last - first;
+      if (size < 2)
+        return;
+
+      auto* data = &first[0];
+      using T = typename RemoveReference<decltype(*data)>::Type;
+      static_assert(alignof(T) <= alignof(ScratchBlock), "SortTypeMerge: over-aligned types are not supported");
+
+      if (size < MinMerge * 2)
+      {
+        InsertionSort(data, size, CountRun(data, size, func), func);
+        return;
+      }
+
+      LinearArena::Marker marker{};
+      if (m_Arena)
+        marker = m_Arena->GetMarker();
+
+      MergeState<T, CompareFunction> state{ data, size, func };
+      size_t min_run = MinRunLength(size);
+      size_t start = 0;
+      while (start < size)
+      {
+        size_t remaining = size - start;
+        size_t run = CountRun(data + start, remaining, func);
+        if (run < min_run)
+        {
+          size_t forced = remaining < min_run ? remaining : min_run;
+          InsertionSort(data + start, forced, run, func);
+          run = forced;
+        }
+
+        state.runs[state.count++] = Run{ start, run };
+        MergeCollapse(state);
+        start += run;
+      }
+      MergeForceCollapse(state);
+
+      if (m_Arena)
+        m_Arena->Rollback(marker);
+    }
+
+    //the most scratch a Sort of size elements of T can need
+    template<typename T>
+    static constexpr size_t GetScratchBytes(size_t size) { return size / 2 * sizeof(T); }
+
+    template<typename SizeType = uint32>
+    SizeType getComplexity(SizeType n) const
+    {
+      SizeType log = 0;
+      for (SizeType i = n; i > 1; i >>= 1)
+        ++log;
+      return n * log;
+    }
+
+    const bool isStable = true;
+  protected:
+    static constexpr size_t MinMerge = 32;
+    static constexpr uint32 MinGallop = 7;
+    //enough for 2^64 elements, the run lengths grow at least like the fibonacci numbers
+    static constexpr uint32 MaxRuns = 85;
+
+    struct alignas(64) ScratchBlock
+    {
+      uint8 bytes[64];
+    };
+
+    struct Run
+    {
+      size_t start = 0;
+      size_t size = 0;
+    };
+
+    template<typename T, typename CompareFunction>
+    struct MergeState
+    {
+      MergeState(T* data, size_t size, CompareFunction& cond)
+        : data(data), size(size), cond(cond)
+      {}
+
+      T* data;
+      size_t size;
+      CompareFunction& cond;
+      T* scratch = nullptr;
+      uint32 min_gallop = MinGallop;
+      uint32 count = 0;
+      Run runs[MaxRuns]{};
+    };
+
+    //a run is at least 2 elements unless the input is shorter, a strictly descending one gets reversed in place
+    template<typename T, typename CompareFunction>
+    static size_t CountRun(T* data, size_t size, CompareFunction& cond)
+    {
+      if (size < 2)
+        return size;
+
+      size_t i = 2;
+      if (cond(data[1], data[0]))
+      {
+        while (i < size && cond(data[i], data[i - 1]))
+          ++i;
+        for (size_t low = 0, high = i - 1; low < high; ++low, --high)
+          Swap(data[low], data[high]);
+      }
+      else
+      {
+        while (i < size && !cond(data[i], data[i - 1]))
+          ++i;
+      }
+      return i;
+    }
+
+    //[0, sorted) is already in order, every other element goes behind the last one it isn't less than
+    template<typename T, typename CompareFunction>
+    static void InsertionSort(T* data, size_t size, size_t sorted, CompareFunction& cond)
+    {
+      for (size_t i = sorted; i < size; ++i)
+      {
+        size_t low = 0;
+        size_t high = i;
+        while (low < high)
+        {
+          size_t middle = low + (high - low) / 2;
+          if (cond(data[i], data[middle]))
+            high = middle;
+          else
+            low = middle + 1;
+        }
+        if (low == i)
+          continue;
+
+        T value = Move(data[i]);
+        MoveBackward(data + low + 1, data + low, i - low);
+        data[low] = Move(value);
+      }
+    }
+
+    //between 32 and 64, so that size / min run is a power of two or a bit less
+    static size_t MinRunLength(size_t size)
+    {
+      size_t odd = 0;
+      while (size >= MinMerge * 2)
+      {
+        odd |= size & 1;
+        size >>= 1;
+      }
+      return size + odd;
+    }
+
+    //dst and src may overlap as long as dst is in front of src
+    template<typename T>
+    static void MoveForward(T* dst, T* src, size_t size)
+    {
+      if constexpr (IsTriviallyCopyable<T>::valid)
+        MemMove(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T) * size);
+      else
+        for (size_t i = 0; i < size; ++i)
+          dst[i] = Move(src[i]);
+    }
+
+    //dst and src may overlap as long as dst is behind src
+    template<typename T>
+    static void MoveBackward(T* dst, T* src, size_t size)
+    {
+      if constexpr (IsTriviallyCopyable<T>::valid)
+        MemMove(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T) * size);
+      else
+        for (size_t i = size; i > 0; --i)
+          dst[i - 1] = Move(src[i - 1]);
+    }
+
+    //where key goes in front of every element that is equal to it, starting the search at hint
+    template<typename T, typename CompareFunction>
+    static size_t GallopLeft(const T& key, T* data, size_t size, size_t hint, CompareFunction& cond)
+    {
+      int64 last = 0;
+      int64 offset = 1;
+      int64 h = static_cast<int64>(hint);
+      if (cond(data[hint], key))
+      {
+        int64 max = static_cast<int64>(size) - h;
+        while (offset < max && cond(data[h + offset], key))
+        {
+          last = offset;
+          offset = (offset << 1) + 1;
+        }
+        if (offset > max)
+          offset = max;
+        last += h;
+        offset += h;
+      }
+      else
+      {
+        int64 max = h + 1;
+        while (offset < max && !cond(data[h - offset], key))
+        {
+          last = offset;
+          offset = (offset << 1) + 1;
+        }
+        if (offset > max)
+          offset = max;
+        int64 k = last;
+        last = h - offset;
+        offset = h - k;
+      }
+
+      //data[last] < key <= data[offset]
+      ++last;
+      while (last < offset)
+      {
+        int64 middle = last + ((offset - last) >> 1);
+        if (cond(data[middle], key))
+          last = middle + 1;
+        else
+          offset = middle;
+      }
+      return static_cast<size_t>(offset);
+    }
+
+    //where key goes behind every element that is equal to it, starting the search at hint
+    template<typename T, typename CompareFunction>
+    static size_t GallopRight(const T& key, T* data, size_t size, size_t hint, CompareFunction& cond)
+    {
+      int64 last = 0;
+      int64 offset = 1;
+      int64 h = static_cast<int64>(hint);
+      if (cond(key, data[hint]))
+      {
+        int64 max = h + 1;
+        while (offset < max && cond(key, data[h - offset]))
+        {
+          last = offset;
+          offset = (offset << 1) + 1;
+        }
+        if (offset > max)
+          offset = max;
+        int64 k = last;
+        last = h - offset;
+        offset = h - k;
+      }
+      else
+      {
+        int64 max = static_cast<int64>(size) - h;
+        while (offset < max && !cond(key, data[h + offset]))
+        {
+          last = offset;
+          offset = (offset << 1) + 1;
+        }
+        if (offset > max)
+          offset = max;
+        last += h;
+        offset += h;
+      }
+
+      //data[last] <= key < data[offset]
+      ++last;
+      while (last < offset)
+      {
+        int64 middle = last + ((offset - last) >> 1);
+        if (cond(key, data[middle]))
+          offset = middle;
+        else
+          last = middle + 1;
+      }
+      return static_cast<size_t>(offset);
+    }
+
+    //keeps the run lengths growing like the fibonacci numbers from the top of the stack down, so that the merges stay
+    //balanced, with the fix from de Gouw et al. that checks one run deeper
+    template<typename T, typename CompareFunction>
+    void MergeCollapse(MergeState<T, CompareFunction>& state)
+    {
+      while (state.count > 1)
+      {
+        uint32 n = state.count - 2;
+        Run* runs = state.runs;
+        if ((n > 0 && runs[n - 1].size <= runs[n].size + runs[n + 1].size) ||
+          (n > 1 && runs[n - 2].size <= runs[n - 1].size + runs[n].size))
+        {
+          if (runs[n - 1].size < runs[n + 1].size)
+            --n;
+        }
+        else if (runs[n].size > runs[n + 1].size)
+          break;
+
+        MergeAt(state, n);
+      }
+    }
+
+    template<typename T, typename CompareFunction>
+    void MergeForceCollapse(MergeState<T, CompareFunction>& state)
+    {
+      while (state.count > 1)
+      {
+        uint32 n = state.count - 2;
+        if (n > 0 && state.runs[n - 1].size < state.runs[n + 1].size)
+          --n;
+        MergeAt(state, n);
+      }
+    }
+
+    //merges the runs i and i + 1
+    template<typename T, typename CompareFunction>
+    void MergeAt(MergeState<T, CompareFunction>& state, uint32 i)
+    {
+      T* a = state.data + state.runs[i].start;
+      size_t a_size = state.runs[i].size;
+      T* b = state.data + state.runs[i + 1].start;
+      size_t b_size = state.runs[i + 1].size;
+
+      state.runs[i].size = a_size + b_size;
+      if (i + 3 == state.count)
+        state.runs[i + 1] = state.runs[i + 2];
+      --state.count;
+
+      //what is in front of b[0] in a and behind a[last] in b already is where it belongs
+      size_t k = GallopRight(b[0], a, a_size, 0, state.cond);
+      a += k;
+      a_size -= k;
+      if (a_size == 0)
+        return;
+
+      b_size = GallopLeft(a[a_size - 1], b, b_size, b_size - 1, state.cond);
+      if (b_size == 0)
+        return;
+
+      if (!state.scratch)
+        state.scratch = GetScratch<T>(state.size / 2);
+
+      if (a_size <= b_size)
+        MergeLow(state, a, a_size, b, b_size);
+      else
+        MergeHigh(state, a, a_size, b, b_size);
+    }
+
+    //a is moved into the scratch and merged from the front, a_size <= b_size, a[0] and b[last] are already known to
+    //go after b[0] and a[last]
+    template<typename T, typename CompareFunction>
+    static void MergeLow(MergeState<T, CompareFunction>& state, T* a, size_t a_size, T* b, size_t b_size)
+    {
+      CompareFunction& cond = state.cond;
+      T* scratch = state.scratch;
+      size_t constructed = a_size;
+      for (size_t i = 0; i < a_size; ++i)
+        new (static_cast<void*>(scratch + i)) T(Move(a[i]));
+
+      T* dst = a;
+      T* pa = scratch;
+      T* pb = b;
+      *dst++ = Move(*pb++);
+      --b_size;
+
+      uint32 min_gallop = state.min_gallop;
+      if (b_size != 0 && a_size != 1)
+      {
+        while (true)
+        {
+          //one at a time until one side wins often enough in a row
+          size_t a_count = 0;
+          size_t b_count = 0;
+          do
+          {
+            if (cond(*pb, *pa))
+            {
+              *dst++ = Move(*pb++);
+              ++b_count;
+              a_count = 0;
+              if (--b_size == 0)
+                goto Done;
+            }
+            else
+            {
+              *dst++ = Move(*pa++);
+              ++a_count;
+              b_count = 0;
+              if (--a_size == 1)
+                goto Done;
+            }
+          } while ((a_count | b_count) < min_gallop);
+
+          //gallop for as long as it keeps paying off
+          ++min_gallop;
+          do
+          {
+            min_gallop -= min_gallop > 1;
+
+            a_count = GallopRight(*pb, pa, a_size, 0, cond);
+            if (a_count)
+            {
+              MoveForward(dst, pa, a_count);
+              dst += a_count;
+              pa += a_count;
+              a_size -= a_count;
+              //0 only with an inconsistent compare
+              if (a_size <= 1)
+                goto Done;
+            }
+            *dst++ = Move(*pb++);
+            if (--b_size == 0)
+              goto Done;
+
+            b_count = GallopLeft(*pa, pb, b_size, 0, cond);
+            if (b_count)
+            {
+              MoveForward(dst, pb, b_count);
+              dst += b_count;
+              pb += b_count;
+              b_size -= b_count;
+              if (b_size == 0)
+                goto Done;
+            }
+            *dst++ = Move(*pa++);
+            if (--a_size == 1)
+              goto Done;
+          } while (a_count >= MinGallop || b_count >= MinGallop);
+          ++min_gallop;
+        }
+      }
+
+    Done:
+      state.min_gallop = min_gallop < 1 ? 1 : min_gallop;
+      if (a_size == 1 && b_size != 0)
+      {
+        //the last of a goes behind everything left in b
+        MoveForward(dst, pb, b_size);
+        dst[b_size] = Move(*pa);
+      }
+      else
+        MoveForward(dst, pa, a_size);
+
+      for (size_t i = 0; i < constructed; ++i)
+        scratch[i].~T();
+    }
+
+    //b is moved into the scratch and merged from the back, b_size < a_size
+    template<typename T, typename CompareFunction>
+    static void MergeHigh(MergeState<T, CompareFunction>& state, T* a, size_t a_size, T* b, size_t b_size)
+    {
+      CompareFunction& cond = state.cond;
+      T* scratch = state.scratch;
+      size_t constructed = b_size;
+      for (size_t i = 0; i < b_size; ++i)
+        new (static_cast<void*>(scratch + i)) T(Move(b[i]));
+
+      //all of them point at the last element of their range
+      T* dst = b + b_size - 1;
+      T* pa = a + a_size - 1;
+      T* pb = scratch + b_size - 1;
+      *dst-- = Move(*pa--);
+      --a_size;
+
+      uint32 min_gallop = state.min_gallop;
+      if (a_size != 0 && b_size != 1)
+      {
+        while (true)
+        {
+          size_t a_count = 0;
+          size_t b_count = 0;
+          do
+          {
+            if (cond(*pb, *pa))
+            {
+              *dst-- = Move(*pa--);
+              ++a_count;
+              b_count = 0;
+              if (--a_size == 0)
+                goto Done;
+            }
+            else
+            {
+              *dst-- = Move(*pb--);
+              ++b_count;
+              a_count = 0;
+              if (--b_size == 1)
+                goto Done;
+            }
+          } while ((a_count | b_count) < min_gallop);
+
+          ++min_gallop;
+          do
+          {
+            min_gallop -= min_gallop > 1;
+
+            a_count = a_size - GallopRight(*pb, a, a_size, a_size - 1, cond);
+            if (a_count)
+            {
+              dst -= a_count;
+              pa -= a_count;
+              MoveBackward(dst + 1, pa + 1, a_count);
+              a_size -= a_count;
+              if (a_size == 0)
+                goto Done;
+            }
+            *dst-- = Move(*pb--);
+            //0 only with an inconsistent compare
+            if (--b_size <= 1)
+              goto Done;
+
+            b_count = b_size - GallopLeft(*pa, scratch, b_size, b_size - 1, cond);
+            if (b_count)
+            {
+              dst -= b_count;
+              pb -= b_count;
+              MoveBackward(dst + 1, pb + 1, b_count);
+              b_size -= b_count;
+              if (b_size <= 1)
+                goto Done;
+            }
+            *dst-- = Move(*pa--);
+            if (--a_size == 0)
+              goto Done;
+          } while (a_count >= MinGallop || b_count >= MinGallop);
+          ++min_gallop;
+        }
+      }
+
+    Done:
+      state.min_gallop = min_gallop < 1 ? 1 : min_gallop;
+      if (b_size == 1 && a_size != 0)
+      {
+        //the first of b goes in front of everything left in a
+        dst -= a_size;
+        pa -= a_size;
+        MoveBackward(dst + 1, pa + 1, a_size);
+        *dst = Move(*pb);
+      }
+      else
+        MoveForward(dst + 1 - b_size, scratch, b_size);
+
+      for (size_t i = 0; i < constructed; ++i)
+        scratch[i].~T();
+    }
+
+    template<typename T>
+    T* GetScratch(size_t count)
+    {
+      size_t bytes = count * sizeof(T);
+      if (m_Arena)
+        return static_cast<T*>(m_Arena->Allocate(bytes, alignof(T)));
+
+      if (bytes <= m_ScratchBytes && reinterpret_cast<size_t>(m_Scratch) % alignof(T) == 0)
+        return static_cast<T*>(m_Scratch);
+
+      Allocator<ScratchBlock> allocator{};
+      if (m_Owned)
+        allocator.Deallocate(static_cast<ScratchBlock*>(m_Scratch));
+
+      size_t blocks = (bytes + sizeof(ScratchBlock) - 1) / sizeof(ScratchBlock);
+      m_Scratch = allocator.Allocate(blocks);
+      m_ScratchBytes = blocks * sizeof(ScratchBlock);
+      m_Owned = true;
+      return static_cast<T*>(m_Scratch);
+    }
+
+    void* m_Scratch = nullptr;
+    size_t m_ScratchBytes = 0;
+    bool m_Owned = false;
+    LinearArena* m_Arena = nullptr;
+  };
+
+  template<class SortType = SortTypePDQ, class ContainerIterator, class CompareFunction>
   static constexpr void Sort(ContainerIterator first, ContainerIterator last, CompareFunction cond)
   {
     auto s = SortType(); s.Sort(first, last, cond);
   }
 
-  template<class SortType = SortTypeInsertion, class ContainerIterator>
+  template<class SortType = SortTypePDQ, class ContainerIterator>
   static constexpr void Sort(ContainerIterator first, ContainerIterator last)
   {
-    auto s= SortType(); s.Sort(first, last,
-      [](auto a, auto b) {
-        return a < b;
-      });
+    using T = typename RemoveReference<decltype(*first)>::Type;
+    auto s = SortType(); s.Sort(first, last, Less<T>());
+  }
+
+  //index of the first element that is not less than key, size if there is none
+  //the loop always runs log2(size) times and picks the half with a conditional move instead of a branch
+  template<typename T, typename Q, class CompareFunction>
+  static constexpr size_t LowerBound(const T* data, size_t size, const Q& key, const CompareFunction& func)
+  {
+    if (size == 0)
+      return 0;
+
+    const T* base = data;
+    while (size > 1)
+    {
+      size_t half = size >> 1;
+      base = func(base[half], key) ? base + half : base;
+      size -= half;
+    }
+    return (base - data) + func(*base, key);
   }
 
   struct HashTypeMD5
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Memory.h"
+#include "Exception.h"
+
+#include "Platform/Memory/VirtualMemory.h"
+
+#include <new>
+
+namespace SSTD
+{
+  //Every block starts at a multiple of Alignment (cache lines, pages, SIMD loads)
+  //Blocks of HugePageThreshold and up are mapped from the OS directly and backed by transparent huge pages where available
+  template<typename T, size_t Alignment = 64>
+  class AlignedAllocator
+  {
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment has to be a power of two");
+    static_assert(Alignment >= alignof(T), "Alignment can't be lower than the one of T");
+
+    enum class BlockKind : size_t
+    {
+      Heap,
+      Mapped
+    };
+
+    //sits right in front of the block, the padding in front of it keeps the block aligned
+    struct Header
+    {
+      size_t size;
+      BlockKind kind;
+    };
+
+    static constexpr size_t Padding = Alignment > sizeof(Header) ? Alignment : sizeof(Header);
+
+  public:
+    using SizeType = size_t;
+    typedef T* Pointer;
+
+    static constexpr size_t HugePageThreshold = 2 * Byte::MB;
+
+    explicit AlignedAllocator() throw() {}
+    AlignedAllocator(const AlignedAllocator& other) {}
+
+    template<typename N>
+    explicit AlignedAllocator(const AlignedAllocator<N, Alignment>& other) {}
+
+    Pointer Allocate(size_t size)
+    {
+      size_t total = Padding + size * sizeof(T);
+      uint8* base;
+      BlockKind kind;
+
+      if (total >= HugePageThreshold)
+      {
+        size_t huge_page = VirtualMemory::GetHugePageSize();
+        base = static_cast<uint8*>(VirtualMemory::Allocate(total, Alignment > huge_page ? Alignment : huge_page));
+        if (!base)
+          throw Exception();
+
+        VirtualMemory::AdviseHugePages(base, total);
+        kind = BlockKind::Mapped;
+      }
+      else
+      {
+        base = static_cast<uint8*>(::operator new(total, std::align_val_t(Alignment)));
+        kind = BlockKind::Heap;
+      }
+
+      Header* header = reinterpret_cast<Header*>(base + Padding) - 1;
+      header->size = total;
+      header->kind = kind;
+      return reinterpret_cast<Pointer>(base + Padding);
+    }
+
+    void Deallocate(Pointer ptr)
+    {
+      if (!ptr)
+        return;
+
+      uint8* base = reinterpret_cast<uint8*>(ptr) - Padding;
+      Header* header = reinterpret_cast<Header*>(ptr) - 1;
+      if (header->kind == BlockKind::Mapped)
+        VirtualMemory::Free(base, header->size);
+      else
+        ::operator delete(static_cast<void*>(base), std::align_val_t(Alignment));
+    }
+
+    template<typename U, typename ... Args>
+    void Construct(U* ptr, Args&&... args)
+    {
+      new (static_cast<void*>(ptr)) T{ Forward<Args>(args)... };
+    }
+  };
+}
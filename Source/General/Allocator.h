@@ -2,12 +2,22 @@
 
 #include "Utility.h"
 #include "Meta.h"
+#include "Exception.h"
+
+#ifdef SSTD_USE_HEAP_ALLOCATOR
+#include "Platform/Memory/Heap.h"
+#endif
+
+#include <new>
 
 namespace SSTD
 {
   template<typename T>
   class Allocator
   {
+    //neither operator new nor the Heap go beyond 16 bytes on their own
+    static constexpr bool IsOverAligned = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
   public:
     using SizeType = size_t;
     typedef T* Pointer;
@@ -20,12 +30,32 @@ namespace SSTD
 
     Pointer Allocate(size_t size)
     {
+      if constexpr (IsOverAligned)
+        return static_cast<Pointer>(::operator new(size * sizeof(T), std::align_val_t(alignof(T))));
+
+#ifdef SSTD_USE_HEAP_ALLOCATOR
+      void* ptr = Heap::Allocate(size * sizeof(T));
+      if (!ptr)
+        throw Exception();
+      return static_cast<Pointer>(ptr);
+#else
       return static_cast<Pointer>(::operator new(size * sizeof(T)));
+#endif
     }
 
     void Deallocate(Pointer ptr)
     {
+      if constexpr (IsOverAligned)
+      {
+        ::operator delete((void*)ptr, std::align_val_t(alignof(T)));
+        return;
+      }
+
+#ifdef SSTD_USE_HEAP_ALLOCATOR
+      Heap::Free((void*)ptr);
+#else
       ::operator delete((void*)ptr);
+#endif
     }
 
     void Construct(Pointer* ptr, const T& value)
@@ -39,4 +69,4 @@ namespace SSTD
       new (static_cast<void*>(ptr)) T{ Forward<Args>(args)... };
     }
   };
-}
\ No newline at end of file
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Memory.h"
+#include "Pattern.h"
+#include "Exception.h"
+
+namespace SSTD
+{
+  //Bump-pointer allocator, memory is taken from the system in big chunks and only given back as a whole with Reset/Rollback
+  //Chunks are kept after a Reset, so a arena that is reused every frame/request stops allocating after warming up
+  class LinearArena : public NonCopyable
+  {
+    struct Chunk
+    {
+      Chunk* next;
+      size_t size;
+
+      uint8* Begin() { return reinterpret_cast<uint8*>(this + 1); }
+      uint8* End() { return Begin() + size; }
+    };
+
+  public:
+    static constexpr size_t DefaultChunkSize = 64 * Byte::KB;
+    static constexpr size_t DefaultAlignment = alignof(long double) > alignof(void*) ? alignof(long double) : alignof(void*);
+
+    struct Marker
+    {
+      Chunk* chunk = nullptr;
+      uint8* position = nullptr;
+    };
+
+    explicit LinearArena(size_t chunk_size = DefaultChunkSize)
+      : m_ChunkSize(chunk_size)
+    {}
+
+    ~LinearArena()
+    {
+      Chunk* chunk = m_First;
+      while (chunk)
+      {
+        Chunk* next = chunk->next;
+        ::operator delete(static_cast<void*>(chunk));
+        chunk = next;
+      }
+    }
+
+    void* Allocate(size_t size, size_t alignment = DefaultAlignment)
+    {
+      uint8* ptr = Align(m_Position, alignment);
+      if (ptr + size <= m_End && m_Current)
+      {
+        m_Position = ptr + size;
+        return ptr;
+      }
+      return AllocateSlow(size, alignment);
+    }
+
+    //everything allocated after the marker was taken gets released
+    Marker GetMarker() const { return { m_Current, m_Position }; }
+
+    void Rollback(const Marker& marker)
+    {
+      if (!marker.chunk)
+      {
+        Reset();
+        return;
+      }
+      m_Current = marker.chunk;
+      m_Position = marker.position;
+      m_End = m_Current->End();
+    }
+
+    void Reset()
+    {
+      m_Current = m_First;
+      m_Position = m_Current ? m_Current->Begin() : nullptr;
+      m_End = m_Current ? m_Current->End() : nullptr;
+    }
+
+    size_t GetCapacity() const
+    {
+      size_t capacity = 0;
+      for (Chunk* chunk = m_First; chunk; chunk = chunk->next)
+        capacity += chunk->size;
+      return capacity;
+    }
+
+    //the arena of the innermost ArenaScope on this thread, nullptr outside of one
+    static LinearArena* GetCurrent() { return s_Current; }
+
+  private:
+    friend class ArenaScope;
+
+    static uint8* Align(uint8* ptr, size_t alignment)
+    {
+      return reinterpret_cast<uint8*>((reinterpret_cast<uintptr>(ptr) + alignment - 1) & ~(static_cast<uintptr>(alignment) - 1));
+    }
+
+    void* AllocateSlow(size_t size, size_t alignment)
+    {
+      //reuse the chunks we kept from before a Reset
+      while (m_Current && m_Current->next)
+      {
+        m_Current = m_Current->next;
+        m_Position = Align(m_Current->Begin(), alignment);
+        m_End = m_Current->End();
+        if (m_Position + size <= m_End)
+        {
+          uint8* ptr = m_Position;
+          m_Position += size;
+          return ptr;
+        }
+      }
+
+      size_t chunk_size = size + alignment > m_ChunkSize ? size + alignment : m_ChunkSize;
+      Chunk* chunk = static_cast<Chunk*>(::operator new(sizeof(Chunk) + chunk_size));
+      chunk->next = nullptr;
+      chunk->size = chunk_size;
+
+      if (m_Current)
+        m_Current->next = chunk;
+      else
+        m_First = chunk;
+
+      m_Current = chunk;
+      uint8* ptr = Align(chunk->Begin(), alignment);
+      m_Position = ptr + size;
+      m_End = chunk->End();
+      return ptr;
+    }
+
+    Chunk* m_First = nullptr;
+    Chunk* m_Current = nullptr;
+    uint8* m_Position = nullptr;
+    uint8* m_End = nullptr;
+    size_t m_ChunkSize;
+
+    static inline thread_local LinearArena* s_Current = nullptr;
+  };
+
+  //Makes arena the one every default constructed ArenaAllocator on this thread uses, until the scope ends
+  //The scope doesn't Reset the arena, whoever owns it decides when the memory can go
+  class ArenaScope : public NonCopyable
+  {
+  public:
+    ArenaScope(LinearArena& arena)
+      : m_Previous(Exchange(LinearArena::s_Current, &arena))
+    {}
+
+    ~ArenaScope()
+    {
+      LinearArena::s_Current = m_Previous;
+    }
+
+  private:
+    LinearArena* m_Previous;
+  };
+
+  //Drop-in for Allocator, e.g. Vector<int, size_t, ArenaAllocator>, Deallocate does nothing
+  //The arena is picked when the allocator is created, so a container has to die before its arena gets Reset
+  //Default construction takes the arena of the current ArenaScope, it can't throw since the containers default construct
+  //their allocator in noexcept constructors. Outside of a scope the arena is picked on the first Allocate instead, which
+  //throws if there is still no scope, there is no hidden fallback arena that would grow forever
+  template<typename T>
+  class ArenaAllocator
+  {
+  public:
+    using SizeType = size_t;
+    typedef T* Pointer;
+
+    explicit ArenaAllocator() noexcept : m_Arena(LinearArena::GetCurrent()) {}
+    explicit ArenaAllocator(LinearArena& arena) throw() : m_Arena(&arena) {}
+    ArenaAllocator(const ArenaAllocator& other) : m_Arena(other.m_Arena) {}
+
+    template<typename N>
+    explicit ArenaAllocator(const ArenaAllocator<N>& other) : m_Arena(other.GetArena()) {}
+
+    Pointer Allocate(size_t size)
+    {
+      if (!m_Arena) [[unlikely]]
+      {
+        m_Arena = LinearArena::GetCurrent();
+        if (!m_Arena)
+          throw Exception();
+      }
+      return static_cast<Pointer>(m_Arena->Allocate(size * sizeof(T), alignof(T)));
+    }
+
+    void Deallocate(Pointer) {}
+
+    template<typename U, typename ... Args>
+    void Construct(U* ptr, Args&&... args)
+    {
+      new (static_cast<void*>(ptr)) T{ Forward<Args>(args)... };
+    }
+
+    LinearArena* GetArena() const { return m_Arena; }
+
+  private:
+    LinearArena* m_Arena;
+  };
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Numeric.h"
+#include "Meta.h"
+#include "Utility.h"
+
+#include <string.h>
+
+namespace SSTD
+{
+  //Hasher<T> turns a key into 64 well mixed bits, hash tables take the low bits as well as the high ones
+  //Equals<T> compares keys, both can have extra overloads for other types so a table can be searched with those
+  //(a String keyed table looked up with a const char*), the overloads have to hash equal keys the same way
+  namespace HashFunctions
+  {
+    static constexpr uint64 Prime0 = 0x9E3779B97F4A7C15ull;
+    static constexpr uint64 Prime1 = 0xBF58476D1CE4E5B9ull;
+    static constexpr uint64 Prime2 = 0x94D049BB133111EBull;
+
+    static constexpr uint64 Rotate(uint64 value, uint32 count)
+    {
+      return (value << count) | (value >> (64 - count));
+    }
+
+    //every input bit reaches every output bit
+    static constexpr uint64 Mix(uint64 value)
+    {
+      value ^= value >> 30;
+      value *= Prime1;
+      value ^= value >> 27;
+      value *= Prime2;
+      value ^= value >> 31;
+      return value;
+    }
+
+    static inline uint64 Load64(const uint8* ptr)
+    {
+      uint64 value;
+      memcpy(&value, ptr, sizeof(value));
+      return value;
+    }
+
+    static inline uint64 Load32(const uint8* ptr)
+    {
+      uint32 value;
+      memcpy(&value, ptr, sizeof(value));
+      return value;
+    }
+
+    //two independent lanes over 16 byte blocks, the tail is read with overlapping loads instead of byte by byte
+    static inline uint64 Bytes(const void* data, size_t size, uint64 seed = 0)
+    {
+      const uint8* ptr = static_cast<const uint8*>(data);
+      uint64 a = seed ^ Prime0;
+      uint64 b = size * Prime1;
+
+      if (size > 16)
+      {
+        const uint8* last = ptr + size - 16;
+        while (ptr < last)
+        {
+          a = Rotate(a ^ (Load64(ptr) * Prime1), 31) * Prime0;
+          b = Rotate(b ^ (Load64(ptr + 8) * Prime2), 29) * Prime0;
+          ptr += 16;
+        }
+        a ^= Load64(last) * Prime1;
+        b ^= Load64(last + 8) * Prime2;
+      }
+      else if (size >= 8)
+      {
+        a ^= Load64(ptr) * Prime1;
+        b ^= Load64(ptr + size - 8) * Prime2;
+      }
+      else if (size >= 4)
+      {
+        a ^= Load32(ptr) * Prime1;
+        b ^= Load32(ptr + size - 4) * Prime2;
+      }
+      else if (size > 0)
+      {
+        a ^= (static_cast<uint64>(ptr[0]) << 16 | static_cast<uint64>(ptr[size >> 1]) << 8 | ptr[size - 1]) * Prime1;
+      }
+
+      return Mix(a ^ Rotate(b, 17));
+    }
+
+    template<typename CharType>
+    static constexpr size_t StringLength(const CharType* str)
+    {
+      if constexpr (IsSame<CharType, char>::valid)
+        if (!IsConstantEvaluated())
+          return strlen(str);
+
+      size_t size = 0;
+      while (str[size] != CharType{})
+        ++size;
+      return size;
+    }
+  }
+
+  template<typename T>
+  struct Hasher;
+
+  template<typename T>
+    requires IsNumeric<T>::valid
+  struct Hasher<T>
+  {
+    uint64 operator()(T value) const
+    {
+      if constexpr (IsSame<T, float>::valid || IsSame<T, double>::valid)
+      {
+        //0.0 and -0.0 compare equal, so they have to hash the same
+        if (value == 0)
+          value = 0;
+        return HashFunctions::Bytes(&value, sizeof(T));
+      }
+      else
+        return HashFunctions::Mix(static_cast<uint64>(value));
+    }
+  };
+
+  template<typename T>
+  struct Hasher<T*>
+  {
+    uint64 operator()(const T* value) const { return HashFunctions::Mix(reinterpret_cast<uint64>(value)); }
+  };
+
+  template<typename T>
+  struct Equals
+  {
+    template<typename U>
+    bool operator()(const T& lhs, const U& rhs) const { return lhs == rhs; }
+  };
+}
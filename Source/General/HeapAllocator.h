@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Exception.h"
+
+#include "Platform/Memory/Heap.h"
+
+namespace SSTD
+{
+  //Allocator on top of the SSTD Heap, also what Allocator uses when SSTD_USE_HEAP_ALLOCATOR is set
+  template<typename T>
+  class HeapAllocator
+  {
+  public:
+    using SizeType = size_t;
+    typedef T* Pointer;
+
+    explicit HeapAllocator() throw() {}
+    HeapAllocator(const HeapAllocator& other) {}
+
+    template<typename N>
+    explicit HeapAllocator(const HeapAllocator<N>& other) {}
+
+    Pointer Allocate(size_t size)
+    {
+      void* ptr = Heap::Allocate(size * sizeof(T));
+      if (!ptr)
+        throw Exception();
+      return static_cast<Pointer>(ptr);
+    }
+
+    void Deallocate(Pointer ptr)
+    {
+      Heap::Free(static_cast<void*>(ptr));
+    }
+
+    template<typename U, typename ... Args>
+    void Construct(U* ptr, Args&&... args)
+    {
+      new (static_cast<void*>(ptr)) T{ Forward<Args>(args)... };
+    }
+  };
+}
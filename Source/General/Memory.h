@@ -2,7 +2,14 @@
 #include "Numeric.h"
 #include "Utility.h"
 
-//#include <xmmintrin.h>
+#include "Platform/DefinePlatform.h"
+#include "Platform/Memory/MemoryKernels.h"
+
+#include <new>
+
+#ifdef PLATFORM_WIN64
+#include <intrin.h>
+#endif
 
 namespace SSTD
 {
@@ -79,31 +86,117 @@ namespace SSTD
     {
         return (val & ~(1UL << (sizeof(T) * 8 - 1UL))) | (bit << (sizeof(T) * 8 - 1UL));
     }
+
+    //undefined for 0
+    static inline uint32 CountTrailingZeros(uint64 val)
+    {
+#ifdef PLATFORM_WIN64
+      unsigned long index;
+      _BitScanForward64(&index, val);
+      return static_cast<uint32>(index);
+#else
+      return static_cast<uint32>(__builtin_ctzll(val));
+#endif
+    }
+
+    //undefined for 0
+    static inline uint32 CountLeadingZeros(uint64 val)
+    {
+#ifdef PLATFORM_WIN64
+      unsigned long index;
+      _BitScanReverse64(&index, val);
+      return static_cast<uint32>(63 - index);
+#else
+      return static_cast<uint32>(__builtin_clzll(val));
+#endif
+    }
+
+    static inline uint32 PopCount(uint64 val)
+    {
+#ifdef PLATFORM_WIN64
+      return static_cast<uint32>(__popcnt64(val));
+#else
+      return static_cast<uint32>(__builtin_popcountll(val));
+#endif
+    }
   }
 
+  //size is in elements, at runtime this goes through MemCopy, in a constant expression element by element
   template<typename T>
     requires IsTriviallyCopyable<T>::valid
   static constexpr T* TMemCpy(T* dst, const T* src, size_t size)
   {
-    //Copy bytewise is not th fastest but it will do the trick
-    char* d = reinterpret_cast<char*>(dst);
-    const char* s = reinterpret_cast<const char*>(src);
-
-    for (size_t i = 0; i < sizeof(T)*size; ++i)
-      d[i] = s[i];
+    if (IsConstantEvaluated())
+    {
+      for (size_t i = 0; i < size; ++i)
+        dst[i] = src[i];
+      return dst;
+    }
+    return static_cast<T*>(MemCopy(dst, src, sizeof(T) * size));
+  }
 
-    return dst;
+  //like TMemCpy, but dst and src may overlap
+  template<typename T>
+    requires IsTriviallyCopyable<T>::valid
+  static constexpr T* TMemMove(T* dst, const T* src, size_t size)
+  {
+    if (IsConstantEvaluated())
+    {
+      if (dst < src)
+      {
+        for (size_t i = 0; i < size; ++i)
+          dst[i] = src[i];
+      }
+      else
+      {
+        for (size_t i = size; i > 0; --i)
+          dst[i - 1] = src[i - 1];
+      }
+      return dst;
+    }
+    return static_cast<T*>(MemMove(dst, src, sizeof(T) * size));
   }
 
+  //copy constructs into uninitialized memory
   template<typename T>
     requires (!IsTriviallyCopyable<T>::valid)
-  static constexpr T* TMemCpy(T* dst, T* src, size_t size)
+  static constexpr T* TMemCpy(T* dst, const T* src, size_t size)
   {
     for (size_t i = 0; i < size; ++i)
     {
-      T& val = src[i];
+      const T& val = src[i];
       new(dst + i) T(val);
     }
     return dst;
   }
+
+  //Moves size objects from src into the uninitialized dst and ends their lifetime in src, the ranges may overlap
+  //trivially relocatable types are moved with a single MemMove
+  template<typename T>
+  static void Relocate(T* dst, T* src, size_t size)
+  {
+    if (dst == src || size == 0)
+      return;
+
+    if constexpr (IsTriviallyRelocatable<T>::valid)
+    {
+      MemMove(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T) * size);
+    }
+    else if (dst < src)
+    {
+      for (size_t i = 0; i < size; ++i)
+      {
+        new(dst + i) T(Move(src[i]));
+        src[i].~T();
+      }
+    }
+    else
+    {
+      for (size_t i = size; i > 0; --i)
+      {
+        new(dst + i - 1) T(Move(src[i - 1]));
+        src[i - 1].~T();
+      }
+    }
+  }
 }
\ No newline at end of file
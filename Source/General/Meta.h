@@ -55,4 +55,35 @@ namespace SSTD
 
   template<size_t A, size_t B>
   concept IsGreaterEqual = (A >= B);
+
+  template<size_t... Indices>
+  struct IndexSequence {};
+
+  template<size_t N, size_t... Indices>
+  struct MakeIndexSequenceHelper { using Type = typename MakeIndexSequenceHelper<N - 1, N - 1, Indices...>::Type; };
+
+  template<size_t... Indices>
+  struct MakeIndexSequenceHelper<0, Indices...> { using Type = IndexSequence<Indices...>; };
+
+  //IndexSequence<0, 1, ..., N - 1>
+  template<size_t N>
+  using MakeIndexSequence = typename MakeIndexSequenceHelper<N>::Type;
+
+  template<size_t Index, typename T, typename... Types>
+  struct TypeAtHelper { using Type = typename TypeAtHelper<Index - 1, Types...>::Type; };
+
+  template<typename T, typename... Types>
+  struct TypeAtHelper<0, T, Types...> { using Type = T; };
+
+  //the Index-th type of the pack
+  template<size_t Index, typename... Types>
+    requires (Index < sizeof...(Types))
+  using TypeAt = typename TypeAtHelper<Index, Types...>::Type;
+
+  //T if Condition holds, F otherwise
+  template<bool Condition, typename T, typename F>
+  struct Conditional { using Type = T; };
+
+  template<typename T, typename F>
+  struct Conditional<false, T, F> { using Type = F; };
 }
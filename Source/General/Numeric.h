@@ -37,6 +37,12 @@ namespace SSTD
   template<>
   struct IsNumeric<uint64> { static constexpr bool valid = true; };
 
+  //long is its own type on every compiler (and size_t is unsigned long on Linux)
+  template<>
+  struct IsNumeric<long> { static constexpr bool valid = true; };
+  template<>
+  struct IsNumeric<unsigned long> { static constexpr bool valid = true; };
+
  //Float, Double
   template<>
   struct IsNumeric<float> { static constexpr bool valid = true; };
@@ -78,6 +84,13 @@ namespace SSTD
     static constexpr int64 min = 0x80'00'00'00'00'00'00'00;
   };
 
+  template<>
+  struct NumericLimit<long>
+  {
+    static constexpr long max = static_cast<long>(~0UL >> 1);
+    static constexpr long min = -max - 1;
+  };
+
   template<>
   struct NumericLimit<uint8>
   {
@@ -106,6 +119,13 @@ namespace SSTD
     static constexpr uint64 min = 0;
   };
 
+  template<>
+  struct NumericLimit<unsigned long>
+  {
+    static constexpr unsigned long max = -1;
+    static constexpr unsigned long min = 0;
+  };
+
   template<size_t>
   struct NumericTypeFromSize;
 
@@ -0,0 +1,384 @@
+#pragma once
+#include "Algorithm.h"
+#include "Numeric.h"
+#include "Utility.h"
+#include "Memory.h"
+#include "Allocator.h"
+
+#include "Containers/Vector.h"
+#include "Platform/Threading/ThreadPool.h"
+
+#include <new>
+
+namespace SSTD
+{
+  //The algorithms split [first, last) into tasks of grain elements and run them on the pool, the calling thread helps
+  //grain 0 picks one that gives every thread a few tasks, pass a smaller one if the elements are expensive
+  //the iterators have to index contiguous memory, like the ones of Vector or plain pointers, ParallelFor also takes
+  //two integers and passes the index instead
+  namespace Parallel
+  {
+    static constexpr uint32 TasksPerThread = 4;
+    static constexpr size_t MinGrain = 2048;
+
+    static inline size_t GetGrain(ThreadPool& pool, size_t size, size_t grain)
+    {
+      if (grain == 0)
+      {
+        grain = size / (static_cast<size_t>(pool.GetConcurrency()) * TasksPerThread);
+        if (grain < MinGrain)
+          grain = MinGrain;
+      }
+
+      //Run counts its tasks in 32 bits
+      size_t min = size / 0xFFFFFFFFull + 1;
+      return grain < min ? min : grain;
+    }
+
+    static inline uint32 GetTaskCount(size_t size, size_t grain)
+    {
+      return static_cast<uint32>((size + grain - 1) / grain);
+    }
+
+    //calls func(begin, end, task) for every chunk of [0, size)
+    template<typename Func>
+    static void ForChunks(ThreadPool& pool, size_t size, size_t grain, Func& func)
+    {
+      uint32 tasks = GetTaskCount(size, grain);
+      pool.Run(tasks, [&](uint32 task)
+        {
+          size_t begin = task * grain;
+          size_t end = size - begin < grain ? size : begin + grain;
+          func(begin, end, task);
+        });
+    }
+
+    //one T per task, constructed by the task itself, so T doesn't need a default constructor
+    //a task that threw never called Set, only the entries that were set get destroyed
+    template<typename T>
+    class TaskResults : public NonCopyable
+    {
+    public:
+      explicit TaskResults(uint32 count)
+        : m_Data(m_Allocator.Allocate(count)), m_IsSet(static_cast<uint8>(0), count)
+      {}
+      ~TaskResults()
+      {
+        for (uint32 i = 0; i < m_IsSet.Size(); ++i)
+        {
+          if (m_IsSet[i])
+            m_Data[i].~T();
+        }
+        m_Allocator.Deallocate(m_Data);
+      }
+
+      template<typename U>
+      void Set(uint32 task, U&& value)
+      {
+        new (static_cast<void*>(m_Data + task)) T(Forward<U>(value));
+        m_IsSet[task] = 1;
+      }
+      T& operator[](uint32 task) { return m_Data[task]; }
+    private:
+      Allocator<T> m_Allocator{};
+      T* m_Data;
+      //one byte per task, so tasks that finish at the same time don't write the same word
+      Vector<uint8> m_IsSet;
+    };
+  }
+
+  //func(element) for every element, or func(index) for an integer range
+  template<class ContainerIterator, class Func>
+  static void ParallelFor(ThreadPool& pool, ContainerIterator first, ContainerIterator last, Func func, size_t grain = 0)
+  {
+    if (first == last)
+      return;
+
+    size_t size = static_cast<size_t>(last - first);
+    grain = Parallel::GetGrain(pool, size, grain);
+    if constexpr (IsNumeric<ContainerIterator>::valid)
+    {
+      auto chunk = [&](size_t begin, size_t end, uint32)
+        {
+          for (size_t i = begin; i < end; ++i)
+            func(static_cast<ContainerIterator>(first + i));
+        };
+      Parallel::ForChunks(pool, size, grain, chunk);
+    }
+    else
+    {
+      auto* data = &first[0];
+      auto chunk = [&](size_t begin, size_t end, uint32)
+        {
+          for (size_t i = begin; i < end; ++i)
+            func(data[i]);
+        };
+      Parallel::ForChunks(pool, size, grain, chunk);
+    }
+  }
+
+  //out[i] = func(first[i]), out has to hold as many elements as [first, last) and may be first itself
+  template<class ContainerIterator, class OutputIterator, class Func>
+  static void ParallelTransform(ThreadPool& pool, ContainerIterator first, ContainerIterator last, OutputIterator out, Func func, size_t grain = 0)
+  {
+    size_t size = static_cast<size_t>(last - first);
+    if (size == 0)
+      return;
+
+    auto* data = &first[0];
+    auto* result = &out[0];
+    grain = Parallel::GetGrain(pool, size, grain);
+    auto chunk = [&](size_t begin, size_t end, uint32)
+      {
+        for (size_t i = begin; i < end; ++i)
+          result[i] = func(data[i]);
+      };
+    Parallel::ForChunks(pool, size, grain, chunk);
+  }
+
+  //init op first[0] op first[1] ..., op has to be associative, the order of the elements is kept
+  template<class ContainerIterator, typename T, class Op>
+  static T ParallelReduce(ThreadPool& pool, ContainerIterator first, ContainerIterator last, T init, Op op, size_t grain = 0)
+  {
+    size_t size = static_cast<size_t>(last - first);
+    if (size == 0)
+      return init;
+
+    auto* data = &first[0];
+    grain = Parallel::GetGrain(pool, size, grain);
+    uint32 tasks = Parallel::GetTaskCount(size, grain);
+
+    Parallel::TaskResults<T> partials(tasks);
+    auto chunk = [&](size_t begin, size_t end, uint32 task)
+      {
+        T sum = static_cast<T>(data[begin]);
+        for (size_t i = begin + 1; i < end; ++i)
+          sum = op(sum, data[i]);
+        partials.Set(task, Move(sum));
+      };
+    Parallel::ForChunks(pool, size, grain, chunk);
+
+    for (uint32 task = 0; task < tasks; ++task)
+      init = op(init, partials[task]);
+    return init;
+  }
+
+  //inclusive scan, out[i] = first[0] op ... op first[i], op has to be associative and out may be first itself
+  //every element is read twice, once for the sums of the tasks and once for the scan itself
+  template<class ContainerIterator, class OutputIterator, class Op>
+  static void ParallelScan(ThreadPool& pool, ContainerIterator first, ContainerIterator last, OutputIterator out, Op op, size_t grain = 0)
+  {
+    size_t size = static_cast<size_t>(last - first);
+    if (size == 0)
+      return;
+
+    using T = typename RemoveReference<decltype(out[0])>::Type;
+    auto* data = &first[0];
+    auto* result = &out[0];
+    grain = Parallel::GetGrain(pool, size, grain);
+    uint32 tasks = Parallel::GetTaskCount(size, grain);
+
+    //the last task's sum is never needed
+    Parallel::TaskResults<T> sums(tasks - 1);
+    auto sum = [&](size_t begin, size_t end, uint32 task)
+      {
+        if (task + 1 == tasks)
+          return;
+
+        T total = static_cast<T>(data[begin]);
+        for (size_t i = begin + 1; i < end; ++i)
+          total = op(total, data[i]);
+        sums.Set(task, Move(total));
+      };
+    if (tasks > 1)
+      Parallel::ForChunks(pool, size, grain, sum);
+
+    //sums[task] becomes everything in front of task + 1
+    for (uint32 task = 1; task + 1 < tasks; ++task)
+      sums[task] = op(sums[task - 1], sums[task]);
+
+    auto scan = [&](size_t begin, size_t end, uint32 task)
+      {
+        T total = task == 0 ? static_cast<T>(data[begin]) : op(sums[task - 1], data[begin]);
+        result[begin] = total;
+        for (size_t i = begin + 1; i < end; ++i)
+        {
+          total = op(total, data[i]);
+          result[i] = total;
+        }
+      };
+    Parallel::ForChunks(pool, size, grain, scan);
+  }
+
+  //Parallel merge sort, not stable, cond must not throw: the scratch is freed if it does, but the range is left with
+  //elements missing or moved from, some of them are still in the scratch of an unfinished merge round
+  //the runs of grain elements are sorted with the default Sort first, then merged pairwise into a scratch buffer of
+  //the same size and back, every merge is cut into pieces along the merge path so that all threads take part until
+  //the last round
+  namespace Parallel
+  {
+    static constexpr size_t MinSortGrain = 16 * 1024;
+    static constexpr size_t MinMergePiece = 8 * 1024;
+
+    template<typename T>
+    static inline void RelocateOne(T* dst, T* src)
+    {
+      if constexpr (IsTriviallyCopyable<T>::valid)
+        *dst = *src;
+      else
+      {
+        new (static_cast<void*>(dst)) T(Move(*src));
+        src->~T();
+      }
+    }
+
+    //how many of the first k merged elements come from a, ties go to a
+    template<typename T, class CompareFunction>
+    static size_t MergePath(const T* a, size_t a_size, const T* b, size_t b_size, size_t k, CompareFunction& cond)
+    {
+      size_t low = k > b_size ? k - b_size : 0;
+      size_t high = k < a_size ? k : a_size;
+      while (low < high)
+      {
+        size_t i = low + (high - low) / 2;
+        if (!cond(b[k - i - 1], a[i]))
+          low = i + 1;
+        else
+          high = i;
+      }
+      return low;
+    }
+
+    //merges src[a, a_end) and src[b, b_end) into the uninitialized dst[out, ...), the elements are moved out of src
+    struct MergeTask
+    {
+      size_t a, a_end;
+      size_t b, b_end;
+      size_t out;
+    };
+
+    template<typename T, class CompareFunction>
+    static void Merge(T* src, T* dst, const MergeTask& task, CompareFunction& cond)
+    {
+      T* a = src + task.a;
+      T* a_end = src + task.a_end;
+      T* b = src + task.b;
+      T* b_end = src + task.b_end;
+      T* out = dst + task.out;
+      while (a != a_end && b != b_end)
+      {
+        if (cond(*b, *a))
+          RelocateOne(out++, b++);
+        else
+          RelocateOne(out++, a++);
+      }
+      while (a != a_end)
+        RelocateOne(out++, a++);
+      while (b != b_end)
+        RelocateOne(out++, b++);
+    }
+  }
+
+  template<class ContainerIterator, class CompareFunction>
+  static void Sort(ThreadPool& pool, ContainerIterator first, ContainerIterator last, CompareFunction cond, size_t grain = 0)
+  {
+    size_t size = static_cast<size_t>(last - first);
+    if (grain == 0)
+    {
+      grain = size / pool.GetConcurrency() + 1;
+      if (grain < Parallel::MinSortGrain)
+        grain = Parallel::MinSortGrain;
+    }
+    grain = Parallel::GetGrain(pool, size, grain);
+
+    if (size <= grain || pool.GetConcurrency() == 1)
+    {
+      Sort(first, last, cond);
+      return;
+    }
+
+    auto* data = &first[0];
+    using T = typename RemoveReference<decltype(*data)>::Type;
+
+    //bounds[r] is where run r starts, the last entry is size
+    Vector<size_t> bounds{};
+    for (size_t begin = 0; begin < size; begin += grain)
+      bounds.PushBack(begin);
+    bounds.PushBack(size);
+
+    pool.Run(static_cast<uint32>(bounds.Size() - 1), [&](uint32 run)
+      {
+        Sort(data + bounds[run], data + bounds[run + 1], cond);
+      });
+
+    //the scratch is freed on the way out, also when cond throws
+    struct Scratch
+    {
+      explicit Scratch(size_t count) : data(allocator.Allocate(count)) {}
+      ~Scratch() { allocator.Deallocate(data); }
+
+      Allocator<T> allocator{};
+      T* data;
+    };
+    Scratch scratch(size);
+    T* src = data;
+    T* dst = scratch.data;
+
+    size_t piece = size / (static_cast<size_t>(pool.GetConcurrency()) * Parallel::TasksPerThread);
+    if (piece < Parallel::MinMergePiece)
+      piece = Parallel::MinMergePiece;
+
+    Vector<Parallel::MergeTask> tasks{};
+    Vector<size_t> merged{};
+    while (bounds.Size() > 2)
+    {
+      //run 2p is merged with run 2p + 1, an odd run at the end with nothing
+      //the cuts are all found before anything moves, a task would otherwise search through elements another one
+      //is moving out of src
+      tasks.Clear();
+      merged.Clear();
+      for (size_t run = 0; run + 1 < bounds.Size(); run += 2)
+      {
+        size_t begin = bounds[run];
+        size_t middle = bounds[run + 1];
+        size_t end = run + 2 < bounds.Size() ? bounds[run + 2] : middle;
+
+        size_t i = 0;
+        for (size_t offset = 0; offset < end - begin; offset += piece)
+        {
+          size_t next = end - begin - offset < piece ? end - begin : offset + piece;
+          size_t i_next = Parallel::MergePath(src + begin, middle - begin, src + middle, end - middle, next, cond);
+          tasks.PushBack(Parallel::MergeTask{ begin + i, begin + i_next, middle + offset - i, middle + next - i_next, begin + offset });
+          i = i_next;
+        }
+        merged.PushBack(begin);
+      }
+      merged.PushBack(size);
+
+      pool.Run(static_cast<uint32>(tasks.Size()), [&](uint32 index)
+        {
+          Parallel::Merge(src, dst, tasks[index], cond);
+        });
+
+      Swap(src, dst);
+      Swap(bounds, merged);
+    }
+
+    if (src != data)
+    {
+      auto chunk = [&](size_t begin, size_t end, uint32)
+        {
+          for (size_t i = begin; i < end; ++i)
+            Parallel::RelocateOne(data + i, src + i);
+        };
+      Parallel::ForChunks(pool, size, Parallel::GetGrain(pool, size, 0), chunk);
+    }
+  }
+
+  template<class ContainerIterator>
+  static void Sort(ThreadPool& pool, ContainerIterator first, ContainerIterator last)
+  {
+    using T = typename RemoveReference<decltype(*first)>::Type;
+    Sort(pool, first, last, Less<T>());
+  }
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Memory.h"
+#include "Pattern.h"
+#include "Exception.h"
+
+#include "Platform/Threading/Mutex.h"
+#include "Platform/Threading/Lock.h"
+
+#include <new>
+
+namespace SSTD
+{
+  //Shared free-list for all slots of one size, slabs are carved into slots and never given back
+  //Every thread keeps a small cache (magazine) in front of it, so most allocations and frees never touch the lock
+  template<size_t SlotSize, size_t SlotAlignment>
+  class ObjectPool : public NonCopyable
+  {
+    struct Slot
+    {
+      Slot* next;
+    };
+
+    struct Slab
+    {
+      Slab* next;
+    };
+
+    struct ThreadCache
+    {
+      ~ThreadCache()
+      {
+        if (head)
+          ObjectPool::Get().Release(head);
+      }
+
+      Slot* head = nullptr;
+      uint32 count = 0;
+    };
+
+  public:
+    //a thread hands BatchSize slots back to the pool once its cache holds 2 * BatchSize
+    static constexpr uint32 BatchSize = 64;
+    static constexpr size_t SlabSize = 64 * Byte::KB;
+
+    //never destroyed, thread caches hand their slots back when their thread exits and that can be after static destruction
+    static ObjectPool& Get()
+    {
+      static ObjectPool* s_Pool = new ObjectPool();
+      return *s_Pool;
+    }
+
+    void* Allocate()
+    {
+      ThreadCache& cache = GetThreadCache();
+      if (!cache.head)
+        Refill(cache);
+
+      Slot* slot = cache.head;
+      cache.head = slot->next;
+      --cache.count;
+      return slot;
+    }
+
+    void Deallocate(void* ptr)
+    {
+      ThreadCache& cache = GetThreadCache();
+      Slot* slot = static_cast<Slot*>(ptr);
+      slot->next = cache.head;
+      cache.head = slot;
+
+      if (++cache.count >= 2 * BatchSize)
+      {
+        //keep the hot half, give the rest to the other threads
+        Slot* last = cache.head;
+        for (uint32 i = 1; i < BatchSize; ++i)
+          last = last->next;
+
+        Slot* rest = last->next;
+        last->next = nullptr;
+        Release(rest);
+        cache.count = BatchSize;
+      }
+    }
+
+  private:
+    //the slab header takes the first slot, so the rest stays aligned
+    static constexpr size_t HeaderSize = sizeof(Slab) > SlotAlignment ? ((sizeof(Slab) + SlotAlignment - 1) / SlotAlignment) * SlotAlignment : SlotAlignment;
+    static constexpr size_t SlabSlotCount = SlotSize >= sizeof(Slot) && SlabSize > HeaderSize ? (SlabSize - HeaderSize) / SlotSize : 0;
+
+    static_assert((SlotAlignment & (SlotAlignment - 1)) == 0, "SlotAlignment has to be a power of two");
+    static_assert(SlotAlignment >= alignof(Slot), "SlotAlignment can't be lower than the one of the free-list link");
+    static_assert(SlotSize >= sizeof(Slot), "SlotSize can't be smaller than the free-list link");
+    static_assert(SlotSize % SlotAlignment == 0, "SlotSize has to be a multiple of SlotAlignment");
+    static_assert(SlabSlotCount > 0, "A slab has to hold at least one slot");
+
+    ObjectPool() = default;
+
+    static ThreadCache& GetThreadCache()
+    {
+      static thread_local ThreadCache s_Cache;
+      return s_Cache;
+    }
+
+    void Refill(ThreadCache& cache)
+    {
+      Lock<Mutex> lock(m_Mutex);
+
+      if (!m_Free)
+        Grow();
+
+      Slot* last = m_Free;
+      uint32 count = 1;
+      while (count < BatchSize && last->next)
+      {
+        last = last->next;
+        ++count;
+      }
+
+      cache.head = m_Free;
+      cache.count = count;
+      m_Free = last->next;
+      last->next = nullptr;
+    }
+
+    void Release(Slot* head)
+    {
+      Slot* last = head;
+      while (last->next)
+        last = last->next;
+
+      Lock<Mutex> lock(m_Mutex);
+      last->next = m_Free;
+      m_Free = head;
+    }
+
+    void Grow()
+    {
+      uint8* memory = static_cast<uint8*>(::operator new(SlabSize, std::align_val_t{ SlotAlignment }));
+      Slab* slab = reinterpret_cast<Slab*>(memory);
+      slab->next = m_Slabs;
+      m_Slabs = slab;
+
+      uint8* slots = memory + HeaderSize;
+      for (size_t i = 0; i < SlabSlotCount; ++i)
+      {
+        Slot* slot = reinterpret_cast<Slot*>(slots + i * SlotSize);
+        slot->next = m_Free;
+        m_Free = slot;
+      }
+    }
+
+    Mutex m_Mutex;
+    Slot* m_Free = nullptr;
+    Slab* m_Slabs = nullptr;
+  };
+
+  //Allocator for single objects (list nodes, control blocks ...), every T of the same size and alignment shares one ObjectPool
+  //It can only hand out one object at a time, so it doesn't work for Vector or String
+  template<typename T>
+  class PoolAllocator
+  {
+    static constexpr size_t SlotAlignment = alignof(T) > alignof(void*) ? alignof(T) : alignof(void*);
+    static constexpr size_t SlotSize = ((sizeof(T) + SlotAlignment - 1) / SlotAlignment) * SlotAlignment;
+
+  public:
+    using SizeType = size_t;
+    using PoolType = ObjectPool<SlotSize, SlotAlignment>;
+    typedef T* Pointer;
+
+    explicit PoolAllocator() throw() {}
+    PoolAllocator(const PoolAllocator& other) {}
+
+    template<typename N>
+    explicit PoolAllocator(const PoolAllocator<N>& other) {}
+
+    Pointer Allocate(size_t size)
+    {
+      if (size != 1)
+        throw Exception();
+      return static_cast<Pointer>(PoolType::Get().Allocate());
+    }
+
+    void Deallocate(Pointer ptr)
+    {
+      if (ptr)
+        PoolType::Get().Deallocate(static_cast<void*>(ptr));
+    }
+
+    template<typename U, typename ... Args>
+    void Construct(U* ptr, Args&&... args)
+    {
+      new (static_cast<void*>(ptr)) T{ Forward<Args>(args)... };
+    }
+  };
+}
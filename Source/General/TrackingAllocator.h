@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Memory.h"
+
+#include "Platform/Memory/AllocationTracker.h"
+
+namespace SSTD
+{
+  //Wraps Inner and books every allocation in the AllocationTracker, on the tag of the current AllocationTagScope
+  //Each block gets a small header (size, tag, time), so Vector<T, size_t, TrackingAllocator> just works
+  //Inner only hands out bytes, so the user pointer is aligned up by hand and the header remembers how far
+  template<typename T, template<typename> typename Inner = Allocator>
+  class TrackingAllocator
+  {
+    struct Header
+    {
+      uint64 size : 48;
+      uint64 tag : 16;
+      uint64 time;
+      uint64 offset;
+    };
+
+    static constexpr size_t UserAlignment = alignof(T) > alignof(Header) ? alignof(T) : alignof(Header);
+
+  public:
+    using SizeType = size_t;
+    typedef T* Pointer;
+
+    explicit TrackingAllocator() throw() {}
+    TrackingAllocator(const TrackingAllocator& other) : m_Inner(other.m_Inner) {}
+
+    template<typename N>
+    explicit TrackingAllocator(const TrackingAllocator<N, Inner>& other) {}
+
+    Pointer Allocate(size_t size)
+    {
+      size_t bytes = size * sizeof(T);
+      uint8* block = m_Inner.Allocate(sizeof(Header) + UserAlignment - 1 + bytes);
+      uint8* user = reinterpret_cast<uint8*>((reinterpret_cast<uintptr>(block) + sizeof(Header) + UserAlignment - 1) & ~(static_cast<uintptr>(UserAlignment) - 1));
+
+      uint16 tag = AllocationTracker::t_CurrentTag;
+      Header* header = reinterpret_cast<Header*>(user) - 1;
+      header->size = bytes;
+      header->tag = tag;
+      header->time = AllocationTracker::OnAllocate(tag, bytes);
+      header->offset = static_cast<uint64>(user - block);
+      return reinterpret_cast<Pointer>(user);
+    }
+
+    void Deallocate(Pointer ptr)
+    {
+      if (!ptr)
+        return;
+
+      Header* header = reinterpret_cast<Header*>(ptr) - 1;
+      uint8* block = reinterpret_cast<uint8*>(ptr) - header->offset;
+      AllocationTracker::OnDeallocate(static_cast<uint16>(header->tag), header->size, header->time);
+      m_Inner.Deallocate(block);
+    }
+
+    template<typename U, typename ... Args>
+    void Construct(U* ptr, Args&&... args)
+    {
+      new (static_cast<void*>(ptr)) T{ Forward<Args>(args)... };
+    }
+
+  private:
+    Inner<uint8> m_Inner{};
+  };
+}
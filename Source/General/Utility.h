@@ -28,6 +28,28 @@ namespace SSTD
     static constexpr bool valid = __is_trivially_copyable(T);
   };
 
+  //gcc only got __is_trivially_destructible with 14, clang deprecates the old __has_trivial_destructor
+  template<typename T>
+  struct IsTriviallyDestructible
+  {
+#if defined(_MSC_VER) || defined(__clang__)
+    static constexpr bool valid = __is_trivially_destructible(T);
+#elif defined(__has_builtin) && __has_builtin(__is_trivially_destructible)
+    static constexpr bool valid = __is_trivially_destructible(T);
+#else
+    static constexpr bool valid = __has_trivial_destructor(T);
+#endif
+  };
+
+  //A type is trivially relocatable if moving it to a new address and forgetting the old one is the same as copying its bytes,
+  //true for everything that doesn't point into itself (most strings, smart pointers, containers)
+  //Opt in by specializing it, e.g. template<> struct IsTriviallyRelocatable<MyType> { static constexpr bool valid = true; };
+  template<typename T>
+  struct IsTriviallyRelocatable
+  {
+    static constexpr bool valid = __is_trivially_copyable(T);
+  };
+
   template<typename T>
   struct IsPointer
   {
@@ -49,6 +71,18 @@ namespace SSTD
   template<typename T>
   struct IsReference<T&&> { static constexpr bool valid = true; };
 
+  //true while the compiler evaluates a constant expression, lets constexpr functions pick a faster runtime path
+  static constexpr bool IsConstantEvaluated() noexcept
+  {
+    return __builtin_is_constant_evaluated();
+  }
+
+  template<typename T>
+  static constexpr typename RemoveReference<T>::Type&& Move(T&& arg) noexcept
+  {
+    return static_cast<typename RemoveReference<T>::Type&&>(arg);
+  }
+
   template <class T>
   static constexpr T&& Forward(typename RemoveReference<T>::Type& t) noexcept
   {
@@ -76,10 +110,4 @@ namespace SSTD
     obj = Move(val);
     return out;
   }
-
-  template<typename T>
-  static constexpr typename RemoveReference<T>::Type&& Move(T&& arg) noexcept
-  {
-    return static_cast<typename RemoveReference<T>::Type&&>(arg);
-  }
 }
\ No newline at end of file
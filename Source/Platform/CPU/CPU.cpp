@@ -0,0 +1,137 @@
+#include "CPU.h"
+#include "Platform/IncludePlatform.h"
+
+#ifdef ARCH_X64
+#ifdef PLATFORM_WIN64
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace SSTD
+{
+#ifdef ARCH_X64
+  struct CpuidResult
+  {
+    uint32 eax, ebx, ecx, edx;
+  };
+
+  static CpuidResult Cpuid(uint32 leaf, uint32 subleaf = 0)
+  {
+    CpuidResult result{};
+#ifdef PLATFORM_WIN64
+    int regs[4];
+    __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+    result = { static_cast<uint32>(regs[0]), static_cast<uint32>(regs[1]), static_cast<uint32>(regs[2]), static_cast<uint32>(regs[3]) };
+#else
+    __cpuid_count(leaf, subleaf, result.eax, result.ebx, result.ecx, result.edx);
+#endif
+    return result;
+  }
+
+  static uint64 ReadXCR0()
+  {
+#ifdef PLATFORM_WIN64
+    return _xgetbv(0);
+#else
+    uint32 low, high;
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return (static_cast<uint64>(high) << 32) | low;
+#endif
+  }
+
+  static CPU::Features QueryFeatures()
+  {
+    CPU::Features features;
+    uint32 max_leaf = Cpuid(0).eax;
+
+    CpuidResult leaf1 = Cpuid(1);
+    features.sse2 = (leaf1.edx >> 26) & 1;
+    features.sse42 = (leaf1.ecx >> 20) & 1;
+    features.popcnt = (leaf1.ecx >> 23) & 1;
+
+    //the OS has to save the wide registers on a context switch, otherwise we can't use them
+    bool os_xsave = (leaf1.ecx >> 27) & 1;
+    uint64 xcr0 = os_xsave ? ReadXCR0() : 0;
+    bool ymm_state = (xcr0 & 0x6) == 0x6;
+    bool zmm_state = (xcr0 & 0xE6) == 0xE6;
+
+    if (max_leaf >= 7)
+    {
+      CpuidResult leaf7 = Cpuid(7);
+      features.bmi2 = (leaf7.ebx >> 8) & 1;
+      features.erms = (leaf7.ebx >> 9) & 1;
+      features.avx2 = ymm_state && ((leaf7.ebx >> 5) & 1);
+      features.avx512f = zmm_state && ((leaf7.ebx >> 16) & 1);
+      features.avx512bw = features.avx512f && ((leaf7.ebx >> 30) & 1);
+    }
+    return features;
+  }
+
+  static size_t QueryLastLevelCacheSize()
+  {
+    //leaf 4 on Intel, 0x8000001D on AMD, both list the cache levels in the same format
+    uint32 leaf = 4;
+    if (Cpuid(0x80000000).eax >= 0x8000001D && Cpuid(0).ebx == 0x68747541) //"Auth"enticAMD
+      leaf = 0x8000001D;
+
+    size_t size = 0;
+    for (uint32 index = 0; index < 16; ++index)
+    {
+      CpuidResult cache = Cpuid(leaf, index);
+      if ((cache.eax & 0x1F) == 0)
+        break;
+
+      size_t ways = ((cache.ebx >> 22) & 0x3FF) + 1;
+      size_t partitions = ((cache.ebx >> 12) & 0x3FF) + 1;
+      size_t line_size = (cache.ebx & 0xFFF) + 1;
+      size_t sets = static_cast<size_t>(cache.ecx) + 1;
+      size_t level_size = ways * partitions * line_size * sets;
+      if (level_size > size)
+        size = level_size;
+    }
+    return size;
+  }
+#else
+  static CPU::Features QueryFeatures()
+  {
+    return {};
+  }
+
+  static size_t QueryLastLevelCacheSize()
+  {
+    return 0;
+  }
+#endif
+
+  static uint32 QueryLogicalCoreCount()
+  {
+#ifdef PLATFORM_WIN64
+    DWORD count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+#elif  PLATFORM_LINUX
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    long count = 1;
+#endif
+    return count > 0 ? static_cast<uint32>(count) : 1;
+  }
+
+  const CPU::Features& CPU::GetFeatures()
+  {
+    static const Features s_Features = QueryFeatures();
+    return s_Features;
+  }
+
+  size_t CPU::GetLastLevelCacheSize()
+  {
+    static const size_t s_Size = QueryLastLevelCacheSize();
+    return s_Size;
+  }
+
+  uint32 CPU::GetLogicalCoreCount()
+  {
+    static const uint32 s_Count = QueryLogicalCoreCount();
+    return s_Count;
+  }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Platform/DefinePlatform.h"
+
+#include "General/Numeric.h"
+
+namespace SSTD
+{
+  //What the processor we run on can do, queried once
+  namespace CPU
+  {
+    struct Features
+    {
+      bool sse2 = false;
+      bool sse42 = false;
+      bool popcnt = false;
+      bool bmi2 = false;
+      bool avx2 = false;    //only set if the OS saves the ymm registers too
+      bool avx512f = false; //same for zmm
+      bool avx512bw = false;
+      bool erms = false;
+    };
+
+    const Features& GetFeatures();
+
+    //size of the biggest (shared) cache level in bytes, 0 if unknown
+    size_t GetLastLevelCacheSize();
+
+    //logical cores the OS has online, at least 1
+    uint32 GetLogicalCoreCount();
+  }
+}
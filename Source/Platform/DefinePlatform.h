@@ -29,11 +29,16 @@
 #elif __linux__
 // linux
 #define PLATFORM_LINUX 1
-#error "Linux is not supported"
 #else
 #error "Unknown compiler"
 #endif
 
+#if defined(_M_X64) || defined(__x86_64__)
+#define ARCH_X64 1
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#define ARCH_ARM64 1
+#endif
+
 /*
 * TEMPLATE
 #ifdef PLATFORM_WIN64
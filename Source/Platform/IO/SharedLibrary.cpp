@@ -3,38 +3,88 @@
 #include "Platform/IncludePlatform.h"
 #include "General/Memory.h"
 
+#ifdef PLATFORM_LINUX
+#include <dlfcn.h>
+#include <sys/stat.h>
+#endif
+
 namespace SSTD
 {
-#ifdef PLATFORM_WIN64
-
   SharedLibrary::SharedLibrary(const String& path)
     : m_FilePath(path)
   {
   }
 
   SharedLibrary::SharedLibrary(const SharedLibrary& other)
+    : m_FilePath(other.m_FilePath)
   {
+    if (other.IsLoaded())
+      Load();
+    CopyFunctions(other);
   }
 
   SharedLibrary::SharedLibrary(SharedLibrary&& other) noexcept
+    : m_FilePath(Move(other.m_FilePath)), m_FuncPtrs(Move(other.m_FuncPtrs)), m_Handle(other.m_Handle), m_LastWriteTime(other.m_LastWriteTime)
   {
+    other.m_Handle = nullptr;
   }
 
   SharedLibrary::~SharedLibrary()
   {
+    DestroyFunctions();
     Free();
   }
 
   SharedLibrary& SharedLibrary::operator=(const SharedLibrary& other)
   {
+    if (this == &other)
+      return *this;
+
+    DestroyFunctions();
+    Free();
+    m_FilePath = other.m_FilePath;
+    if (other.IsLoaded())
+      Load();
+    CopyFunctions(other);
     return *this;
   }
 
   SharedLibrary& SharedLibrary::operator=(SharedLibrary&& other) noexcept
   {
+    if (this == &other)
+      return *this;
+
+    DestroyFunctions();
+    Free();
+    m_FilePath = Move(other.m_FilePath);
+    m_FuncPtrs = Move(other.m_FuncPtrs);
+    m_Handle = other.m_Handle;
+    m_LastWriteTime = other.m_LastWriteTime;
+    other.m_Handle = nullptr;
     return *this;
   }
 
+  //the copy gets its own handle, so every function is looked up again
+  void SharedLibrary::CopyFunctions(const SharedLibrary& other)
+  {
+    m_FuncPtrs.Reserve(other.m_FuncPtrs.Size());
+    for (ICallable* f : other.m_FuncPtrs)
+    {
+      ICallable* copy = f->Clone();
+      copy->ReloadFrom(m_Handle);
+      m_FuncPtrs.PushBack(copy);
+    }
+  }
+
+  void SharedLibrary::DestroyFunctions()
+  {
+    for (ICallable* f : m_FuncPtrs)
+      delete f;
+    m_FuncPtrs.Clear();
+  }
+
+#ifdef PLATFORM_WIN64
+
   void SharedLibrary::Load()
   {
     m_Handle = LoadLibraryA(m_FilePath.CStr());
@@ -55,7 +105,9 @@ namespace SSTD
   }
   void SharedLibrary::Free()
   {
-    FreeLibrary(static_cast<HMODULE>(m_Handle));
+    if (m_Handle)
+      FreeLibrary(static_cast<HMODULE>(m_Handle));
+    m_Handle = nullptr;
   }
 
   void* SharedLibrary::LoadFunction(const String& funcname, void* handle)
@@ -68,5 +120,45 @@ namespace SSTD
 #elif  PLATFORM_IPHONE
 #elif  PLATFORM_MAC
 #elif  PLATFORM_LINUX
+
+  static int64 GetLastWriteTime(const String& path)
+  {
+    struct stat info;
+    if (stat(path.CStr(), &info) != 0)
+      return 0;
+    return static_cast<int64>(info.st_mtim.tv_sec) * 1000000000ll + info.st_mtim.tv_nsec;
+  }
+
+  void SharedLibrary::Load()
+  {
+    m_Handle = dlopen(m_FilePath.CStr(), RTLD_NOW | RTLD_LOCAL);
+    if (m_Handle)
+      m_LastWriteTime = GetLastWriteTime(m_FilePath);
+  }
+
+  void SharedLibrary::TryHotReload()
+  {
+    int64 time = GetLastWriteTime(m_FilePath);
+    if (time != m_LastWriteTime)
+    {
+      //dlopen hands back the old image as long as it is still open
+      Free();
+      Load();
+      for (auto& f : m_FuncPtrs)
+        f->ReloadFrom(m_Handle); //this way we keep the same-handles :D
+    }
+  }
+
+  void SharedLibrary::Free()
+  {
+    if (m_Handle)
+      dlclose(m_Handle);
+    m_Handle = nullptr;
+  }
+
+  void* SharedLibrary::LoadFunction(const String& funcname, void* handle)
+  {
+    return handle ? dlsym(handle, funcname.CStr()) : nullptr;
+  }
 #endif
 }
\ No newline at end of file
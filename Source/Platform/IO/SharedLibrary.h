@@ -2,6 +2,7 @@
 
 #include "General/Numeric.h"
 #include "General/Allocator.h"
+#include "General/Exception.h"
 
 #include "Containers/String.h"
 #include "Containers/Vector.h"
@@ -29,6 +30,9 @@ namespace SSTD
   {
     struct ICallable
     {
+      ICallable(const String& funcname) : func_name(funcname) {}
+      virtual ~ICallable() = default;
+      virtual ICallable* Clone() const = 0;
       virtual void ReloadFrom(void* handle) = 0;
       const String func_name = "Invalid";
     };
@@ -38,8 +42,9 @@ namespace SSTD
     {
       typedef ReturnValue(*Apply)(Args...);
 
-      Callable(const String& funcname, Apply f) : func_name(func_name), func(f) {}
-      virtual void ReloadFrom(void* handle) override final { func = LoadFunction(func_name, handle); }
+      Callable(const String& funcname, void* f) : ICallable(funcname), func(reinterpret_cast<Apply>(f)) {}
+      virtual ICallable* Clone() const override final { return new Callable(*this); }
+      virtual void ReloadFrom(void* handle) override final { func = reinterpret_cast<Apply>(SharedLibrary::LoadFunction(this->func_name, handle)); }
       Apply func = nullptr;
     };
 
@@ -52,47 +57,58 @@ namespace SSTD
     SharedLibrary& operator=(const SharedLibrary& other);
     SharedLibrary& operator=(SharedLibrary&& other) noexcept;
 
+    //the arguments are taken by value, so they match the types the function was loaded with
     template<typename ReturnValue, typename ... Args>
-    ReturnValue operator()(const SharedLibaryFunctionHandle& func_handle, Args&&... args) { return CallFunction<ReturnValue, Args>(func_handle, Forward<Args>(args)...); }
+    ReturnValue operator()(const SharedLibaryFunctionHandle& func_handle, Args... args) { return CallFunction<ReturnValue, Args...>(func_handle, args...); }
 
     void Load();
     void TryHotReload();
     void Free();
 
+    bool IsLoaded() const { return m_Handle != nullptr; }
+
     template<typename ReturnValue, typename ... Args>
     SharedLibaryFunctionHandle LoadFunction(const String& funcname)
     {
-      m_FuncPtrs.EmplaceBack<Callable<ReturnValue, Args>>(funcname, LoadFunction(funcname, m_Handle));
-      return { m_FuncPtrs.Size() - 1 };
+      m_FuncPtrs.EmplaceBack(new Callable<ReturnValue, Args...>(funcname, LoadFunction(funcname, m_Handle)));
+      return { static_cast<uint32>(m_FuncPtrs.Size() - 1) };
     }
 
+    //checks the handle and the signature before calling
     template<typename ReturnValue, typename ... Args>
-    ReturnValue SafeCall(const SharedLibaryFunctionHandle& func_handle, Args&&... args)
+    ReturnValue SafeCall(const SharedLibaryFunctionHandle& func_handle, Args... args)
     {
-      if(m_FuncPtrs.Size() < func_handle.id)
-        return dynamic_cast<Callable<ReturnValue, Args>*>(m_FuncPtrs[func_handle])->func(Forward<Args>(args)...);
-      throw;
+      if (func_handle.id < m_FuncPtrs.Size())
+      {
+        auto* callable = dynamic_cast<Callable<ReturnValue, Args...>*>(m_FuncPtrs[func_handle.id]);
+        if (callable && callable->func)
+          return callable->func(args...);
+      }
+      throw Exception();
     }
 
     template<typename ReturnValue, typename ... Args>
-    ReturnValue CallFunction(const SharedLibaryFunctionHandle& func_handle, Args&&... args)
+    ReturnValue CallFunction(const SharedLibaryFunctionHandle& func_handle, Args... args)
     {
-      return dynamic_cast<Callable<ReturnValue, Args>*>(m_FuncPtrs[func_handle.id])->func(Forward<Args>(args)...);
+      return static_cast<Callable<ReturnValue, Args...>*>(m_FuncPtrs[func_handle.id])->func(args...);
     }
 
   private:
     static void* LoadFunction(const String& funcname, void* handle);
+    void CopyFunctions(const SharedLibrary& other);
+    void DestroyFunctions();
 
     String m_FilePath;
     Vector<ICallable*> m_FuncPtrs;
-#ifdef PLATFORM_WIN64
     void* m_Handle = nullptr;
-    uint64 m_LastWriteTime;
+#ifdef PLATFORM_WIN64
+    uint64 m_LastWriteTime = 0;
 #elif  PLATFORM_WIN32
 #elif  PLATFORM_IPHONE_SIM
 #elif  PLATFORM_IPHONE
 #elif  PLATFORM_MAC
 #elif  PLATFORM_LINUX
+    int64 m_LastWriteTime = 0;
 #endif
   };
 }
\ No newline at end of file
@@ -11,4 +11,7 @@
 #elif  PLATFORM_IPHONE
 #elif  PLATFORM_MAC
 #elif  PLATFORM_LINUX
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
 #endif
\ No newline at end of file
@@ -0,0 +1,283 @@
+#include "AllocationTracker.h"
+
+#include "Platform/IncludePlatform.h"
+#include "Platform/Threading/Atomic.h"
+#include "Platform/Threading/Mutex.h"
+#include "Platform/Threading/Lock.h"
+#include "Math/Math.h"
+
+#include <stdio.h>
+#ifdef PLATFORM_LINUX
+#include <time.h>
+#endif
+
+namespace SSTD
+{
+  namespace
+  {
+    //a thread only publishes its live bytes once they moved this far, that keeps the shared counter cold
+    static constexpr int64 FlushBytes = 64 * 1024;
+
+    struct ThreadCounter
+    {
+      a_uint64 allocations;
+      a_uint64 deallocations;
+      a_uint64 bytes_allocated;
+      a_uint64 bytes_freed;
+      a_uint64 lifetime[AllocationTracker::LifetimeBucketCount];
+    };
+
+    //only the owning thread writes, so a relaxed load + store is enough and stays off the bus
+    static void Add(a_uint64& counter, uint64 value)
+    {
+      counter.Store(counter.Load(MemoryOrder::Relaxed) + value, MemoryOrder::Relaxed);
+    }
+
+    //blocks are never freed, a dead thread's block (and its counts) is handed to the next new thread
+    struct alignas(64) ThreadBlock
+    {
+      ThreadCounter tags[AllocationTracker::MaxTags];
+      a_int64 pending_live;
+      uint32 sample_countdown = AllocationTracker::LifetimeSampleRate;
+      ThreadBlock* next = nullptr;
+      ThreadBlock* next_free = nullptr;
+    };
+
+    //tags are usually registered from static constructors, so everything here has to work before our own statics are set up
+    static Mutex& GetMutex()
+    {
+      static Mutex mutex;
+      return mutex;
+    }
+
+    static ThreadBlock* s_Blocks = nullptr;
+    static ThreadBlock* s_FreeBlocks = nullptr;
+
+    static const char* s_TagNames[AllocationTracker::MaxTags] = { "untagged" };
+    static a_uint32 s_TagCount = 1;
+
+    static a_int64 s_Live;
+    static a_int64 s_Peak;
+
+    static thread_local ThreadBlock* t_Block = nullptr;
+
+    static void Flush(ThreadBlock* block)
+    {
+      int64 pending = block->pending_live.Exchange(0, MemoryOrder::Relaxed);
+      int64 live = s_Live.FetchAdd(pending, MemoryOrder::Relaxed) + pending;
+      s_Peak.FetchMax(live, MemoryOrder::Relaxed);
+    }
+
+    struct BlockOwner
+    {
+      ~BlockOwner()
+      {
+        if (!t_Block)
+          return;
+
+        Flush(t_Block);
+        Lock<Mutex> lock(GetMutex());
+        t_Block->next_free = s_FreeBlocks;
+        s_FreeBlocks = t_Block;
+        t_Block = nullptr;
+      }
+    };
+
+    static thread_local BlockOwner t_BlockOwner;
+
+    static ThreadBlock* GetBlock()
+    {
+      if (t_Block)
+        return t_Block;
+
+      Lock<Mutex> lock(GetMutex());
+      if (s_FreeBlocks)
+      {
+        t_Block = s_FreeBlocks;
+        s_FreeBlocks = s_FreeBlocks->next_free;
+      }
+      else
+      {
+        t_Block = new ThreadBlock();
+        t_Block->next = s_Blocks;
+        s_Blocks = t_Block;
+      }
+
+      (void)&t_BlockOwner;
+      return t_Block;
+    }
+
+    static void UpdateLive(ThreadBlock* block, int64 delta)
+    {
+      int64 pending = block->pending_live.Load(MemoryOrder::Relaxed) + delta;
+      block->pending_live.Store(pending, MemoryOrder::Relaxed);
+      if (pending >= FlushBytes || pending <= -FlushBytes)
+        Flush(block);
+    }
+
+    static uint32 LifetimeBucket(uint64 lifetime)
+    {
+      if (lifetime == 0)
+        return 0;
+      uint32 bucket = static_cast<uint32>(Math::Log2(lifetime) / 2);
+      return bucket < AllocationTracker::LifetimeBucketCount ? bucket : AllocationTracker::LifetimeBucketCount - 1;
+    }
+
+    static bool Equals(const char* a, const char* b)
+    {
+      while (*a && *a == *b)
+      {
+        ++a;
+        ++b;
+      }
+      return *a == *b;
+    }
+
+    static void Accumulate(AllocationTracker::Counters& dst, const ThreadCounter& src)
+    {
+      dst.allocations += src.allocations.Load(MemoryOrder::Relaxed);
+      dst.deallocations += src.deallocations.Load(MemoryOrder::Relaxed);
+      dst.bytes_allocated += src.bytes_allocated.Load(MemoryOrder::Relaxed);
+      dst.bytes_freed += src.bytes_freed.Load(MemoryOrder::Relaxed);
+      for (uint32 i = 0; i < AllocationTracker::LifetimeBucketCount; ++i)
+        dst.lifetime[i] += src.lifetime[i].Load(MemoryOrder::Relaxed);
+    }
+
+    static void Accumulate(AllocationTracker::Counters& dst, const AllocationTracker::Counters& src)
+    {
+      dst.allocations += src.allocations;
+      dst.deallocations += src.deallocations;
+      dst.bytes_allocated += src.bytes_allocated;
+      dst.bytes_freed += src.bytes_freed;
+      for (uint32 i = 0; i < AllocationTracker::LifetimeBucketCount; ++i)
+        dst.lifetime[i] += src.lifetime[i];
+    }
+  }
+
+  uint16 AllocationTracker::RegisterTag(const char* name)
+  {
+    Lock<Mutex> lock(GetMutex());
+    uint32 count = s_TagCount.Load(MemoryOrder::Relaxed);
+    for (uint32 i = 0; i < count; ++i)
+    {
+      if (Equals(s_TagNames[i], name))
+        return static_cast<uint16>(i);
+    }
+
+    if (count == MaxTags)
+      return UntaggedIndex;
+
+    s_TagNames[count] = name;
+    s_TagCount.Store(count + 1, MemoryOrder::Release);
+    return static_cast<uint16>(count);
+  }
+
+  uint64 AllocationTracker::OnAllocate(uint16 tag, size_t size)
+  {
+    ThreadBlock* block = GetBlock();
+    ThreadCounter& counter = block->tags[tag];
+    Add(counter.allocations, 1);
+    Add(counter.bytes_allocated, size);
+    UpdateLive(block, static_cast<int64>(size));
+
+    if (--block->sample_countdown)
+      return 0;
+
+    block->sample_countdown = LifetimeSampleRate;
+    return Now();
+  }
+
+  void AllocationTracker::OnDeallocate(uint16 tag, size_t size, uint64 time_stamp)
+  {
+    ThreadBlock* block = GetBlock();
+    ThreadCounter& counter = block->tags[tag];
+    Add(counter.deallocations, 1);
+    Add(counter.bytes_freed, size);
+    if (time_stamp)
+      Add(counter.lifetime[LifetimeBucket(Now() - time_stamp)], 1);
+    UpdateLive(block, -static_cast<int64>(size));
+  }
+
+  uint64 AllocationTracker::Now()
+  {
+#ifdef PLATFORM_WIN64
+    static const uint64 frequency = []()
+    {
+      LARGE_INTEGER value;
+      QueryPerformanceFrequency(&value);
+      return static_cast<uint64>(value.QuadPart);
+    }();
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    uint64 ticks = static_cast<uint64>(counter.QuadPart);
+    return (ticks / frequency) * 1000000000ull + (ticks % frequency) * 1000000000ull / frequency;
+#elif  PLATFORM_WIN32
+#elif  PLATFORM_IPHONE_SIM
+#elif  PLATFORM_IPHONE
+#elif  PLATFORM_MAC
+#elif  PLATFORM_LINUX
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint64>(time.tv_sec) * 1000000000ull + static_cast<uint64>(time.tv_nsec);
+#endif
+  }
+
+  void AllocationTracker::TakeSnapshot(Snapshot& snapshot)
+  {
+    snapshot = Snapshot{};
+    snapshot.tag_count = s_TagCount.Load(MemoryOrder::Acquire);
+    for (uint32 i = 0; i < snapshot.tag_count; ++i)
+      snapshot.tag_names[i] = s_TagNames[i];
+
+    int64 pending = 0;
+    {
+      Lock<Mutex> lock(GetMutex());
+      for (ThreadBlock* block = s_Blocks; block; block = block->next)
+      {
+        for (uint32 i = 0; i < snapshot.tag_count; ++i)
+          Accumulate(snapshot.tags[i], block->tags[i]);
+        pending += block->pending_live.Load(MemoryOrder::Relaxed);
+      }
+    }
+
+    for (uint32 i = 0; i < snapshot.tag_count; ++i)
+      Accumulate(snapshot.total, snapshot.tags[i]);
+
+    snapshot.live_bytes = s_Live.Load(MemoryOrder::Relaxed) + pending;
+    int64 peak = s_Peak.Load(MemoryOrder::Relaxed);
+    snapshot.peak_bytes = peak > snapshot.live_bytes ? peak : snapshot.live_bytes;
+  }
+
+  void AllocationTracker::Dump(void (*write)(const char* line, void* user), void* user)
+  {
+    Snapshot* snapshot = new Snapshot();
+    TakeSnapshot(*snapshot);
+
+    char line[256];
+    snprintf(line, sizeof(line), "allocations %llu, deallocations %llu, live %lld bytes, peak %lld bytes",
+      static_cast<unsigned long long>(snapshot->total.allocations), static_cast<unsigned long long>(snapshot->total.deallocations),
+      static_cast<long long>(snapshot->live_bytes), static_cast<long long>(snapshot->peak_bytes));
+    write(line, user);
+
+    for (uint32 i = 0; i < snapshot->tag_count; ++i)
+    {
+      const Counters& tag = snapshot->tags[i];
+      if (!tag.allocations && !tag.deallocations)
+        continue;
+
+      snprintf(line, sizeof(line), "  %s: allocations %llu, deallocations %llu, allocated %llu bytes, freed %llu bytes",
+        snapshot->tag_names[i], static_cast<unsigned long long>(tag.allocations), static_cast<unsigned long long>(tag.deallocations),
+        static_cast<unsigned long long>(tag.bytes_allocated), static_cast<unsigned long long>(tag.bytes_freed));
+      write(line, user);
+
+      //sampled lifetime histogram, bucket i starts at 4^i ns
+      int length = snprintf(line, sizeof(line), "    lifetime:");
+      for (uint32 b = 0; b < LifetimeBucketCount && length < static_cast<int>(sizeof(line)); ++b)
+        length += snprintf(line + length, sizeof(line) - length, " %llu", static_cast<unsigned long long>(tag.lifetime[b]));
+      write(line, user);
+    }
+
+    delete snapshot;
+  }
+}
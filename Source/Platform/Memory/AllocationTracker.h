@@ -0,0 +1,92 @@
+#pragma once
+
+#include "General/Numeric.h"
+#include "General/Pattern.h"
+
+namespace SSTD
+{
+  //Statistics behind TrackingAllocator
+  //Every thread counts into its own block without any locked instruction, a snapshot sums up all blocks
+  //Allocations are booked on the tag that is active on the allocating thread (see AllocationTagScope)
+  namespace AllocationTracker
+  {
+    static constexpr uint32 MaxTags = 64;
+    static constexpr uint16 UntaggedIndex = 0;
+
+    //bucket i holds lifetimes in [4^i, 4^(i+1)) ns, the last one everything above ~1s
+    //reading the clock costs more than the rest of the tracking, so only every LifetimeSampleRate-th allocation is timed
+    static constexpr uint32 LifetimeBucketCount = 16;
+    static constexpr uint32 LifetimeSampleRate = 16;
+
+    struct Counters
+    {
+      uint64 allocations = 0;
+      uint64 deallocations = 0;
+      uint64 bytes_allocated = 0;
+      uint64 bytes_freed = 0;
+      uint64 lifetime[LifetimeBucketCount]{};
+    };
+
+    struct Snapshot
+    {
+      Counters total;
+      Counters tags[MaxTags];
+      const char* tag_names[MaxTags]{};
+      uint32 tag_count = 0;
+
+      //live is exact, peak can miss up to 64 KiB per thread
+      int64 live_bytes = 0;
+      int64 peak_bytes = 0;
+    };
+
+    //the same name always gets the same index, once all tags are used up new names end up as untagged
+    uint16 RegisterTag(const char* name);
+
+    //returns the time stamp the block has to hand back to OnDeallocate, 0 if its lifetime isn't sampled
+    uint64 OnAllocate(uint16 tag, size_t size);
+    void OnDeallocate(uint16 tag, size_t size, uint64 time_stamp);
+
+    //monotonic nanoseconds
+    uint64 Now();
+
+    void TakeSnapshot(Snapshot& snapshot);
+
+    //one human readable line per call, tags without any allocation are skipped
+    void Dump(void (*write)(const char* line, void* user), void* user = nullptr);
+
+    inline thread_local uint16 t_CurrentTag = UntaggedIndex;
+  }
+
+  //usually a static, e.g. static AllocationTag s_Tag("Renderer");
+  class AllocationTag
+  {
+  public:
+    explicit AllocationTag(const char* name)
+      : m_Index(AllocationTracker::RegisterTag(name))
+    {}
+
+    uint16 GetIndex() const { return m_Index; }
+
+  private:
+    uint16 m_Index;
+  };
+
+  //Books every tracked allocation of this thread on tag, until the scope ends
+  class AllocationTagScope : public NonCopyable
+  {
+  public:
+    AllocationTagScope(const AllocationTag& tag)
+      : m_Previous(AllocationTracker::t_CurrentTag)
+    {
+      AllocationTracker::t_CurrentTag = tag.GetIndex();
+    }
+
+    ~AllocationTagScope()
+    {
+      AllocationTracker::t_CurrentTag = m_Previous;
+    }
+
+  private:
+    uint16 m_Previous;
+  };
+}
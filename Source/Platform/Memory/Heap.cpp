@@ -0,0 +1,637 @@
+#include "Heap.h"
+#include "VirtualMemory.h"
+
+#include "General/Memory.h"
+#include "Math/Math.h"
+#include "Platform/Threading/Atomic.h"
+#include "Platform/Threading/Mutex.h"
+#include "Platform/Threading/Lock.h"
+
+namespace SSTD
+{
+  namespace
+  {
+    static constexpr size_t SegmentSize = 4 * Byte::MB;
+    static constexpr size_t PageShift = 16;
+    static constexpr size_t PageSize = size_t(1) << PageShift;
+    static constexpr uint32 PagesPerSegment = SegmentSize / PageSize;
+
+    //one bit per page, the first page holds the segment header and is never free
+    static constexpr uint64 AllPagesFree = ~uint64(1);
+    static_assert(PagesPerSegment == 64);
+
+    //empty segments kept for reuse before they go back to the OS
+    static constexpr uint32 SegmentCacheSize = 4;
+
+    //huge blocks start right after this, so the segment lookup by masking still works for them
+    static constexpr size_t HugeHeaderSize = 64;
+
+    //a page that ran dry goes to the back of its queue, we look at this many before taking a fresh page
+    static constexpr uint32 MaxPageSearch = 8;
+
+    //16 byte steps up to 128, then four classes per power of two up to MaxSmallSize
+    static constexpr uint32 SizeClassCount = 40;
+
+    static constexpr uint32 SizeClassOf(size_t size)
+    {
+      if (size <= 128)
+        return size <= 16 ? 0 : static_cast<uint32>((size + 15) / 16 - 1);
+
+      uint32 k = static_cast<uint32>(Math::Log2(static_cast<uint64>(size - 1)));
+      return 8 + (k - 7) * 4 + static_cast<uint32>(((size - 1) >> (k - 2)) & 3);
+    }
+
+    static constexpr size_t BlockSizeOf(uint32 size_class)
+    {
+      if (size_class < 8)
+        return (size_class + 1) * 16;
+
+      uint32 k = (size_class - 8) / 4 + 7;
+      return (size_t(1) << k) + ((size_class - 8) % 4 + 1) * (size_t(1) << (k - 2));
+    }
+
+    //pages with this class hold one large block spanning several pages
+    static constexpr uint32 LargeClass = SizeClassCount;
+
+    static_assert(SizeClassOf(Heap::MaxSmallSize) == SizeClassCount - 1);
+    static_assert(Heap::MaxLargeSize <= SegmentSize - PageSize);
+    static_assert(BlockSizeOf(SizeClassCount - 1) == Heap::MaxSmallSize);
+
+    struct Block
+    {
+      Block* next;
+    };
+
+    struct ThreadHeap;
+
+    struct Page
+    {
+      Block* free = nullptr;
+      Block* local_free = nullptr;
+      AtomicPointer<Block> thread_free{};
+
+      ThreadHeap* heap = nullptr;
+      Page* next = nullptr;
+      Page* prev = nullptr;
+      uint8* start = nullptr;
+
+      uint32 used = 0;
+      uint32 block_size = 0;
+      uint32 size_class = 0;
+      //pages taken by a large block, only set on its first page
+      uint32 span = 0;
+    };
+
+    enum class SegmentKind : uint32
+    {
+      Small,
+      Huge
+    };
+
+    //lives at the start of every segment, the first page is reserved for it
+    struct Segment
+    {
+      SegmentKind kind;
+      size_t size;
+      Segment* next;
+      uint64 free_mask;
+      Page pages[PagesPerSegment];
+    };
+
+    static_assert(sizeof(Segment) <= PageSize);
+
+    struct ThreadHeap
+    {
+      //the head of every queue is the page we allocate from
+      Page* pages[SizeClassCount]{};
+      Page* free_pages = nullptr;
+      Segment* segments = nullptr;
+      ThreadHeap* next_orphan = nullptr;
+      //large blocks freed by other threads, released on the next large allocation
+      AtomicPointer<Block> large_free{};
+    };
+
+    //heaps are never destroyed, when a thread dies its heap waits here for the next thread
+    //frees into an orphaned heap simply take the remote path until it gets adopted
+    static Mutex s_OrphanMutex;
+    static ThreadHeap* s_Orphans = nullptr;
+
+    static Mutex s_SegmentMutex;
+    static Segment* s_SegmentCache = nullptr;
+    static uint32 s_SegmentCacheCount = 0;
+
+    static thread_local ThreadHeap* t_Heap = nullptr;
+
+    //set once the owner below is gone, destructors running after it must not bind a new heap to the thread
+    static thread_local bool t_HeapGone = false;
+
+    static void TrimHeap(ThreadHeap* heap);
+
+    static ThreadHeap* AdoptHeap()
+    {
+      {
+        Lock<Mutex> lock(s_OrphanMutex);
+        if (s_Orphans)
+        {
+          ThreadHeap* heap = s_Orphans;
+          s_Orphans = s_Orphans->next_orphan;
+          return heap;
+        }
+      }
+      return new ThreadHeap();
+    }
+
+    static void OrphanHeap(ThreadHeap* heap)
+    {
+      Lock<Mutex> lock(s_OrphanMutex);
+      heap->next_orphan = s_Orphans;
+      s_Orphans = heap;
+    }
+
+    struct HeapOwner
+    {
+      ~HeapOwner()
+      {
+        t_HeapGone = true;
+        if (!t_Heap)
+          return;
+
+        TrimHeap(t_Heap);
+        OrphanHeap(t_Heap);
+        t_Heap = nullptr;
+      }
+    };
+
+    static thread_local HeapOwner t_HeapOwner;
+
+    static Segment* GetSegment(const void* ptr)
+    {
+      return reinterpret_cast<Segment*>(reinterpret_cast<uintptr>(ptr) & ~(static_cast<uintptr>(SegmentSize) - 1));
+    }
+
+    static Page* GetPage(Segment* segment, const void* ptr)
+    {
+      return &segment->pages[(static_cast<const uint8*>(ptr) - reinterpret_cast<uint8*>(segment)) >> PageShift];
+    }
+
+    //nullptr once the thread is shutting down
+    static ThreadHeap* GetThreadHeap()
+    {
+      if (t_Heap)
+        return t_Heap;
+      if (t_HeapGone)
+        return nullptr;
+
+      t_Heap = AdoptHeap();
+
+      //touch the owner so its destructor runs at thread exit
+      (void)&t_HeapOwner;
+      return t_Heap;
+    }
+
+    static void PushFront(Page*& queue, Page* page)
+    {
+      page->prev = nullptr;
+      page->next = queue;
+      if (queue)
+        queue->prev = page;
+      queue = page;
+    }
+
+    static void Unlink(Page*& queue, Page* page)
+    {
+      if (page->prev)
+        page->prev->next = page->next;
+      else
+        queue = page->next;
+
+      if (page->next)
+        page->next->prev = page->prev;
+
+      page->next = nullptr;
+      page->prev = nullptr;
+    }
+
+    static uint32 PageIndex(const Page* page)
+    {
+      return static_cast<uint32>(page - GetSegment(page)->pages);
+    }
+
+    //every page of a segment is either in the free list or in use, the mask mirrors the free list
+    static void TakePage(ThreadHeap* heap, Page* page)
+    {
+      Unlink(heap->free_pages, page);
+      GetSegment(page)->free_mask &= ~(uint64(1) << PageIndex(page));
+    }
+
+    static void GivePage(ThreadHeap* heap, Page* page)
+    {
+      page->free = nullptr;
+      page->local_free = nullptr;
+      page->used = 0;
+      page->span = 0;
+      PushFront(heap->free_pages, page);
+      GetSegment(page)->free_mask |= uint64(1) << PageIndex(page);
+    }
+
+    static void ReleaseSegment(ThreadHeap* heap, Segment* segment)
+    {
+      for (uint32 i = 1; i < PagesPerSegment; ++i)
+        Unlink(heap->free_pages, &segment->pages[i]);
+
+      Segment** link = &heap->segments;
+      while (*link != segment)
+        link = &(*link)->next;
+      *link = segment->next;
+
+      {
+        Lock<Mutex> lock(s_SegmentMutex);
+        if (s_SegmentCacheCount < SegmentCacheSize)
+        {
+          segment->next = s_SegmentCache;
+          s_SegmentCache = segment;
+          ++s_SegmentCacheCount;
+          return;
+        }
+      }
+      VirtualMemory::Free(segment, SegmentSize);
+    }
+
+    //the last segment stays, so a heap that drains and refills doesn't go to the OS every time
+    static void TryReleaseSegment(ThreadHeap* heap, Segment* segment)
+    {
+      if (segment->free_mask != AllPagesFree)
+        return;
+      if (heap->segments == segment && !segment->next)
+        return;
+      ReleaseSegment(heap, segment);
+    }
+
+    static void* TakeCachedSegment()
+    {
+      Lock<Mutex> lock(s_SegmentMutex);
+      Segment* segment = s_SegmentCache;
+      if (segment)
+      {
+        s_SegmentCache = segment->next;
+        --s_SegmentCacheCount;
+      }
+      return segment;
+    }
+
+    static bool AddSegment(ThreadHeap* heap)
+    {
+      void* memory = TakeCachedSegment();
+      if (!memory)
+        memory = VirtualMemory::Allocate(SegmentSize, SegmentSize);
+      if (!memory)
+        return false;
+
+      Segment* segment = new (memory) Segment{};
+      segment->kind = SegmentKind::Small;
+      segment->size = SegmentSize;
+      segment->next = heap->segments;
+      segment->free_mask = AllPagesFree;
+      heap->segments = segment;
+
+      for (uint32 i = PagesPerSegment - 1; i > 0; --i)
+      {
+        Page* page = &segment->pages[i];
+        page->heap = heap;
+        page->start = reinterpret_cast<uint8*>(segment) + i * PageSize;
+        PushFront(heap->free_pages, page);
+      }
+      return true;
+    }
+
+    static Page* TakeFreshPage(ThreadHeap* heap, uint32 size_class)
+    {
+      if (!heap->free_pages && !AddSegment(heap))
+        return nullptr;
+
+      Page* page = heap->free_pages;
+      TakePage(heap, page);
+
+      page->size_class = size_class;
+      page->block_size = static_cast<uint32>(BlockSizeOf(size_class));
+      page->used = 0;
+      page->local_free = nullptr;
+
+      //carve the page back to front, so the free list hands out ascending addresses
+      Block* free = nullptr;
+      uint32 capacity = static_cast<uint32>(PageSize / page->block_size);
+      for (uint32 i = capacity; i > 0; --i)
+      {
+        Block* block = reinterpret_cast<Block*>(page->start + (i - 1) * page->block_size);
+        block->next = free;
+        free = block;
+      }
+      page->free = free;
+
+      PushFront(heap->pages[size_class], page);
+      return page;
+    }
+
+    //move everything that was freed since the last time into the free list
+    static void Collect(Page* page)
+    {
+      if (page->local_free)
+      {
+        if (!page->free)
+        {
+          page->free = page->local_free;
+        }
+        else
+        {
+          Block* last = page->local_free;
+          while (last->next)
+            last = last->next;
+          last->next = page->free;
+          page->free = page->local_free;
+        }
+        page->local_free = nullptr;
+      }
+
+      if (!page->thread_free.Load(MemoryOrder::Relaxed))
+        return;
+
+      Block* remote = page->thread_free.Exchange(nullptr, MemoryOrder::Acquire);
+      Block* last = remote;
+      uint32 count = 1;
+      while (last->next)
+      {
+        last = last->next;
+        ++count;
+      }
+      last->next = page->free;
+      page->free = remote;
+      page->used -= count;
+    }
+
+    static void RetirePage(ThreadHeap* heap, Page* page)
+    {
+      //keep at least one page per class around, otherwise a alloc/free loop would re-carve a page every time
+      Page*& queue = heap->pages[page->size_class];
+      if (queue == page && !page->next)
+        return;
+
+      Unlink(queue, page);
+      GivePage(heap, page);
+      TryReleaseSegment(heap, GetSegment(page));
+    }
+
+    static Block* PopBlock(Page* page)
+    {
+      Block* block = page->free;
+      page->free = block->next;
+      ++page->used;
+      return block;
+    }
+
+    static void* AllocateSlow(ThreadHeap* heap, uint32 size_class)
+    {
+      Page*& queue = heap->pages[size_class];
+
+      for (uint32 i = 0; i < MaxPageSearch && queue; ++i)
+      {
+        Page* page = queue;
+        Collect(page);
+        if (page->free)
+          return PopBlock(page);
+
+        if (!page->next)
+          break;
+
+        //dry, rotate it to the back so the others get a chance
+        Unlink(queue, page);
+        Page* last = queue;
+        while (last->next)
+          last = last->next;
+        last->next = page;
+        page->prev = last;
+      }
+
+      Page* page = TakeFreshPage(heap, size_class);
+      return page ? PopBlock(page) : nullptr;
+    }
+
+    static void FreeLarge(ThreadHeap* heap, Page* page)
+    {
+      Segment* segment = GetSegment(page);
+      uint32 first = PageIndex(page);
+      uint32 last = first + page->span;
+      for (uint32 i = first; i < last; ++i)
+        GivePage(heap, &segment->pages[i]);
+      TryReleaseSegment(heap, segment);
+    }
+
+    static void CollectLarge(ThreadHeap* heap)
+    {
+      if (!heap->large_free.Load(MemoryOrder::Relaxed))
+        return;
+
+      Block* block = heap->large_free.Exchange(nullptr, MemoryOrder::Acquire);
+      while (block)
+      {
+        Block* next = block->next;
+        FreeLarge(heap, GetPage(GetSegment(block), block));
+        block = next;
+      }
+    }
+
+    //first page of a run of count free pages, 0 if there is none (page 0 is never free)
+    static uint32 FindFreeRun(uint64 free_mask, uint32 count)
+    {
+      uint64 run = free_mask;
+      for (uint32 i = 1; i < count && run; ++i)
+        run &= free_mask >> i;
+      return run ? Bit::CountTrailingZeros(run) : 0;
+    }
+
+    //blocks between MaxSmallSize and MaxLargeSize take a run of whole pages
+    static void* AllocateLarge(ThreadHeap* heap, size_t size)
+    {
+      CollectLarge(heap);
+
+      uint32 count = static_cast<uint32>((size + PageSize - 1) >> PageShift);
+      Segment* segment = heap->segments;
+      uint32 first = 0;
+      for (; segment; segment = segment->next)
+      {
+        first = FindFreeRun(segment->free_mask, count);
+        if (first)
+          break;
+      }
+
+      if (!segment)
+      {
+        if (!AddSegment(heap))
+          return nullptr;
+        segment = heap->segments;
+        first = 1;
+      }
+
+      for (uint32 i = first; i < first + count; ++i)
+        TakePage(heap, &segment->pages[i]);
+
+      Page* page = &segment->pages[first];
+      page->size_class = LargeClass;
+      page->block_size = count * static_cast<uint32>(PageSize);
+      page->span = count;
+      page->used = 1;
+      return page->start;
+    }
+
+    static void* AllocateFrom(ThreadHeap* heap, size_t size)
+    {
+      if (size > Heap::MaxSmallSize)
+        return AllocateLarge(heap, size);
+
+      uint32 size_class = SizeClassOf(size);
+      Page* page = heap->pages[size_class];
+      if (page && page->free)
+        return PopBlock(page);
+
+      return AllocateSlow(heap, size_class);
+    }
+
+    //gives every page and segment without a live block back, including the one TryReleaseSegment keeps
+    static void TrimHeap(ThreadHeap* heap)
+    {
+      CollectLarge(heap);
+
+      for (uint32 size_class = 0; size_class < SizeClassCount; ++size_class)
+      {
+        Page* page = heap->pages[size_class];
+        while (page)
+        {
+          Page* next = page->next;
+          Collect(page);
+          if (page->used == 0)
+          {
+            Unlink(heap->pages[size_class], page);
+            GivePage(heap, page);
+          }
+          page = next;
+        }
+      }
+
+      Segment* segment = heap->segments;
+      while (segment)
+      {
+        Segment* next = segment->next;
+        if (segment->free_mask == AllPagesFree)
+          ReleaseSegment(heap, segment);
+        segment = next;
+      }
+    }
+
+    static void* AllocateHuge(size_t size)
+    {
+      size_t total = HugeHeaderSize + size;
+      void* memory = VirtualMemory::Allocate(total, SegmentSize);
+      if (!memory)
+        return nullptr;
+
+      Segment* segment = static_cast<Segment*>(memory);
+      segment->kind = SegmentKind::Huge;
+      segment->size = total;
+      return static_cast<uint8*>(memory) + HugeHeaderSize;
+    }
+  }
+
+  void* Heap::Allocate(size_t size)
+  {
+    if (size > MaxLargeSize)
+      return AllocateHuge(size);
+
+    ThreadHeap* heap = GetThreadHeap();
+    if (!heap)
+    {
+      //the thread is past its heap, borrow an orphaned one for this block and hand it straight back
+      heap = AdoptHeap();
+      void* ptr = AllocateFrom(heap, size);
+      OrphanHeap(heap);
+      return ptr;
+    }
+
+    return AllocateFrom(heap, size);
+  }
+
+  void Heap::Free(void* ptr)
+  {
+    if (!ptr)
+      return;
+
+    Segment* segment = GetSegment(ptr);
+    if (segment->kind == SegmentKind::Huge)
+    {
+      VirtualMemory::Free(segment, segment->size);
+      return;
+    }
+
+    Page* page = GetPage(segment, ptr);
+    Block* block = static_cast<Block*>(ptr);
+
+    if (page->size_class == LargeClass)
+    {
+      if (page->heap == t_Heap)
+      {
+        FreeLarge(page->heap, page);
+        return;
+      }
+
+      Block* head = page->heap->large_free.Load(MemoryOrder::Relaxed);
+      do
+      {
+        block->next = head;
+      } while (!page->heap->large_free.CompareExchange(head, block, MemoryOrder::Release));
+      return;
+    }
+
+    if (page->heap == t_Heap)
+    {
+      block->next = page->local_free;
+      page->local_free = block;
+      if (--page->used == 0)
+        RetirePage(page->heap, page);
+      return;
+    }
+
+    //not our page, hand it to the owner without taking any lock
+    Block* head = page->thread_free.Load(MemoryOrder::Relaxed);
+    do
+    {
+      block->next = head;
+    } while (!page->thread_free.CompareExchange(head, block, MemoryOrder::Release));
+  }
+
+  void Heap::Purge()
+  {
+    if (t_Heap)
+      TrimHeap(t_Heap);
+
+    Segment* segments = nullptr;
+    {
+      Lock<Mutex> lock(s_SegmentMutex);
+      segments = s_SegmentCache;
+      s_SegmentCache = nullptr;
+      s_SegmentCacheCount = 0;
+    }
+
+    while (segments)
+    {
+      Segment* next = segments->next;
+      VirtualMemory::Free(segments, SegmentSize);
+      segments = next;
+    }
+  }
+
+  size_t Heap::GetSize(const void* ptr)
+  {
+    Segment* segment = GetSegment(ptr);
+    if (segment->kind == SegmentKind::Huge)
+      return segment->size - HugeHeaderSize;
+    return GetPage(segment, ptr)->block_size;
+  }
+}
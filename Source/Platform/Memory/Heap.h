@@ -0,0 +1,29 @@
+#pragma once
+
+#include "General/Numeric.h"
+
+namespace SSTD
+{
+  //General purpose allocator with segregated size classes and one heap per thread (in the spirit of mimalloc)
+  //- small blocks (<= 32 KiB) come from 64 KiB pages that each serve one size class, pages live in 4 MiB segments
+  //- a thread only ever touches its own pages without atomics, frees from other threads go through a lock-free list on the page
+  //- empty pages go back to their heap and get reused for any size class
+  //- blocks up to 2 MiB take a run of whole pages from a segment
+  //- empty segments go to a small process wide cache and from there back to the OS
+  //- bigger blocks are mapped from the OS directly
+  namespace Heap
+  {
+    static constexpr size_t MaxSmallSize = 32 * 1024;
+    static constexpr size_t MaxLargeSize = 2 * 1024 * 1024;
+
+    //blocks are at least 16 byte aligned, returns nullptr if the OS is out of memory
+    void* Allocate(size_t size);
+    void Free(void* ptr);
+
+    //usable size of the block, can be bigger than what was asked for
+    size_t GetSize(const void* ptr);
+
+    //returns the free pages of the calling thread's heap and the cached segments to the OS
+    void Purge();
+  }
+}
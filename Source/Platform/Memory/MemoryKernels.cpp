@@ -0,0 +1,153 @@
+#include "MemoryKernelsImpl.h"
+
+#include "Platform/CPU/CPU.h"
+#include "Platform/Threading/Atomic.h"
+
+namespace SSTD
+{
+  //used where none of the vector versions was built, the compiler is free to vectorize the loops itself
+  namespace
+  {
+    static void* CopyScalar(void* dst, const void* src, size_t size)
+    {
+      uint8* d = static_cast<uint8*>(dst);
+      const uint8* s = static_cast<const uint8*>(src);
+      for (size_t i = 0; i < size; ++i)
+        d[i] = s[i];
+      return dst;
+    }
+
+    static void* MoveScalar(void* dst, const void* src, size_t size)
+    {
+      uint8* d = static_cast<uint8*>(dst);
+      const uint8* s = static_cast<const uint8*>(src);
+      if (d < s)
+      {
+        for (size_t i = 0; i < size; ++i)
+          d[i] = s[i];
+      }
+      else
+      {
+        for (size_t i = size; i > 0; --i)
+          d[i - 1] = s[i - 1];
+      }
+      return dst;
+    }
+
+    static void* SetScalar(void* dst, uint8 value, size_t size)
+    {
+      uint8* d = static_cast<uint8*>(dst);
+      for (size_t i = 0; i < size; ++i)
+        d[i] = value;
+      return dst;
+    }
+
+    static int32 CompareScalar(const void* lhs, const void* rhs, size_t size)
+    {
+      const uint8* l = static_cast<const uint8*>(lhs);
+      const uint8* r = static_cast<const uint8*>(rhs);
+      for (size_t i = 0; i < size; ++i)
+      {
+        if (l[i] != r[i])
+          return static_cast<int32>(l[i]) - static_cast<int32>(r[i]);
+      }
+      return 0;
+    }
+
+    static const void* FindScalar(const void* ptr, uint8 value, size_t size)
+    {
+      const uint8* p = static_cast<const uint8*>(ptr);
+      for (size_t i = 0; i < size; ++i)
+      {
+        if (p[i] == value)
+          return p + i;
+      }
+      return nullptr;
+    }
+
+    static constexpr MemoryKernels::Table s_ScalarTable = { &CopyScalar, &MoveScalar, &SetScalar, &CompareScalar, &FindScalar, "Scalar" };
+
+    static const MemoryKernels::Table* SelectTable()
+    {
+      const CPU::Features& features = CPU::GetFeatures();
+
+      const MemoryKernels::Table* table = nullptr;
+      if (features.avx512bw)
+        table = MemoryKernels::GetAVX512Table();
+      if (!table && features.avx2)
+        table = MemoryKernels::GetAVX2Table();
+      if (!table && features.sse2)
+        table = MemoryKernels::GetSSE2Table();
+      return table ? table : &s_ScalarTable;
+    }
+
+    //picked on the first call and not in a static constructor, other static constructors may already copy memory
+    //every thread picks the same table, so it doesn't matter who stores it first
+    static AtomicPointer<const MemoryKernels::Table> s_Active;
+  }
+
+  const MemoryKernels::Table& MemoryKernels::GetActive()
+  {
+    const Table* table = s_Active.Load(MemoryOrder::Relaxed);
+    if (!table)
+    {
+      table = SelectTable();
+      s_Active.Store(table, MemoryOrder::Relaxed);
+    }
+    return *table;
+  }
+
+  size_t MemoryKernels::GetNonTemporalThreshold()
+  {
+    //streaming only pays off once the copy would push everything else out of the cache
+    static const size_t s_Threshold = CPU::GetLastLevelCacheSize() ? CPU::GetLastLevelCacheSize() : 8 * Byte::MB;
+    return s_Threshold;
+  }
+
+  //tiny sizes are the most common ones (short strings, single elements), they don't need the indirect call
+  void* MemCopy(void* dst, const void* src, size_t size)
+  {
+#ifdef ARCH_X64
+    if (size <= 16)
+    {
+      CopyTiny(static_cast<uint8*>(dst), static_cast<const uint8*>(src), size);
+      return dst;
+    }
+#endif
+    return MemoryKernels::GetActive().copy(dst, src, size);
+  }
+
+  void* MemMove(void* dst, const void* src, size_t size)
+  {
+#ifdef ARCH_X64
+    if (size <= 16)
+    {
+      CopyTiny(static_cast<uint8*>(dst), static_cast<const uint8*>(src), size);
+      return dst;
+    }
+#endif
+    return MemoryKernels::GetActive().move(dst, src, size);
+  }
+
+  void* MemSet(void* dst, uint8 value, size_t size)
+  {
+#ifdef ARCH_X64
+    if (size <= 16)
+    {
+      SetTiny(static_cast<uint8*>(dst), value, size);
+      return dst;
+    }
+#endif
+    return MemoryKernels::GetActive().set(dst, value, size);
+  }
+
+  int32 MemCompare(const void* lhs, const void* rhs, size_t size)
+  {
+    return MemoryKernels::GetActive().compare(lhs, rhs, size);
+  }
+
+  const void* MemFind(const void* ptr, uint8 value, size_t size)
+  {
+    return MemoryKernels::GetActive().find(ptr, value, size);
+  }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "General/Numeric.h"
+
+namespace SSTD
+{
+  //Byte routines (like memcpy and friends) with a SSE2, AVX2 and AVX-512 version each
+  //the best one for the running CPU is picked on the first call
+  //copies at least the size of the last level cache bypass it with non-temporal stores
+
+  //dst and src must not overlap
+  void* MemCopy(void* dst, const void* src, size_t size);
+
+  //dst and src may overlap
+  void* MemMove(void* dst, const void* src, size_t size);
+
+  void* MemSet(void* dst, uint8 value, size_t size);
+
+  //<0, 0 or >0 like memcmp, the first different byte decides
+  int32 MemCompare(const void* lhs, const void* rhs, size_t size);
+
+  //first byte equal to value, nullptr if there is none
+  const void* MemFind(const void* ptr, uint8 value, size_t size);
+
+  namespace MemoryKernels
+  {
+    //every ISA provides the same set of routines
+    struct Table
+    {
+      void* (*copy)(void* dst, const void* src, size_t size);
+      void* (*move)(void* dst, const void* src, size_t size);
+      void* (*set)(void* dst, uint8 value, size_t size);
+      int32 (*compare)(const void* lhs, const void* rhs, size_t size);
+      const void* (*find)(const void* ptr, uint8 value, size_t size);
+      const char* name;
+    };
+
+    //the table MemCopy etc. use, lets benchmarks and tests see which one got picked
+    const Table& GetActive();
+
+    //from this size on copies and sets go around the cache
+    size_t GetNonTemporalThreshold();
+  }
+}
@@ -0,0 +1,36 @@
+//compiled with AVX2 enabled (see CMakeLists.txt), only called after the CPU said it has it
+#include "MemoryKernelsImpl.h"
+
+namespace SSTD
+{
+#if defined(ARCH_X64) && (defined(__AVX2__) || defined(_MSC_VER))
+  namespace
+  {
+    struct AVX2
+    {
+      using Vector = __m256i;
+      static constexpr size_t Width = 32;
+      static constexpr uint64 FullMask = 0xFFFFFFFF;
+
+      static Vector Load(const void* ptr) { return _mm256_loadu_si256(static_cast<const __m256i*>(ptr)); }
+      static void Store(void* ptr, Vector value) { _mm256_storeu_si256(static_cast<__m256i*>(ptr), value); }
+      static void StoreAligned(void* ptr, Vector value) { _mm256_store_si256(static_cast<__m256i*>(ptr), value); }
+      static void Stream(void* ptr, Vector value) { _mm256_stream_si256(static_cast<__m256i*>(ptr), value); }
+      static Vector Broadcast(uint8 value) { return _mm256_set1_epi8(static_cast<char>(value)); }
+      static uint64 EqualMask(Vector lhs, Vector rhs) { return static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs))); }
+    };
+  }
+
+  static constexpr MemoryKernels::Table s_Table = MakeTable<AVX2, SSE2>("AVX2");
+
+  const MemoryKernels::Table* MemoryKernels::GetAVX2Table()
+  {
+    return &s_Table;
+  }
+#else
+  const MemoryKernels::Table* MemoryKernels::GetAVX2Table()
+  {
+    return nullptr;
+  }
+#endif
+}
@@ -0,0 +1,47 @@
+//compiled with AVX-512 F/BW enabled (see CMakeLists.txt), only called after the CPU said it has it
+#include "MemoryKernelsImpl.h"
+
+namespace SSTD
+{
+#if defined(ARCH_X64) && ((defined(__AVX512F__) && defined(__AVX512BW__)) || defined(_MSC_VER))
+  namespace
+  {
+    struct AVX2
+    {
+      using Vector = __m256i;
+      static constexpr size_t Width = 32;
+      static constexpr uint64 FullMask = 0xFFFFFFFF;
+
+      static Vector Load(const void* ptr) { return _mm256_loadu_si256(static_cast<const __m256i*>(ptr)); }
+      static void Store(void* ptr, Vector value) { _mm256_storeu_si256(static_cast<__m256i*>(ptr), value); }
+      static Vector Broadcast(uint8 value) { return _mm256_set1_epi8(static_cast<char>(value)); }
+    };
+
+    struct AVX512
+    {
+      using Vector = __m512i;
+      static constexpr size_t Width = 64;
+      static constexpr uint64 FullMask = ~0ull;
+
+      static Vector Load(const void* ptr) { return _mm512_loadu_si512(ptr); }
+      static void Store(void* ptr, Vector value) { _mm512_storeu_si512(ptr, value); }
+      static void StoreAligned(void* ptr, Vector value) { _mm512_store_si512(ptr, value); }
+      static void Stream(void* ptr, Vector value) { _mm512_stream_si512(static_cast<__m512i*>(ptr), value); }
+      static Vector Broadcast(uint8 value) { return _mm512_set1_epi8(static_cast<char>(value)); }
+      static uint64 EqualMask(Vector lhs, Vector rhs) { return _mm512_cmpeq_epi8_mask(lhs, rhs); }
+    };
+  }
+
+  static constexpr MemoryKernels::Table s_Table = MakeTable<AVX512, AVX2>("AVX-512");
+
+  const MemoryKernels::Table* MemoryKernels::GetAVX512Table()
+  {
+    return &s_Table;
+  }
+#else
+  const MemoryKernels::Table* MemoryKernels::GetAVX512Table()
+  {
+    return nullptr;
+  }
+#endif
+}
@@ -0,0 +1,518 @@
+#pragma once
+
+//Only included by the MemoryKernels*.cpp files, every one of them is compiled for a different instruction set
+//so everything in here has internal linkage, otherwise the linker could mix AVX2 code into the SSE2 path
+
+#include "MemoryKernels.h"
+
+#include "General/Memory.h"
+
+#include "Platform/DefinePlatform.h"
+
+#ifdef ARCH_X64
+#include <immintrin.h>
+#include <string.h>
+#endif
+
+namespace SSTD
+{
+  namespace MemoryKernels
+  {
+    //nullptr if the library was built without that instruction set
+    const Table* GetSSE2Table();
+    const Table* GetAVX2Table();
+    const Table* GetAVX512Table();
+  }
+
+#ifdef ARCH_X64
+  namespace
+  {
+    //x64 always has SSE2, the wider instruction sets use it for the sizes below their own width
+    struct SSE2
+    {
+      using Vector = __m128i;
+      static constexpr size_t Width = 16;
+      static constexpr uint64 FullMask = 0xFFFF;
+
+      static Vector Load(const void* ptr) { return _mm_loadu_si128(static_cast<const __m128i*>(ptr)); }
+      static void Store(void* ptr, Vector value) { _mm_storeu_si128(static_cast<__m128i*>(ptr), value); }
+      static void StoreAligned(void* ptr, Vector value) { _mm_store_si128(static_cast<__m128i*>(ptr), value); }
+      static void Stream(void* ptr, Vector value) { _mm_stream_si128(static_cast<__m128i*>(ptr), value); }
+      static Vector Broadcast(uint8 value) { return _mm_set1_epi8(static_cast<char>(value)); }
+      static uint64 EqualMask(Vector lhs, Vector rhs) { return static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs))); }
+    };
+
+    static uint32 CountTrailingZeros(uint64 mask)
+    {
+#ifdef PLATFORM_WIN64
+      unsigned long index;
+      _BitScanForward64(&index, mask);
+      return static_cast<uint32>(index);
+#else
+      return static_cast<uint32>(__builtin_ctzll(mask));
+#endif
+    }
+
+    //big endian load, so comparing the integers compares the bytes in memory order
+    static uint64 LoadBigEndian64(const uint8* ptr)
+    {
+      uint64 value;
+      memcpy(&value, ptr, sizeof(value));
+#ifdef PLATFORM_WIN64
+      return _byteswap_uint64(value);
+#else
+      return __builtin_bswap64(value);
+#endif
+    }
+
+    template<typename T>
+    static T LoadScalar(const uint8* ptr)
+    {
+      T value;
+      memcpy(&value, ptr, sizeof(T));
+      return value;
+    }
+
+    template<typename T>
+    static void StoreScalar(uint8* ptr, T value)
+    {
+      memcpy(ptr, &value, sizeof(T));
+    }
+
+    //first and last chunk can overlap, both are loaded before anything is stored, so this is also a valid move
+    template<typename T>
+    static void CopyEnds(uint8* dst, const uint8* src, size_t size)
+    {
+      T head = LoadScalar<T>(src);
+      T tail = LoadScalar<T>(src + size - sizeof(T));
+      StoreScalar<T>(dst, head);
+      StoreScalar<T>(dst + size - sizeof(T), tail);
+    }
+
+    //size <= 16, also a valid move
+    static void CopyTiny(uint8* dst, const uint8* src, size_t size)
+    {
+      if (size >= 8)
+        CopyEnds<uint64>(dst, src, size);
+      else if (size >= 4)
+        CopyEnds<uint32>(dst, src, size);
+      else if (size >= 2)
+        CopyEnds<uint16>(dst, src, size);
+      else if (size)
+        *dst = *src;
+    }
+
+    //size <= 16
+    static void SetTiny(uint8* dst, uint8 value, size_t size)
+    {
+      uint64 pattern = value * 0x0101010101010101ull;
+      if (size >= 8)
+      {
+        StoreScalar<uint64>(dst, pattern);
+        StoreScalar<uint64>(dst + size - 8, pattern);
+      }
+      else if (size >= 4)
+      {
+        StoreScalar<uint32>(dst, static_cast<uint32>(pattern));
+        StoreScalar<uint32>(dst + size - 4, static_cast<uint32>(pattern));
+      }
+      else if (size >= 2)
+      {
+        StoreScalar<uint16>(dst, static_cast<uint16>(pattern));
+        StoreScalar<uint16>(dst + size - 2, static_cast<uint16>(pattern));
+      }
+      else if (size)
+      {
+        *dst = value;
+      }
+    }
+
+    template<typename ISA>
+    static void CopyEndsVector(uint8* dst, const uint8* src, size_t size)
+    {
+      typename ISA::Vector head = ISA::Load(src);
+      typename ISA::Vector tail = ISA::Load(src + size - ISA::Width);
+      ISA::Store(dst, head);
+      ISA::Store(dst + size - ISA::Width, tail);
+    }
+
+    //handles everything up to 4 vectors, loads before it stores, returns false if size is bigger
+    template<typename ISA, typename HalfISA>
+    static bool CopySmall(uint8* dst, const uint8* src, size_t size)
+    {
+      static constexpr size_t W = ISA::Width;
+
+      if (size <= 16)
+      {
+        CopyTiny(dst, src, size);
+        return true;
+      }
+
+      if (size <= 32 && W > 16)
+      {
+        CopyEndsVector<SSE2>(dst, src, size);
+        return true;
+      }
+
+      if (size <= W && W > 32)
+      {
+        CopyEndsVector<HalfISA>(dst, src, size);
+        return true;
+      }
+
+      if (size <= 2 * W)
+      {
+        CopyEndsVector<ISA>(dst, src, size);
+        return true;
+      }
+
+      if (size <= 4 * W)
+      {
+        typename ISA::Vector v0 = ISA::Load(src);
+        typename ISA::Vector v1 = ISA::Load(src + W);
+        typename ISA::Vector v2 = ISA::Load(src + size - 2 * W);
+        typename ISA::Vector v3 = ISA::Load(src + size - W);
+        ISA::Store(dst, v0);
+        ISA::Store(dst + W, v1);
+        ISA::Store(dst + size - 2 * W, v2);
+        ISA::Store(dst + size - W, v3);
+        return true;
+      }
+      return false;
+    }
+
+    //size > 4 * Width, the stores are aligned, first and last vector are kept in registers and written at the end
+    //safe for dst < src even if they overlap, every chunk is loaded before it gets overwritten
+    template<typename ISA, bool NonTemporal>
+    static void CopyForward(uint8* dst, const uint8* src, size_t size)
+    {
+      static constexpr size_t W = ISA::Width;
+      typename ISA::Vector head = ISA::Load(src);
+      typename ISA::Vector tail = ISA::Load(src + size - W);
+
+      size_t skip = (W - (reinterpret_cast<uintptr>(dst) & (W - 1))) & (W - 1);
+      uint8* d = dst + skip;
+      const uint8* s = src + skip;
+      size_t left = size - skip;
+
+      while (left > 4 * W)
+      {
+        typename ISA::Vector v0 = ISA::Load(s);
+        typename ISA::Vector v1 = ISA::Load(s + W);
+        typename ISA::Vector v2 = ISA::Load(s + 2 * W);
+        typename ISA::Vector v3 = ISA::Load(s + 3 * W);
+        if constexpr (NonTemporal)
+        {
+          ISA::Stream(d, v0);
+          ISA::Stream(d + W, v1);
+          ISA::Stream(d + 2 * W, v2);
+          ISA::Stream(d + 3 * W, v3);
+        }
+        else
+        {
+          ISA::StoreAligned(d, v0);
+          ISA::StoreAligned(d + W, v1);
+          ISA::StoreAligned(d + 2 * W, v2);
+          ISA::StoreAligned(d + 3 * W, v3);
+        }
+        d += 4 * W;
+        s += 4 * W;
+        left -= 4 * W;
+      }
+
+      if constexpr (NonTemporal)
+        _mm_sfence();
+
+      while (left > W)
+      {
+        ISA::StoreAligned(d, ISA::Load(s));
+        d += W;
+        s += W;
+        left -= W;
+      }
+
+      ISA::Store(dst + size - W, tail);
+      ISA::Store(dst, head);
+    }
+
+    //mirror of CopyForward for dst > src
+    template<typename ISA>
+    static void CopyBackward(uint8* dst, const uint8* src, size_t size)
+    {
+      static constexpr size_t W = ISA::Width;
+      typename ISA::Vector head = ISA::Load(src);
+      typename ISA::Vector tail = ISA::Load(src + size - W);
+
+      size_t skip = reinterpret_cast<uintptr>(dst + size) & (W - 1);
+      uint8* d = dst + size - skip;
+      const uint8* s = src + size - skip;
+      size_t left = size - skip;
+
+      while (left > 4 * W)
+      {
+        d -= 4 * W;
+        s -= 4 * W;
+        typename ISA::Vector v3 = ISA::Load(s + 3 * W);
+        typename ISA::Vector v2 = ISA::Load(s + 2 * W);
+        typename ISA::Vector v1 = ISA::Load(s + W);
+        typename ISA::Vector v0 = ISA::Load(s);
+        ISA::StoreAligned(d + 3 * W, v3);
+        ISA::StoreAligned(d + 2 * W, v2);
+        ISA::StoreAligned(d + W, v1);
+        ISA::StoreAligned(d, v0);
+        left -= 4 * W;
+      }
+
+      while (left > W)
+      {
+        d -= W;
+        s -= W;
+        ISA::StoreAligned(d, ISA::Load(s));
+        left -= W;
+      }
+
+      ISA::Store(dst, head);
+      ISA::Store(dst + size - W, tail);
+    }
+
+    template<typename ISA, typename HalfISA>
+    static void* Copy(void* dst, const void* src, size_t size)
+    {
+      uint8* d = static_cast<uint8*>(dst);
+      const uint8* s = static_cast<const uint8*>(src);
+
+      if (CopySmall<ISA, HalfISA>(d, s, size))
+        return dst;
+
+      if (size >= MemoryKernels::GetNonTemporalThreshold())
+        CopyForward<ISA, true>(d, s, size);
+      else
+        CopyForward<ISA, false>(d, s, size);
+      return dst;
+    }
+
+    template<typename ISA, typename HalfISA>
+    static void* Move(void* dst, const void* src, size_t size)
+    {
+      uint8* d = static_cast<uint8*>(dst);
+      const uint8* s = static_cast<const uint8*>(src);
+
+      if (d == s || CopySmall<ISA, HalfISA>(d, s, size))
+        return dst;
+
+      if (d + size <= s || s + size <= d)
+        return Copy<ISA, HalfISA>(dst, src, size);
+
+      if (d < s)
+        CopyForward<ISA, false>(d, s, size);
+      else
+        CopyBackward<ISA>(d, s, size);
+      return dst;
+    }
+
+    template<typename ISA>
+    static void SetEndsVector(uint8* dst, uint8 value, size_t size)
+    {
+      typename ISA::Vector v = ISA::Broadcast(value);
+      ISA::Store(dst, v);
+      ISA::Store(dst + size - ISA::Width, v);
+    }
+
+    template<typename ISA, typename HalfISA>
+    static void* Set(void* dst, uint8 value, size_t size)
+    {
+      static constexpr size_t W = ISA::Width;
+      uint8* d = static_cast<uint8*>(dst);
+
+      if (size <= 16)
+      {
+        SetTiny(d, value, size);
+        return dst;
+      }
+
+      if (size <= 32 && W > 16)
+      {
+        SetEndsVector<SSE2>(d, value, size);
+        return dst;
+      }
+
+      if (size <= W && W > 32)
+      {
+        SetEndsVector<HalfISA>(d, value, size);
+        return dst;
+      }
+
+      typename ISA::Vector v = ISA::Broadcast(value);
+      ISA::Store(d, v);
+      ISA::Store(d + size - W, v);
+      if (size <= 2 * W)
+        return dst;
+
+      size_t skip = (W - (reinterpret_cast<uintptr>(d) & (W - 1))) & (W - 1);
+      uint8* p = d + skip;
+      size_t left = size - skip;
+
+      if (size >= MemoryKernels::GetNonTemporalThreshold())
+      {
+        for (; left > 4 * W; p += 4 * W, left -= 4 * W)
+        {
+          ISA::Stream(p, v);
+          ISA::Stream(p + W, v);
+          ISA::Stream(p + 2 * W, v);
+          ISA::Stream(p + 3 * W, v);
+        }
+        _mm_sfence();
+      }
+      else
+      {
+        for (; left > 4 * W; p += 4 * W, left -= 4 * W)
+        {
+          ISA::StoreAligned(p, v);
+          ISA::StoreAligned(p + W, v);
+          ISA::StoreAligned(p + 2 * W, v);
+          ISA::StoreAligned(p + 3 * W, v);
+        }
+      }
+
+      //the rest up to the last (already stored) vector
+      for (; left > W; p += W, left -= W)
+        ISA::StoreAligned(p, v);
+      return dst;
+    }
+
+    //size >= ISA::Width, the last vector overlaps the one before, bytes in there that were equal stay equal
+    template<typename ISA>
+    static bool CompareVectors(const uint8* lhs, const uint8* rhs, size_t size, int32& result)
+    {
+      size_t i = 0;
+
+      //four vectors at a time with a single branch, the exact position is searched below once something differs
+      for (; i + 4 * ISA::Width <= size; i += 4 * ISA::Width)
+      {
+        uint64 equal = ISA::EqualMask(ISA::Load(lhs + i), ISA::Load(rhs + i))
+          & ISA::EqualMask(ISA::Load(lhs + i + ISA::Width), ISA::Load(rhs + i + ISA::Width))
+          & ISA::EqualMask(ISA::Load(lhs + i + 2 * ISA::Width), ISA::Load(rhs + i + 2 * ISA::Width))
+          & ISA::EqualMask(ISA::Load(lhs + i + 3 * ISA::Width), ISA::Load(rhs + i + 3 * ISA::Width));
+        if (equal != ISA::FullMask)
+          break;
+      }
+
+      if (i == size)
+        return false;
+      if (i + ISA::Width > size)
+        i = size - ISA::Width;
+
+      for (;;)
+      {
+        uint64 mask = ~ISA::EqualMask(ISA::Load(lhs + i), ISA::Load(rhs + i)) & ISA::FullMask;
+        if (mask)
+        {
+          size_t index = i + CountTrailingZeros(mask);
+          result = static_cast<int32>(lhs[index]) - static_cast<int32>(rhs[index]);
+          return true;
+        }
+
+        if (i + ISA::Width == size)
+          return false;
+
+        i += ISA::Width;
+        if (i + ISA::Width > size)
+          i = size - ISA::Width;
+      }
+    }
+
+    template<typename ISA>
+    static int32 Compare(const void* lhs, const void* rhs, size_t size)
+    {
+      const uint8* l = static_cast<const uint8*>(lhs);
+      const uint8* r = static_cast<const uint8*>(rhs);
+
+      int32 result = 0;
+      if (size >= ISA::Width)
+        CompareVectors<ISA>(l, r, size, result);
+      else if (size >= 16)
+        CompareVectors<SSE2>(l, r, size, result);
+      else if (size >= 8)
+      {
+        uint64 lhs_head = LoadBigEndian64(l), rhs_head = LoadBigEndian64(r);
+        if (lhs_head != rhs_head)
+          return lhs_head < rhs_head ? -1 : 1;
+
+        uint64 lhs_tail = LoadBigEndian64(l + size - 8), rhs_tail = LoadBigEndian64(r + size - 8);
+        if (lhs_tail != rhs_tail)
+          return lhs_tail < rhs_tail ? -1 : 1;
+      }
+      else
+      {
+        for (size_t i = 0; i < size; ++i)
+        {
+          if (l[i] != r[i])
+            return static_cast<int32>(l[i]) - static_cast<int32>(r[i]);
+        }
+      }
+      return result;
+    }
+
+    //same overlap trick as CompareVectors, a match in the overlap would have been found by the vector before
+    template<typename ISA>
+    static const void* FindVectors(const uint8* ptr, uint8 value, size_t size)
+    {
+      typename ISA::Vector needle = ISA::Broadcast(value);
+      size_t i = 0;
+
+      for (; i + 4 * ISA::Width <= size; i += 4 * ISA::Width)
+      {
+        uint64 match = ISA::EqualMask(ISA::Load(ptr + i), needle)
+          | ISA::EqualMask(ISA::Load(ptr + i + ISA::Width), needle)
+          | ISA::EqualMask(ISA::Load(ptr + i + 2 * ISA::Width), needle)
+          | ISA::EqualMask(ISA::Load(ptr + i + 3 * ISA::Width), needle);
+        if (match)
+          break;
+      }
+
+      if (i == size)
+        return nullptr;
+      if (i + ISA::Width > size)
+        i = size - ISA::Width;
+
+      for (;;)
+      {
+        uint64 mask = ISA::EqualMask(ISA::Load(ptr + i), needle);
+        if (mask)
+          return ptr + i + CountTrailingZeros(mask);
+
+        if (i + ISA::Width == size)
+          return nullptr;
+
+        i += ISA::Width;
+        if (i + ISA::Width > size)
+          i = size - ISA::Width;
+      }
+    }
+
+    template<typename ISA>
+    static const void* Find(const void* ptr, uint8 value, size_t size)
+    {
+      const uint8* p = static_cast<const uint8*>(ptr);
+
+      if (size >= ISA::Width)
+        return FindVectors<ISA>(p, value, size);
+      if (size >= 16)
+        return FindVectors<SSE2>(p, value, size);
+
+      for (size_t i = 0; i < size; ++i)
+      {
+        if (p[i] == value)
+          return p + i;
+      }
+      return nullptr;
+    }
+
+    template<typename ISA, typename HalfISA>
+    static constexpr MemoryKernels::Table MakeTable(const char* name)
+    {
+      return { &Copy<ISA, HalfISA>, &Move<ISA, HalfISA>, &Set<ISA, HalfISA>, &Compare<ISA>, &Find<ISA>, name };
+    }
+  }
+#endif
+}
@@ -0,0 +1,18 @@
+#include "MemoryKernelsImpl.h"
+
+namespace SSTD
+{
+#ifdef ARCH_X64
+  static constexpr MemoryKernels::Table s_Table = MakeTable<SSE2, SSE2>("SSE2");
+
+  const MemoryKernels::Table* MemoryKernels::GetSSE2Table()
+  {
+    return &s_Table;
+  }
+#else
+  const MemoryKernels::Table* MemoryKernels::GetSSE2Table()
+  {
+    return nullptr;
+  }
+#endif
+}
@@ -0,0 +1,113 @@
+#include "VirtualMemory.h"
+#include "Platform/IncludePlatform.h"
+
+#include "General/Memory.h"
+
+#ifdef PLATFORM_LINUX
+#include <sys/mman.h>
+#endif
+
+namespace SSTD
+{
+  static size_t AlignUp(size_t value, size_t alignment)
+  {
+    return (value + alignment - 1) & ~(alignment - 1);
+  }
+
+#ifdef PLATFORM_WIN64
+  void* VirtualMemory::Allocate(size_t size, size_t alignment)
+  {
+    size = AlignUp(size, GetPageSize());
+
+    //reserve more than we need, find the aligned address in there and try to grab exactly that range
+    //another thread can steal the range in between, so we retry a few times
+    for (uint32 attempt = 0; attempt < 8; ++attempt)
+    {
+      uint8* base = static_cast<uint8*>(VirtualAlloc(nullptr, size + alignment, MEM_RESERVE, PAGE_NOACCESS));
+      if (!base)
+        return nullptr;
+
+      uint8* aligned = reinterpret_cast<uint8*>(AlignUp(reinterpret_cast<size_t>(base), alignment));
+      VirtualFree(base, 0, MEM_RELEASE);
+
+      if (void* ptr = VirtualAlloc(aligned, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE))
+        return ptr;
+    }
+    return nullptr;
+  }
+
+  void VirtualMemory::Free(void* ptr, size_t size)
+  {
+    VirtualFree(ptr, 0, MEM_RELEASE);
+  }
+
+  //large pages need SeLockMemoryPrivilege and have to be requested at allocation time, so there is nothing to advise
+  bool VirtualMemory::AdviseHugePages(void* ptr, size_t size)
+  {
+    return false;
+  }
+
+  size_t VirtualMemory::GetHugePageSize()
+  {
+    return GetLargePageMinimum();
+  }
+
+  size_t VirtualMemory::GetPageSize()
+  {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+  }
+#elif  PLATFORM_WIN32
+#elif  PLATFORM_IPHONE_SIM
+#elif  PLATFORM_IPHONE
+#elif  PLATFORM_MAC
+#elif  PLATFORM_LINUX
+  void* VirtualMemory::Allocate(size_t size, size_t alignment)
+  {
+    size = AlignUp(size, GetPageSize());
+    size_t total = size + (alignment > GetPageSize() ? alignment : 0);
+
+    uint8* base = static_cast<uint8*>(mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (base == MAP_FAILED)
+      return nullptr;
+
+    //cut away what we don't need in front of and behind the aligned range
+    uint8* aligned = reinterpret_cast<uint8*>(AlignUp(reinterpret_cast<size_t>(base), alignment));
+    if (aligned != base)
+      munmap(base, aligned - base);
+
+    uint8* end = aligned + size;
+    if (end != base + total)
+      munmap(end, (base + total) - end);
+
+    return aligned;
+  }
+
+  void VirtualMemory::Free(void* ptr, size_t size)
+  {
+    munmap(ptr, AlignUp(size, GetPageSize()));
+  }
+
+  bool VirtualMemory::AdviseHugePages(void* ptr, size_t size)
+  {
+#ifdef MADV_HUGEPAGE
+    return madvise(ptr, AlignUp(size, GetPageSize()), MADV_HUGEPAGE) == 0;
+#else
+    return false;
+#endif
+  }
+
+  //the size transparent huge pages use on x86-64 and most arm64 kernels
+  size_t VirtualMemory::GetHugePageSize()
+  {
+    return 2 * Byte::MB;
+  }
+
+  size_t VirtualMemory::GetPageSize()
+  {
+    static const size_t s_PageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return s_PageSize;
+  }
+#endif
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Platform/DefinePlatform.h"
+
+#include "General/Numeric.h"
+
+namespace SSTD
+{
+  //Pages straight from the OS, bypassing malloc/new
+  namespace VirtualMemory
+  {
+    //returns committed, zeroed memory whose address is a multiple of alignment (a power of two), nullptr if the OS is out of memory
+    void* Allocate(size_t size, size_t alignment);
+    void Free(void* ptr, size_t size);
+
+    //asks the OS to back the range with (2 MiB transparent) huge pages, returns false if it won't
+    bool AdviseHugePages(void* ptr, size_t size);
+
+    size_t GetHugePageSize();
+
+    size_t GetPageSize();
+  }
+}
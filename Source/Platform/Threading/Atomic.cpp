@@ -0,0 +1,57 @@
+#include "Atomic.h"
+#include "Futex.h"
+
+namespace SSTD
+{
+  //the spin doubles every round, so we give up after ~2^MaxSpinShift pauses in total
+  static constexpr uint32 MaxSpinShift = 10;
+
+  //waiters announce themselves in a small shared table, so a notify without anyone waiting never enters the kernel
+  //different words can share a slot, that only costs an unneeded wake
+  struct alignas(64) WaiterSlot
+  {
+    volatile uint32 count = 0;
+  };
+
+  static constexpr uint32 WaiterSlotCount = 64;
+  static WaiterSlot s_WaiterSlots[WaiterSlotCount];
+
+  static WaiterSlot& GetWaiterSlot(const volatile uint32& word)
+  {
+    uint64 address = reinterpret_cast<uint64>(&word);
+    return s_WaiterSlots[((address >> 2) ^ (address >> 12)) % WaiterSlotCount];
+  }
+
+  void AtomicWait::Wait(const volatile uint32& word, uint32 expected, MemoryOrder order)
+  {
+    for (uint32 shift = 0; shift < MaxSpinShift; ++shift)
+    {
+      if (AtomicUtils::Load(word, order) != expected)
+        return;
+
+      for (uint32 i = 0; i < (1u << shift); ++i)
+        AtomicUtils::Pause();
+    }
+
+    WaiterSlot& slot = GetWaiterSlot(word);
+    AtomicUtils::PreIncrement(slot.count);
+    while (AtomicUtils::Load(word, order) == expected)
+      Futex::Wait(const_cast<volatile uint32&>(word), expected);
+    AtomicUtils::PreDecrement(slot.count);
+  }
+
+  void AtomicWait::NotifyOne(volatile uint32& word)
+  {
+    //pairs with the increment in Wait, either we see the waiter or it sees the new value
+    AtomicUtils::Fence();
+    if (AtomicUtils::Load(GetWaiterSlot(word).count, MemoryOrder::Relaxed))
+      Futex::WakeOne(word);
+  }
+
+  void AtomicWait::NotifyAll(volatile uint32& word)
+  {
+    AtomicUtils::Fence();
+    if (AtomicUtils::Load(GetWaiterSlot(word).count, MemoryOrder::Relaxed))
+      Futex::WakeAll(word);
+  }
+}
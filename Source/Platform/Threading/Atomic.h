@@ -3,35 +3,120 @@
 #include "Platform/IncludePlatform.h"
 
 #include "General/Numeric.h"
-#include "General/Concepts.h"
+#include "General/Meta.h"
+#include "General/Memory.h"
+#include "Containers/Pair.h"
 #include "AtomicUtils.h"
 
 namespace SSTD
 {
-  template<IntegralType T, size_t = sizeof(T)>
-  class AtomicInt;
+  //parking on a 32-bit word, see AtomicInt::Wait
+  namespace AtomicWait
+  {
+    void Wait(const volatile uint32& word, uint32 expected, MemoryOrder order);
+    void NotifyOne(volatile uint32& word);
+    void NotifyAll(volatile uint32& word);
+  }
 
+  //every operation takes an optional MemoryOrder, the operators are always sequentially consistent
   template<IntegralType T>
-  class AtomicInt<T, 1>
+  class AtomicInt
   {
     using DataType = NumericTypeFromSize<sizeof(T)>::Unsigned;
   public:
-    AtomicInt() : m_Data(0) {}
-    AtomicInt(T value) : m_Data(static_cast<uint8>(value)) {}
+    constexpr AtomicInt() : m_Data(0) {}
+    constexpr AtomicInt(T value) : m_Data(static_cast<DataType>(value)) {}
+
+    void Store(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      AtomicUtils::Store(m_Data, static_cast<DataType>(value), order);
+    }
+
+    T Load(MemoryOrder order = MemoryOrder::SequentiallyConsistent) const
+    {
+      return static_cast<T>(AtomicUtils::Load(m_Data, order));
+    }
+
+    T Exchange(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return static_cast<T>(AtomicUtils::Exchange(m_Data, static_cast<DataType>(value), order));
+    }
+
+    //returns true if the value was expected and got replaced by desired, otherwise expected receives the current value
+    bool CompareExchange(T& expected, T desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      DataType e = static_cast<DataType>(expected);
+      bool result = AtomicUtils::CompareExchange(m_Data, e, static_cast<DataType>(desired), order);
+      expected = static_cast<T>(e);
+      return result;
+    }
+
+    //all Fetch* operations return the value before the operation
+    T FetchAdd(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return static_cast<T>(AtomicUtils::Add(m_Data, static_cast<DataType>(value), order) - static_cast<DataType>(value));
+    }
+
+    T FetchSub(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return static_cast<T>(AtomicUtils::Subtract(m_Data, static_cast<DataType>(value), order) + static_cast<DataType>(value));
+    }
+
+    T FetchAnd(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return static_cast<T>(AtomicUtils::And(m_Data, static_cast<DataType>(value), order));
+    }
+
+    T FetchOr(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return static_cast<T>(AtomicUtils::Or(m_Data, static_cast<DataType>(value), order));
+    }
 
-    constexpr void Store(T value)
+    T FetchXor(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      AtomicUtils::Store(m_Data, static_cast<DataType>(value));
+      return static_cast<T>(AtomicUtils::Xor(m_Data, static_cast<DataType>(value), order));
     }
 
-    constexpr T Load()
+    //only writes if the value actually changes, so a hot max-counter doesn't bounce the cache line on every call
+    T FetchMin(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return static_cast<T>(AtomicUtils::Load(m_Data));
+      T current = Load(MemoryOrder::Relaxed);
+      while (value < current && !CompareExchange(current, value, order))
+        ;
+      return current;
     }
 
-    operator T()
+    T FetchMax(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return static_cast<T>(AtomicUtils::Load(m_Data));
+      T current = Load(MemoryOrder::Relaxed);
+      while (current < value && !CompareExchange(current, value, order))
+        ;
+      return current;
+    }
+
+    //blocks until the value is no longer expected, spins for a short while before the thread gets parked
+    //whoever changes the value has to call NotifyOne/NotifyAll afterwards
+    void Wait(T expected, MemoryOrder order = MemoryOrder::SequentiallyConsistent) const
+      requires (sizeof(T) == 4)
+    {
+      AtomicWait::Wait(m_Data, static_cast<DataType>(expected), order);
+    }
+
+    void NotifyOne()
+      requires (sizeof(T) == 4)
+    {
+      AtomicWait::NotifyOne(m_Data);
+    }
+
+    void NotifyAll()
+      requires (sizeof(T) == 4)
+    {
+      AtomicWait::NotifyAll(m_Data);
+    }
+
+    operator T() const
+    {
+      return Load();
     }
 
     void operator=(T value)
@@ -102,21 +187,34 @@ namespace SSTD
   public:
     AtomicBool() : m_Data(0) {};
     AtomicBool(bool value) : m_Data(static_cast<uint8>(value)) {};
-    AtomicBool(const AtomicBool& other) : m_Data(other.m_Data) {};
+    AtomicBool(const AtomicBool& other) : m_Data(other.m_Data.Load()) {};
 
-    void Store(bool value)
+    void Store(bool value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      m_Data.Store(static_cast<uint8>(value));
+      m_Data.Store(static_cast<uint8>(value), order);
+    }
+
+    bool Load(MemoryOrder order = MemoryOrder::SequentiallyConsistent) const
+    {
+      return m_Data.Load(order) == 1;
+    }
+
+    bool Exchange(bool value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return m_Data.Exchange(static_cast<uint8>(value), order) == 1;
     }
 
-    bool Load()
+    bool CompareExchange(bool& expected, bool desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return m_Data.Load();
+      uint8 e = static_cast<uint8>(expected);
+      bool result = m_Data.CompareExchange(e, static_cast<uint8>(desired), order);
+      expected = e == 1;
+      return result;
     }
 
     void operator=(const AtomicBool& other)
     {
-      m_Data = other.m_Data;
+      m_Data.Store(other.m_Data.Load());
     }
 
     void operator=(bool value) 
@@ -124,12 +222,133 @@ namespace SSTD
       m_Data.Store(static_cast<uint8>(value));
     }
 
-    operator bool() 
+    operator bool() const
     {
       return m_Data.Load() == 1;
     };
   private:
-    a_int8 m_Data;
+    a_uint8 m_Data;
   };
   using a_bool = AtomicBool;
-}
\ No newline at end of file
+
+  template<typename T>
+  class AtomicPointer
+  {
+    using DataType = NumericTypeFromSize<sizeof(T*)>::Unsigned;
+  public:
+    constexpr AtomicPointer() : m_Data(0) {}
+    AtomicPointer(T* value) : m_Data(ToData(value)) {}
+
+    void Store(T* value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      AtomicUtils::Store(m_Data, ToData(value), order);
+    }
+
+    T* Load(MemoryOrder order = MemoryOrder::SequentiallyConsistent) const
+    {
+      return ToPointer(AtomicUtils::Load(m_Data, order));
+    }
+
+    T* Exchange(T* value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return ToPointer(AtomicUtils::Exchange(m_Data, ToData(value), order));
+    }
+
+    //returns true if the pointer was expected and got replaced by desired, otherwise expected receives the current pointer
+    bool CompareExchange(T*& expected, T* desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      DataType e = ToData(expected);
+      bool result = AtomicUtils::CompareExchange(m_Data, e, ToData(desired), order);
+      expected = ToPointer(e);
+      return result;
+    }
+
+    //pointer arithmetic, offset is in elements not bytes
+    T* FetchAdd(intptr offset, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      DataType bytes = static_cast<DataType>(offset * static_cast<intptr>(sizeof(T)));
+      return ToPointer(AtomicUtils::Add(m_Data, bytes, order) - bytes);
+    }
+
+    T* FetchSub(intptr offset, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return FetchAdd(-offset, order);
+    }
+
+    operator T*() const { return Load(); }
+    T* operator->() const { return Load(); }
+
+    void operator=(T* value) { Store(value); }
+
+  private:
+    static DataType ToData(T* ptr) { return reinterpret_cast<DataType>(ptr); }
+    static T* ToPointer(DataType data) { return reinterpret_cast<T*>(data); }
+
+    volatile DataType m_Data;
+  };
+
+  //two 64-bit values that are swapped together, the classic use is a pointer + a version tag so a
+  //compare-exchange fails if the pointer got popped and pushed again in between (ABA)
+  template<typename T1, typename T2>
+    requires (sizeof(T1) == 8 && sizeof(T2) == 8)
+  class AtomicPair
+  {
+  public:
+    using ValueType = Pair<T1, T2>;
+
+    AtomicPair() : m_Data{ 0, 0 } {}
+    AtomicPair(const T1& first, const T2& second) : m_Data{ __builtin_bit_cast(uint64, first), __builtin_bit_cast(uint64, second) } {}
+
+    ValueType Load(MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return ToValue(AtomicUtils::Load128(m_Data, order));
+    }
+
+    //two plain loads, the halves may tear, only good as the expected value of a CompareExchange
+    ValueType Peek() const
+    {
+      uint64 low = m_Data.low;
+      uint64 high = m_Data.high;
+
+      ValueType out;
+      out.first = __builtin_bit_cast(T1, low);
+      out.second = __builtin_bit_cast(T2, high);
+      return out;
+    }
+
+    void Store(const T1& first, const T2& second, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      ValueType expected = Peek();
+      while (!CompareExchange(expected, first, second, order))
+        ;
+    }
+
+    //returns true if the pair was expected and got replaced, otherwise expected receives the current pair
+    bool CompareExchange(ValueType& expected, const T1& first, const T2& second, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      AtomicUtils::Int128 e = ToData(expected);
+      bool result = AtomicUtils::CompareExchange128(m_Data, e, { __builtin_bit_cast(uint64, first), __builtin_bit_cast(uint64, second) }, order);
+      expected = ToValue(e);
+      return result;
+    }
+
+  private:
+    static AtomicUtils::Int128 ToData(const ValueType& value)
+    {
+      return { __builtin_bit_cast(uint64, value.first), __builtin_bit_cast(uint64, value.second) };
+    }
+
+    static ValueType ToValue(const AtomicUtils::Int128& data)
+    {
+      ValueType out;
+      out.first = __builtin_bit_cast(T1, data.low);
+      out.second = __builtin_bit_cast(T2, data.high);
+      return out;
+    }
+
+    volatile AtomicUtils::Int128 m_Data;
+  };
+
+  template<typename T>
+  using AtomicTaggedPointer = AtomicPair<T*, uint64>;
+}
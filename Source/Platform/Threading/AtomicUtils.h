@@ -3,223 +3,557 @@
 #include "Platform/IncludePlatform.h"
 
 #include "General/Numeric.h"
+#include "General/Meta.h"
 
 namespace SSTD
 {
+  enum class MemoryOrder : uint8
+  {
+    Relaxed,
+    Acquire,
+    Release,
+    AcquireRelease,
+    SequentiallyConsistent
+  };
+
   namespace AtomicUtils
   {
+    //two 64-bit words that get swapped as one (cmpxchg16b), used for tagged pointers
+    struct alignas(16) Int128
+    {
+      uint64 low;
+      uint64 high;
+    };
+
 #ifdef PLATFORM_WIN64
 
 #include <intrin0.h>
 
-    static uint8 Load(volatile uint8& ptr)
+    //x64 keeps loads and stores in order by itself (only a store followed by a load can pass), so there only the compiler has to be held back
+    //on arm64 we need a real barrier, the interlocked functions come in _nf (relaxed), _acq and _rel flavours there
+#ifdef ARCH_ARM64
+#define SSTD_INTERLOCKED(func, order, ...) ((order) == MemoryOrder::Relaxed ? func##_nf(__VA_ARGS__) : (order) == MemoryOrder::Acquire ? func##_acq(__VA_ARGS__) : (order) == MemoryOrder::Release ? func##_rel(__VA_ARGS__) : func(__VA_ARGS__))
+#else
+#define SSTD_INTERLOCKED(func, order, ...) ((void)(order), func(__VA_ARGS__))
+#endif
+
+    inline void AcquireBarrier(MemoryOrder order)
+    {
+      if (order == MemoryOrder::Relaxed || order == MemoryOrder::Release)
+        return;
+#ifdef ARCH_ARM64
+      __dmb(_ARM64_BARRIER_ISH);
+#else
+      _ReadWriteBarrier();
+#endif
+    }
+
+    inline void ReleaseBarrier(MemoryOrder order)
+    {
+      if (order == MemoryOrder::Relaxed || order == MemoryOrder::Acquire)
+        return;
+#ifdef ARCH_ARM64
+      __dmb(_ARM64_BARRIER_ISH);
+#else
+      _ReadWriteBarrier();
+#endif
+    }
+
+    //__iso_volatile_* is a plain access, without the acquire/release msvc gives volatile under /volatile:ms
+    static uint8 Load(const volatile uint8& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      uint8 value = static_cast<uint8>(__iso_volatile_load8(reinterpret_cast<const volatile __int8*>(&ptr)));
+      AcquireBarrier(order);
+      return value;
+    }
+    static uint16 Load(const volatile uint16& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      uint16 value = static_cast<uint16>(__iso_volatile_load16(reinterpret_cast<const volatile __int16*>(&ptr)));
+      AcquireBarrier(order);
+      return value;
+    }
+    static uint32 Load(const volatile uint32& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      uint32 value = static_cast<uint32>(__iso_volatile_load32(reinterpret_cast<const volatile __int32*>(&ptr)));
+      AcquireBarrier(order);
+      return value;
+    }
+    static uint64 Load(const volatile uint64& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      uint64 value = static_cast<uint64>(__iso_volatile_load64(reinterpret_cast<const volatile __int64*>(&ptr)));
+      AcquireBarrier(order);
+      return value;
+    }
+
+
+    //only a sequentially consistent store needs the (implicitly locked) xchg, everything else is a plain mov
+    static void Store(volatile uint8& ptr, uint8 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      if (order == MemoryOrder::SequentiallyConsistent)
+      {
+        _InterlockedExchange8(reinterpret_cast<volatile CHAR*>(&ptr), value);
+        return;
+      }
+      ReleaseBarrier(order);
+      __iso_volatile_store8(reinterpret_cast<volatile __int8*>(&ptr), static_cast<__int8>(value));
+    }
+    static void Store(volatile uint16& ptr, uint16 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      if (order == MemoryOrder::SequentiallyConsistent)
+      {
+        _InterlockedExchange16(reinterpret_cast<volatile SHORT*>(&ptr), value);
+        return;
+      }
+      ReleaseBarrier(order);
+      __iso_volatile_store16(reinterpret_cast<volatile __int16*>(&ptr), static_cast<__int16>(value));
+    }
+    static void Store(volatile uint32& ptr, uint32 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      if (order == MemoryOrder::SequentiallyConsistent)
+      {
+        _InterlockedExchange(reinterpret_cast<volatile LONG*>(&ptr), value);
+        return;
+      }
+      ReleaseBarrier(order);
+      __iso_volatile_store32(reinterpret_cast<volatile __int32*>(&ptr), static_cast<__int32>(value));
+    }
+    static void Store(volatile uint64& ptr, uint64 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      if (order == MemoryOrder::SequentiallyConsistent)
+      {
+        _InterlockedExchange64(reinterpret_cast<volatile LONG64*>(&ptr), value);
+        return;
+      }
+      ReleaseBarrier(order);
+      __iso_volatile_store64(reinterpret_cast<volatile __int64*>(&ptr), static_cast<__int64>(value));
+    }
+
+
+    static uint8 Exchange(volatile uint8& ptr, uint8 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedOr8(reinterpret_cast<volatile CHAR*>(&ptr), 0);
+      return SSTD_INTERLOCKED(_InterlockedExchange8, order, reinterpret_cast<volatile CHAR*>(&ptr), value);
     }
-    static uint16 Load(volatile uint16& ptr)
+    static uint16 Exchange(volatile uint16& ptr, uint16 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedOr16(reinterpret_cast<volatile SHORT*>(&ptr), 0);
+      return SSTD_INTERLOCKED(_InterlockedExchange16, order, reinterpret_cast<volatile SHORT*>(&ptr), value);
     }
-    static uint32 Load(volatile uint32& ptr)
+    static uint32 Exchange(volatile uint32& ptr, uint32 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedOr(reinterpret_cast<volatile LONG*>(&ptr), 0);
+      return SSTD_INTERLOCKED(_InterlockedExchange, order, reinterpret_cast<volatile LONG*>(&ptr), value);
     }
-    static uint64 Load(volatile uint64& ptr)
+    static uint64 Exchange(volatile uint64& ptr, uint64 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedOr64(reinterpret_cast<volatile LONG64*>(&ptr), 0);
+      return SSTD_INTERLOCKED(_InterlockedExchange64, order, reinterpret_cast<volatile LONG64*>(&ptr), value);
     }
 
 
-    static void Store(volatile uint8& ptr, uint8 value)
+    //returns true if ptr held expected and got replaced, otherwise expected receives the current value
+    static bool CompareExchange(volatile uint8& ptr, uint8& expected, uint8 desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      _InterlockedExchange8(reinterpret_cast<volatile CHAR*>(&ptr), value);
+      uint8 prev = SSTD_INTERLOCKED(_InterlockedCompareExchange8, order, reinterpret_cast<volatile CHAR*>(&ptr), desired, expected);
+      if (prev == expected)
+        return true;
+      expected = prev;
+      return false;
     }
-    static void Store(volatile uint16& ptr, uint16 value)
+    static bool CompareExchange(volatile uint16& ptr, uint16& expected, uint16 desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      _InterlockedExchange16(reinterpret_cast<volatile SHORT*>(&ptr), value);
+      uint16 prev = SSTD_INTERLOCKED(_InterlockedCompareExchange16, order, reinterpret_cast<volatile SHORT*>(&ptr), desired, expected);
+      if (prev == expected)
+        return true;
+      expected = prev;
+      return false;
     }
-    static void Store(volatile uint32& ptr, uint32 value)
+    static bool CompareExchange(volatile uint32& ptr, uint32& expected, uint32 desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      _InterlockedExchange(reinterpret_cast<volatile LONG*>(&ptr), value);
+      uint32 prev = SSTD_INTERLOCKED(_InterlockedCompareExchange, order, reinterpret_cast<volatile LONG*>(&ptr), desired, expected);
+      if (prev == expected)
+        return true;
+      expected = prev;
+      return false;
     }
-    static void Store(volatile uint64& ptr, uint64 value)
+    static bool CompareExchange(volatile uint64& ptr, uint64& expected, uint64 desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      _InterlockedExchange64(reinterpret_cast<volatile LONG64*>(&ptr), value);
+      uint64 prev = SSTD_INTERLOCKED(_InterlockedCompareExchange64, order, reinterpret_cast<volatile LONG64*>(&ptr), desired, expected);
+      if (prev == expected)
+        return true;
+      expected = prev;
+      return false;
     }
 
-    static uint8 PreIncrement(volatile uint8& ptr)
+
+    static uint8 PreIncrement(volatile uint8& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      auto out = _InterlockedExchangeAdd8(reinterpret_cast<volatile CHAR*>(&ptr), 1);
+      auto out = SSTD_INTERLOCKED(_InterlockedExchangeAdd8, order, reinterpret_cast<volatile CHAR*>(&ptr), 1);
       return ++out;
     }
-    static uint16 PreIncrement(volatile uint16& ptr)
+    static uint16 PreIncrement(volatile uint16& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedIncrement16(reinterpret_cast<volatile SHORT*>(&ptr));
+      return SSTD_INTERLOCKED(_InterlockedIncrement16, order, reinterpret_cast<volatile SHORT*>(&ptr));
     }
-    static uint32 PreIncrement(volatile uint32& ptr)
+    static uint32 PreIncrement(volatile uint32& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedIncrement(reinterpret_cast<volatile LONG*>(&ptr));
+      return SSTD_INTERLOCKED(_InterlockedIncrement, order, reinterpret_cast<volatile LONG*>(&ptr));
     }
-    static uint64 PreIncrement(volatile uint64& ptr)
+    static uint64 PreIncrement(volatile uint64& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedIncrement64(reinterpret_cast<volatile LONG64*>(&ptr));
+      return SSTD_INTERLOCKED(_InterlockedIncrement64, order, reinterpret_cast<volatile LONG64*>(&ptr));
     }
 
 
-    static uint8 PostIncrement(volatile uint8& ptr)
+    static uint8 PostIncrement(volatile uint8& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedExchangeAdd8(reinterpret_cast<volatile CHAR*>(&ptr), 1L);
+      return SSTD_INTERLOCKED(_InterlockedExchangeAdd8, order, reinterpret_cast<volatile CHAR*>(&ptr), 1L);
     }
-    static uint16 PostIncrement(volatile uint16& ptr)
+    static uint16 PostIncrement(volatile uint16& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedExchangeAdd16(reinterpret_cast<volatile SHORT*>(&ptr), 1L);
+      return SSTD_INTERLOCKED(_InterlockedExchangeAdd16, order, reinterpret_cast<volatile SHORT*>(&ptr), 1L);
     }
-    static uint32 PostIncrement(volatile uint32& ptr)
+    static uint32 PostIncrement(volatile uint32& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedExchangeAdd(reinterpret_cast<volatile LONG*>(&ptr), 1L);
+      return SSTD_INTERLOCKED(_InterlockedExchangeAdd, order, reinterpret_cast<volatile LONG*>(&ptr), 1L);
     }
-    static uint64 PostIncrement(volatile uint64& ptr)
+    static uint64 PostIncrement(volatile uint64& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedExchangeAdd64(reinterpret_cast<volatile LONG64*>(&ptr), 1L);
+      return SSTD_INTERLOCKED(_InterlockedExchangeAdd64, order, reinterpret_cast<volatile LONG64*>(&ptr), 1L);
     }
 
 
-    static uint8 PreDecrement(volatile uint8& ptr)
+    static uint8 PreDecrement(volatile uint8& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      auto out = _InterlockedExchangeAdd8(reinterpret_cast<volatile CHAR*>(&ptr), -1);
+      auto out = SSTD_INTERLOCKED(_InterlockedExchangeAdd8, order, reinterpret_cast<volatile CHAR*>(&ptr), -1);
       return --out;
     }
-    static uint16 PreDecrement(volatile uint16& ptr)
+    static uint16 PreDecrement(volatile uint16& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedDecrement16(reinterpret_cast<volatile SHORT*>(&ptr));
+      return SSTD_INTERLOCKED(_InterlockedDecrement16, order, reinterpret_cast<volatile SHORT*>(&ptr));
     }
-    static uint32 PreDecrement(volatile uint32& ptr)
+    static uint32 PreDecrement(volatile uint32& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedDecrement(reinterpret_cast<volatile LONG*>(&ptr));
+      return SSTD_INTERLOCKED(_InterlockedDecrement, order, reinterpret_cast<volatile LONG*>(&ptr));
     }
-    static uint64 PreDecrement(volatile uint64& ptr)
+    static uint64 PreDecrement(volatile uint64& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedDecrement64(reinterpret_cast<volatile LONG64*>(&ptr));
+      return SSTD_INTERLOCKED(_InterlockedDecrement64, order, reinterpret_cast<volatile LONG64*>(&ptr));
     }
 
 
-    static uint8 PostDecrement(volatile uint8& ptr)
+    static uint8 PostDecrement(volatile uint8& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedExchangeAdd8(reinterpret_cast<volatile CHAR*>(&ptr), -1L);
+      return SSTD_INTERLOCKED(_InterlockedExchangeAdd8, order, reinterpret_cast<volatile CHAR*>(&ptr), -1L);
     }
-    static uint16 PostDecrement(volatile uint16& ptr)
+    static uint16 PostDecrement(volatile uint16& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedExchangeAdd16(reinterpret_cast<volatile SHORT*>(&ptr), -1L);
+      return SSTD_INTERLOCKED(_InterlockedExchangeAdd16, order, reinterpret_cast<volatile SHORT*>(&ptr), -1L);
     }
-    static uint32 PostDecrement(volatile uint32& ptr)
+    static uint32 PostDecrement(volatile uint32& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedExchangeAdd(reinterpret_cast<volatile LONG*>(&ptr), -1L);
+      return SSTD_INTERLOCKED(_InterlockedExchangeAdd, order, reinterpret_cast<volatile LONG*>(&ptr), -1L);
     }
-    static uint64 PostDecrement(volatile uint64& ptr)
+    static uint64 PostDecrement(volatile uint64& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedExchangeAdd64(reinterpret_cast<volatile LONG64*>(&ptr), -1L);
+      return SSTD_INTERLOCKED(_InterlockedExchangeAdd64, order, reinterpret_cast<volatile LONG64*>(&ptr), -1L);
     }
 
 
-    static uint8 Add(volatile uint8& ptr, uint8 value)
+    static uint8 Add(volatile uint8& ptr, uint8 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return value + _InterlockedExchangeAdd8(reinterpret_cast<volatile CHAR*>(&ptr), value);
+      return value + SSTD_INTERLOCKED(_InterlockedExchangeAdd8, order, reinterpret_cast<volatile CHAR*>(&ptr), value);
     }
 
-    static uint16 Add(volatile uint16& ptr, uint16 value)
+    static uint16 Add(volatile uint16& ptr, uint16 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return value + _InterlockedExchangeAdd16(reinterpret_cast<volatile SHORT*>(&ptr), value);
+      return value + SSTD_INTERLOCKED(_InterlockedExchangeAdd16, order, reinterpret_cast<volatile SHORT*>(&ptr), value);
     }
 
-    static uint32 Add(volatile uint32& ptr, uint32 value)
+    static uint32 Add(volatile uint32& ptr, uint32 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return value + _InterlockedExchangeAdd(reinterpret_cast<volatile LONG*>(&ptr), value);
+      return value + SSTD_INTERLOCKED(_InterlockedExchangeAdd, order, reinterpret_cast<volatile LONG*>(&ptr), value);
     }
 
-    static uint64 Add(volatile uint64& ptr, uint64 value)
+    static uint64 Add(volatile uint64& ptr, uint64 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return value + _InterlockedExchangeAdd64(reinterpret_cast<volatile LONG64*>(&ptr), value);
+      return value + SSTD_INTERLOCKED(_InterlockedExchangeAdd64, order, reinterpret_cast<volatile LONG64*>(&ptr), value);
     }
 
 
-    static uint8 Subtract(volatile uint8& ptr, uint8 value)
+    static uint8 Subtract(volatile uint8& ptr, uint8 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return Add(ptr, -value);
+      return Add(ptr, static_cast<uint8>(0 - value), order);
     }
 
-    static uint16 Subtract(volatile uint16& ptr, uint16 value)
+    static uint16 Subtract(volatile uint16& ptr, uint16 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return Add(ptr, -value);
+      return Add(ptr, static_cast<uint16>(0 - value), order);
     }
 
-    static uint32 Subtract(volatile uint32& ptr, uint32 value)
+    static uint32 Subtract(volatile uint32& ptr, uint32 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return Add(ptr, -value);
+      return Add(ptr, static_cast<uint32>(0 - value), order);
     }
 
-    static uint64 Subtract(volatile uint64& ptr, uint64 value)
+    static uint64 Subtract(volatile uint64& ptr, uint64 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return Add(ptr, -value);
+      return Add(ptr, static_cast<uint64>(0 - value), order);
     }
 
 
-    static uint8 And(volatile uint8& ptr, uint8 value)
+    static uint8 And(volatile uint8& ptr, uint8 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedAnd8(reinterpret_cast<volatile CHAR*>(&ptr), value);
+      return SSTD_INTERLOCKED(_InterlockedAnd8, order, reinterpret_cast<volatile CHAR*>(&ptr), value);
     }
-    static uint16 And(volatile uint16& ptr, uint16 value)
+    static uint16 And(volatile uint16& ptr, uint16 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedAnd16(reinterpret_cast<volatile SHORT*>(&ptr), value);
+      return SSTD_INTERLOCKED(_InterlockedAnd16, order, reinterpret_cast<volatile SHORT*>(&ptr), value);
     }
-    static uint32 And(volatile uint32& ptr, uint32 value)
+    static uint32 And(volatile uint32& ptr, uint32 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedAnd(reinterpret_cast<volatile LONG*>(&ptr), value);
+      return SSTD_INTERLOCKED(_InterlockedAnd, order, reinterpret_cast<volatile LONG*>(&ptr), value);
     }
-    static uint64 And(volatile uint64& ptr, uint64 value)
+    static uint64 And(volatile uint64& ptr, uint64 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedAnd64(reinterpret_cast<volatile LONG64*>(&ptr), value);
+      return SSTD_INTERLOCKED(_InterlockedAnd64, order, reinterpret_cast<volatile LONG64*>(&ptr), value);
     }
 
 
-    static uint8 Or(volatile uint8& ptr, uint8 value)
+    static uint8 Or(volatile uint8& ptr, uint8 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedOr8(reinterpret_cast<volatile CHAR*>(&ptr), value);
+      return SSTD_INTERLOCKED(_InterlockedOr8, order, reinterpret_cast<volatile CHAR*>(&ptr), value);
     }
-    static uint16 Or(volatile uint16& ptr, uint16 value)
+    static uint16 Or(volatile uint16& ptr, uint16 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedOr16(reinterpret_cast<volatile SHORT*>(&ptr), value);
+      return SSTD_INTERLOCKED(_InterlockedOr16, order, reinterpret_cast<volatile SHORT*>(&ptr), value);
     }
-    static uint32 Or(volatile uint32& ptr, uint32 value)
+    static uint32 Or(volatile uint32& ptr, uint32 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedOr(reinterpret_cast<volatile LONG*>(&ptr), value);
+      return SSTD_INTERLOCKED(_InterlockedOr, order, reinterpret_cast<volatile LONG*>(&ptr), value);
     }
-    static uint64 Or(volatile uint64& ptr, uint64 value)
+    static uint64 Or(volatile uint64& ptr, uint64 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedOr64(reinterpret_cast<volatile LONG64*>(&ptr), value);
+      return SSTD_INTERLOCKED(_InterlockedOr64, order, reinterpret_cast<volatile LONG64*>(&ptr), value);
     }
 
 
-    static uint8 Xor(volatile uint8& ptr, uint8 value)
+    static uint8 Xor(volatile uint8& ptr, uint8 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return SSTD_INTERLOCKED(_InterlockedXor8, order, reinterpret_cast<volatile CHAR*>(&ptr), value);
+    }
+    static uint16 Xor(volatile uint16& ptr, uint16 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return SSTD_INTERLOCKED(_InterlockedXor16, order, reinterpret_cast<volatile SHORT*>(&ptr), value);
+    }
+    static uint32 Xor(volatile uint32& ptr, uint32 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return SSTD_INTERLOCKED(_InterlockedXor, order, reinterpret_cast<volatile LONG*>(&ptr), value);
+    }
+    static uint64 Xor(volatile uint64& ptr, uint64 value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return SSTD_INTERLOCKED(_InterlockedXor64, order, reinterpret_cast<volatile LONG64*>(&ptr), value);
+    }
+
+    //returns true if ptr held expected and got replaced, otherwise expected receives the current value
+    inline bool CompareExchange128(volatile Int128& ptr, Int128& expected, Int128 desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedXor8(reinterpret_cast<volatile CHAR*>(&ptr), value);
+      return SSTD_INTERLOCKED(_InterlockedCompareExchange128, order, reinterpret_cast<volatile LONG64*>(&ptr), desired.high, desired.low, reinterpret_cast<LONG64*>(&expected));
     }
-    static uint16 Xor(volatile uint16& ptr, uint16 value)
+
+    //there is no plain 128-bit load, so we compare-exchange the value with itself
+    inline Int128 Load128(volatile Int128& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedXor16(reinterpret_cast<volatile SHORT*>(&ptr), value);
+      Int128 out{ 0, 0 };
+      CompareExchange128(ptr, out, out, order);
+      return out;
     }
-    static uint32 Xor(volatile uint32& ptr, uint32 value)
+
+    inline void Fence(MemoryOrder order = MemoryOrder::SequentiallyConsistent)
     {
-      return _InterlockedXor(reinterpret_cast<volatile LONG*>(&ptr), value);
+      if (order == MemoryOrder::SequentiallyConsistent)
+        MemoryBarrier();
+      else if (order != MemoryOrder::Relaxed)
+        AcquireBarrier(MemoryOrder::AcquireRelease);
     }
-    static uint64 Xor(volatile uint64& ptr, uint64 value)
+
+    //hint for spin-wait loops, lets the sibling hyper-thread run and saves some power
+    inline void Pause()
     {
-      return _InterlockedXor64(reinterpret_cast<volatile LONG64*>(&ptr), value);
+      YieldProcessor();
     }
+
+#undef SSTD_INTERLOCKED
 #elif  PLATFORM_WIN32
 #elif  PLATFORM_IPHONE_SIM
 #elif  PLATFORM_IPHONE
 #elif  PLATFORM_MAC
 #elif  PLATFORM_LINUX
+    static constexpr int ToNative(MemoryOrder order)
+    {
+      switch (order)
+      {
+      case MemoryOrder::Relaxed:
+        return __ATOMIC_RELAXED;
+      case MemoryOrder::Acquire:
+        return __ATOMIC_ACQUIRE;
+      case MemoryOrder::Release:
+        return __ATOMIC_RELEASE;
+      case MemoryOrder::AcquireRelease:
+        return __ATOMIC_ACQ_REL;
+      default:
+        return __ATOMIC_SEQ_CST;
+      }
+    }
+
+    //a load, like the failure order of a CAS, can't contain a release
+    static constexpr int ToNativeLoad(MemoryOrder order)
+    {
+      switch (order)
+      {
+      case MemoryOrder::Relaxed:
+      case MemoryOrder::Release:
+        return __ATOMIC_RELAXED;
+      case MemoryOrder::Acquire:
+      case MemoryOrder::AcquireRelease:
+        return __ATOMIC_ACQUIRE;
+      default:
+        return __ATOMIC_SEQ_CST;
+      }
+    }
+
+    //a store can't contain an acquire
+    static constexpr int ToNativeStore(MemoryOrder order)
+    {
+      switch (order)
+      {
+      case MemoryOrder::Relaxed:
+      case MemoryOrder::Acquire:
+        return __ATOMIC_RELAXED;
+      case MemoryOrder::Release:
+      case MemoryOrder::AcquireRelease:
+        return __ATOMIC_RELEASE;
+      default:
+        return __ATOMIC_SEQ_CST;
+      }
+    }
+
+    template<IntegralType T>
+    static T Load(const volatile T& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return __atomic_load_n(&ptr, ToNativeLoad(order));
+    }
+
+    template<IntegralType T>
+    static void Store(volatile T& ptr, T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      __atomic_store_n(&ptr, value, ToNativeStore(order));
+    }
+
+    template<IntegralType T>
+    static T Exchange(volatile T& ptr, T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return __atomic_exchange_n(&ptr, value, ToNative(order));
+    }
+
+    //returns true if ptr held expected and got replaced, otherwise expected receives the current value
+    template<IntegralType T>
+    static bool CompareExchange(volatile T& ptr, T& expected, T desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return __atomic_compare_exchange_n(&ptr, &expected, desired, false, ToNative(order), ToNativeLoad(order));
+    }
+
+    template<IntegralType T>
+    static T PreIncrement(volatile T& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return __atomic_add_fetch(&ptr, 1, ToNative(order));
+    }
+
+    template<IntegralType T>
+    static T PostIncrement(volatile T& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return __atomic_fetch_add(&ptr, 1, ToNative(order));
+    }
+
+    template<IntegralType T>
+    static T PreDecrement(volatile T& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return __atomic_sub_fetch(&ptr, 1, ToNative(order));
+    }
+
+    template<IntegralType T>
+    static T PostDecrement(volatile T& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return __atomic_fetch_sub(&ptr, 1, ToNative(order));
+    }
+
+    template<IntegralType T>
+    static T Add(volatile T& ptr, T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return __atomic_add_fetch(&ptr, value, ToNative(order));
+    }
+
+    template<IntegralType T>
+    static T Subtract(volatile T& ptr, T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return __atomic_sub_fetch(&ptr, value, ToNative(order));
+    }
+
+    template<IntegralType T>
+    static T And(volatile T& ptr, T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return __atomic_fetch_and(&ptr, value, ToNative(order));
+    }
+
+    template<IntegralType T>
+    static T Or(volatile T& ptr, T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return __atomic_fetch_or(&ptr, value, ToNative(order));
+    }
+
+    template<IntegralType T>
+    static T Xor(volatile T& ptr, T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      return __atomic_fetch_xor(&ptr, value, ToNative(order));
+    }
+
+    //returns true if ptr held expected and got replaced, otherwise expected receives the current value
+    inline bool CompareExchange128(volatile Int128& ptr, Int128& expected, Int128 desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+#if defined(__x86_64__)
+      //gcc only emits cmpxchg16b for __atomic builtins through libatomic, so we do it ourselves
+      //the lock prefix is a full barrier, which is at least as strong as any order
+      (void)order;
+      bool result;
+      asm volatile("lock cmpxchg16b %1"
+        : "=@ccz"(result), "+m"(ptr), "+a"(expected.low), "+d"(expected.high)
+        : "b"(desired.low), "c"(desired.high)
+        : "memory");
+      return result;
+#else
+      //goes through libatomic on most targets, SSTDLib links it everywhere but x64
+      return __atomic_compare_exchange(const_cast<Int128*>(&ptr), &expected, &desired, false, ToNative(order), ToNativeLoad(order));
+#endif
+    }
+
+    //there is no plain 128-bit load, so we compare-exchange the value with itself
+    inline Int128 Load128(volatile Int128& ptr, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      Int128 out{ 0, 0 };
+      CompareExchange128(ptr, out, out, order);
+      return out;
+    }
+
+    inline void Fence(MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+      __atomic_thread_fence(ToNative(order));
+    }
+
+    //hint for spin-wait loops, lets the sibling hyper-thread run and saves some power
+    inline void Pause()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+#elif defined(__aarch64__)
+      asm volatile("yield");
+#endif
+    }
 #endif
   }
 }
\ No newline at end of file
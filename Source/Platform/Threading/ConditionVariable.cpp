@@ -1,5 +1,10 @@
 #include "ConditionVariable.h"
 
+#ifdef PLATFORM_LINUX
+#include "Futex.h"
+#include "AtomicUtils.h"
+#endif
+
 namespace SSTD
 {
 #ifdef PLATFORM_WIN64
@@ -28,5 +33,31 @@ namespace SSTD
 #elif  PLATFORM_IPHONE
 #elif  PLATFORM_MAC
 #elif  PLATFORM_LINUX
+  ConditionVariable::ConditionVariable() :m_Sequence(0)
+  {
+  }
+  ConditionVariable::~ConditionVariable()
+  {
+    NotifyAll();
+  }
+  void ConditionVariable::NotifyOne()
+  {
+    AtomicUtils::PreIncrement(m_Sequence, MemoryOrder::Release);
+    Futex::WakeOne(m_Sequence);
+  }
+  void ConditionVariable::NotifyAll()
+  {
+    AtomicUtils::PreIncrement(m_Sequence, MemoryOrder::Release);
+    Futex::WakeAll(m_Sequence);
+  }
+  void ConditionVariable::Wait(Lock<Mutex>& lock)
+  {
+    uint32 sequence = AtomicUtils::Load(m_Sequence, MemoryOrder::Acquire);
+    Mutex& mutex = lock.GetLock();
+
+    mutex.Unlock();
+    Futex::Wait(m_Sequence, sequence);
+    mutex.Lock();
+  }
 #endif
 }
\ No newline at end of file
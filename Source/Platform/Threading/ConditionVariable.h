@@ -35,6 +35,8 @@ namespace SSTD
 #elif  PLATFORM_IPHONE
 #elif  PLATFORM_MAC
 #elif  PLATFORM_LINUX
+    //every notify bumps the sequence, a waiter only sleeps if nobody notified since it released the mutex
+    volatile uint32 m_Sequence;
 #endif
   };
 }
\ No newline at end of file
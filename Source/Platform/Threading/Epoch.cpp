@@ -0,0 +1,117 @@
+#include "Epoch.h"
+
+#include "Atomic.h"
+#include "Mutex.h"
+#include "Lock.h"
+
+namespace SSTD
+{
+  namespace
+  {
+    static constexpr uint64 Idle = ~0ull;
+
+    //records are never freed, a dead thread's record is handed to the next new thread
+    //only the owning thread writes epoch, TryAdvance reads all of them
+    struct alignas(64) ThreadRecord
+    {
+      a_uint64 epoch{ Idle };
+      uint32 depth = 0;
+      ThreadRecord* next = nullptr;
+      ThreadRecord* next_free = nullptr;
+    };
+
+    static Mutex& GetMutex()
+    {
+      static Mutex mutex;
+      return mutex;
+    }
+
+    static a_uint64 s_Epoch{ 0 };
+    static AtomicPointer<ThreadRecord> s_Records;
+    static ThreadRecord* s_FreeRecords = nullptr;
+
+    static thread_local ThreadRecord* t_Record = nullptr;
+
+    struct RecordOwner
+    {
+      ~RecordOwner()
+      {
+        if (!t_Record)
+          return;
+
+        Lock<Mutex> lock(GetMutex());
+        t_Record->next_free = s_FreeRecords;
+        s_FreeRecords = t_Record;
+        t_Record = nullptr;
+      }
+    };
+
+    static thread_local RecordOwner t_RecordOwner;
+
+    static ThreadRecord* GetRecord()
+    {
+      if (t_Record)
+        return t_Record;
+
+      Lock<Mutex> lock(GetMutex());
+      if (s_FreeRecords)
+      {
+        t_Record = s_FreeRecords;
+        s_FreeRecords = s_FreeRecords->next_free;
+      }
+      else
+      {
+        //the list only grows at the head, TryAdvance can walk it without the mutex
+        t_Record = new ThreadRecord();
+        t_Record->next = s_Records.Load(MemoryOrder::Relaxed);
+        s_Records.Store(t_Record, MemoryOrder::Release);
+      }
+
+      (void)&t_RecordOwner;
+      return t_Record;
+    }
+  }
+
+  void Epoch::Enter()
+  {
+    ThreadRecord* record = GetRecord();
+    if (record->depth++ != 0)
+      return;
+
+    //the epoch may move on between the load and the store, then announce the new one,
+    //otherwise TryAdvance could pass us twice and free what we are about to read
+    uint64 epoch = s_Epoch.Load();
+    for (;;)
+    {
+      record->epoch.Store(epoch);
+      uint64 now = s_Epoch.Load();
+      if (now == epoch)
+        break;
+      epoch = now;
+    }
+  }
+
+  void Epoch::Leave()
+  {
+    ThreadRecord* record = t_Record;
+    if (--record->depth == 0)
+      record->epoch.Store(Idle, MemoryOrder::Release);
+  }
+
+  uint64 Epoch::Current()
+  {
+    return s_Epoch.Load();
+  }
+
+  bool Epoch::TryAdvance()
+  {
+    uint64 epoch = s_Epoch.Load();
+    for (ThreadRecord* record = s_Records.Load(MemoryOrder::Acquire); record; record = record->next)
+    {
+      uint64 seen = record->epoch.Load();
+      if (seen != Idle && seen != epoch)
+        return false;
+    }
+    return s_Epoch.CompareExchange(epoch, epoch + 1);
+  }
+}
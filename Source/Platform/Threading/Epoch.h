@@ -0,0 +1,35 @@
+#pragma once
+
+#include "General/Numeric.h"
+#include "General/Pattern.h"
+
+namespace SSTD
+{
+  //Epoch based reclamation, lets readers walk shared nodes without taking a lock
+  //readers keep an EpochGuard alive while they touch the nodes, a writer that unlinks a node stamps it with
+  //Epoch::Current() afterwards and frees it once Epoch::CanFree(stamp) is true, by then no reader can still see it
+  //a reader that stays inside a guard for long holds back every free, keep the guarded part short
+  namespace Epoch
+  {
+    //nested calls are fine, only the outermost pair counts
+    void Enter();
+    void Leave();
+
+    uint64 Current();
+
+    //moves the global epoch on if every thread inside a guard has seen the current one
+    bool TryAdvance();
+
+    inline bool CanFree(uint64 stamp)
+    {
+      return Current() >= stamp + 2;
+    }
+  }
+
+  class EpochGuard : public NonCopyable
+  {
+  public:
+    EpochGuard() { Epoch::Enter(); }
+    ~EpochGuard() { Epoch::Leave(); }
+  };
+}
@@ -0,0 +1,43 @@
+#include "Futex.h"
+#include "Platform/IncludePlatform.h"
+
+#ifdef PLATFORM_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace SSTD
+{
+#ifdef PLATFORM_WIN64
+  void Futex::Wait(volatile uint32& word, uint32 expected)
+  {
+    WaitOnAddress(&word, &expected, sizeof(uint32), INFINITE);
+  }
+  void Futex::WakeOne(volatile uint32& word)
+  {
+    WakeByAddressSingle((void*)&word);
+  }
+  void Futex::WakeAll(volatile uint32& word)
+  {
+    WakeByAddressAll((void*)&word);
+  }
+#elif  PLATFORM_WIN32
+#elif  PLATFORM_IPHONE_SIM
+#elif  PLATFORM_IPHONE
+#elif  PLATFORM_MAC
+#elif  PLATFORM_LINUX
+  //the words are never shared between processes, so we can always use the cheaper private futex ops
+  void Futex::Wait(volatile uint32& word, uint32 expected)
+  {
+    syscall(SYS_futex, &word, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+  }
+  void Futex::WakeOne(volatile uint32& word)
+  {
+    syscall(SYS_futex, &word, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+  }
+  void Futex::WakeAll(volatile uint32& word)
+  {
+    syscall(SYS_futex, &word, FUTEX_WAKE_PRIVATE, NumericLimit<int32>::max, nullptr, nullptr, 0);
+  }
+#endif
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Platform/DefinePlatform.h"
+
+#include "General/Numeric.h"
+
+namespace SSTD
+{
+  //Futex provides the raw "park on a 32-bit word" primitive the Mutex, ConditionVariable and AtomicInt::Wait build on
+  //Wait only sleeps if the word still holds the expected value, spurious wakeups are possible so always re-check the word
+  namespace Futex
+  {
+    void Wait(volatile uint32& word, uint32 expected);
+    void WakeOne(volatile uint32& word);
+    void WakeAll(volatile uint32& word);
+  }
+}
@@ -18,7 +18,8 @@ namespace SSTD
     }
     ~Lock()
     {
-      Unlock();
+      if (m_Owned)
+        Unlock();
     }
 
     void Unlock()
@@ -1,5 +1,10 @@
 #include "Mutex.h"
 
+#ifdef PLATFORM_LINUX
+#include "Futex.h"
+#include "AtomicUtils.h"
+#endif
+
 namespace SSTD
 {
 #ifdef PLATFORM_WIN64
@@ -20,8 +25,8 @@ namespace SSTD
   {
     if (TryEnterCriticalSection(&m_Handle))
     {
-      return true;
       ++m_LockCount;
+      return true;
     }
     return false;
   }
@@ -39,5 +44,66 @@ namespace SSTD
 #elif  PLATFORM_IPHONE
 #elif  PLATFORM_MAC
 #elif  PLATFORM_LINUX
+  //see Ulrich Drepper - "Futexes Are Tricky" (mutex3), the kernel is only entered if the lock is contended
+  static constexpr uint32 SpinCount = 100;
+
+  Mutex::Mutex() :m_Handle(0), m_LockCount(0)
+  {
+  }
+  Mutex::~Mutex()
+  {
+  }
+  void Mutex::Lock()
+  {
+    uint32 state = 0;
+    if (AtomicUtils::CompareExchange<uint32>(m_Handle, state, 1, MemoryOrder::Acquire))
+    {
+      ++m_LockCount;
+      return;
+    }
+
+    //spin a bit before we go to sleep, most critical sections are short
+    for (uint32 i = 0; i < SpinCount && state == 1; ++i)
+    {
+      AtomicUtils::Pause();
+      state = 0;
+      if (AtomicUtils::CompareExchange<uint32>(m_Handle, state, 1, MemoryOrder::Acquire))
+      {
+        ++m_LockCount;
+        return;
+      }
+    }
+
+    //mark the lock as contended, whoever unlocks it has to wake us up
+    if (state != 2)
+      state = AtomicUtils::Exchange<uint32>(m_Handle, 2, MemoryOrder::Acquire);
+
+    while (state != 0)
+    {
+      Futex::Wait(m_Handle, 2);
+      state = AtomicUtils::Exchange<uint32>(m_Handle, 2, MemoryOrder::Acquire);
+    }
+    ++m_LockCount;
+  }
+  bool Mutex::TryLock()
+  {
+    uint32 state = 0;
+    if (AtomicUtils::CompareExchange<uint32>(m_Handle, state, 1, MemoryOrder::Acquire))
+    {
+      ++m_LockCount;
+      return true;
+    }
+    return false;
+  }
+  void Mutex::Unlock()
+  {
+    --m_LockCount;
+    if (AtomicUtils::Exchange<uint32>(m_Handle, 0, MemoryOrder::Release) == 2)
+      Futex::WakeOne(m_Handle);
+  }
+  bool Mutex::IsLocked()
+  {
+    return AtomicUtils::Load(m_Handle, MemoryOrder::Relaxed) != 0;
+  }
 #endif
-}
\ No newline at end of file
+}
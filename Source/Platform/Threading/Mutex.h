@@ -2,6 +2,8 @@
 
 #include "Platform/IncludePlatform.h"
 
+#include "General/Numeric.h"
+
 namespace SSTD
 {
   class Mutex
@@ -22,8 +24,11 @@ namespace SSTD
 #elif  PLATFORM_IPHONE
 #elif  PLATFORM_MAC
 #elif  PLATFORM_LINUX
+    friend class ConditionVariable;
+    //0 = unlocked, 1 = locked, 2 = locked and someone might sleep on the futex
+    volatile uint32 m_Handle;
 #endif
   private:
     unsigned int m_LockCount;
   };
-}
\ No newline at end of file
+}
@@ -3,9 +3,13 @@
 
 namespace SSTD
 {
+  Thread::Thread(const Function<void()>& func, bool launch) noexcept
+    : Thread(func, ThreadDesc{}, launch)
+  {}
 
 #ifdef PLATFORM_WIN64
-  Thread::Thread(const Function<void()>& func, bool launch) noexcept
+  Thread::Thread(const Function<void()>& func, const ThreadDesc& desc, bool launch) noexcept
+    : m_Desc(desc)
   {
     struct InternalThread
     {
@@ -17,14 +21,26 @@ namespace SSTD
       {
         InternalThread* data = reinterpret_cast<InternalThread*>(param);
         data->m_Function.Invoke();
+        delete data;
         return 0;
       }
       Function<void()> m_Function;
     };
 
-    m_Handle = CreateThread(NULL, 0, InternalThread::threadProc, new InternalThread(func), CREATE_SUSPENDED, reinterpret_cast<LPDWORD>(&m_Id));
+    InternalThread* data = new InternalThread(func);
+    m_Handle = CreateThread(NULL, m_Desc.stack_size, InternalThread::threadProc, data, CREATE_SUSPENDED, reinterpret_cast<LPDWORD>(&m_Id));
+    if (!m_Handle)
+    {
+      delete data;
+      m_State = ThreadState::Failed;
+      return;
+    }
+
+    if (!m_Desc.name.IsEmpty())
+      SetName(m_Desc.name);
 
-    //TODO: add Thread name
+    if (m_Desc.affinity)
+      SetAffinity(m_Desc.affinity);
 
     if (launch)
       Start();
@@ -35,15 +51,37 @@ namespace SSTD
   }
   void Thread::Start()
   {
+    if (m_State != ThreadState::Created)
+      return;
+
     ResumeThread(m_Handle);
+    m_State = ThreadState::Running;
   }
   void Thread::Join()
   {
+    if (m_State != ThreadState::Running)
+      return;
+
     WaitForSingleObject(m_Handle, INFINITE);
+    m_State = ThreadState::Finished;
   }
   void Thread::Detach()
   {
     CloseHandle(m_Handle);
+    m_State = ThreadState::Finished;
+  }
+  void Thread::SetName(const String& name)
+  {
+    m_Desc.name = name;
+
+    wchar_t buffer[64]{};
+    MultiByteToWideChar(CP_UTF8, 0, name.CStr(), static_cast<int>(name.Size()), buffer, 63);
+    SetThreadDescription(m_Handle, buffer);
+  }
+  void Thread::SetAffinity(uint64 affinity)
+  {
+    m_Desc.affinity = affinity;
+    SetThreadAffinityMask(m_Handle, static_cast<DWORD_PTR>(affinity));
   }
   void* Thread::GetNative()
   {
@@ -54,5 +92,130 @@ namespace SSTD
 #elif  PLATFORM_IPHONE
 #elif  PLATFORM_MAC
 #elif  PLATFORM_LINUX
+  static_assert(sizeof(pthread_t) == sizeof(unsigned long), "pthread_t does not fit into the native handle");
+
+  struct InternalThread
+  {
+  public:
+    InternalThread(const Function<void()>& func)
+      :m_Function(func)
+    {}
+    static void* threadProc(void* param)
+    {
+      InternalThread* data = reinterpret_cast<InternalThread*>(param);
+      data->m_Function.Invoke();
+      delete data;
+      return nullptr;
+    }
+    Function<void()> m_Function;
+  };
+
+  Thread::Thread(const Function<void()>& func, const ThreadDesc& desc, bool launch) noexcept
+    : m_Data(new InternalThread(func)), m_Desc(desc)
+  {
+    if (launch)
+      Start();
+  }
+  Thread::~Thread()
+  {
+    Join();
+
+    //never started, so the thread can't clean up after itself
+    delete reinterpret_cast<InternalThread*>(m_Data);
+  }
+  void Thread::Start()
+  {
+    if (m_State != ThreadState::Created)
+      return;
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+
+    if (m_Desc.stack_size)
+    {
+      //some libcs want whole pages
+      size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+      size_t stack_size = m_Desc.stack_size < static_cast<size_t>(PTHREAD_STACK_MIN) ? static_cast<size_t>(PTHREAD_STACK_MIN) : m_Desc.stack_size;
+      stack_size = (stack_size + page - 1) & ~(page - 1);
+      if (pthread_attr_setstacksize(&attributes, stack_size) != 0)
+      {
+        pthread_attr_destroy(&attributes);
+        m_State = ThreadState::Failed;
+        return;
+      }
+    }
+
+    if (m_Desc.affinity)
+    {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (uint32 i = 0; i < 64; ++i)
+        if (m_Desc.affinity & (1ULL << i))
+          CPU_SET(i, &set);
+      pthread_attr_setaffinity_np(&attributes, sizeof(set), &set);
+    }
+
+    pthread_t handle;
+    if (pthread_create(&handle, &attributes, InternalThread::threadProc, m_Data) == 0)
+    {
+      m_Handle = handle;
+      m_Data = nullptr;
+      m_State = ThreadState::Running;
+
+      if (!m_Desc.name.IsEmpty())
+        SetName(m_Desc.name);
+    }
+    else
+    {
+      //m_Data stays with us, the destructor frees it
+      m_State = ThreadState::Failed;
+    }
+    pthread_attr_destroy(&attributes);
+  }
+  void Thread::Join()
+  {
+    if (m_State != ThreadState::Running)
+      return;
+
+    pthread_join(static_cast<pthread_t>(m_Handle), nullptr);
+    m_State = ThreadState::Finished;
+  }
+  void Thread::Detach()
+  {
+    if (m_State != ThreadState::Running)
+      return;
+
+    pthread_detach(static_cast<pthread_t>(m_Handle));
+    m_State = ThreadState::Finished;
+  }
+  void Thread::SetName(const String& name)
+  {
+    m_Desc.name = name;
+    if (m_State != ThreadState::Running)
+      return;
+
+    //the kernel only keeps 15 characters + the null terminator
+    char buffer[16]{};
+    size_t size = name.Size() < 15 ? name.Size() : 15;
+    TMemCpy<char>(buffer, name.CStr(), size);
+    pthread_setname_np(static_cast<pthread_t>(m_Handle), buffer);
+  }
+  void Thread::SetAffinity(uint64 affinity)
+  {
+    m_Desc.affinity = affinity;
+    if (m_State != ThreadState::Running)
+      return;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint32 i = 0; i < 64; ++i)
+      if (affinity & (1ULL << i))
+        CPU_SET(i, &set);
+    pthread_setaffinity_np(static_cast<pthread_t>(m_Handle), sizeof(set), &set);
+  }
+  void* Thread::GetNative()
+  {
+    return reinterpret_cast<void*>(m_Handle);
+  }
 #endif
-}
\ No newline at end of file
+}
@@ -2,6 +2,7 @@
 
 #include "Platform/DefinePlatform.h"
 #include "Containers/Function.h"
+#include "Containers/String.h"
 
 #include "General/Numeric.h"
 
@@ -11,19 +12,38 @@ namespace SSTD
   {
     Created,
     Running,
-    Finished
+    Finished,
+    //the platform refused to create the thread, it never runs
+    Failed
+  };
+
+  struct ThreadDesc
+  {
+    String name = "";
+
+    //0 uses the platform default
+    size_t stack_size = 0;
+
+    //one bit per logical core, 0 lets the scheduler decide
+    uint64 affinity = 0;
   };
 
   class Thread
   {
   public:
     Thread(const Function<void()>& func, bool launch) noexcept;
+    Thread(const Function<void()>& func, const ThreadDesc& desc, bool launch) noexcept;
     virtual ~Thread();
 
     void Start();
     void Join();
     void Detach();
 
+    void SetName(const String& name);
+    void SetAffinity(uint64 affinity);
+
+    ThreadState GetState() const { return m_State; }
+
     void* GetNative();
   private:
 #ifdef PLATFORM_WIN64
@@ -34,6 +54,11 @@ namespace SSTD
 #elif  PLATFORM_IPHONE
 #elif  PLATFORM_MAC
 #elif  PLATFORM_LINUX
+    //pthreads can't be created suspended, so we keep the entry point until Start()
+    void* m_Data = nullptr;
+    unsigned long m_Handle = 0;
 #endif
+    ThreadDesc m_Desc;
+    ThreadState m_State = ThreadState::Created;
   };
-}
\ No newline at end of file
+}
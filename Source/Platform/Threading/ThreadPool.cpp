@@ -0,0 +1,125 @@
+#include "ThreadPool.h"
+
+#include "Platform/CPU/CPU.h"
+
+namespace SSTD
+{
+  ThreadPool::ThreadPool(uint32 workers)
+  {
+    if (workers == 0)
+      workers = CPU::GetLogicalCoreCount() - 1;
+
+    m_Workers.Reserve(workers);
+    for (uint32 i = 0; i < workers; ++i)
+    {
+      ThreadDesc desc{};
+      desc.name = "SSTD Worker";
+      m_Workers.EmplaceBack(new Thread(Function<void()>::Create([this]() { WorkerLoop(); }), desc, true));
+    }
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+    {
+      Lock<Mutex> lock(m_Mutex);
+      m_Stop = true;
+    }
+    m_WorkReady.NotifyAll();
+
+    //the Thread destructor joins
+    m_Workers.Erase();
+  }
+
+  void ThreadPool::RunErased(uint32 count, void* context, Invoke invoke)
+  {
+    if (count == 0)
+      return;
+
+    uint32 idle = 0;
+    if (count == 1 || m_Workers.IsEmpty() || !m_Busy.CompareExchange(idle, 1, MemoryOrder::Acquire))
+    {
+      for (uint32 i = 0; i < count; ++i)
+        invoke(context, i);
+      return;
+    }
+
+    Batch batch{};
+    batch.context = context;
+    batch.invoke = invoke;
+    batch.count = count;
+    {
+      Lock<Mutex> lock(m_Mutex);
+      m_Batch = &batch;
+      ++m_Generation;
+    }
+    m_WorkReady.NotifyAll();
+
+    Work(batch);
+
+    //every index is taken once we get here, a worker that wakes up later must not pick up the batch anymore
+    {
+      Lock<Mutex> lock(m_Mutex);
+      m_Batch = nullptr;
+      m_WorkDone.WaitFor(lock, [&]() { return batch.active == 0; });
+    }
+    m_Busy.Store(0, MemoryOrder::Release);
+
+    if (batch.error)
+      std::rethrow_exception(batch.error);
+  }
+
+  ThreadPool& ThreadPool::GetDefault()
+  {
+    static ThreadPool s_Pool{};
+    return s_Pool;
+  }
+
+  void ThreadPool::WorkerLoop()
+  {
+    uint32 seen = 0;
+    while (true)
+    {
+      Batch* batch = nullptr;
+      {
+        Lock<Mutex> lock(m_Mutex);
+        m_WorkReady.WaitFor(lock, [&]() { return m_Stop || m_Generation != seen; });
+        if (m_Stop)
+          return;
+
+        seen = m_Generation;
+        batch = m_Batch;
+        if (!batch)
+          continue;
+        ++batch->active;
+      }
+
+      Work(*batch);
+
+      bool last = false;
+      {
+        Lock<Mutex> lock(m_Mutex);
+        last = --batch->active == 0;
+      }
+      if (last)
+        m_WorkDone.NotifyAll();
+    }
+  }
+
+  void ThreadPool::Work(Batch& batch)
+  {
+    try
+    {
+      for (uint32 i = batch.next.FetchAdd(1, MemoryOrder::Relaxed); i < batch.count; i = batch.next.FetchAdd(1, MemoryOrder::Relaxed))
+        batch.invoke(batch.context, i);
+    }
+    catch (...)
+    {
+      //hand out nothing more, the tasks already running finish and Run rethrows
+      batch.next.Store(batch.count, MemoryOrder::Relaxed);
+
+      Lock<Mutex> lock(m_Mutex);
+      if (!batch.error)
+        batch.error = std::current_exception();
+    }
+  }
+}
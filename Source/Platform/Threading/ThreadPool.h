@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Thread.h"
+#include "Mutex.h"
+#include "ConditionVariable.h"
+#include "Atomic.h"
+
+#include "Containers/Vector.h"
+#include "Containers/Pointer.h"
+#include "Containers/Function.h"
+#include "General/Pattern.h"
+#include "General/Utility.h"
+
+#include <exception>
+
+namespace SSTD
+{
+  //Fixed set of worker threads for fork-join work, see General/ParallelAlgorithm.h for the algorithms on top
+  //Run hands out task indices to the workers and the calling thread alike and returns once every task is done
+  //only one Run is in flight at a time, a Run from inside a task or from a second thread runs its tasks inline
+  class ThreadPool : public NonCopyable
+  {
+  public:
+    //0 workers starts one per logical core minus the calling thread
+    explicit ThreadPool(uint32 workers = 0);
+    ~ThreadPool();
+
+    //calls task(i) for every i in [0, count), task is used in place, so nothing gets copied or allocated
+    //if a task throws no further indices are handed out, the batch still finishes and the first exception is rethrown here
+    template<typename Task>
+    void Run(uint32 count, Task&& task)
+    {
+      using Type = typename RemoveReference<Task>::Type;
+      RunErased(count, const_cast<void*>(static_cast<const void*>(&task)), [](void* context, uint32 index) { (*static_cast<Type*>(context))(index); });
+    }
+
+    //the workers plus the calling thread
+    uint32 GetConcurrency() const { return static_cast<uint32>(m_Workers.Size()) + 1; }
+
+    //shared pool sized to the machine, started on first use
+    static ThreadPool& GetDefault();
+  private:
+    using Invoke = void(*)(void*, uint32);
+
+    struct Batch
+    {
+      void* context = nullptr;
+      Invoke invoke = nullptr;
+      uint32 count = 0;
+      AtomicInt<uint32> next{ 0 };
+      //workers that took the batch and may still touch it
+      uint32 active = 0;
+      //first exception a task threw, guarded by m_Mutex
+      std::exception_ptr error{};
+    };
+
+    void RunErased(uint32 count, void* context, Invoke invoke);
+    void WorkerLoop();
+    void Work(Batch& batch);
+
+    Vector<UniquePointer<Thread>> m_Workers;
+    Mutex m_Mutex;
+    ConditionVariable m_WorkReady;
+    ConditionVariable m_WorkDone;
+    Batch* m_Batch = nullptr;
+    uint32 m_Generation = 0;
+    bool m_Stop = false;
+    AtomicInt<uint32> m_Busy{ 0 };
+  };
+}
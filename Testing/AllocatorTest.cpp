@@ -0,0 +1,378 @@
+#include <gtest/gtest.h>
+
+#include "General/ArenaAllocator.h"
+#include "General/PoolAllocator.h"
+#include "General/HeapAllocator.h"
+#include "General/TrackingAllocator.h"
+#include "General/AlignedAllocator.h"
+#include "Containers/Vector.h"
+#include "Platform/Threading/Atomic.h"
+
+#include "TestUtility.h"
+
+#include <cstring>
+
+namespace
+{
+  struct alignas(64) CacheLine
+  {
+    uint64 values[8];
+  };
+
+  bool IsAligned(const void* ptr, size_t alignment)
+  {
+    return (reinterpret_cast<SSTD::uintptr>(ptr) & (alignment - 1)) == 0;
+  }
+}
+
+TEST(LinearArenaTest, AllocationsAreAligned)
+{
+  SSTD::LinearArena arena(1024);
+  for (size_t alignment = 1; alignment <= 256; alignment *= 2)
+  {
+    //an odd sized block in front makes sure the position has to be aligned up
+    arena.Allocate(3, 1);
+    EXPECT_TRUE(IsAligned(arena.Allocate(24, alignment), alignment)) << alignment;
+  }
+  EXPECT_TRUE(IsAligned(arena.Allocate(8), SSTD::LinearArena::DefaultAlignment));
+}
+
+TEST(LinearArenaTest, BlocksDontOverlap)
+{
+  SSTD::LinearArena arena(256);
+  uint8* blocks[64];
+  for (uint32 i = 0; i < 64; ++i)
+  {
+    blocks[i] = static_cast<uint8*>(arena.Allocate(40));
+    for (uint32 b = 0; b < 40; ++b)
+      blocks[i][b] = static_cast<uint8>(i);
+  }
+
+  for (uint32 i = 0; i < 64; ++i)
+    for (uint32 b = 0; b < 40; ++b)
+      ASSERT_EQ(blocks[i][b], static_cast<uint8>(i));
+}
+
+TEST(LinearArenaTest, BlockBiggerThanChunk)
+{
+  SSTD::LinearArena arena(256);
+  uint8* block = static_cast<uint8*>(arena.Allocate(4096, 64));
+  EXPECT_TRUE(IsAligned(block, 64));
+  block[4095] = 1;
+  EXPECT_GE(arena.GetCapacity(), 4096u);
+}
+
+TEST(LinearArenaTest, RollbackHandsOutTheSameMemory)
+{
+  SSTD::LinearArena arena(256);
+  arena.Allocate(16);
+
+  SSTD::LinearArena::Marker marker = arena.GetMarker();
+  void* first = arena.Allocate(32);
+  for (uint32 i = 0; i < 32; ++i)
+    arena.Allocate(32);
+
+  arena.Rollback(marker);
+  EXPECT_EQ(arena.Allocate(32), first);
+}
+
+//after a Reset the chunks are reused, the same work doesn't take any new memory
+TEST(LinearArenaTest, ResetKeepsChunks)
+{
+  SSTD::LinearArena arena(256);
+  void* first = arena.Allocate(16);
+  for (uint32 i = 0; i < 100; ++i)
+    arena.Allocate(48);
+  size_t capacity = arena.GetCapacity();
+
+  arena.Reset();
+  EXPECT_EQ(arena.Allocate(16), first);
+  for (uint32 i = 0; i < 100; ++i)
+    arena.Allocate(48);
+  EXPECT_EQ(arena.GetCapacity(), capacity);
+}
+
+//without a scope the allocator still constructs, so a container can, the first Allocate has to find a scope
+TEST(ArenaAllocatorTest, DefaultConstructionNeedsScope)
+{
+  SSTD::LinearArena outer;
+  SSTD::LinearArena inner;
+  EXPECT_EQ(SSTD::LinearArena::GetCurrent(), nullptr);
+  static_assert(noexcept(SSTD::ArenaAllocator<int>()));
+  SSTD::ArenaAllocator<int> unbound{};
+  EXPECT_EQ(unbound.GetArena(), nullptr);
+  EXPECT_THROW(unbound.Allocate(4), SSTD::Exception);
+
+  SSTD::Vector<int, size_t, SSTD::ArenaAllocator> values{};
+  EXPECT_THROW(values.PushBack(1), SSTD::Exception);
+  EXPECT_TRUE(values.IsEmpty());
+
+  {
+    SSTD::ArenaScope outer_scope(outer);
+    EXPECT_EQ(SSTD::ArenaAllocator<int>().GetArena(), &outer);
+    {
+      SSTD::ArenaScope inner_scope(inner);
+      EXPECT_EQ(SSTD::ArenaAllocator<int>().GetArena(), &inner);
+    }
+    EXPECT_EQ(SSTD::ArenaAllocator<int>().GetArena(), &outer);
+
+    //bound on first use to the scope it is used in
+    EXPECT_NE(unbound.Allocate(4), nullptr);
+    EXPECT_EQ(unbound.GetArena(), &outer);
+    values.PushBack(1);
+    EXPECT_EQ(values[0], 1);
+  }
+  EXPECT_EQ(SSTD::LinearArena::GetCurrent(), nullptr);
+}
+
+TEST(ArenaAllocatorTest, VectorLivesInArena)
+{
+  SSTD::LinearArena arena(1024);
+  SSTD::ArenaScope scope(arena);
+
+  SSTD::Vector<CacheLine, size_t, SSTD::ArenaAllocator> values{};
+  for (uint64 i = 0; i < 100; ++i)
+    values.PushBack(CacheLine{ { i } });
+
+  EXPECT_TRUE(IsAligned(values.Data(), alignof(CacheLine)));
+  EXPECT_GE(arena.GetCapacity(), 100 * sizeof(CacheLine));
+  for (uint64 i = 0; i < 100; ++i)
+    EXPECT_EQ(values[i].values[0], i);
+}
+
+TEST(PoolAllocatorTest, SlotsAreAlignedAndDistinct)
+{
+  SSTD::PoolAllocator<CacheLine> allocator{};
+  CacheLine* blocks[300];
+  for (uint32 i = 0; i < 300; ++i)
+  {
+    blocks[i] = allocator.Allocate(1);
+    ASSERT_TRUE(IsAligned(blocks[i], alignof(CacheLine)));
+    blocks[i]->values[0] = i;
+  }
+
+  for (uint32 i = 0; i < 300; ++i)
+    EXPECT_EQ(blocks[i]->values[0], i);
+  for (uint32 i = 0; i < 300; ++i)
+    allocator.Deallocate(blocks[i]);
+}
+
+TEST(PoolAllocatorTest, FreedSlotIsReused)
+{
+  SSTD::PoolAllocator<uint64> allocator{};
+  uint64* first = allocator.Allocate(1);
+  allocator.Deallocate(first);
+  EXPECT_EQ(allocator.Allocate(1), first);
+  allocator.Deallocate(first);
+  allocator.Deallocate(nullptr);
+}
+
+TEST(PoolAllocatorTest, OnlySingleObjects)
+{
+  SSTD::PoolAllocator<uint64> allocator{};
+  EXPECT_THROW(allocator.Allocate(2), SSTD::Exception);
+}
+
+//the threads swap their blocks, so every slot is freed on another thread than the one that took it
+TEST(PoolAllocatorTest, FreeOnOtherThread)
+{
+  static constexpr uint32 Threads = 4;
+  static constexpr uint32 Blocks = 1000;
+  static uint64* s_Blocks[Threads][Blocks];
+
+  SSTD::a_uint32 arrived{ 0 };
+  SSTD::a_uint32 bad{ 0 };
+  TestUtility::RunThreads(Threads, [&](uint32 index)
+    {
+      SSTD::PoolAllocator<uint64> allocator{};
+      for (uint32 i = 0; i < Blocks; ++i)
+      {
+        s_Blocks[index][i] = allocator.Allocate(1);
+        *s_Blocks[index][i] = index * Blocks + i;
+      }
+
+      ++arrived;
+      arrived.NotifyAll();
+      for (uint32 seen = arrived.Load(); seen != Threads; seen = arrived.Load())
+        arrived.Wait(seen);
+
+      uint32 other = (index + 1) % Threads;
+      for (uint32 i = 0; i < Blocks; ++i)
+      {
+        if (*s_Blocks[other][i] != other * Blocks + i)
+          ++bad;
+        allocator.Deallocate(s_Blocks[other][i]);
+      }
+    });
+
+  EXPECT_EQ(bad.Load(), 0u);
+}
+
+//small, large and huge blocks, every one is filled and checked so overlapping blocks show up
+TEST(HeapTest, BlocksAreAlignedAndSized)
+{
+  static const size_t Sizes[] = { 1, 8, 16, 24, 100, 1000, 4096, 5000, SSTD::Heap::MaxSmallSize, SSTD::Heap::MaxSmallSize + 1,
+    200 * 1024, SSTD::Heap::MaxLargeSize, SSTD::Heap::MaxLargeSize + 1, 8 * 1024 * 1024 };
+  static constexpr size_t Count = sizeof(Sizes) / sizeof(Sizes[0]);
+
+  uint8* blocks[Count];
+  for (size_t i = 0; i < Count; ++i)
+  {
+    blocks[i] = static_cast<uint8*>(SSTD::Heap::Allocate(Sizes[i]));
+    ASSERT_NE(blocks[i], nullptr);
+    EXPECT_TRUE(IsAligned(blocks[i], 16)) << Sizes[i];
+    EXPECT_GE(SSTD::Heap::GetSize(blocks[i]), Sizes[i]);
+    memset(blocks[i], static_cast<int>(i), Sizes[i]);
+  }
+
+  for (size_t i = 0; i < Count; ++i)
+  {
+    EXPECT_EQ(blocks[i][0], static_cast<uint8>(i));
+    EXPECT_EQ(blocks[i][Sizes[i] - 1], static_cast<uint8>(i));
+    SSTD::Heap::Free(blocks[i]);
+  }
+  SSTD::Heap::Free(nullptr);
+}
+
+//blocks are freed by another thread than the one that took them, then handed out again
+TEST(HeapTest, FreeOnOtherThread)
+{
+  static constexpr uint32 Threads = 4;
+  static constexpr uint32 Blocks = 2000;
+  static uint64* s_Blocks[Threads][Blocks];
+
+  SSTD::a_uint32 arrived{ 0 };
+  SSTD::a_uint32 bad{ 0 };
+  TestUtility::RunThreads(Threads, [&](uint32 index)
+    {
+      for (uint32 i = 0; i < Blocks; ++i)
+      {
+        s_Blocks[index][i] = static_cast<uint64*>(SSTD::Heap::Allocate(8 + (i % 64) * 8));
+        *s_Blocks[index][i] = index * Blocks + i;
+      }
+
+      ++arrived;
+      arrived.NotifyAll();
+      for (uint32 seen = arrived.Load(); seen != Threads; seen = arrived.Load())
+        arrived.Wait(seen);
+
+      uint32 other = (index + 1) % Threads;
+      for (uint32 i = 0; i < Blocks; ++i)
+      {
+        if (*s_Blocks[other][i] != other * Blocks + i)
+          ++bad;
+        SSTD::Heap::Free(s_Blocks[other][i]);
+      }
+
+      //the remote frees have to be collected before the pages get reused
+      for (uint32 i = 0; i < Blocks; ++i)
+      {
+        uint64* block = static_cast<uint64*>(SSTD::Heap::Allocate(8 + (i % 64) * 8));
+        *block = i;
+        SSTD::Heap::Free(block);
+      }
+      SSTD::Heap::Purge();
+    });
+
+  EXPECT_EQ(bad.Load(), 0u);
+}
+
+TEST(HeapAllocatorTest, Vector)
+{
+  SSTD::Vector<uint64, size_t, SSTD::HeapAllocator> values{};
+  for (uint64 i = 0; i < 10000; ++i)
+    values.PushBack(i);
+
+  EXPECT_TRUE(IsAligned(values.Data(), 16));
+  for (uint64 i = 0; i < 10000; ++i)
+    ASSERT_EQ(values[i], i);
+}
+
+TEST(TrackingAllocatorTest, OverAlignedBlocks)
+{
+  SSTD::TrackingAllocator<CacheLine> allocator{};
+  CacheLine* blocks[16];
+  for (uint32 i = 0; i < 16; ++i)
+  {
+    blocks[i] = allocator.Allocate(i + 1);
+    ASSERT_TRUE(IsAligned(blocks[i], alignof(CacheLine)));
+    for (uint32 j = 0; j <= i; ++j)
+      blocks[i][j].values[0] = i;
+  }
+
+  for (uint32 i = 0; i < 16; ++i)
+  {
+    for (uint32 j = 0; j <= i; ++j)
+      EXPECT_EQ(blocks[i][j].values[0], i);
+    allocator.Deallocate(blocks[i]);
+  }
+}
+
+//allocations are booked on the tag of the scope, and taken off again by the free
+TEST(TrackingAllocatorTest, BooksOnCurrentTag)
+{
+  static SSTD::AllocationTag s_Tag("TrackingAllocatorTest");
+  SSTD::TrackingAllocator<uint64> allocator{};
+  SSTD::AllocationTracker::Snapshot before{};
+  SSTD::AllocationTracker::TakeSnapshot(before);
+
+  uint64* block = nullptr;
+  {
+    SSTD::AllocationTagScope scope(s_Tag);
+    block = allocator.Allocate(100);
+  }
+
+  SSTD::AllocationTracker::Snapshot during{};
+  SSTD::AllocationTracker::TakeSnapshot(during);
+  const SSTD::AllocationTracker::Counters& tag = during.tags[s_Tag.GetIndex()];
+  EXPECT_STREQ(during.tag_names[s_Tag.GetIndex()], "TrackingAllocatorTest");
+  EXPECT_EQ(tag.allocations - before.tags[s_Tag.GetIndex()].allocations, 1u);
+  EXPECT_EQ(tag.bytes_allocated - before.tags[s_Tag.GetIndex()].bytes_allocated, 100 * sizeof(uint64));
+  EXPECT_EQ(during.live_bytes - before.live_bytes, static_cast<int64>(100 * sizeof(uint64)));
+
+  //the free is booked on the tag of the block, not on the one active now
+  allocator.Deallocate(block);
+  SSTD::AllocationTracker::Snapshot after{};
+  SSTD::AllocationTracker::TakeSnapshot(after);
+  EXPECT_EQ(after.tags[s_Tag.GetIndex()].deallocations - before.tags[s_Tag.GetIndex()].deallocations, 1u);
+  EXPECT_EQ(after.tags[s_Tag.GetIndex()].bytes_freed - before.tags[s_Tag.GetIndex()].bytes_freed, 100 * sizeof(uint64));
+  EXPECT_EQ(after.live_bytes, before.live_bytes);
+}
+
+//blocks below and above HugePageThreshold take different paths, both have to be aligned and writable to the end
+template<size_t Alignment>
+static void CheckAlignedAllocator()
+{
+  SSTD::AlignedAllocator<uint8, Alignment> allocator{};
+  static const size_t Sizes[] = { 1, 100, 4096, SSTD::AlignedAllocator<uint8, Alignment>::HugePageThreshold, 5 * 1024 * 1024 };
+  for (size_t size : Sizes)
+  {
+    uint8* block = allocator.Allocate(size);
+    EXPECT_TRUE(IsAligned(block, Alignment)) << size;
+    memset(block, 0xAB, size);
+    EXPECT_EQ(block[size - 1], 0xAB);
+    allocator.Deallocate(block);
+  }
+  allocator.Deallocate(nullptr);
+}
+
+TEST(AlignedAllocatorTest, CacheLineAlignment)
+{
+  CheckAlignedAllocator<64>();
+}
+
+TEST(AlignedAllocatorTest, PageAlignment)
+{
+  CheckAlignedAllocator<4096>();
+}
+
+TEST(AlignedAllocatorTest, Vector)
+{
+  SSTD::Vector<float, size_t, SSTD::AlignedAllocator> values{};
+  for (uint32 i = 0; i < 1000; ++i)
+  {
+    values.PushBack(static_cast<float>(i));
+    ASSERT_TRUE(IsAligned(values.Data(), 64));
+  }
+  EXPECT_EQ(values[999], 999.0f);
+}
@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+
+#include "Platform/Threading/Atomic.h"
+
+#include "TestUtility.h"
+
+static constexpr uint32 ThreadCount = 4;
+
+namespace
+{
+  static constexpr SSTD::MemoryOrder Orders[] = { SSTD::MemoryOrder::Relaxed, SSTD::MemoryOrder::Acquire, SSTD::MemoryOrder::Release,
+    SSTD::MemoryOrder::AcquireRelease, SSTD::MemoryOrder::SequentiallyConsistent };
+
+  //the values go through the unsigned DataType, they have to come back with their sign and wrap like T does
+  template<typename T>
+  void CheckFetchOperations(T first, T second)
+  {
+    SSTD::AtomicInt<T> value(first);
+    EXPECT_EQ(value.FetchAdd(second), first);
+    EXPECT_EQ(value.Load(), static_cast<T>(first + second));
+    EXPECT_EQ(value.FetchSub(second), static_cast<T>(first + second));
+    EXPECT_EQ(value.Load(), first);
+
+    EXPECT_EQ(value.FetchAnd(second), first);
+    EXPECT_EQ(value.Load(), static_cast<T>(first & second));
+    value.Store(first);
+    EXPECT_EQ(value.FetchOr(second), first);
+    EXPECT_EQ(value.Load(), static_cast<T>(first | second));
+    value.Store(first);
+    EXPECT_EQ(value.FetchXor(second), first);
+    EXPECT_EQ(value.Load(), static_cast<T>(first ^ second));
+
+    //the prefix operators and += -= return the new value, the postfix ones and the bitwise assignments the old,
+    //like the Interlocked intrinsics of the windows backend
+    value.Store(first);
+    EXPECT_EQ(++value, static_cast<T>(first + 1));
+    EXPECT_EQ(value++, static_cast<T>(first + 1));
+    EXPECT_EQ(--value, static_cast<T>(first + 1));
+    EXPECT_EQ(value--, static_cast<T>(first + 1));
+    EXPECT_EQ(value += second, static_cast<T>(first + second));
+    EXPECT_EQ(value -= second, first);
+    EXPECT_EQ(value ^= second, first);
+    EXPECT_EQ(value.Load(), static_cast<T>(first ^ second));
+  }
+}
+
+TEST(AtomicIntTest, ExchangeAndCompareExchange)
+{
+  SSTD::a_int64 value{ -7 };
+  EXPECT_EQ(value.Exchange(9), -7);
+  EXPECT_EQ(value.Load(), 9);
+
+  //a failed exchange writes the current value back and leaves the atomic alone
+  int64 expected = 3;
+  EXPECT_FALSE(value.CompareExchange(expected, 4));
+  EXPECT_EQ(expected, 9);
+  EXPECT_EQ(value.Load(), 9);
+
+  EXPECT_TRUE(value.CompareExchange(expected, -1));
+  EXPECT_EQ(expected, 9);
+  EXPECT_EQ(value.Load(), -1);
+
+  SSTD::a_uint8 small{ 200 };
+  uint8 expected8 = 200;
+  EXPECT_TRUE(small.CompareExchange(expected8, 255));
+  EXPECT_EQ(small.Exchange(1), 255u);
+}
+
+TEST(AtomicIntTest, FetchOperationsReturnTheOldValue)
+{
+  CheckFetchOperations<int8>(-100, 60);
+  CheckFetchOperations<uint8>(250, 10);
+  CheckFetchOperations<int16>(-2, 0x1234);
+  CheckFetchOperations<uint16>(0xFFF0, 0x0F0F);
+  CheckFetchOperations<int32>(-123456, 77);
+  CheckFetchOperations<uint32>(0xFFFFFFFFu, 2);
+  CheckFetchOperations<int64>(-(1ll << 40), 1ll << 41);
+  CheckFetchOperations<uint64>(0x8000000000000000ull, 0x8000000000000001ull);
+}
+
+//the old value comes back either way, the value only changes if the new one is smaller or larger
+TEST(AtomicIntTest, FetchMinAndMax)
+{
+  SSTD::a_int32 value{ 5 };
+  EXPECT_EQ(value.FetchMin(8), 5);
+  EXPECT_EQ(value.Load(), 5);
+  EXPECT_EQ(value.FetchMin(-3), 5);
+  EXPECT_EQ(value.Load(), -3);
+  EXPECT_EQ(value.FetchMin(-3), -3);
+
+  EXPECT_EQ(value.FetchMax(-10), -3);
+  EXPECT_EQ(value.Load(), -3);
+  EXPECT_EQ(value.FetchMax(12), -3);
+  EXPECT_EQ(value.Load(), 12);
+  EXPECT_EQ(value.FetchMax(12), 12);
+
+  SSTD::a_uint64 maximum{ 0 };
+  SSTD::a_uint64 minimum{ ~0ull };
+  TestUtility::RunThreads(ThreadCount, [&](uint32 index)
+    {
+      for (uint64 i = 0; i < 10000; ++i)
+      {
+        uint64 sample = i * ThreadCount + index;
+        maximum.FetchMax(sample, SSTD::MemoryOrder::Relaxed);
+        minimum.FetchMin(sample + 5, SSTD::MemoryOrder::Relaxed);
+      }
+    });
+  EXPECT_EQ(maximum.Load(), 10000ull * ThreadCount - 1);
+  EXPECT_EQ(minimum.Load(), 5u);
+}
+
+//a load can't release and a store can't acquire, those orders are weakened to the part that applies
+TEST(AtomicIntTest, EveryMemoryOrder)
+{
+  SSTD::a_uint32 value{ 0 };
+  uint32 expected = 0;
+  for (SSTD::MemoryOrder order : Orders)
+  {
+    value.Store(expected + 1, order);
+    EXPECT_EQ(value.Load(order), expected + 1);
+    EXPECT_EQ(value.Exchange(expected + 2, order), expected + 1);
+    EXPECT_EQ(value.FetchAdd(1, order), expected + 2);
+    expected += 3;
+    EXPECT_TRUE(value.CompareExchange(expected, expected, order));
+    SSTD::AtomicUtils::Fence(order);
+  }
+  EXPECT_EQ(value.Load(), 15u);
+}
+
+TEST(AtomicIntTest, ConcurrentFetchAdd)
+{
+  static constexpr uint32 Increments = 100000;
+  SSTD::a_uint64 sum{ 0 };
+  SSTD::a_uint32 flags{ 0 };
+  TestUtility::RunThreads(ThreadCount, [&](uint32 index)
+    {
+      for (uint32 i = 0; i < Increments; ++i)
+        sum.FetchAdd(i % 3, SSTD::MemoryOrder::Relaxed);
+      flags.FetchOr(1u << index);
+    });
+
+  EXPECT_EQ(sum.Load(), static_cast<uint64>(Increments / 3 * 3) * ThreadCount);
+  EXPECT_EQ(flags.Load(), (1u << ThreadCount) - 1);
+}
+
+TEST(AtomicPairTest, CompareExchangeReplacesExpected)
+{
+  SSTD::AtomicPair<uint64, uint64> pair(1, 2);
+
+  SSTD::AtomicPair<uint64, uint64>::ValueType expected = pair.Load();
+  EXPECT_EQ(expected.first, 1u);
+  EXPECT_EQ(expected.second, 2u);
+
+  EXPECT_TRUE(pair.CompareExchange(expected, 3, 4));
+  SSTD::AtomicPair<uint64, uint64>::ValueType now = pair.Load();
+  EXPECT_EQ(now.first, 3u);
+  EXPECT_EQ(now.second, 4u);
+}
+
+TEST(AtomicPairTest, CompareExchangeFailureReturnsCurrent)
+{
+  SSTD::AtomicPair<uint64, uint64> pair(5, 6);
+
+  //only one half matches, the pair must stay as it is
+  SSTD::AtomicPair<uint64, uint64>::ValueType expected{};
+  expected.first = 5;
+  expected.second = 7;
+  EXPECT_FALSE(pair.CompareExchange(expected, 8, 9));
+  EXPECT_EQ(expected.first, 5u);
+  EXPECT_EQ(expected.second, 6u);
+
+  SSTD::AtomicPair<uint64, uint64>::ValueType now = pair.Load();
+  EXPECT_EQ(now.first, 5u);
+  EXPECT_EQ(now.second, 6u);
+}
+
+TEST(AtomicPairTest, StoreAndTaggedPointer)
+{
+  int values[2] = { 0, 0 };
+  SSTD::AtomicTaggedPointer<int> pointer(values, 0);
+
+  pointer.Store(values + 1, 1);
+  SSTD::AtomicTaggedPointer<int>::ValueType now = pointer.Load(SSTD::MemoryOrder::Acquire);
+  EXPECT_EQ(now.first, values + 1);
+  EXPECT_EQ(now.second, 1u);
+}
+
+//both halves always move together, a torn read or a lost update shows up as halves that differ
+TEST(AtomicPairTest, ConcurrentIncrementsNeverTear)
+{
+  static constexpr uint64 Increments = 20000;
+  SSTD::AtomicPair<uint64, uint64> pair(0, 0);
+  SSTD::a_uint32 torn{ 0 };
+
+  TestUtility::RunThreads(ThreadCount, [&](uint32)
+    {
+      SSTD::AtomicPair<uint64, uint64>::ValueType expected = pair.Peek();
+      for (uint64 i = 0; i < Increments; ++i)
+      {
+        while (!pair.CompareExchange(expected, expected.first + 1, expected.second + 1, SSTD::MemoryOrder::AcquireRelease))
+          ;
+        expected.first += 1;
+        expected.second += 1;
+
+        SSTD::AtomicPair<uint64, uint64>::ValueType seen = pair.Load(SSTD::MemoryOrder::Acquire);
+        if (seen.first != seen.second)
+          ++torn;
+      }
+    });
+
+  SSTD::AtomicPair<uint64, uint64>::ValueType now = pair.Load();
+  EXPECT_EQ(torn.Load(), 0u);
+  EXPECT_EQ(now.first, Increments * ThreadCount);
+  EXPECT_EQ(now.second, Increments * ThreadCount);
+}
+
+TEST(AtomicPointerTest, ArithmeticIsInElements)
+{
+  uint64 values[4] = {};
+  SSTD::AtomicPointer<uint64> pointer(values);
+
+  EXPECT_EQ(pointer.FetchAdd(3), values);
+  EXPECT_EQ(pointer.Load(), values + 3);
+  EXPECT_EQ(pointer.FetchSub(2), values + 3);
+  EXPECT_EQ(pointer.Load(), values + 1);
+
+  uint64* expected = values;
+  EXPECT_FALSE(pointer.CompareExchange(expected, values + 2));
+  EXPECT_EQ(expected, values + 1);
+  EXPECT_TRUE(pointer.CompareExchange(expected, values + 2));
+  EXPECT_EQ(pointer.Exchange(nullptr), values + 2);
+}
+
+TEST(AtomicWaitTest, ReturnsWhenValueDiffers)
+{
+  SSTD::a_uint32 value{ 1 };
+  value.Wait(0);
+  EXPECT_EQ(value.Load(), 1u);
+}
+
+TEST(AtomicWaitTest, NotifyOneWakesWaiter)
+{
+  SSTD::a_uint32 flag{ 0 };
+  SSTD::a_uint32 woken{ 0 };
+
+  TestUtility::RunThreads(2, [&](uint32 index)
+    {
+      if (index == 0)
+      {
+        flag.Wait(0, SSTD::MemoryOrder::Acquire);
+        woken.Store(1);
+      }
+      else
+      {
+        flag.Store(1, SSTD::MemoryOrder::Release);
+        flag.NotifyOne();
+      }
+    });
+
+  EXPECT_EQ(woken.Load(), 1u);
+}
+
+//every waiter has to get past the value it waited on, a lost wakeup hangs the test
+TEST(AtomicWaitTest, NotifyAllWakesEveryWaiter)
+{
+  static constexpr uint32 Rounds = 200;
+  SSTD::a_uint32 round{ 0 };
+  SSTD::a_uint32 arrived{ 0 };
+
+  TestUtility::RunThreads(ThreadCount, [&](uint32 index)
+    {
+      for (uint32 r = 0; r < Rounds; ++r)
+      {
+        if (index == 0)
+        {
+          //wait for every other thread to reach round r, then release them
+          uint32 target = (r + 1) * (ThreadCount - 1);
+          for (uint32 seen = arrived.Load(); seen < target; seen = arrived.Load())
+            arrived.Wait(seen);
+          round.Store(r + 1);
+          round.NotifyAll();
+        }
+        else
+        {
+          ++arrived;
+          arrived.NotifyAll();
+          round.Wait(r);
+        }
+      }
+    });
+
+  EXPECT_EQ(round.Load(), Rounds);
+  EXPECT_EQ(arrived.Load(), Rounds * (ThreadCount - 1));
+}
@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include "Containers/BTreeMap.h"
+#include "Containers/BTreeSet.h"
+#include "Containers/String.h"
+
+#include "TestUtility.h"
+
+#include <cstdio>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+using TestUtility::Tracked;
+
+namespace
+{
+  //Tracked values make the leaves small, so a few thousand keys already give a tree several levels deep
+  using Map = SSTD::BTreeMap<int, Tracked>;
+
+  void ExpectSame(const Map& map, const std::map<int, int>& reference)
+  {
+    ASSERT_EQ(map.Size(), reference.size());
+    auto expected = reference.begin();
+    for (auto entry : map)
+    {
+      ASSERT_NE(expected, reference.end());
+      ASSERT_EQ(entry.key, expected->first);
+      ASSERT_EQ(entry.value.value, expected->second);
+      ASSERT_TRUE(entry.value.IsValid());
+      ++expected;
+    }
+    ASSERT_EQ(expected, reference.end());
+  }
+
+  //the bounds have to land where std::map's do, including past the end of a leaf and past the last element
+  template<typename M>
+  void ExpectSameBounds(const M& map, const std::set<uint64>& reference, uint64 key)
+  {
+    auto lower = map.LowerBound(key);
+    auto expected = reference.lower_bound(key);
+    ASSERT_EQ(lower == map.end(), expected == reference.end()) << key;
+    if (expected != reference.end())
+    {
+      ASSERT_EQ(lower.Key(), *expected) << key;
+    }
+
+    auto upper = map.UpperBound(key);
+    expected = reference.upper_bound(key);
+    ASSERT_EQ(upper == map.end(), expected == reference.end()) << key;
+    if (expected != reference.end())
+    {
+      ASSERT_EQ(upper.Key(), *expected) << key;
+    }
+  }
+
+  SSTD::String KeyString(int i)
+  {
+    char buffer[32];
+    int size = snprintf(buffer, sizeof(buffer), "key %06d", i);
+    return SSTD::String(buffer, static_cast<size_t>(size));
+  }
+}
+
+TEST(BTreeMapTest, RandomOperations)
+{
+  {
+    std::mt19937 rng(1);
+    Map map{};
+    std::map<int, int> reference;
+
+    for (int step = 0; step < 20000; ++step)
+    {
+      //removes win over inserts in the second half, so the tree grows first and shrinks back after
+      bool shrinking = step > 10000;
+      int key = static_cast<int>(rng() % 4096);
+      int value = static_cast<int>(rng() % 10000);
+      switch (rng() % 8)
+      {
+      case 0:
+      case 1:
+        if (!shrinking)
+        {
+          ASSERT_EQ(map.Insert(key, Tracked(value)), reference.emplace(key, value).second);
+        }
+        break;
+      case 2:
+        map.InsertOrAssign(key, Tracked(value));
+        reference[key] = value;
+        break;
+      case 3:
+        if (!shrinking)
+        {
+          map[key].value = value;
+          reference[key] = value;
+        }
+        break;
+      default:
+        ASSERT_EQ(map.Remove(key), reference.erase(key) == 1);
+        break;
+      }
+
+      if (step % 97 == 0)
+        ExpectSame(map, reference);
+      ASSERT_EQ(Tracked::s_Live, static_cast<int>(reference.size()));
+    }
+
+    ExpectSame(map, reference);
+    for (int key = 0; key < 4096; ++key)
+    {
+      const Tracked* value = map.Find(key);
+      auto it = reference.find(key);
+      ASSERT_EQ(value != nullptr, it != reference.end()) << key;
+      if (value)
+      {
+        ASSERT_EQ(value->value, it->second) << key;
+      }
+    }
+
+    //down to nothing and back, the root has to go away and come back
+    for (int key = 0; key < 4096; ++key)
+      map.Remove(key);
+    EXPECT_TRUE(map.IsEmpty());
+    EXPECT_EQ(map.Depth(), 0u);
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_TRUE(map.Insert(1, Tracked(1)));
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(BTreeMapTest, BoundsAndRanges)
+{
+  SSTD::BTreeMap<uint64, uint64> map{};
+  std::set<uint64> reference;
+  for (uint64 i = 0; i < 5000; i += 3)
+  {
+    map.Insert(i, i * 2);
+    reference.insert(i);
+  }
+  EXPECT_GT(map.Depth(), 1u);
+
+  for (uint64 key = 0; key < 5010; ++key)
+    ExpectSameBounds(map, reference, key);
+
+  uint64 sum = 0;
+  uint64 count = 0;
+  map.ApplyRange(100ull, 200ull, [&](const uint64& key, uint64& value)
+    {
+      EXPECT_GE(key, 100u);
+      EXPECT_LT(key, 200u);
+      EXPECT_EQ(value, key * 2);
+      sum += key;
+      ++count;
+    });
+  EXPECT_EQ(count, 33u);
+  EXPECT_EQ(sum, 4950u);
+
+  EXPECT_THROW(map.At(1ull), SSTD::Exception);
+  EXPECT_EQ(map.At(3ull), 6u);
+}
+
+TEST(BTreeMapTest, BulkLoadCopyAndMove)
+{
+  {
+    //sorted with duplicates, the first of each is kept
+    std::vector<int> keys;
+    std::vector<Tracked> values;
+    for (int i = 0; i < 3000; ++i)
+    {
+      keys.push_back(i / 2);
+      values.push_back(Tracked(i));
+    }
+
+    Map map{};
+    map.Insert(-5, Tracked(0));
+    map.BulkLoad(keys.data(), values.data(), keys.size());
+    ASSERT_EQ(map.Size(), 1500u);
+    EXPECT_FALSE(map.Contains(-5));
+    for (int key = 0; key < 1500; ++key)
+      ASSERT_EQ(map.At(key).value, key * 2) << key;
+
+    //a bulk loaded tree still takes inserts and removes
+    for (int key = 0; key < 1500; key += 2)
+      ASSERT_TRUE(map.Remove(key));
+    for (int key = 1500; key < 2000; ++key)
+      ASSERT_TRUE(map.Insert(key, Tracked(key)));
+    EXPECT_EQ(map.Size(), 1250u);
+
+    Map copy(map);
+    EXPECT_EQ(copy.Size(), 1250u);
+    EXPECT_EQ(copy.At(1999).value, 1999);
+
+    Map moved(Move(map));
+    EXPECT_TRUE(map.IsEmpty());
+    EXPECT_EQ(moved.Size(), 1250u);
+
+    copy = Move(moved);
+    moved = copy;
+    EXPECT_EQ(moved.At(1).value, 2);
+    EXPECT_EQ(Tracked::s_Live, 1250 * 2 + 3000);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+//String keys take the binary search path and are found with a const char*
+TEST(BTreeSetTest, StringKeys)
+{
+  SSTD::BTreeSet<SSTD::String> set{};
+  std::set<int> reference;
+  std::mt19937 rng(2);
+  for (int step = 0; step < 5000; ++step)
+  {
+    int key = static_cast<int>(rng() % 2000);
+    if (rng() % 3)
+      ASSERT_EQ(set.Insert(KeyString(key)), reference.insert(key).second);
+    else
+      ASSERT_EQ(set.Remove(KeyString(key)), reference.erase(key) == 1);
+  }
+
+  ASSERT_EQ(set.Size(), reference.size());
+  auto expected = reference.begin();
+  for (const SSTD::String& key : set)
+  {
+    ASSERT_EQ(key, KeyString(*expected));
+    ++expected;
+  }
+
+  int first = *reference.begin();
+  EXPECT_TRUE(set.Contains(KeyString(first).CStr()));
+  EXPECT_NE(set.Find(KeyString(first).CStr()), nullptr);
+  EXPECT_EQ(set.Find("not a key"), nullptr);
+}
+
+TEST(BTreeSetTest, BulkLoadAndRange)
+{
+  std::vector<uint32> keys;
+  for (uint32 i = 0; i < 10000; ++i)
+    keys.push_back(i * 2);
+
+  SSTD::BTreeSet<uint32> set{};
+  set.BulkLoad(keys.data(), keys.size());
+  EXPECT_EQ(set.Size(), 10000u);
+  EXPECT_TRUE(set.Contains(19998u));
+  EXPECT_FALSE(set.Contains(19999u));
+
+  std::vector<uint32> range;
+  set.ApplyRange(101u, 111u, [&](const uint32& key) { range.push_back(key); });
+  EXPECT_EQ(range, (std::vector<uint32>{ 102, 104, 106, 108, 110 }));
+}
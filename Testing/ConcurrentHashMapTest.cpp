@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include "Containers/ConcurrentHashMap.h"
+
+#include "TestUtility.h"
+
+#include <random>
+#include <unordered_map>
+
+static constexpr uint32 ThreadCount = 4;
+
+namespace
+{
+  //ComputeIfAbsent must not need a default constructor
+  struct Value
+  {
+    explicit Value(int pValue) : value(pValue) {}
+
+    int value;
+  };
+}
+
+TEST(ConcurrentHashMapTest, SingleThreadAgainstStd)
+{
+  std::mt19937 rng(1);
+  SSTD::ConcurrentHashMap<int, int> map(4);
+  std::unordered_map<int, int> reference;
+
+  //enough keys for the shards to grow several times and for the retired lists to be collected
+  for (int step = 0; step < 50000; ++step)
+  {
+    int key = static_cast<int>(rng() % 4096);
+    int value = static_cast<int>(rng());
+    switch (rng() % 4)
+    {
+    case 0:
+      ASSERT_EQ(map.Insert(key, value), reference.emplace(key, value).second);
+      break;
+    case 1:
+    {
+      bool added = reference.count(key) == 0;
+      reference[key] = value;
+      ASSERT_EQ(map.Upsert(key, value), added);
+      break;
+    }
+    case 2:
+      ASSERT_EQ(map.Remove(key), reference.erase(key) == 1);
+      break;
+    case 3:
+    {
+      int found = 0;
+      auto it = reference.find(key);
+      ASSERT_EQ(map.Find(key, found), it != reference.end());
+      if (it != reference.end())
+      {
+        ASSERT_EQ(found, it->second);
+      }
+      break;
+    }
+    }
+  }
+
+  ASSERT_EQ(map.Size(), reference.size());
+  for (const std::pair<const int, int>& entry : reference)
+  {
+    int found = 0;
+    ASSERT_TRUE(map.Find(entry.first, found));
+    ASSERT_EQ(found, entry.second);
+  }
+
+  map.Erase();
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_FALSE(map.Contains(reference.begin()->first));
+  EXPECT_TRUE(map.Insert(1, 1));
+}
+
+TEST(ConcurrentHashMapTest, ShardCount)
+{
+  EXPECT_EQ((SSTD::ConcurrentHashMap<int, int>(3).ShardCount()), 4u);
+  EXPECT_THROW((SSTD::ConcurrentHashMap<int, int>(SSTD::ConcurrentHashMap<int, int>::MaxShards + 1)), SSTD::Exception);
+
+  //a single shard takes every hash, the many shard map has to spread them without going out of range
+  for (size_t shards : { size_t(1), SSTD::ConcurrentHashMap<int, int>::MaxShards })
+  {
+    SSTD::ConcurrentHashMap<int, int> map(shards);
+    EXPECT_EQ(map.ShardCount(), shards);
+    for (int i = 0; i < 1000; ++i)
+      map.Insert(i, i);
+    EXPECT_EQ(map.Size(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+      ASSERT_TRUE(map.Contains(i)) << i;
+  }
+}
+
+//every key is asked for by every thread at once, compute() may run only once per key and all of them see its result
+TEST(ConcurrentHashMapTest, ComputeIfAbsentRunsOnce)
+{
+  static constexpr int Keys = 2000;
+  SSTD::ConcurrentHashMap<int, Value> map(8);
+  SSTD::a_uint32 calls[Keys] = {};
+  SSTD::a_uint32 wrong{ 0 };
+
+  TestUtility::RunThreads(ThreadCount, [&](uint32 index)
+    {
+      for (int i = 0; i < Keys; ++i)
+      {
+        int key = (i * 7 + static_cast<int>(index) * 13) % Keys;
+        Value value = map.ComputeIfAbsent(key, [&]()
+          {
+            ++calls[key];
+            return Value(key * 3);
+          });
+        if (value.value != key * 3)
+          ++wrong;
+      }
+    });
+
+  EXPECT_EQ(wrong.Load(), 0u);
+  EXPECT_EQ(map.Size(), static_cast<size_t>(Keys));
+  for (int i = 0; i < Keys; ++i)
+    ASSERT_EQ(calls[i].Load(), 1u) << i;
+}
+
+//writers own disjoint keys and keep replacing and removing them while readers look at all of them,
+//a reader may miss a key but must never see a value that was not written for it
+TEST(ConcurrentHashMapTest, ReadersDuringWrites)
+{
+  static constexpr int KeysPerWriter = 512;
+  static constexpr int Rounds = 20;
+  static constexpr uint32 Writers = 2;
+
+  SSTD::ConcurrentHashMap<int, int> map(4);
+  SSTD::a_uint32 writersDone{ 0 };
+  SSTD::a_uint32 wrong{ 0 };
+
+  TestUtility::RunThreads(Writers + 2, [&](uint32 index)
+    {
+      if (index < Writers)
+      {
+        int first = static_cast<int>(index) * KeysPerWriter;
+        for (int round = 1; round <= Rounds; ++round)
+        {
+          for (int key = first; key < first + KeysPerWriter; ++key)
+            map.Upsert(key, key * 100 + round);
+          for (int key = first; key < first + KeysPerWriter; key += 3)
+            map.Remove(key);
+        }
+        ++writersDone;
+      }
+      else
+      {
+        std::mt19937 rng(index);
+        while (writersDone.Load() != Writers)
+        {
+          int key = static_cast<int>(rng() % (Writers * KeysPerWriter));
+          map.Visit(key, [&](const int& value)
+            {
+              if (value / 100 != key || value % 100 == 0 || value % 100 > Rounds)
+                ++wrong;
+            });
+        }
+      }
+    });
+
+  EXPECT_EQ(wrong.Load(), 0u);
+
+  //the last round left every key but the removed ones with its final value
+  for (int key = 0; key < static_cast<int>(Writers) * KeysPerWriter; ++key)
+  {
+    int value = 0;
+    bool removed = (key % KeysPerWriter) % 3 == 0;
+    ASSERT_EQ(map.Find(key, value), !removed) << key;
+    if (!removed)
+    {
+      ASSERT_EQ(value, key * 100 + Rounds) << key;
+    }
+  }
+}
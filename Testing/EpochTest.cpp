@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include "Platform/Threading/Epoch.h"
+#include "Platform/Threading/Atomic.h"
+
+#include "TestUtility.h"
+
+#include <deque>
+#include <vector>
+
+namespace
+{
+  //advances as far as the threads inside guards allow, returns how many steps that was
+  uint32 AdvanceAll()
+  {
+    uint32 steps = 0;
+    while (steps < 8 && SSTD::Epoch::TryAdvance())
+      ++steps;
+    return steps;
+  }
+}
+
+//a reader that entered before the stamp was taken holds it back, at most one advance gets past it
+TEST(EpochTest, GuardOnOtherThreadBlocksFree)
+{
+  SSTD::a_uint32 phase{ 0 };
+
+  TestUtility::RunThreads(2, [&](uint32 index)
+    {
+      if (index == 0)
+      {
+        SSTD::EpochGuard guard;
+        phase.Store(1);
+        phase.NotifyAll();
+        for (uint32 seen = phase.Load(); seen != 2; seen = phase.Load())
+          phase.Wait(seen);
+      }
+      else
+      {
+        for (uint32 seen = phase.Load(); seen != 1; seen = phase.Load())
+          phase.Wait(seen);
+
+        uint64 stamp = SSTD::Epoch::Current();
+        EXPECT_LE(AdvanceAll(), 1u);
+        EXPECT_FALSE(SSTD::Epoch::CanFree(stamp));
+
+        phase.Store(2);
+        phase.NotifyAll();
+      }
+    });
+
+  //the reader is gone, nothing holds the epoch back anymore
+  uint64 stamp = SSTD::Epoch::Current();
+  EXPECT_GE(AdvanceAll(), 2u);
+  EXPECT_TRUE(SSTD::Epoch::CanFree(stamp));
+}
+
+//only the outermost guard counts, leaving the inner one still protects
+TEST(EpochTest, NestedGuards)
+{
+  uint64 stamp = 0;
+  {
+    SSTD::EpochGuard outer;
+    {
+      SSTD::EpochGuard inner;
+      stamp = SSTD::Epoch::Current();
+    }
+    EXPECT_LE(AdvanceAll(), 1u);
+    EXPECT_FALSE(SSTD::Epoch::CanFree(stamp));
+  }
+
+  EXPECT_GE(AdvanceAll(), 1u);
+  EXPECT_TRUE(SSTD::Epoch::CanFree(stamp));
+}
+
+//a writer keeps swapping a shared node and poisons the old ones once CanFree says so, instead of deleting them,
+//so a reader that still sees a poisoned node inside its guard is caught without relying on a crash
+TEST(EpochTest, ReclamationStress)
+{
+  static constexpr uint32 Readers = 3;
+  static constexpr uint32 Swaps = 20000;
+
+  struct Node
+  {
+    SSTD::a_uint32 alive{ 1 };
+  };
+
+  std::vector<Node*> nodes;
+  nodes.reserve(Swaps + 1);
+  for (uint32 i = 0; i <= Swaps; ++i)
+    nodes.push_back(new Node());
+
+  SSTD::AtomicPointer<Node> shared(nodes[0]);
+  SSTD::a_uint32 done{ 0 };
+  SSTD::a_uint32 poisoned{ 0 };
+  SSTD::a_uint32 seenDead{ 0 };
+
+  TestUtility::RunThreads(Readers + 1, [&](uint32 index)
+    {
+      if (index == 0)
+      {
+        std::deque<std::pair<Node*, uint64>> retired;
+        for (uint32 i = 1; i <= Swaps; ++i)
+        {
+          Node* old = shared.Exchange(nodes[i]);
+          retired.emplace_back(old, SSTD::Epoch::Current());
+
+          SSTD::Epoch::TryAdvance();
+          while (!retired.empty() && SSTD::Epoch::CanFree(retired.front().second))
+          {
+            retired.front().first->alive.Store(0);
+            retired.pop_front();
+            ++poisoned;
+          }
+        }
+        done.Store(1);
+      }
+      else
+      {
+        while (!done.Load())
+        {
+          SSTD::EpochGuard guard;
+          Node* node = shared.Load(SSTD::MemoryOrder::Acquire);
+          for (uint32 i = 0; i < 4; ++i)
+          {
+            if (node->alive.Load() != 1)
+              ++seenDead;
+          }
+        }
+      }
+    });
+
+  EXPECT_EQ(seenDead.Load(), 0u);
+  //otherwise the test proved nothing
+  EXPECT_GT(poisoned.Load(), 0u);
+
+  for (Node* node : nodes)
+    delete node;
+}
@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+
+#include "Containers/FlatMap.h"
+#include "Containers/FlatSet.h"
+
+#include "TestUtility.h"
+
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+using TestUtility::Tracked;
+using TestUtility::ThrowingTracked;
+
+namespace
+{
+  using Map = SSTD::FlatMap<int, Tracked>;
+
+  //the keys have to come out in the same order as std::map's
+  void ExpectSame(const Map& map, const std::map<int, int>& reference)
+  {
+    ASSERT_EQ(map.Size(), reference.size());
+    size_t index = 0;
+    for (const std::pair<const int, int>& entry : reference)
+    {
+      ASSERT_EQ(map.KeyAt(index), entry.first) << index;
+      ASSERT_EQ(map.ValueAt(index).value, entry.second) << index;
+      ASSERT_TRUE(map.ValueAt(index).IsValid()) << index;
+      ++index;
+    }
+  }
+}
+
+TEST(FlatMapTest, RandomOperations)
+{
+  {
+    std::mt19937 rng(1);
+    Map map{};
+    std::map<int, int> reference;
+
+    for (int step = 0; step < 3000; ++step)
+    {
+      int key = static_cast<int>(rng() % 1024);
+      int value = static_cast<int>(rng() % 10000);
+      switch (rng() % 8)
+      {
+      case 0:
+      case 1:
+        EXPECT_EQ(map.Insert(key, Tracked(value)), reference.emplace(key, value).second);
+        break;
+      case 2:
+        map.InsertOrAssign(key, Tracked(value));
+        reference[key] = value;
+        break;
+      case 3:
+        map[key].value = value;
+        reference[key] = value;
+        break;
+      case 4:
+      case 5:
+        EXPECT_EQ(map.Remove(key), reference.erase(key) == 1);
+        break;
+      case 6:
+      {
+        //unsorted and with duplicates, the existing key and then the first in the batch win
+        std::vector<int> keys;
+        std::vector<Tracked> values;
+        for (uint32 i = 0, count = rng() % 32; i < count; ++i)
+        {
+          keys.push_back(static_cast<int>(rng() % 1024));
+          values.push_back(Tracked(static_cast<int>(rng() % 10000)));
+          reference.emplace(keys.back(), values.back().value);
+        }
+        map.Insert(keys.data(), values.data(), keys.size());
+        break;
+      }
+      case 7:
+      {
+        std::set<int> unique;
+        for (uint32 i = 0, count = rng() % 32; i < count; ++i)
+          unique.insert(static_cast<int>(rng() % 1024));
+
+        std::vector<int> keys(unique.begin(), unique.end());
+        std::vector<Tracked> values;
+        for (int k : keys)
+        {
+          values.push_back(Tracked(k * 3));
+          reference.emplace(k, k * 3);
+        }
+        map.InsertSorted(keys.data(), values.data(), keys.size());
+        break;
+      }
+      }
+
+      ExpectSame(map, reference);
+      ASSERT_EQ(Tracked::s_Live, static_cast<int>(reference.size()));
+    }
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(FlatMapTest, BulkInsertTieBreak)
+{
+  SSTD::FlatMap<int, int> map{};
+  map.Insert(5, 50);
+
+  int keys[] = { 7, 5, 3, 7, 3, 7, 1 };
+  int values[] = { 1, 2, 3, 4, 5, 6, 7 };
+  map.Insert(keys, values, 7);
+
+  ASSERT_EQ(map.Size(), 4u);
+  EXPECT_EQ(map.At(1), 7);
+  EXPECT_EQ(map.At(3), 3);
+  EXPECT_EQ(map.At(5), 50);
+  EXPECT_EQ(map.At(7), 1);
+}
+
+//a value that throws must not leave its key behind, every later lookup would be off by one
+TEST(FlatMapTest, ThrowingValue)
+{
+  {
+    SSTD::FlatMap<int, ThrowingTracked> map{};
+    for (int key = 0; key < 100; ++key)
+    {
+      if (key % 4 == 1)
+      {
+        EXPECT_THROW(map.TryEmplace(key, -1), SSTD::Exception);
+      }
+      else
+        map.Insert(key, ThrowingTracked(key));
+    }
+
+    EXPECT_EQ(map.Size(), 75u);
+    for (int key = 0; key < 100; ++key)
+    {
+      const ThrowingTracked* value = map.Find(key);
+      ASSERT_EQ(value != nullptr, key % 4 != 1) << key;
+      if (value)
+      {
+        ASSERT_EQ(value->value, key) << key;
+      }
+    }
+    EXPECT_EQ(Tracked::s_Live, 75);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(FlatMapTest, FindAndAt)
+{
+  SSTD::FlatMap<int, int> map{};
+  for (int i = 0; i < 100; i += 2)
+    map.Insert(i, i * 10);
+
+  EXPECT_EQ(*map.Find(42), 420);
+  EXPECT_EQ(map.Find(43), nullptr);
+  EXPECT_EQ(map.Find(-1), nullptr);
+  EXPECT_EQ(map.Find(100), nullptr);
+  EXPECT_TRUE(map.Contains(0));
+  EXPECT_THROW(map.At(1), SSTD::Exception);
+
+  int sum = 0;
+  int previous = -1;
+  map.Apply([&](const int& key, int& value)
+    {
+      EXPECT_LT(previous, key);
+      previous = key;
+      sum += value;
+    });
+  EXPECT_EQ(sum, 24500);
+
+  SSTD::FlatMap<int, int> copy = map;
+  map.Clear();
+  EXPECT_TRUE(map.IsEmpty());
+  EXPECT_EQ(copy.Size(), 50u);
+  EXPECT_EQ(copy.Keys()[49], 98);
+}
+
+TEST(FlatSetTest, RandomOperations)
+{
+  std::mt19937 rng(2);
+  SSTD::FlatSet<uint32> set{};
+  std::set<uint32> reference;
+
+  for (int step = 0; step < 3000; ++step)
+  {
+    uint32 key = rng() % 1024;
+    switch (rng() % 4)
+    {
+    case 0:
+      ASSERT_EQ(set.Insert(key), reference.insert(key).second);
+      break;
+    case 1:
+      ASSERT_EQ(set.Remove(key), reference.erase(key) == 1);
+      break;
+    case 2:
+    {
+      std::vector<uint32> keys;
+      for (uint32 i = 0, count = rng() % 32; i < count; ++i)
+        keys.push_back(rng() % 1024);
+      set.Insert(keys.data(), keys.size());
+      reference.insert(keys.begin(), keys.end());
+      break;
+    }
+    case 3:
+    {
+      std::set<uint32> unique;
+      for (uint32 i = 0, count = rng() % 32; i < count; ++i)
+        unique.insert(rng() % 1024);
+      std::vector<uint32> keys(unique.begin(), unique.end());
+      set.InsertSorted(keys.data(), keys.size());
+      reference.insert(keys.begin(), keys.end());
+      break;
+    }
+    }
+
+    ASSERT_EQ(set.Size(), reference.size());
+    ASSERT_EQ(set.Contains(key), reference.count(key) == 1);
+  }
+
+  std::vector<uint32> expected(reference.begin(), reference.end());
+  std::vector<uint32> actual;
+  for (uint32 key : set)
+    actual.push_back(key);
+  EXPECT_EQ(actual, expected);
+  EXPECT_EQ(set.Find(1024u), nullptr);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include "Containers/HandleMap.h"
+
+#include "TestUtility.h"
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using TestUtility::Tracked;
+
+namespace
+{
+  using Map = SSTD::HandleMap<Tracked>;
+
+  void ExpectSame(const Map& map, const std::unordered_map<Map::HandleType, int>& reference)
+  {
+    ASSERT_EQ(map.Size(), reference.size());
+    for (const auto& entry : reference)
+    {
+      const Tracked* value = map.Get(entry.first);
+      ASSERT_NE(value, nullptr);
+      ASSERT_EQ(value->value, entry.second);
+      ASSERT_TRUE(value->IsValid());
+    }
+
+    //the dense array and the handles point at each other
+    for (size_t i = 0; i < map.Size(); ++i)
+      ASSERT_EQ(map.Get(map.HandleAt(i)), map.Data() + i);
+  }
+}
+
+//removed handles must stay stale even after their slot is reused, so every one of them is checked again at the end
+TEST(HandleMapTest, RandomOperations)
+{
+  {
+    std::mt19937 rng(1);
+    Map map{};
+    std::unordered_map<Map::HandleType, int> reference;
+    std::vector<Map::HandleType> live;
+    std::vector<Map::HandleType> stale;
+
+    for (int step = 0; step < 5000; ++step)
+    {
+      if (live.empty() || rng() % 5 < 3)
+      {
+        int value = static_cast<int>(rng() % 10000);
+        Map::HandleType handle = map.Emplace(value);
+        ASSERT_NE(handle, Map::InvalidHandle);
+        ASSERT_EQ(reference.count(handle), 0u);
+        reference[handle] = value;
+        live.push_back(handle);
+      }
+      else
+      {
+        size_t at = rng() % live.size();
+        Map::HandleType handle = live[at];
+        live[at] = live.back();
+        live.pop_back();
+
+        EXPECT_TRUE(map.Remove(handle));
+        EXPECT_FALSE(map.Remove(handle));
+        reference.erase(handle);
+        stale.push_back(handle);
+      }
+
+      ExpectSame(map, reference);
+      ASSERT_EQ(Tracked::s_Live, static_cast<int>(reference.size()));
+    }
+
+    for (Map::HandleType handle : stale)
+    {
+      ASSERT_FALSE(map.Validate(handle));
+      ASSERT_EQ(map.Get(handle), nullptr);
+    }
+
+    Map copy(map);
+    ExpectSame(copy, reference);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(HandleMapTest, InvalidHandles)
+{
+  Map map{};
+  EXPECT_FALSE(map.Validate(Map::InvalidHandle));
+  EXPECT_EQ(map.Get(Map::InvalidHandle), nullptr);
+  EXPECT_THROW(map.At(Map::InvalidHandle), SSTD::Exception);
+
+  Map::HandleType handle = map.Insert(Tracked(5));
+  EXPECT_EQ(map.At(handle).value, 5);
+  EXPECT_EQ(map[handle].value, 5);
+
+  //an index that was never handed out, and a known index with the wrong generation
+  EXPECT_FALSE(map.Validate(handle + 1));
+  EXPECT_FALSE(map.Validate(handle + (static_cast<Map::HandleType>(1) << 32)));
+}
+
+TEST(HandleMapTest, EraseMakesEveryHandleStale)
+{
+  {
+    Map map{};
+    std::vector<Map::HandleType> handles;
+    for (int i = 0; i < 100; ++i)
+      handles.push_back(map.Emplace(i));
+
+    map.Erase();
+    EXPECT_TRUE(map.IsEmpty());
+    EXPECT_EQ(Tracked::s_Live, 0);
+    for (Map::HandleType handle : handles)
+      ASSERT_FALSE(map.Validate(handle));
+
+    //the slots are reused with a new generation
+    Map::HandleType handle = map.Emplace(7);
+    EXPECT_EQ(map.Get(handle)->value, 7);
+    EXPECT_EQ(map.Size(), 1u);
+
+    int sum = 0;
+    for (const Tracked& value : map)
+      sum += value.value;
+    EXPECT_EQ(sum, 7);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
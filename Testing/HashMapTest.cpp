@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+
+#include "Containers/HashMap.h"
+#include "Containers/HashSet.h"
+#include "Containers/String.h"
+
+#include "TestUtility.h"
+
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+using TestUtility::Tracked;
+using TestUtility::ThrowingTracked;
+
+namespace
+{
+  //every hash has the same low 7 bits, so each probe sees nothing but H2 matches and has to compare keys
+  struct SameLowBits
+  {
+    uint64 operator()(int key) const { return static_cast<uint64>(key) << 7; }
+  };
+
+  template<typename M>
+  void ExpectSame(const M& map, const std::unordered_map<int, int>& reference)
+  {
+    ASSERT_EQ(map.Size(), reference.size());
+    for (const std::pair<const int, int>& entry : reference)
+    {
+      const Tracked* value = map.Find(entry.first);
+      ASSERT_NE(value, nullptr) << entry.first;
+      ASSERT_EQ(value->value, entry.second) << entry.first;
+      ASSERT_TRUE(value->IsValid()) << entry.first;
+    }
+
+    //the iterators visit every element once
+    size_t count = 0;
+    for (const auto& slot : map)
+    {
+      auto it = reference.find(slot.first);
+      ASSERT_NE(it, reference.end()) << slot.first;
+      ASSERT_EQ(slot.second.value, it->second);
+      ++count;
+    }
+    ASSERT_EQ(count, reference.size());
+  }
+
+  //inserts, removes and rebuilds on a key range small enough to hit existing keys and tombstones, checked against
+  //std::unordered_map after every step
+  template<typename M>
+  void RandomOperations(uint32 seed, int steps)
+  {
+    std::mt19937 rng(seed);
+    M map{};
+    std::unordered_map<int, int> reference;
+
+    for (int step = 0; step < steps; ++step)
+    {
+      int key = static_cast<int>(rng() % 512);
+      int value = static_cast<int>(rng() % 10000);
+      switch (rng() % 16)
+      {
+      case 0:
+      case 1:
+      case 2:
+        EXPECT_EQ(map.Insert(key, Tracked(value)), reference.emplace(key, value).second);
+        break;
+      case 3:
+      case 4:
+        map.InsertOrAssign(key, Tracked(value));
+        reference[key] = value;
+        break;
+      case 5:
+        map[key].value = value;
+        reference[key] = value;
+        break;
+      case 6:
+      case 7:
+      case 8:
+      case 9:
+        EXPECT_EQ(map.Remove(key), reference.erase(key) == 1);
+        break;
+      case 10:
+        EXPECT_EQ(map.Contains(key), reference.count(key) == 1);
+        break;
+      case 11:
+        map.Rehash(0);
+        break;
+      case 12:
+        map.Reserve(map.Size() + rng() % 64);
+        break;
+      case 13:
+        if (rng() % 16 == 0)
+        {
+          map.Erase();
+          reference.clear();
+        }
+        break;
+      default:
+      {
+        //a copy and a move of the whole table have to stay usable on their own
+        if (rng() % 8 == 0)
+        {
+          M copy{};
+          copy = map;
+          map.Clear();
+          map = Move(copy);
+          EXPECT_EQ(copy.Size(), 0u);
+        }
+        break;
+      }
+      }
+
+      ExpectSame(map, reference);
+      ASSERT_EQ(Tracked::s_Live, static_cast<int>(reference.size()));
+    }
+  }
+}
+
+TEST(HashMapTest, RandomOperations)
+{
+  RandomOperations<SSTD::HashMap<int, Tracked>>(1, 4000);
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(HashMapTest, RandomOperationsWithCollisions)
+{
+  RandomOperations<SSTD::HashMap<int, Tracked, SameLowBits>>(2, 4000);
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(HashMapTest, GrowthAndRehash)
+{
+  {
+    SSTD::HashMap<int, Tracked> map{};
+    for (int i = 0; i < 10000; ++i)
+      map.Insert(i, Tracked(i));
+    EXPECT_EQ(map.Size(), 10000u);
+    EXPECT_GE(map.Capacity(), 10000u);
+
+    for (int i = 0; i < 10000; i += 2)
+      EXPECT_TRUE(map.Remove(i));
+
+    //shrinking keeps the odd keys and drops the tombstones
+    size_t capacity = map.Capacity();
+    map.Rehash(0);
+    EXPECT_LT(map.Capacity(), capacity);
+    for (int i = 0; i < 10000; ++i)
+      ASSERT_EQ(map.Contains(i), i % 2 == 1) << i;
+    EXPECT_EQ(Tracked::s_Live, 5000);
+
+    map.Reserve(20000);
+    capacity = map.Capacity();
+    for (int i = 0; i < 20000; i += 2)
+      map.Insert(i, Tracked(i));
+    EXPECT_EQ(map.Capacity(), capacity);
+    EXPECT_EQ(map.Size(), 15000u);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(HashMapTest, AtAndFind)
+{
+  SSTD::HashMap<int, int> map{};
+  map.Insert(1, 10);
+  EXPECT_EQ(map.At(1), 10);
+  EXPECT_THROW(map.At(2), SSTD::Exception);
+  EXPECT_EQ(map.Find(2), nullptr);
+
+  //TryEmplace leaves an existing value alone
+  EXPECT_FALSE(map.TryEmplace(1, 20).second);
+  EXPECT_EQ(*map.Find(1), 10);
+  EXPECT_EQ(map.InsertOrAssign(1, 30), 30);
+
+  const SSTD::HashMap<int, int>& view = map;
+  EXPECT_EQ(view.At(1), 30);
+}
+
+//a value that throws while it is built must not leave a full slot behind, neither on insert nor on copy
+TEST(HashMapTest, ThrowingValue)
+{
+  {
+    SSTD::HashMap<int, ThrowingTracked> map{};
+    std::unordered_map<int, int> reference;
+    for (int i = 0; i < 3000; ++i)
+    {
+      if (i % 3 == 0)
+      {
+        EXPECT_THROW(map.TryEmplace(i, -1), SSTD::Exception);
+      }
+      else
+      {
+        map.Insert(i, ThrowingTracked(i));
+        reference.emplace(i, i);
+      }
+    }
+
+    ExpectSame(map, reference);
+    SSTD::HashMap<int, ThrowingTracked> copy(map);
+    ExpectSame(copy, reference);
+    EXPECT_EQ(Tracked::s_Live, static_cast<int>(reference.size()) * 2);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+//a String table can be searched with a plain const char*
+TEST(HashMapTest, StringKeys)
+{
+  SSTD::HashMap<SSTD::String, int> map{};
+  for (int i = 0; i < 200; ++i)
+  {
+    char buffer[32];
+    int size = snprintf(buffer, sizeof(buffer), "key number %d", i);
+    map.Insert(SSTD::String(buffer, static_cast<size_t>(size)), i);
+  }
+
+  ASSERT_NE(map.Find("key number 150"), nullptr);
+  EXPECT_EQ(*map.Find("key number 150"), 150);
+  EXPECT_TRUE(map.Contains(SSTD::String("key number 0")));
+  EXPECT_FALSE(map.Contains("key number 200"));
+  EXPECT_TRUE(map.Remove("key number 7"));
+  EXPECT_EQ(map.Size(), 199u);
+}
+
+TEST(HashSetTest, RandomOperations)
+{
+  std::mt19937 rng(3);
+  SSTD::HashSet<uint64> set{};
+  std::unordered_set<uint64> reference;
+
+  for (int step = 0; step < 20000; ++step)
+  {
+    uint64 key = rng() % 2048;
+    if (rng() % 3)
+      ASSERT_EQ(set.Insert(key), reference.insert(key).second);
+    else
+      ASSERT_EQ(set.Remove(key), reference.erase(key) == 1);
+  }
+
+  ASSERT_EQ(set.Size(), reference.size());
+  for (uint64 key = 0; key < 2048; ++key)
+  {
+    const uint64* found = set.Find(key);
+    ASSERT_EQ(found != nullptr, reference.count(key) == 1) << key;
+    if (found)
+    {
+      ASSERT_EQ(*found, key);
+    }
+  }
+
+  size_t count = 0;
+  for (uint64 key : set)
+  {
+    ASSERT_EQ(reference.count(key), 1u);
+    ++count;
+  }
+  EXPECT_EQ(count, reference.size());
+
+  SSTD::HashSet<uint64> copy(set);
+  set.Clear();
+  EXPECT_EQ(copy.Size(), reference.size());
+  EXPECT_TRUE(set.IsEmpty());
+  EXPECT_FALSE(set.Contains(0ull));
+}
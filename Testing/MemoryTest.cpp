@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include "Platform/Memory/MemoryKernels.h"
+#include "Containers/Vector.h"
+
+#include <cstring>
+
+//the kernels pick a different path per size and alignment, so every size up to a few vectors is tried at every
+//offset inside a cache line, the std functions are the reference
+
+namespace
+{
+  static constexpr size_t MaxSize = 300;
+  static constexpr size_t MaxOffset = 64;
+
+  void Fill(uint8* data, size_t size, uint32 seed)
+  {
+    for (size_t i = 0; i < size; ++i)
+      data[i] = static_cast<uint8>((i * 31 + seed) ^ (i >> 3));
+  }
+
+  int32 Sign(int value)
+  {
+    return value < 0 ? -1 : value > 0 ? 1 : 0;
+  }
+}
+
+TEST(MemoryKernelsTest, ActiveTable)
+{
+  const SSTD::MemoryKernels::Table& table = SSTD::MemoryKernels::GetActive();
+  EXPECT_NE(table.name, nullptr);
+  EXPECT_GT(SSTD::MemoryKernels::GetNonTemporalThreshold(), 0u);
+}
+
+TEST(MemoryKernelsTest, MemCopy)
+{
+  alignas(64) uint8 src[MaxSize + MaxOffset];
+  alignas(64) uint8 dst[MaxSize + MaxOffset + 1];
+  Fill(src, sizeof(src), 1);
+
+  for (size_t offset = 0; offset < MaxOffset; offset += 7)
+  {
+    for (size_t size = 0; size <= MaxSize; ++size)
+    {
+      memset(dst, 0xEE, sizeof(dst));
+      EXPECT_EQ(SSTD::MemCopy(dst + offset, src + (MaxOffset - 1 - offset), size), dst + offset);
+      ASSERT_EQ(memcmp(dst + offset, src + (MaxOffset - 1 - offset), size), 0) << size << " " << offset;
+      ASSERT_EQ(dst[offset + size], 0xEE) << size << " " << offset;
+      if (offset)
+      {
+        ASSERT_EQ(dst[offset - 1], 0xEE) << size << " " << offset;
+      }
+    }
+  }
+}
+
+TEST(MemoryKernelsTest, MemMoveOverlapping)
+{
+  alignas(64) uint8 data[MaxSize + MaxOffset];
+  alignas(64) uint8 expected[MaxSize + MaxOffset];
+
+  for (size_t shift = 1; shift < MaxOffset; shift += 5)
+  {
+    for (size_t size = 0; size <= MaxSize; size += 3)
+    {
+      //forwards
+      Fill(data, sizeof(data), 2);
+      memcpy(expected, data, sizeof(data));
+      memmove(expected + shift, expected, size);
+      SSTD::MemMove(data + shift, data, size);
+      ASSERT_EQ(memcmp(data, expected, sizeof(data)), 0) << size << " " << shift;
+
+      //backwards
+      Fill(data, sizeof(data), 3);
+      memcpy(expected, data, sizeof(data));
+      memmove(expected, expected + shift, size);
+      SSTD::MemMove(data, data + shift, size);
+      ASSERT_EQ(memcmp(data, expected, sizeof(data)), 0) << size << " " << shift;
+    }
+  }
+}
+
+TEST(MemoryKernelsTest, MemSet)
+{
+  alignas(64) uint8 data[MaxSize + MaxOffset + 1];
+  for (size_t offset = 0; offset < MaxOffset; offset += 7)
+  {
+    for (size_t size = 0; size <= MaxSize; ++size)
+    {
+      memset(data, 0xEE, sizeof(data));
+      SSTD::MemSet(data + offset, 0x5A, size);
+      for (size_t i = 0; i < sizeof(data); ++i)
+        ASSERT_EQ(data[i], i >= offset && i < offset + size ? 0x5A : 0xEE) << size << " " << offset;
+    }
+  }
+}
+
+TEST(MemoryKernelsTest, MemCompare)
+{
+  alignas(64) uint8 lhs[MaxSize];
+  alignas(64) uint8 rhs[MaxSize];
+  Fill(lhs, MaxSize, 4);
+
+  for (size_t size = 0; size <= MaxSize; size += 5)
+  {
+    memcpy(rhs, lhs, MaxSize);
+    EXPECT_EQ(SSTD::MemCompare(lhs, rhs, size), 0) << size;
+
+    //one different byte at every position, in both directions
+    for (size_t at = 0; at < size; at += 11)
+    {
+      memcpy(rhs, lhs, MaxSize);
+      rhs[at] = static_cast<uint8>(lhs[at] + 1);
+      ASSERT_EQ(Sign(SSTD::MemCompare(lhs, rhs, size)), Sign(memcmp(lhs, rhs, size))) << size << " " << at;
+      ASSERT_EQ(Sign(SSTD::MemCompare(rhs, lhs, size)), Sign(memcmp(rhs, lhs, size))) << size << " " << at;
+    }
+  }
+}
+
+TEST(MemoryKernelsTest, MemFind)
+{
+  alignas(64) uint8 data[MaxSize + MaxOffset];
+  for (size_t offset = 0; offset < MaxOffset; offset += 9)
+  {
+    for (size_t size = 0; size <= MaxSize; size += 3)
+    {
+      memset(data, 0, sizeof(data));
+      EXPECT_EQ(SSTD::MemFind(data + offset, 1, size), nullptr);
+
+      //the first match wins, a match right behind the range doesn't count
+      for (size_t at = 0; at < size; at += 13)
+      {
+        memset(data, 0, sizeof(data));
+        data[offset + at] = 1;
+        if (at + 1 < size)
+          data[offset + at + 1] = 1;
+        ASSERT_EQ(SSTD::MemFind(data + offset, 1, size), data + offset + at) << size << " " << at;
+      }
+
+      if (offset + size < sizeof(data))
+      {
+        memset(data, 0, sizeof(data));
+        data[offset + size] = 1;
+        ASSERT_EQ(SSTD::MemFind(data + offset, 1, size), nullptr) << size;
+      }
+    }
+  }
+}
+
+//big enough for the non-temporal path
+TEST(MemoryKernelsTest, LargeBlocks)
+{
+  size_t size = SSTD::MemoryKernels::GetNonTemporalThreshold() * 2 + 13;
+  SSTD::Vector<uint8> src(static_cast<uint8>(0), size + 1);
+  SSTD::Vector<uint8> dst(static_cast<uint8>(0), size + 1);
+  Fill(src.Data(), size + 1, 5);
+
+  SSTD::MemCopy(dst.Data() + 1, src.Data(), size);
+  EXPECT_EQ(memcmp(dst.Data() + 1, src.Data(), size), 0);
+
+  SSTD::MemSet(dst.Data(), 0x11, size);
+  EXPECT_EQ(dst[0], 0x11);
+  EXPECT_EQ(dst[size - 1], 0x11);
+  EXPECT_EQ(SSTD::MemFind(dst.Data(), 0x12, size), nullptr);
+
+  SSTD::Vector<uint8> expected = src;
+  memmove(expected.Data() + 1, expected.Data(), size);
+  SSTD::MemMove(src.Data() + 1, src.Data(), size);
+  EXPECT_EQ(SSTD::MemCompare(src.Data(), expected.Data(), size + 1), 0);
+
+  expected[size] = static_cast<uint8>(src[size] ^ 1);
+  EXPECT_EQ(Sign(SSTD::MemCompare(src.Data(), expected.Data(), size + 1)), Sign(memcmp(src.Data(), expected.Data(), size + 1)));
+}
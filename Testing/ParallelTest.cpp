@@ -0,0 +1,312 @@
+#include <gtest/gtest.h>
+
+#include "General/ParallelAlgorithm.h"
+#include "General/Exception.h"
+#include "Containers/Vector.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+static constexpr uint32 Workers = 3;
+
+namespace
+{
+  //a contiguous range of indices, joining two is only valid if the second starts right behind the first, so the
+  //result tells whether a reduce or scan kept the order of the elements
+  struct Span
+  {
+    Span(uint64 index) : first(index), last(index), ordered(true) {}
+
+    uint64 first;
+    uint64 last;
+    bool ordered;
+  };
+
+  Span Join(const Span& lhs, const Span& rhs)
+  {
+    Span span(lhs.first);
+    span.last = rhs.last;
+    span.ordered = lhs.ordered && rhs.ordered && lhs.last + 1 == rhs.first;
+    return span;
+  }
+
+  //Tracked with an atomic count, the sort moves and destroys elements on every thread of the pool
+  struct Relocated
+  {
+    Relocated(int pValue = 0) : value(pValue), self(this) { ++s_Live; }
+    Relocated(const Relocated& other) : value(other.value), self(this) { ++s_Live; }
+    Relocated(Relocated&& other) noexcept : value(other.value), self(this) { other.value = -1; ++s_Live; }
+    ~Relocated() { --s_Live; self = nullptr; }
+
+    Relocated& operator=(const Relocated& other) { value = other.value; return *this; }
+    Relocated& operator=(Relocated&& other) noexcept { value = other.value; other.value = -1; return *this; }
+
+    bool operator<(const Relocated& other) const { return value < other.value; }
+
+    bool IsValid() const { return self == this; }
+
+    int value;
+    Relocated* self;
+
+    static inline SSTD::a_int32 s_Live{ 0 };
+  };
+
+  SSTD::Vector<uint64> MakeInput(size_t size, uint32 seed)
+  {
+    std::mt19937_64 rng(seed);
+    SSTD::Vector<uint64> values{};
+    values.Reserve(size);
+    for (size_t i = 0; i < size; ++i)
+      values.PushBack(rng() % 1000000);
+    return values;
+  }
+}
+
+TEST(ThreadPoolTest, RunsEveryIndexOnce)
+{
+  SSTD::ThreadPool pool(Workers);
+  EXPECT_EQ(pool.GetConcurrency(), Workers + 1);
+
+  for (uint32 count : { 0u, 1u, 5u, 1000u })
+  {
+    std::vector<SSTD::a_uint32> calls(count);
+    pool.Run(count, [&](uint32 index) { ++calls[index]; });
+    for (uint32 i = 0; i < count; ++i)
+      ASSERT_EQ(calls[i].Load(), 1u) << count << " " << i;
+  }
+}
+
+//the first exception comes out of Run, the pool is still usable afterwards
+TEST(ThreadPoolTest, ExceptionIsRethrown)
+{
+  SSTD::ThreadPool pool(Workers);
+  SSTD::a_uint32 ran{ 0 };
+  EXPECT_THROW(pool.Run(10000, [&](uint32 index)
+    {
+      ++ran;
+      if (index == 100)
+        throw SSTD::Exception();
+    }), SSTD::Exception);
+  EXPECT_GT(ran.Load(), 0u);
+
+  //no further indices are handed out, so nowhere near all of them ran
+  EXPECT_LT(ran.Load(), 10000u);
+
+  SSTD::a_uint32 calls{ 0 };
+  pool.Run(100, [&](uint32) { ++calls; });
+  EXPECT_EQ(calls.Load(), 100u);
+}
+
+//a Run from inside a task runs inline instead of waiting on the pool it is part of
+TEST(ThreadPoolTest, NestedRun)
+{
+  SSTD::ThreadPool pool(Workers);
+  SSTD::a_uint32 calls{ 0 };
+  pool.Run(8, [&](uint32)
+    {
+      pool.Run(8, [&](uint32) { ++calls; });
+    });
+  EXPECT_EQ(calls.Load(), 64u);
+}
+
+TEST(ParallelForTest, ElementsAndIndices)
+{
+  SSTD::ThreadPool pool(Workers);
+  SSTD::Vector<uint64> values = MakeInput(100000, 1);
+  SSTD::Vector<uint64> expected = values;
+
+  SSTD::ParallelFor(pool, values.begin(), values.end(), [](uint64& value) { value *= 3; }, 1000);
+  for (size_t i = 0; i < values.Size(); ++i)
+    ASSERT_EQ(values[i], expected[i] * 3) << i;
+
+  std::vector<SSTD::a_uint32> calls(12345);
+  SSTD::ParallelFor(pool, 0u, 12345u, [&](uint32 index) { ++calls[index]; }, 100);
+  for (size_t i = 0; i < calls.size(); ++i)
+    ASSERT_EQ(calls[i].Load(), 1u) << i;
+
+  //empty ranges don't call anything
+  SSTD::ParallelFor(pool, 5u, 5u, [](uint32) { FAIL(); });
+}
+
+TEST(ParallelTransformTest, AgainstSerial)
+{
+  SSTD::ThreadPool pool(Workers);
+  SSTD::Vector<uint64> values = MakeInput(50001, 2);
+  SSTD::Vector<double> output(0.0, values.Size());
+
+  SSTD::ParallelTransform(pool, values.begin(), values.end(), output.begin(), [](uint64 value) { return value * 0.5; }, 999);
+  for (size_t i = 0; i < values.Size(); ++i)
+    ASSERT_EQ(output[i], values[i] * 0.5) << i;
+
+  //in place
+  SSTD::ParallelTransform(pool, values.begin(), values.end(), values.begin(), [](uint64 value) { return value + 1; });
+  EXPECT_EQ(values[50000], static_cast<uint64>(output[50000] * 2) + 1);
+}
+
+TEST(ParallelReduceTest, KeepsOrder)
+{
+  SSTD::ThreadPool pool(Workers);
+  for (size_t size : { size_t(1), size_t(1000), size_t(100003) })
+  {
+    SSTD::Vector<uint64> indices{};
+    for (size_t i = 0; i < size; ++i)
+      indices.PushBack(i + 1);
+
+    //the init goes in front of everything
+    Span span = SSTD::ParallelReduce(pool, indices.begin(), indices.end(), Span(0), Join, 777);
+    EXPECT_TRUE(span.ordered) << size;
+    EXPECT_EQ(span.first, 0u);
+    EXPECT_EQ(span.last, size);
+
+    SSTD::Vector<uint64> values = MakeInput(size, 3);
+    uint64 sum = SSTD::ParallelReduce(pool, values.begin(), values.end(), 5ull, [](uint64 lhs, uint64 rhs) { return lhs + rhs; });
+    EXPECT_EQ(sum, std::accumulate(values.Data(), values.Data() + size, 5ull));
+  }
+
+  SSTD::Vector<uint64> empty{};
+  EXPECT_EQ(SSTD::ParallelReduce(pool, empty.begin(), empty.end(), 7ull, [](uint64 lhs, uint64 rhs) { return lhs + rhs; }), 7u);
+}
+
+//the tasks that threw never set their partial sum, only the ones that did may be destroyed
+TEST(ParallelReduceTest, ThrowingOp)
+{
+  {
+    SSTD::ThreadPool pool(Workers);
+    SSTD::Vector<Relocated> values{};
+    for (int i = 0; i < 100000; ++i)
+      values.PushBack(Relocated(i));
+
+    auto op = [](const Relocated& lhs, const Relocated& rhs)
+      {
+        if (rhs.value % 20000 == 7)
+          throw SSTD::Exception();
+        return Relocated(lhs.value ^ rhs.value);
+      };
+    EXPECT_THROW(SSTD::ParallelReduce(pool, values.begin(), values.end(), Relocated(0), op, 1000), SSTD::Exception);
+    EXPECT_EQ(Relocated::s_Live.Load(), 100000);
+  }
+  EXPECT_EQ(Relocated::s_Live.Load(), 0);
+}
+
+TEST(ParallelScanTest, AgainstSerial)
+{
+  SSTD::ThreadPool pool(Workers);
+  for (size_t grain : { size_t(0), size_t(1), size_t(100), size_t(4096) })
+  {
+    for (size_t size : { size_t(1), size_t(99), size_t(100), size_t(101), size_t(30000) })
+    {
+      SSTD::Vector<uint64> values = MakeInput(size, static_cast<uint32>(size));
+      std::vector<uint64> expected(size);
+      std::partial_sum(values.Data(), values.Data() + size, expected.begin());
+
+      SSTD::Vector<uint64> output(static_cast<uint64>(0), size);
+      SSTD::ParallelScan(pool, values.begin(), values.end(), output.begin(), [](uint64 lhs, uint64 rhs) { return lhs + rhs; }, grain);
+      for (size_t i = 0; i < size; ++i)
+        ASSERT_EQ(output[i], expected[i]) << grain << " " << size << " " << i;
+
+      //in place
+      SSTD::ParallelScan(pool, values.begin(), values.end(), values.begin(), [](uint64 lhs, uint64 rhs) { return lhs + rhs; }, grain);
+      for (size_t i = 0; i < size; ++i)
+        ASSERT_EQ(values[i], expected[i]) << grain << " " << size << " " << i;
+    }
+  }
+
+  //every element exactly once and in order
+  SSTD::Vector<Span> spans{};
+  SSTD::Vector<uint64> indices{};
+  for (uint64 i = 0; i < 10000; ++i)
+  {
+    indices.PushBack(i);
+    spans.PushBack(Span(0));
+  }
+  SSTD::ParallelScan(pool, indices.begin(), indices.end(), spans.begin(), Join, 333);
+  for (uint64 i = 0; i < 10000; ++i)
+  {
+    ASSERT_TRUE(spans[i].ordered) << i;
+    ASSERT_EQ(spans[i].first, 0u);
+    ASSERT_EQ(spans[i].last, i);
+  }
+}
+
+TEST(ParallelSortTest, AgainstStd)
+{
+  SSTD::ThreadPool pool(Workers);
+  for (size_t size : { size_t(0), size_t(1), size_t(1000), size_t(100000), size_t(300001) })
+  {
+    SSTD::Vector<uint64> values = MakeInput(size, static_cast<uint32>(size));
+    std::vector<uint64> expected(values.Data(), values.Data() + size);
+    std::sort(expected.begin(), expected.end());
+
+    //the default grain, a small one for many runs and an odd one out in most merge rounds, and one past the size
+    //that sorts on the calling thread alone
+    for (size_t grain : { size_t(0), size_t(5000), size + 1 })
+    {
+      SSTD::Vector<uint64> sorted = values;
+      SSTD::Sort(pool, sorted.begin(), sorted.end(), SSTD::Less<uint64>(), grain);
+      for (size_t i = 0; i < size; ++i)
+        ASSERT_EQ(sorted[i], expected[i]) << size << " " << grain << " " << i;
+    }
+  }
+}
+
+//the merges relocate into uninitialized scratch and back, nothing may be copied over or lost
+TEST(ParallelSortTest, ElementsAreMovedProperly)
+{
+  {
+    SSTD::ThreadPool pool(Workers);
+    SSTD::Vector<uint64> numbers = MakeInput(100000, 4);
+    SSTD::Vector<Relocated> values{};
+    for (uint64 number : numbers)
+      values.PushBack(Relocated(static_cast<int>(number)));
+
+    SSTD::Sort(pool, values.begin(), values.end(), SSTD::Less<Relocated>(), 16 * 1024);
+    for (size_t i = 0; i < values.Size(); ++i)
+    {
+      ASSERT_TRUE(values[i].IsValid()) << i;
+      if (i > 0)
+      {
+        ASSERT_LE(values[i - 1].value, values[i].value) << i;
+      }
+    }
+    EXPECT_EQ(Relocated::s_Live.Load(), 100000);
+  }
+  EXPECT_EQ(Relocated::s_Live.Load(), 0);
+}
+
+//a comparator that throws partway through the merges comes out of Sort without leaking the scratch
+TEST(ParallelSortTest, ThrowingCompare)
+{
+  static constexpr size_t Grain = 20000;
+  SSTD::ThreadPool pool(Workers);
+  SSTD::Vector<uint64> values = MakeInput(200000, 5);
+
+  //the runs are sorted before the first merge starts, so the compares up to there are those of the runs alone
+  SSTD::a_uint64 compares{ 0 };
+  auto count = [&](uint64 lhs, uint64 rhs)
+    {
+      compares.FetchAdd(1, SSTD::MemoryOrder::Relaxed);
+      return lhs < rhs;
+    };
+  SSTD::Vector<uint64> runs = values;
+  for (size_t begin = 0; begin < runs.Size(); begin += Grain)
+    SSTD::Sort(runs.Data() + begin, runs.Data() + begin + Grain, count);
+  uint64 run_compares = compares.Exchange(0);
+  SSTD::Vector<uint64> sorted = values;
+  SSTD::Sort(pool, sorted.begin(), sorted.end(), count, Grain);
+  uint64 total_compares = compares.Exchange(0);
+  ASSERT_LT(run_compares, total_compares);
+
+  uint64 throw_at = run_compares + (total_compares - run_compares) / 2;
+  auto cond = [&](uint64 lhs, uint64 rhs)
+    {
+      if (compares.FetchAdd(1, SSTD::MemoryOrder::Relaxed) == throw_at)
+        throw SSTD::Exception();
+      return lhs < rhs;
+    };
+  EXPECT_THROW(SSTD::Sort(pool, values.begin(), values.end(), cond, Grain), SSTD::Exception);
+
+  //the pool is still usable
+  SSTD::Sort(pool, values.begin(), values.end());
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+
+#include "Containers/RobinHoodMap.h"
+#include "Containers/String.h"
+
+#include "TestUtility.h"
+
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+
+using TestUtility::Tracked;
+using TestUtility::ThrowingTracked;
+
+namespace
+{
+  //every key has the same home at the very end of the table, so each run wraps around to the front
+  struct SameHomeAtEnd
+  {
+    uint64 operator()(int key) const { return ~static_cast<uint64>(0) - static_cast<uint64>(key); }
+  };
+
+  //every instance hashes differently, a table that keeps a layout but not the hasher that built it loses its keys
+  struct SeededHasher
+  {
+    SeededHasher() : seed(++s_Seeds * 0x9E3779B97F4A7C15ull) {}
+
+    uint64 operator()(int key) const { return SSTD::HashFunctions::Mix(static_cast<uint64>(key) ^ seed); }
+
+    uint64 seed;
+
+    static inline uint64 s_Seeds = 0;
+  };
+
+  template<typename M>
+  void ExpectSame(const M& map, const std::unordered_map<int, int>& reference)
+  {
+    ASSERT_EQ(map.Size(), reference.size());
+    for (const std::pair<const int, int>& entry : reference)
+    {
+      const Tracked* value = map.Find(entry.first);
+      ASSERT_NE(value, nullptr) << entry.first;
+      ASSERT_EQ(value->value, entry.second) << entry.first;
+      ASSERT_TRUE(value->IsValid()) << entry.first;
+    }
+
+    size_t count = 0;
+    for (const auto& slot : map)
+    {
+      auto it = reference.find(slot.first);
+      ASSERT_NE(it, reference.end()) << slot.first;
+      ASSERT_EQ(slot.second.value, it->second);
+      ++count;
+    }
+    ASSERT_EQ(count, reference.size());
+  }
+
+  //removes shift the runs back, so the key range is kept small to get long runs and many of them
+  template<typename M>
+  void RandomOperations(uint32 seed, int steps, int keys)
+  {
+    std::mt19937 rng(seed);
+    M map{};
+    std::unordered_map<int, int> reference;
+
+    for (int step = 0; step < steps; ++step)
+    {
+      int key = static_cast<int>(rng() % static_cast<uint32>(keys));
+      int value = static_cast<int>(rng() % 10000);
+      switch (rng() % 12)
+      {
+      case 0:
+      case 1:
+      case 2:
+        EXPECT_EQ(map.Insert(key, Tracked(value)), reference.emplace(key, value).second);
+        break;
+      case 3:
+        map.InsertOrAssign(key, Tracked(value));
+        reference[key] = value;
+        break;
+      case 4:
+        map[key].value = value;
+        reference[key] = value;
+        break;
+      case 5:
+      case 6:
+      case 7:
+        EXPECT_EQ(map.Remove(key), reference.erase(key) == 1);
+        break;
+      case 8:
+        EXPECT_EQ(map.Contains(key), reference.count(key) == 1);
+        break;
+      case 9:
+        map.Reserve(map.Size() + rng() % 32);
+        break;
+      case 10:
+        if (rng() % 32 == 0)
+        {
+          map.Erase();
+          reference.clear();
+        }
+        break;
+      default:
+        if (rng() % 8 == 0)
+        {
+          M copy(map);
+          map = Move(copy);
+        }
+        break;
+      }
+
+      ExpectSame(map, reference);
+      ASSERT_EQ(Tracked::s_Live, static_cast<int>(reference.size()));
+      //a free slot is always left, otherwise a probe for a missing key would never stop
+      ASSERT_TRUE(map.Size() == 0 || map.Size() < map.Capacity());
+    }
+  }
+}
+
+TEST(RobinHoodMapTest, RandomOperations)
+{
+  RandomOperations<SSTD::RobinHoodMap<int, Tracked>>(1, 6000, 1024);
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(RobinHoodMapTest, RunsThatWrapAround)
+{
+  RandomOperations<SSTD::RobinHoodMap<int, Tracked, SameHomeAtEnd>>(2, 3000, 64);
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(RobinHoodMapTest, ReserveAndGrowth)
+{
+  SSTD::RobinHoodMap<int, int> map{};
+  EXPECT_EQ(map.MemoryUsage(), 0u);
+  EXPECT_EQ(map.Find(1), nullptr);
+
+  //exactly the room asked for, filling it must not grow
+  map.Reserve(900);
+  size_t capacity = map.Capacity();
+  EXPECT_GE(capacity, 1000u);
+  EXPECT_LT(capacity, 1010u);
+  for (int i = 0; i < 900; ++i)
+    map.Insert(i, i);
+  EXPECT_EQ(map.Capacity(), capacity);
+  EXPECT_GT(map.LoadFactor(), 0.85f);
+
+  map.Insert(900, 900);
+  for (int i = 901; i < 1000; ++i)
+    map.Insert(i, i);
+  EXPECT_GT(map.Capacity(), capacity);
+
+  //every other key removed, the rest still found through the shifted runs
+  for (int i = 0; i < 1000; i += 2)
+    EXPECT_TRUE(map.Remove(i));
+  for (int i = 0; i < 1000; ++i)
+    ASSERT_EQ(map.Contains(i), i % 2 == 1) << i;
+
+  EXPECT_EQ(map.At(1), 1);
+  EXPECT_THROW(map.At(0), SSTD::Exception);
+
+  int sum = 0;
+  map.Apply([&](const int& key, int& value)
+    {
+      EXPECT_EQ(key, value);
+      sum += value;
+    });
+  EXPECT_EQ(sum, 250000);
+}
+
+//the hasher has to go with the table it built
+TEST(RobinHoodMapTest, AssignmentTakesTheHasher)
+{
+  using Map = SSTD::RobinHoodMap<int, int, SeededHasher>;
+  Map map{};
+  for (int i = 0; i < 500; ++i)
+    map.Insert(i, i);
+
+  Map moved{};
+  moved = Move(map);
+  Map copied{};
+  copied = moved;
+
+  for (int i = 0; i < 500; ++i)
+  {
+    ASSERT_TRUE(moved.Contains(i)) << i;
+    ASSERT_TRUE(copied.Contains(i)) << i;
+  }
+}
+
+//the run opened for a value that throws is shifted back, every other key stays where its probe finds it
+TEST(RobinHoodMapTest, ThrowingValue)
+{
+  {
+    SSTD::RobinHoodMap<int, ThrowingTracked, SameHomeAtEnd> map{};
+    std::unordered_map<int, int> reference;
+    for (int i = 0; i < 60; ++i)
+    {
+      if (i % 3 == 0)
+      {
+        EXPECT_THROW(map.TryEmplace(i, -1), SSTD::Exception);
+      }
+      else
+      {
+        map.Insert(i, ThrowingTracked(i));
+        reference.emplace(i, i);
+      }
+      ExpectSame(map, reference);
+    }
+    EXPECT_EQ(Tracked::s_Live, static_cast<int>(reference.size()));
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(RobinHoodMapTest, StringKeys)
+{
+  SSTD::RobinHoodMap<SSTD::String, int> map{};
+  for (int i = 0; i < 300; ++i)
+  {
+    char buffer[32];
+    int size = snprintf(buffer, sizeof(buffer), "robin hood key %d", i);
+    map.Insert(SSTD::String(buffer, static_cast<size_t>(size)), i);
+  }
+
+  ASSERT_NE(map.Find("robin hood key 299"), nullptr);
+  EXPECT_EQ(*map.Find("robin hood key 299"), 299);
+  EXPECT_FALSE(map.Contains("robin hood key 300"));
+  EXPECT_TRUE(map.Remove("robin hood key 0"));
+  EXPECT_EQ(map.Size(), 299u);
+}
@@ -0,0 +1,388 @@
+#include <gtest/gtest.h>
+
+#include "General/Algorithm.h"
+#include "Containers/Vector.h"
+#include "Containers/String.h"
+#include "General/ArenaAllocator.h"
+
+#include "TestUtility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using TestUtility::Tracked;
+
+namespace
+{
+  enum class Input
+  {
+    Random,
+    Sorted,
+    Reversed,
+    FewUnique,
+    OrganPipe,
+    AlmostSorted,
+  };
+
+  static constexpr Input Inputs[] = { Input::Random, Input::Sorted, Input::Reversed, Input::FewUnique, Input::OrganPipe, Input::AlmostSorted };
+
+  //below, around and far above the insertion sort thresholds
+  static constexpr size_t Sizes[] = { 0, 1, 2, 3, 7, 16, 23, 24, 25, 63, 64, 65, 100, 257, 1000, 4099, 100000 };
+
+  std::vector<uint64> MakeInput(Input input, size_t size, uint32 seed)
+  {
+    std::mt19937_64 rng(seed);
+    std::vector<uint64> values(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+      switch (input)
+      {
+      case Input::Random: values[i] = rng(); break;
+      case Input::Sorted: values[i] = i; break;
+      case Input::Reversed: values[i] = size - i; break;
+      case Input::FewUnique: values[i] = rng() % 4; break;
+      case Input::OrganPipe: values[i] = i < size / 2 ? i : size - i; break;
+      case Input::AlmostSorted: values[i] = i; break;
+      }
+    }
+
+    if (input == Input::AlmostSorted)
+    {
+      for (size_t i = 0; i < size / 100 + 1 && size > 1; ++i)
+        std::swap(values[rng() % size], values[rng() % size]);
+    }
+    return values;
+  }
+
+  //sorts a copy of every input with SortType and checks it against std::sort
+  template<typename SortType>
+  void CheckAgainstStd()
+  {
+    for (Input input : Inputs)
+    {
+      for (size_t size : Sizes)
+      {
+        std::vector<uint64> expected = MakeInput(input, size, static_cast<uint32>(size));
+        SSTD::Vector<uint64> values{};
+        values.Append(expected.data(), expected.size());
+
+        std::sort(expected.begin(), expected.end());
+        SSTD::Sort<SortType>(values.begin(), values.end());
+        for (size_t i = 0; i < size; ++i)
+          ASSERT_EQ(values[i], expected[i]) << static_cast<int>(input) << " " << size << " " << i;
+      }
+    }
+  }
+
+  struct Keyed
+  {
+    uint32 key;
+    uint32 order;
+  };
+
+  //few distinct keys, so most elements share theirs with many others, the input order is kept in order
+  template<typename F>
+  void CheckStability(size_t size, uint32 keys, const F& sort)
+  {
+    std::mt19937 rng(static_cast<uint32>(size));
+    SSTD::Vector<Keyed> values{};
+    for (size_t i = 0; i < size; ++i)
+      values.PushBack(Keyed{ static_cast<uint32>(rng() % keys), static_cast<uint32>(i) });
+
+    sort(values);
+    for (size_t i = 1; i < size; ++i)
+    {
+      ASSERT_LE(values[i - 1].key, values[i].key) << size << " " << i;
+      if (values[i - 1].key == values[i].key)
+      {
+        ASSERT_LT(values[i - 1].order, values[i].order) << size << " " << i;
+      }
+    }
+  }
+
+  SSTD::String NumberString(uint64 value)
+  {
+    char buffer[48];
+    int size = snprintf(buffer, sizeof(buffer), "a long enough prefix %llu", static_cast<unsigned long long>(value));
+    return SSTD::String(buffer, static_cast<size_t>(size));
+  }
+}
+
+TEST(PDQSortTest, AgainstStd)
+{
+  CheckAgainstStd<SSTD::SortTypePDQ>();
+}
+
+TEST(PDQSortTest, CustomCompare)
+{
+  std::vector<uint64> expected = MakeInput(Input::Random, 5000, 1);
+  SSTD::Vector<uint64> values{};
+  values.Append(expected.data(), expected.size());
+
+  std::sort(expected.begin(), expected.end(), [](uint64 lhs, uint64 rhs) { return lhs > rhs; });
+  SSTD::Sort(values.begin(), values.end(), [](uint64 lhs, uint64 rhs) { return lhs > rhs; });
+  for (size_t i = 0; i < expected.size(); ++i)
+    ASSERT_EQ(values[i], expected[i]) << i;
+}
+
+//Strings aren't trivially copyable and take the path without the branchless partition
+TEST(PDQSortTest, Strings)
+{
+  for (Input input : Inputs)
+  {
+    std::vector<uint64> numbers = MakeInput(input, 3000, 2);
+    SSTD::Vector<SSTD::String> values{};
+    for (uint64 number : numbers)
+      values.PushBack(NumberString(number % 100000));
+
+    SSTD::Sort(values.begin(), values.end());
+    for (size_t i = 1; i < values.Size(); ++i)
+      ASSERT_FALSE(values[i] < values[i - 1]) << static_cast<int>(input) << " " << i;
+  }
+}
+
+//every element is moved, never copied over or lost
+TEST(PDQSortTest, ElementsAreMovedProperly)
+{
+  {
+    std::vector<uint64> numbers = MakeInput(Input::Random, 10000, 3);
+    SSTD::Vector<Tracked> values{};
+    for (uint64 number : numbers)
+      values.PushBack(Tracked(static_cast<int>(number % 1000)));
+
+    SSTD::Sort(values.begin(), values.end());
+    for (size_t i = 0; i < values.Size(); ++i)
+    {
+      ASSERT_TRUE(values[i].IsValid()) << i;
+      ASSERT_NE(values[i].value, -1) << i;
+      if (i > 0)
+      {
+        ASSERT_LE(values[i - 1].value, values[i].value) << i;
+      }
+    }
+    EXPECT_EQ(Tracked::s_Live, 10000);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(RadixSortTest, AgainstStd)
+{
+  CheckAgainstStd<SSTD::SortTypeRadix>();
+}
+
+//negative numbers have to come before the positive ones
+TEST(RadixSortTest, SignedIntegers)
+{
+  std::mt19937_64 rng(4);
+  for (size_t size : { size_t(50), size_t(5000), size_t(200000) })
+  {
+    std::vector<int64> expected(size);
+    std::vector<int32> expected32(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+      expected[i] = static_cast<int64>(rng());
+      expected32[i] = static_cast<int32>(rng() % 2001) - 1000;
+    }
+
+    SSTD::Vector<int64> values{};
+    values.Append(expected.data(), size);
+    SSTD::Vector<int32> values32{};
+    values32.Append(expected32.data(), size);
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(expected32.begin(), expected32.end());
+    SSTD::Sort<SSTD::SortTypeRadix>(values.begin(), values.end());
+    SSTD::Sort<SSTD::SortTypeRadix>(values32.begin(), values32.end());
+    for (size_t i = 0; i < size; ++i)
+    {
+      ASSERT_EQ(values[i], expected[i]) << size << " " << i;
+      ASSERT_EQ(values32[i], expected32[i]) << size << " " << i;
+    }
+  }
+}
+
+//negative floats sort backwards by their bits, -0.0 lands right before 0.0
+TEST(RadixSortTest, Floats)
+{
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+  for (size_t size : { size_t(40), size_t(3000), size_t(100000) })
+  {
+    std::vector<double> expected(size);
+    for (size_t i = 0; i < size; ++i)
+      expected[i] = distribution(rng);
+    expected[0] = -0.0;
+    expected[size / 2] = 0.0;
+    expected[size - 1] = -INFINITY;
+    expected[size / 3] = INFINITY;
+
+    SSTD::Vector<double> values{};
+    values.Append(expected.data(), size);
+    SSTD::Vector<float> floats{};
+    for (double value : expected)
+      floats.PushBack(static_cast<float>(value));
+
+    std::sort(expected.begin(), expected.end());
+    SSTD::Sort<SSTD::SortTypeRadix>(values.begin(), values.end());
+    SSTD::Sort<SSTD::SortTypeRadix>(floats.begin(), floats.end());
+    for (size_t i = 0; i < size; ++i)
+    {
+      ASSERT_EQ(values[i], expected[i]) << size << " " << i;
+      ASSERT_EQ(floats[i], static_cast<float>(expected[i])) << size << " " << i;
+    }
+
+    size_t zero = std::lower_bound(expected.begin(), expected.end(), 0.0) - expected.begin();
+    EXPECT_TRUE(std::signbit(values[zero]));
+    EXPECT_FALSE(std::signbit(values[zero + 1]));
+  }
+}
+
+//sizes below the insertion threshold, in the cache and far past it
+TEST(RadixSortTest, Stability)
+{
+  for (size_t size : { size_t(60), size_t(5000), size_t(300000) })
+  {
+    CheckStability(size, 16, [](SSTD::Vector<Keyed>& values)
+      {
+        SSTD::Sort<SSTD::SortTypeRadix>(values.begin(), values.end(), [](const Keyed& value) { return value.key; });
+      });
+  }
+}
+
+//elements that aren't trivially copyable are relocated between the buffers, never copied or lost
+TEST(RadixSortTest, ElementsAreMovedProperly)
+{
+  {
+    std::vector<uint64> numbers = MakeInput(Input::Random, 20000, 6);
+    SSTD::Vector<Tracked> values{};
+    for (uint64 number : numbers)
+      values.PushBack(Tracked(static_cast<int>(number % 100000)));
+
+    SSTD::Sort<SSTD::SortTypeRadix>(values.begin(), values.end(), [](const Tracked& value) { return value.value; });
+    for (size_t i = 0; i < values.Size(); ++i)
+    {
+      ASSERT_TRUE(values[i].IsValid()) << i;
+      if (i > 0)
+      {
+        ASSERT_LE(values[i - 1].value, values[i].value) << i;
+      }
+    }
+    EXPECT_EQ(Tracked::s_Live, 20000);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(MergeSortTest, AgainstStd)
+{
+  CheckAgainstStd<SSTD::SortTypeMerge>();
+}
+
+//long runs that take turns for a while and then don't interleave at all, so the merges gallop in both directions
+TEST(MergeSortTest, Runs)
+{
+  for (size_t run : { size_t(50), size_t(1000), size_t(30000) })
+  {
+    std::vector<uint64> expected;
+    for (size_t block = 0; block < 7; ++block)
+    {
+      for (size_t i = 0; i < run; ++i)
+        expected.push_back(block % 2 ? i * 2 + 1 : (block * run + i) * 3);
+    }
+    SSTD::Vector<uint64> values{};
+    values.Append(expected.data(), expected.size());
+
+    std::sort(expected.begin(), expected.end());
+    SSTD::Sort<SSTD::SortTypeMerge>(values.begin(), values.end());
+    for (size_t i = 0; i < expected.size(); ++i)
+      ASSERT_EQ(values[i], expected[i]) << run << " " << i;
+  }
+}
+
+//few keys give long stretches of equal ones, many keys make the merges gallop over equal ones
+TEST(MergeSortTest, Stability)
+{
+  for (size_t size : { size_t(60), size_t(5000), size_t(300000) })
+  {
+    for (uint32 keys : { 16u, 100000u })
+    {
+      CheckStability(size, keys, [](SSTD::Vector<Keyed>& values)
+        {
+          SSTD::Sort<SSTD::SortTypeMerge>(values.begin(), values.end(), [](const Keyed& lhs, const Keyed& rhs) { return lhs.key < rhs.key; });
+        });
+    }
+  }
+}
+
+TEST(MergeSortTest, Scratch)
+{
+  std::vector<uint64> numbers = MakeInput(Input::Random, 20000, 7);
+  std::vector<uint64> expected = numbers;
+  std::sort(expected.begin(), expected.end());
+  auto sort = [&](SSTD::SortTypeMerge& sorter, size_t size)
+    {
+      SSTD::Vector<uint64> values{};
+      values.Append(numbers.data(), size);
+      sorter.Sort(values.begin(), values.end(), SSTD::Less<uint64>());
+
+      std::vector<uint64> reference(numbers.begin(), numbers.begin() + static_cast<ptrdiff_t>(size));
+      std::sort(reference.begin(), reference.end());
+      for (size_t i = 0; i < size; ++i)
+        ASSERT_EQ(values[i], reference[i]) << size << " " << i;
+    };
+
+  //the kept scratch has to grow when a later Sort needs more
+  SSTD::SortTypeMerge kept{};
+  for (size_t size : { size_t(1000), size_t(100), size_t(20000), size_t(5000) })
+    sort(kept, size);
+
+  //a buffer of GetScratchBytes is enough and gets used, one that is too small or misaligned is left alone
+  std::vector<uint64> buffer(SSTD::SortTypeMerge::GetScratchBytes<uint64>(20000) / sizeof(uint64) + 1, ~0ull);
+  {
+    SSTD::SortTypeMerge sorter(buffer.data(), SSTD::SortTypeMerge::GetScratchBytes<uint64>(20000));
+    sort(sorter, 20000);
+    EXPECT_NE(std::count(buffer.begin(), buffer.end(), ~0ull), static_cast<ptrdiff_t>(buffer.size()));
+  }
+  std::fill(buffer.begin(), buffer.end(), ~0ull);
+  {
+    SSTD::SortTypeMerge small(buffer.data(), 64);
+    sort(small, 20000);
+    SSTD::SortTypeMerge misaligned(reinterpret_cast<uint8*>(buffer.data()) + 1, buffer.size() * sizeof(uint64) - 1);
+    sort(misaligned, 20000);
+    EXPECT_EQ(std::count(buffer.begin(), buffer.end(), ~0ull), static_cast<ptrdiff_t>(buffer.size()));
+  }
+
+  //the arena is rolled back, the next allocation lands where it would have before the Sort
+  SSTD::LinearArena arena{};
+  void* before = arena.Allocate(8, 8);
+  SSTD::SortTypeMerge sorter(arena);
+  sort(sorter, 20000);
+  sort(sorter, 20000);
+  void* after = arena.Allocate(8, 8);
+  EXPECT_EQ(static_cast<uint8*>(after), static_cast<uint8*>(before) + 8);
+}
+
+//the scratch holds relocated elements only for the length of a merge, nothing may be copied over or lost
+TEST(MergeSortTest, ElementsAreMovedProperly)
+{
+  {
+    std::vector<uint64> numbers = MakeInput(Input::Random, 20000, 8);
+    SSTD::Vector<Tracked> values{};
+    for (uint64 number : numbers)
+      values.PushBack(Tracked(static_cast<int>(number % 1000)));
+
+    SSTD::Sort<SSTD::SortTypeMerge>(values.begin(), values.end());
+    for (size_t i = 0; i < values.Size(); ++i)
+    {
+      ASSERT_TRUE(values[i].IsValid()) << i;
+      if (i > 0)
+      {
+        ASSERT_LE(values[i - 1].value, values[i].value) << i;
+      }
+    }
+    EXPECT_EQ(Tracked::s_Live, 20000);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Platform/Threading/Thread.h"
+#include "Containers/Pointer.h"
+#include "Containers/Vector.h"
+#include "General/Exception.h"
+
+namespace TestUtility
+{
+  //counts the live instances and remembers its own address, so a container that copies the bytes of an object
+  //instead of moving it, or forgets a destructor, shows up as a stale self pointer or a wrong count
+  struct Tracked
+  {
+    Tracked(int pValue = 0) : value(pValue), self(this) { ++s_Live; }
+    Tracked(const Tracked& other) : value(other.value), self(this) { ++s_Live; }
+    Tracked(Tracked&& other) noexcept : value(other.value), self(this) { other.value = -1; ++s_Live; }
+    ~Tracked() { --s_Live; self = nullptr; }
+
+    Tracked& operator=(const Tracked& other) { value = other.value; return *this; }
+    Tracked& operator=(Tracked&& other) noexcept { value = other.value; other.value = -1; return *this; }
+
+    bool operator==(const Tracked& other) const { return value == other.value; }
+    bool operator<(const Tracked& other) const { return value < other.value; }
+
+    bool IsValid() const { return self == this; }
+
+    int value;
+    Tracked* self;
+
+    static inline int s_Live = 0;
+  };
+
+  //throws while it is built from a negative value, for the paths that have to undo an insert
+  struct ThrowingTracked : Tracked
+  {
+    ThrowingTracked(int pValue = 0) : Tracked(pValue)
+    {
+      if (pValue < 0)
+        throw SSTD::Exception();
+    }
+  };
+
+  //runs function(index) on count threads at once and waits for all of them
+  template<typename F>
+  void RunThreads(uint32 count, const F& function)
+  {
+    SSTD::Vector<SSTD::UniquePointer<SSTD::Thread>> threads{};
+    threads.Reserve(count);
+    for (uint32 i = 0; i < count; ++i)
+      threads.EmplaceBack(new SSTD::Thread(SSTD::Function<void()>::Create([&function, i]() { function(i); }), true));
+    for (uint32 i = 0; i < count; ++i)
+      threads[i]->Join();
+  }
+}
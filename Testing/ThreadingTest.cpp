@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include "Platform/Threading/Thread.h"
+#include "Platform/Threading/Mutex.h"
+#include "Platform/Threading/ConditionVariable.h"
+#include "Platform/Threading/Atomic.h"
+
+#include "TestUtility.h"
+
+static constexpr uint32 ThreadCount = 4;
+
+TEST(ThreadTest, StartAndJoin)
+{
+  SSTD::a_uint32 calls{ 0 };
+  SSTD::ThreadDesc desc{};
+  desc.name = "test thread";
+  desc.stack_size = 256 * 1024;
+  SSTD::Thread thread(SSTD::Function<void()>::Create([&]() { ++calls; }), desc, false);
+
+  //created suspended, nothing runs before Start
+  EXPECT_EQ(thread.GetState(), SSTD::ThreadState::Created);
+  EXPECT_EQ(calls.Load(), 0u);
+
+  thread.Start();
+  EXPECT_EQ(thread.GetState(), SSTD::ThreadState::Running);
+  thread.Join();
+  EXPECT_EQ(thread.GetState(), SSTD::ThreadState::Finished);
+  EXPECT_EQ(calls.Load(), 1u);
+
+  //a finished thread doesn't start again
+  thread.Start();
+  thread.Join();
+  EXPECT_EQ(calls.Load(), 1u);
+}
+
+//the counter is a plain int, any increment that gets past the lock shows up as a lost update
+TEST(MutexTest, Contention)
+{
+  static constexpr int Increments = 100000;
+  SSTD::Mutex mutex{};
+  int counter = 0;
+
+  TestUtility::RunThreads(ThreadCount, [&](uint32 index)
+    {
+      for (int i = 0; i < Increments; ++i)
+      {
+        //every other thread spins on TryLock, so both ways in are taken under contention
+        if (index % 2)
+        {
+          while (!mutex.TryLock())
+            ;
+          ++counter;
+          mutex.Unlock();
+        }
+        else
+        {
+          SSTD::Lock<SSTD::Mutex> lock(mutex);
+          ++counter;
+        }
+      }
+    });
+
+  EXPECT_EQ(counter, Increments * static_cast<int>(ThreadCount));
+  EXPECT_FALSE(mutex.IsLocked());
+  EXPECT_TRUE(mutex.TryLock());
+  EXPECT_TRUE(mutex.IsLocked());
+  EXPECT_FALSE(mutex.TryLock());
+  mutex.Unlock();
+}
+
+//the threads hand a token around in turn, a lost wake up hangs the test instead of failing it
+TEST(ConditionVariableTest, PingPong)
+{
+  static constexpr uint32 Rounds = 2000;
+  SSTD::Mutex mutex{};
+  SSTD::ConditionVariable condition{};
+  uint32 turn = 0;
+  uint32 order_errors = 0;
+
+  TestUtility::RunThreads(ThreadCount, [&](uint32 index)
+    {
+      for (uint32 round = 0; round < Rounds; ++round)
+      {
+        SSTD::Lock<SSTD::Mutex> lock(mutex);
+        condition.WaitFor(lock, [&]() { return turn % ThreadCount == index; });
+        if (turn != round * ThreadCount + index)
+          ++order_errors;
+        ++turn;
+        condition.NotifyAll();
+      }
+    });
+
+  EXPECT_EQ(turn, Rounds * ThreadCount);
+  EXPECT_EQ(order_errors, 0u);
+}
+
+//NotifyOne wakes a single waiter, every item is taken exactly once
+TEST(ConditionVariableTest, ProducerConsumers)
+{
+  static constexpr uint32 Items = 20000;
+  SSTD::Mutex mutex{};
+  SSTD::ConditionVariable condition{};
+  uint32 available = 0;
+  uint32 produced = 0;
+  SSTD::a_uint32 consumed{ 0 };
+
+  TestUtility::RunThreads(ThreadCount, [&](uint32 index)
+    {
+      if (index == 0)
+      {
+        for (uint32 i = 0; i < Items; ++i)
+        {
+          SSTD::Lock<SSTD::Mutex> lock(mutex);
+          ++available;
+          ++produced;
+          condition.NotifyOne();
+        }
+
+        //wake the consumers that wait for more than there is
+        SSTD::Lock<SSTD::Mutex> lock(mutex);
+        condition.NotifyAll();
+        return;
+      }
+
+      for (;;)
+      {
+        SSTD::Lock<SSTD::Mutex> lock(mutex);
+        condition.WaitFor(lock, [&]() { return available > 0 || produced == Items; });
+        if (available == 0)
+          return;
+        --available;
+        ++consumed;
+      }
+    });
+
+  EXPECT_EQ(consumed.Load(), Items);
+  EXPECT_EQ(available, 0u);
+}
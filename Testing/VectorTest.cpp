@@ -0,0 +1,640 @@
+#include <gtest/gtest.h>
+
+#include "Containers/Vector.h"
+#include "Containers/SmallVector.h"
+#include "Containers/StaticVector.h"
+#include "Containers/SoAVector.h"
+#include "Containers/SegmentedVector.h"
+#include "Containers/String.h"
+#include "Containers/Pointer.h"
+
+#include "TestUtility.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using TestUtility::Tracked;
+
+namespace
+{
+  //long enough to live on the heap
+  SSTD::String LongString(int i)
+  {
+    char buffer[64];
+    int size = snprintf(buffer, sizeof(buffer), "a string that does not fit inline %d", i);
+    return SSTD::String(buffer, static_cast<size_t>(size));
+  }
+
+  template<typename V>
+  void ExpectSame(const V& vector, const std::vector<int>& reference)
+  {
+    ASSERT_EQ(static_cast<size_t>(vector.Size()), reference.size());
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+      ASSERT_EQ(vector[i].value, reference[i]) << i;
+      ASSERT_TRUE(vector[i].IsValid()) << i;
+    }
+
+    //the iterators walk the same elements
+    size_t index = 0;
+    for (const Tracked& value : vector)
+      ASSERT_EQ(value.value, reference[index++]);
+    ASSERT_EQ(index, reference.size());
+  }
+
+  //random inserts and removes at any position, checked against std::vector after every step
+  template<typename V>
+  void RandomOperations(uint32 seed, int steps)
+  {
+    std::mt19937 rng(seed);
+    V vector{};
+    std::vector<int> reference;
+
+    for (int step = 0; step < steps; ++step)
+    {
+      int value = static_cast<int>(rng() % 1000);
+      size_t size = reference.size();
+      switch (rng() % 8)
+      {
+      case 0:
+      case 1:
+        vector.PushBack(Tracked(value));
+        reference.push_back(value);
+        break;
+      case 2:
+      {
+        size_t index = size ? rng() % (size + 1) : 0;
+        vector.EmplaceAt(index, value);
+        reference.insert(reference.begin() + index, value);
+        break;
+      }
+      case 3:
+        if (size)
+        {
+          size_t index = rng() % size;
+          EXPECT_EQ(vector.RemoveAt(index).value, reference[index]);
+          reference.erase(reference.begin() + index);
+        }
+        break;
+      case 4:
+        if (size)
+        {
+          size_t index = rng() % size;
+          size_t count = rng() % (size - index + 1);
+          vector.RemoveRange(index, count);
+          reference.erase(reference.begin() + index, reference.begin() + index + count);
+        }
+        break;
+      case 5:
+        if (size)
+        {
+          vector.PopBack();
+          reference.pop_back();
+        }
+        break;
+      case 6:
+        vector.Reserve(vector.Size() + rng() % 8);
+        break;
+      case 7:
+      {
+        //inserting an element of the vector itself, the value is taken before anything moves
+        if (size)
+        {
+          size_t from = rng() % size;
+          vector.Insert(0, vector[from]);
+          reference.insert(reference.begin(), reference[from]);
+        }
+        break;
+      }
+      }
+
+      ExpectSame(vector, reference);
+      ASSERT_EQ(Tracked::s_Live, static_cast<int>(reference.size()));
+    }
+  }
+}
+
+TEST(VectorTest, RandomOperations)
+{
+  RandomOperations<SSTD::Vector<Tracked>>(1, 2000);
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(VectorTest, CopyAndMove)
+{
+  {
+    SSTD::Vector<Tracked> vector{};
+    for (int i = 0; i < 50; ++i)
+      vector.PushBack(Tracked(i));
+
+    SSTD::Vector<Tracked> copy(vector);
+    EXPECT_EQ(copy.Size(), 50u);
+    EXPECT_EQ(copy[49].value, 49);
+    EXPECT_TRUE(copy[49].IsValid());
+
+    SSTD::Vector<Tracked> assigned{};
+    assigned.PushBack(Tracked(-5));
+    assigned = vector;
+    EXPECT_EQ(assigned.Size(), 50u);
+    EXPECT_EQ(assigned[0].value, 0);
+
+    SSTD::Vector<Tracked> moved(Move(copy));
+    EXPECT_EQ(copy.Size(), 0u);
+    EXPECT_EQ(moved.Size(), 50u);
+
+    assigned = Move(moved);
+    EXPECT_EQ(assigned.Size(), 50u);
+    EXPECT_EQ(Tracked::s_Live, 100);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(VectorTest, ResizeAndAppend)
+{
+  {
+    SSTD::Vector<Tracked> vector{};
+    vector.Resize(10);
+    EXPECT_EQ(vector.Size(), 10u);
+    EXPECT_EQ(Tracked::s_Live, 10);
+
+    vector.Resize(3);
+    EXPECT_EQ(Tracked::s_Live, 3);
+
+    Tracked more[4] = { Tracked(7), Tracked(8), Tracked(9), Tracked(10) };
+    vector.Append(more, 4);
+    EXPECT_EQ(vector.Size(), 7u);
+    EXPECT_EQ(vector[6].value, 10);
+    EXPECT_TRUE(vector[6].IsValid());
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(VectorTest, IndexOf)
+{
+  SSTD::Vector<int> vector{};
+  for (int i = 0; i < 10; ++i)
+    vector.PushBack(i * 2);
+
+  EXPECT_EQ(vector.IndexOf(6), 3u);
+  EXPECT_EQ(vector.IndexOf(7), SSTD::Vector<int>::NotFound);
+  EXPECT_TRUE(vector.Contains(18));
+}
+
+//the argument lives in the buffer that growing frees, it has to be read before that
+TEST(VectorTest, PushBackOwnElement)
+{
+  {
+    SSTD::Vector<SSTD::String> strings{};
+    SSTD::Vector<Tracked> values{};
+    strings.PushBack(LongString(0));
+    values.PushBack(Tracked(0));
+    //the buffer runs full and grows several times on the way
+    for (int i = 0; i < 100; ++i)
+    {
+      strings.PushBack(strings[0]);
+      values.EmplaceBack(values.Back());
+    }
+
+    for (size_t i = 0; i < values.Size(); ++i)
+    {
+      ASSERT_EQ(strings[i], LongString(0)) << i;
+      ASSERT_EQ(values[i].value, 0) << i;
+      ASSERT_TRUE(values[i].IsValid()) << i;
+    }
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+//Strings and pointers opt into IsTriviallyRelocatable, growing moves their bytes and must not leak or double free
+TEST(VectorTest, TriviallyRelocatableGrowth)
+{
+  static_assert(SSTD::IsTriviallyRelocatable<SSTD::String>::valid);
+  static_assert(!SSTD::IsTriviallyRelocatable<Tracked>::valid);
+
+  SSTD::Vector<SSTD::String> strings{};
+  SSTD::Vector<SSTD::SharedPointer<int>> pointers{};
+  for (int i = 0; i < 500; ++i)
+  {
+    strings.PushBack(LongString(i));
+    pointers.PushBack(SSTD::SharedPointer<int>(new int(i)));
+  }
+  strings.EmplaceAt(0, "front");
+  strings.RemoveAt(100);
+
+  EXPECT_EQ(strings[0], "front");
+  EXPECT_EQ(strings[1], LongString(0));
+  EXPECT_EQ(strings[100], LongString(100));
+  EXPECT_EQ(strings.Size(), 500u);
+  for (int i = 0; i < 500; ++i)
+    ASSERT_EQ(*pointers[i], i);
+}
+
+TEST(SmallVectorTest, RandomOperations)
+{
+  RandomOperations<SSTD::SmallVector<Tracked, 8>>(2, 2000);
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(SmallVectorTest, SpillsAndComesBack)
+{
+  {
+    SSTD::SmallVector<Tracked, 4> vector{};
+    for (int i = 0; i < 4; ++i)
+      vector.PushBack(Tracked(i));
+    EXPECT_TRUE(vector.IsInline());
+
+    vector.PushBack(Tracked(4));
+    EXPECT_FALSE(vector.IsInline());
+    EXPECT_GE(vector.Capacity(), 5u);
+
+    vector.RemoveRange(1, 3);
+    vector.Minimize();
+    EXPECT_TRUE(vector.IsInline());
+    ASSERT_EQ(vector.Size(), 2u);
+    EXPECT_EQ(vector[0].value, 0);
+    EXPECT_EQ(vector[1].value, 4);
+    EXPECT_TRUE(vector[1].IsValid());
+
+    vector.Clear();
+    EXPECT_TRUE(vector.IsInline());
+    EXPECT_EQ(Tracked::s_Live, 0);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+//an inline vector has to move its elements one by one, a spilled one hands over its buffer
+TEST(SmallVectorTest, CopyAndMove)
+{
+  {
+    SSTD::SmallVector<Tracked, 4> small{};
+    SSTD::SmallVector<Tracked, 4> large{};
+    for (int i = 0; i < 3; ++i)
+      small.PushBack(Tracked(i));
+    for (int i = 0; i < 10; ++i)
+      large.PushBack(Tracked(i));
+
+    SSTD::SmallVector<Tracked, 4> copy(large);
+    EXPECT_EQ(copy.Size(), 10u);
+    EXPECT_EQ(copy[9].value, 9);
+
+    SSTD::SmallVector<Tracked, 4> moved_small(Move(small));
+    EXPECT_TRUE(moved_small.IsInline());
+    EXPECT_EQ(small.Size(), 0u);
+    ASSERT_EQ(moved_small.Size(), 3u);
+    EXPECT_EQ(moved_small[2].value, 2);
+    EXPECT_TRUE(moved_small[2].IsValid());
+
+    const Tracked* buffer = large.Data();
+    SSTD::SmallVector<Tracked, 4> moved_large(Move(large));
+    EXPECT_EQ(moved_large.Data(), buffer);
+    EXPECT_TRUE(large.IsInline());
+    EXPECT_EQ(large.Size(), 0u);
+
+    copy = moved_small;
+    EXPECT_EQ(copy.Size(), 3u);
+    moved_small = Move(moved_large);
+    EXPECT_EQ(moved_small.Size(), 10u);
+    EXPECT_EQ(Tracked::s_Live, 13);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(SmallVectorTest, IndexOf)
+{
+  SSTD::SmallVector<int, 4> vector{};
+  for (int i = 0; i < 10; ++i)
+    vector.PushBack(i * 2);
+
+  EXPECT_EQ(vector.IndexOf(18), 9u);
+  EXPECT_EQ(vector.IndexOf(7), (SSTD::SmallVector<int, 4>::NotFound));
+  EXPECT_EQ((SSTD::SmallVector<int, 4>::NotFound), SSTD::Vector<int>::NotFound);
+}
+
+TEST(StaticVectorTest, RandomOperations)
+{
+  RandomOperations<SSTD::StaticVector<Tracked, 1024>>(3, 2000);
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(StaticVectorTest, FullVector)
+{
+  {
+    SSTD::StaticVector<Tracked, 4> vector{};
+    for (int i = 0; i < 4; ++i)
+      EXPECT_NE(vector.TryEmplaceBack(i), nullptr);
+    EXPECT_TRUE(vector.IsFull());
+
+    //a full vector refuses without touching what is already there
+    EXPECT_EQ(vector.TryEmplaceBack(4), nullptr);
+    EXPECT_THROW(vector.EmplaceBack(4), SSTD::Exception);
+    EXPECT_THROW(vector.EmplaceAt(0, 4), SSTD::Exception);
+    EXPECT_THROW(vector.Reserve(5), SSTD::Exception);
+    EXPECT_THROW(vector.Resize(5), SSTD::Exception);
+    ASSERT_EQ(vector.Size(), 4u);
+    EXPECT_EQ(vector[3].value, 3);
+    EXPECT_EQ(Tracked::s_Live, 4);
+
+    SSTD::StaticVector<Tracked, 4> moved(Move(vector));
+    EXPECT_EQ(vector.Size(), 0u);
+    EXPECT_EQ(moved.Size(), 4u);
+    EXPECT_TRUE(moved[0].IsValid());
+
+    vector = moved;
+    EXPECT_EQ(vector.Size(), 4u);
+    EXPECT_EQ(Tracked::s_Live, 8);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+namespace
+{
+  constexpr int ConstantSum()
+  {
+    SSTD::StaticVector<int, 8> vector{};
+    for (int i = 1; i <= 5; ++i)
+      vector.PushBack(i);
+    vector.RemoveAt(0);
+    vector.EmplaceAt(0, 10);
+
+    int sum = 0;
+    for (size_t i = 0; i < vector.Size(); ++i)
+      sum += vector[i];
+    return sum;
+  }
+}
+
+TEST(StaticVectorTest, ConstantEvaluation)
+{
+  static_assert(ConstantSum() == 24);
+  EXPECT_EQ(ConstantSum(), 24);
+}
+
+TEST(StaticVectorTest, IndexOf)
+{
+  SSTD::StaticVector<int, 16> vector{};
+  for (int i = 0; i < 10; ++i)
+    vector.PushBack(i * 2);
+
+  EXPECT_EQ(vector.IndexOf(4), 2u);
+  EXPECT_EQ(vector.IndexOf(7), (SSTD::StaticVector<int, 16>::NotFound));
+  EXPECT_THROW(vector.At(10), SSTD::Exception);
+}
+
+namespace
+{
+  using Particles = SSTD::SoAVector<float, uint64, Tracked>;
+
+  template<size_t Index, typename V>
+  bool IsColumnAligned(V& vector)
+  {
+    return reinterpret_cast<SSTD::uintptr>(vector.template Data<Index>()) % V::ColumnAlignment == 0;
+  }
+
+  //every row is checked field by field against a plain std::vector of the values it was built from
+  void ExpectSame(const Particles& particles, const std::vector<int>& reference)
+  {
+    ASSERT_EQ(particles.Size(), reference.size());
+    for (size_t i = 0; i < reference.size(); ++i)
+    {
+      ASSERT_EQ(particles[i].Get<0>(), static_cast<float>(reference[i]) * 0.5f) << i;
+      ASSERT_EQ(particles[i].Get<1>(), static_cast<uint64>(reference[i]) << 32) << i;
+      ASSERT_EQ(particles[i].Get<2>().value, reference[i]) << i;
+      ASSERT_TRUE(particles[i].Get<2>().IsValid()) << i;
+    }
+    ASSERT_EQ(particles.Column<2>().Size(), reference.size());
+  }
+
+  void EmplaceParticle(Particles& particles, int value)
+  {
+    particles.EmplaceBack(static_cast<float>(value) * 0.5f, static_cast<uint64>(value) << 32, Tracked(value));
+  }
+}
+
+TEST(SoAVectorTest, RowsAndColumns)
+{
+  {
+    Particles particles{};
+    std::vector<int> reference;
+    for (int i = 0; i < 1000; ++i)
+    {
+      EmplaceParticle(particles, i);
+      reference.push_back(i);
+    }
+    ExpectSame(particles, reference);
+    EXPECT_TRUE(IsColumnAligned<0>(particles));
+    EXPECT_TRUE(IsColumnAligned<1>(particles));
+    EXPECT_TRUE(IsColumnAligned<2>(particles));
+    EXPECT_EQ(Tracked::s_Live, 1000);
+
+    for (size_t index : { 0, 500, 997 })
+    {
+      particles.RemoveAt(index);
+      reference.erase(reference.begin() + index);
+    }
+    particles.PopBack();
+    reference.pop_back();
+    ExpectSame(particles, reference);
+
+    particles.Back().Get<2>().value = 7;
+    EXPECT_EQ(particles.Column<2>()[particles.Size() - 1].value, 7);
+
+    particles.Resize(10);
+    EXPECT_EQ(particles.Size(), 10u);
+    EXPECT_EQ(Tracked::s_Live, 10);
+    particles.Resize(20);
+    EXPECT_EQ(particles[19].Get<0>(), 0.0f);
+    EXPECT_EQ(particles[19].Get<1>(), 0u);
+    EXPECT_EQ(Tracked::s_Live, 20);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+//the fields of the first row are read while the columns they live in are moved to a larger block
+TEST(SoAVectorTest, EmplaceOwnRow)
+{
+  {
+    Particles particles{};
+    EmplaceParticle(particles, 3);
+    for (int i = 0; i < 100; ++i)
+      particles.EmplaceBack(particles[0].Get<0>(), particles[0].Get<1>(), particles[0].Get<2>());
+
+    for (size_t i = 0; i < particles.Size(); ++i)
+    {
+      ASSERT_EQ(particles[i].Get<0>(), 1.5f) << i;
+      ASSERT_EQ(particles[i].Get<1>(), 3ull << 32) << i;
+      ASSERT_EQ(particles[i].Get<2>().value, 3) << i;
+      ASSERT_TRUE(particles[i].Get<2>().IsValid()) << i;
+    }
+    EXPECT_EQ(Tracked::s_Live, 101);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(SoAVectorTest, CopyMoveAndAppend)
+{
+  {
+    Particles particles{};
+    std::vector<int> reference;
+    for (int i = 0; i < 100; ++i)
+    {
+      EmplaceParticle(particles, i);
+      reference.push_back(i);
+    }
+
+    Particles copy(particles);
+    ExpectSame(copy, reference);
+    EXPECT_TRUE(IsColumnAligned<1>(copy));
+
+    const float* column = particles.Data<0>();
+    Particles moved(Move(particles));
+    EXPECT_EQ(moved.Data<0>(), column);
+    EXPECT_EQ(particles.Size(), 0u);
+    ExpectSame(moved, reference);
+
+    //whole columns at once, then another vector behind them
+    float floats[3] = { 100.0f * 0.5f, 101.0f * 0.5f, 102.0f * 0.5f };
+    uint64 integers[3] = { 100ull << 32, 101ull << 32, 102ull << 32 };
+    Tracked tracked[3] = { Tracked(100), Tracked(101), Tracked(102) };
+    moved.Append(floats, integers, tracked, 3);
+    reference.insert(reference.end(), { 100, 101, 102 });
+    ExpectSame(moved, reference);
+
+    moved.Append(copy);
+    reference.insert(reference.end(), reference.begin(), reference.begin() + 100);
+    ExpectSame(moved, reference);
+
+    copy = Move(moved);
+    ExpectSame(copy, reference);
+    EXPECT_EQ(Tracked::s_Live, 203 + 3);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(SoAVectorTest, ApplyColumns)
+{
+  SSTD::SoAVector<float, float, int> vector{};
+  for (int i = 0; i < 333; ++i)
+    vector.EmplaceBack(static_cast<float>(i), 2.0f, i);
+
+  vector.ApplyColumns<0, 1>([](float* x, const float* scale, size_t size)
+    {
+      EXPECT_EQ(reinterpret_cast<SSTD::uintptr>(x) % 64, 0u);
+      EXPECT_EQ(reinterpret_cast<SSTD::uintptr>(scale) % 64, 0u);
+      for (size_t i = 0; i < size; ++i)
+        x[i] *= scale[i];
+    });
+
+  for (int i = 0; i < 333; ++i)
+  {
+    ASSERT_EQ(vector[i].Get<0>(), static_cast<float>(i * 2));
+    ASSERT_EQ(vector[i].Get<2>(), i);
+  }
+}
+
+//growing adds chunks, the elements already stored must stay where they are
+TEST(SegmentedVectorTest, AddressesAreStable)
+{
+  {
+    SSTD::SegmentedVector<Tracked, 16> vector{};
+    std::vector<const Tracked*> addresses;
+    for (int i = 0; i < 1000; ++i)
+      addresses.push_back(&vector.EmplaceBack(i));
+    EXPECT_EQ(vector.ChunkCount(), (1000u + 15) / 16);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+      ASSERT_EQ(&vector[i], addresses[i]);
+      ASSERT_EQ(vector[i].value, i);
+      ASSERT_TRUE(vector[i].IsValid());
+    }
+
+    int expected = 0;
+    for (const Tracked& value : vector)
+      ASSERT_EQ(value.value, expected++);
+    EXPECT_EQ(expected, 1000);
+
+    size_t chunks = 0;
+    size_t total = 0;
+    vector.ApplyChunks([&](Tracked* data, size_t size)
+      {
+        EXPECT_EQ(data, addresses[chunks * 16]);
+        ++chunks;
+        total += size;
+      });
+    EXPECT_EQ(chunks, vector.ChunkCount());
+    EXPECT_EQ(total, 1000u);
+    EXPECT_EQ(Tracked::s_Live, 1000);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(SegmentedVectorTest, ResizeEraseAndMinimize)
+{
+  {
+    SSTD::SegmentedVector<Tracked, 16> vector{};
+    vector.Resize(100);
+    EXPECT_EQ(Tracked::s_Live, 100);
+    vector.Resize(20);
+    EXPECT_EQ(Tracked::s_Live, 20);
+    EXPECT_EQ(vector.ChunkCount(), 7u);
+
+    vector.Minimize();
+    EXPECT_EQ(vector.ChunkCount(), 2u);
+    EXPECT_EQ(vector.Capacity(), 32u);
+
+    vector.PopBack();
+    EXPECT_EQ(vector.Size(), 19u);
+    EXPECT_EQ(Tracked::s_Live, 19);
+
+    //erase keeps the chunks around for the next elements
+    const Tracked* first = &vector[0];
+    vector.Erase();
+    EXPECT_EQ(Tracked::s_Live, 0);
+    EXPECT_EQ(vector.ChunkCount(), 2u);
+    EXPECT_EQ(&vector.EmplaceBack(5), first);
+
+    vector.Clear();
+    EXPECT_EQ(vector.ChunkCount(), 0u);
+    EXPECT_THROW(vector.At(0), SSTD::Exception);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}
+
+TEST(SegmentedVectorTest, CopyMoveAndAppend)
+{
+  {
+    Tracked values[40];
+    for (int i = 0; i < 40; ++i)
+      values[i].value = i;
+
+    //starts in the middle of a chunk and spans three more
+    SSTD::SegmentedVector<Tracked, 16> vector{};
+    vector.EmplaceBack(-2);
+    vector.Append(values, 40);
+    ASSERT_EQ(vector.Size(), 41u);
+    for (int i = 0; i < 40; ++i)
+    {
+      ASSERT_EQ(vector[i + 1].value, i);
+      ASSERT_TRUE(vector[i + 1].IsValid());
+    }
+
+    SSTD::SegmentedVector<Tracked, 16> copy(vector);
+    copy.Append(vector);
+    EXPECT_EQ(copy.Size(), 82u);
+    EXPECT_EQ(copy[41].value, -2);
+    EXPECT_EQ(copy[81].value, 39);
+
+    const Tracked* first = &vector[0];
+    SSTD::SegmentedVector<Tracked, 16> moved(Move(vector));
+    EXPECT_EQ(&moved[0], first);
+    EXPECT_EQ(vector.Size(), 0u);
+
+    copy = moved;
+    EXPECT_EQ(copy.Size(), 41u);
+    moved = Move(copy);
+    EXPECT_EQ(moved.Size(), 41u);
+    EXPECT_EQ(Tracked::s_Live, 40 + 41);
+  }
+  EXPECT_EQ(Tracked::s_Live, 0);
+}